@@ -0,0 +1,260 @@
+#pragma once
+
+#include <inttypes.h>
+#include <string>
+#include <list>
+#include <unordered_map>
+
+#include "Asset/AssetHandle.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+enum class AssetType {
+    MUSIC,
+    SOUND,
+    SHADER,
+    TEXTURE,
+    FONT,
+    COUNT
+};
+
+class AssetCache;
+
+/// @brief Entry of the asset cache, shared by all the references of an asset
+struct AssetCacheEntry {
+    std::string key;
+    AssetType type;
+    AssetHandle handle;
+    uint32_t ref_count;
+    size_t cpu_bytes;
+    size_t gpu_bytes;
+
+    // Position in the LRU list while the entry is not referenced
+    std::list<AssetCacheEntry*>::iterator lru_it;
+    bool in_lru;
+};
+
+/// @brief Counted reference on a cached asset, the asset can be evicted once no reference is left.
+/// A reference must not outlive its cache.
+template<typename T>
+class AssetRef {
+public:
+    AssetRef() : m_cache(nullptr), m_entry(nullptr) {}
+
+    AssetRef(AssetCache* cache, AssetCacheEntry* entry);
+
+    AssetRef(const AssetRef& other);
+    AssetRef(AssetRef&& other) noexcept;
+
+    AssetRef& operator=(const AssetRef& other);
+    AssetRef& operator=(AssetRef&& other) noexcept;
+
+    ~AssetRef();
+
+    /// @brief Drop the reference
+    void reset();
+
+    /// @brief Check if the reference points to a loaded asset
+    bool is_valid() const { return m_entry != nullptr; }
+
+    explicit operator bool() const { return is_valid(); }
+
+    /// @brief Get the handle of the asset, usable with the asset manager
+    AssetHandle get_handle() const { return m_entry ? m_entry->handle : AssetHandle{-1, typeid(T)}; }
+
+    /// @brief Get the asset, the reference must be valid
+    T& get() const;
+
+    T* operator->() const { return &get(); }
+    T& operator*() const { return get(); }
+
+private:
+    AssetCache* m_cache;
+    AssetCacheEntry* m_entry;
+};
+
+/// @brief Deduplicating cache in front of the asset factory.
+/// Assets are keyed by their type and normalized path, the second request of the same asset returns
+/// the loaded one. The CPU and GPU memory of the assets is accounted per type and when a budget is
+/// exceeded the least recently released assets with no reference left are removed from the manager.
+class AssetCache {
+public:
+    /// @brief Constructor, the budgets are unlimited
+    /// @param manager Asset manager storing the assets
+    /// @param factory Asset factory loading the assets
+    AssetCache(AssetManager& manager, AssetFactory& factory);
+
+    /// @brief Destructor, removes the assets owned by the cache from the manager
+    ~AssetCache();
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    AssetRef<Music> music(const std::string& path);
+
+    AssetRef<Sound> sound(const std::string& path);
+
+    AssetRef<Shader> shader(const std::string& vertex_path, const std::string& fragment_path);
+
+    AssetRef<Texture> texture(const std::string& path);
+
+    AssetRef<Font> font(const std::string& path, uint32_t font_size);
+
+    /// @brief Set the memory budgets, evicts at once if they are exceeded
+    /// @param cpu_bytes Budget of the memory used by the assets on the CPU side
+    /// @param gpu_bytes Budget of the video memory used by the assets
+    void set_budget(size_t cpu_bytes, size_t gpu_bytes);
+
+    /// @brief Remove the unreferenced assets until the budgets are respected
+    void collect();
+
+    /// @brief Remove all the unreferenced assets
+    void purge();
+
+    size_t get_cpu_bytes() const { return m_cpu_bytes; }
+    size_t get_gpu_bytes() const { return m_gpu_bytes; }
+    size_t get_cpu_bytes(AssetType type) const { return m_cpu_bytes_type[(size_t)type]; }
+    size_t get_gpu_bytes(AssetType type) const { return m_gpu_bytes_type[(size_t)type]; }
+
+    size_t get_entry_count() const { return m_entries.size(); }
+    uint32_t get_hit_count() const { return m_hits; }
+    uint32_t get_miss_count() const { return m_misses; }
+    uint32_t get_eviction_count() const { return m_evictions; }
+
+    /// @brief Log the memory used per asset type
+    void report() const;
+
+private:
+    template<typename T>
+    friend class AssetRef;
+
+    template<typename T, typename LOAD>
+    AssetRef<T> acquire(AssetType type, const std::string& key, LOAD&& load);
+
+    void add_ref(AssetCacheEntry* entry);
+    void release(AssetCacheEntry* entry);
+
+    void measure(AssetCacheEntry& entry);
+    void evict(AssetCacheEntry& entry);
+    bool over_budget() const;
+
+    AssetManager& m_manager;
+    AssetFactory& m_factory;
+
+    std::unordered_map<std::string, AssetCacheEntry> m_entries;
+
+    // Unreferenced entries, least recently released first
+    std::list<AssetCacheEntry*> m_lru;
+
+    size_t m_cpu_budget, m_gpu_budget;
+    size_t m_cpu_bytes, m_gpu_bytes;
+    size_t m_cpu_bytes_type[(size_t)AssetType::COUNT];
+    size_t m_gpu_bytes_type[(size_t)AssetType::COUNT];
+
+    uint32_t m_hits, m_misses, m_evictions;
+};
+
+namespace detail {
+
+template<typename T> AssetStorage<T>& asset_storage(AssetManager& manager);
+template<> inline AssetStorage<Music>& asset_storage<Music>(AssetManager& manager) { return manager.musics; }
+template<> inline AssetStorage<Sound>& asset_storage<Sound>(AssetManager& manager) { return manager.sounds; }
+template<> inline AssetStorage<Shader>& asset_storage<Shader>(AssetManager& manager) { return manager.shaders; }
+template<> inline AssetStorage<Texture>& asset_storage<Texture>(AssetManager& manager) { return manager.textures; }
+template<> inline AssetStorage<Font>& asset_storage<Font>(AssetManager& manager) { return manager.fonts; }
+
+}
+
+template<typename T>
+AssetRef<T>::AssetRef(AssetCache* cache, AssetCacheEntry* entry)
+: m_cache(cache), m_entry(entry) {
+    if (m_entry) {
+        m_cache->add_ref(m_entry);
+    }
+}
+
+template<typename T>
+AssetRef<T>::AssetRef(const AssetRef& other)
+: AssetRef(other.m_cache, other.m_entry) {}
+
+template<typename T>
+AssetRef<T>::AssetRef(AssetRef&& other) noexcept
+: m_cache(other.m_cache), m_entry(other.m_entry) {
+    other.m_cache = nullptr;
+    other.m_entry = nullptr;
+}
+
+template<typename T>
+AssetRef<T>& AssetRef<T>::operator=(const AssetRef& other) {
+    if (this != &other) {
+        // Take the new reference first, the entry may be the same
+        if (other.m_entry) {
+            other.m_cache->add_ref(other.m_entry);
+        }
+        reset();
+        m_cache = other.m_cache;
+        m_entry = other.m_entry;
+    }
+    return *this;
+}
+
+template<typename T>
+AssetRef<T>& AssetRef<T>::operator=(AssetRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_cache = other.m_cache;
+        m_entry = other.m_entry;
+        other.m_cache = nullptr;
+        other.m_entry = nullptr;
+    }
+    return *this;
+}
+
+template<typename T>
+AssetRef<T>::~AssetRef() {
+    reset();
+}
+
+template<typename T>
+void AssetRef<T>::reset() {
+    if (m_entry) {
+        m_cache->release(m_entry);
+    }
+    m_cache = nullptr;
+    m_entry = nullptr;
+}
+
+template<typename T>
+T& AssetRef<T>::get() const {
+    return detail::asset_storage<T>(m_cache->m_manager).get(m_entry->handle);
+}
+
+template<typename T, typename LOAD>
+AssetRef<T> AssetCache::acquire(AssetType type, const std::string& key, LOAD&& load) {
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_hits++;
+        return AssetRef<T>(this, &it->second);
+    }
+
+    m_misses++;
+    AssetHandle handle = load();
+    if (!detail::asset_storage<T>(m_manager).validity(handle)) {
+        // Failures are not cached, the factory already logged the reason
+        return AssetRef<T>();
+    }
+
+    AssetCacheEntry& entry = m_entries.emplace(key, AssetCacheEntry{
+        key, type, handle, 0, 0, 0, m_lru.end(), false
+    }).first->second;
+    measure(entry);
+
+    AssetRef<T> ref(this, &entry);
+    collect();
+    return ref;
+}
+
+}
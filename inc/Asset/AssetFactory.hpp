@@ -6,12 +6,20 @@
 #include "External/stb_image/stb_image_write.h"
 
 #include "Asset/AssetManager.hpp"
+#include "Asset/AssetPack.hpp"
+#include "Asset/ImageData.hpp"
+
+#include "Graphic/ShaderCache.hpp"
 
 #include "Audio/Music.hpp"
 #include "Audio/Sound.hpp"
 
 #include "Text/Font.hpp"
 #include "Text/FontSystem.hpp"
+#include "Text/FontBitmap.hpp"
+
+struct FT_FaceRec_;   // forward declaration FreeType
+typedef struct FT_FaceRec_* FT_Face;
 
 namespace AMB {
 
@@ -24,6 +32,14 @@ public:
 
     AssetHandle create_sound(const std::string& path);
 
+    /// @brief Set the program binary cache used by the shader creation
+    /// @param cache Cache, nullptr to always compile
+    void set_shader_cache(ShaderCache* cache);
+
+    /// @brief Create a shader, the compile and link run in the driver and are checked at first use
+    /// @param vertex_path Path of the vertex shader
+    /// @param fragment_path Path of the fragment shader
+    /// @return Handle of the shader, invalid if a source can not be read
     AssetHandle create_shader(const std::string& vertex_path, const std::string& fragment_path);
     
     AssetHandle create_shader_from_code(const std::string& vertex_code, const std::string& fragment_code);
@@ -36,16 +52,73 @@ public:
 
     AssetHandle create_font(const std::string& path, uint32_t font_size);
 
+    /// @brief Create a font with its glyphs rasterized by the workers of a thread pool, one atlas upload
+    /// @param path Path of the font file, read in memory
+    /// @param font_size Height of the glyphs in pixels
+    /// @param pool Thread pool rendering the glyphs, each worker with its own FreeType library
+    /// @return Handle of the font, invalid if the file can not be read
+    AssetHandle create_font(const std::string& path, uint32_t font_size, ThreadPool& pool);
+
+    /// @brief Create a set of fonts, all their glyphs are rasterized at once by the workers of a thread pool
+    /// @param fonts Paths of the font files and heights of their glyphs in pixels
+    /// @param pool Thread pool rendering the glyphs
+    /// @return Handles of the fonts in the order of the requests, invalid for a file which can not be read
+    std::vector<AssetHandle> create_fonts(const std::vector<std::pair<std::string, uint32_t>>& fonts, ThreadPool& pool);
+
+    /// @brief Create a signed distance field font, one atlas drawn at any size with the SDF text shader
+    /// @param path Path of the font file
+    /// @param base_size Height of the rasterized glyphs in pixels
+    /// @param spread Distance range of the field in pixels, bounds the outline and shadow effects
+    /// @param pool Thread pool computing the distance transforms, nullptr to compute them on this thread
+    /// @return Handle of the font, invalid if the file can not be read
+    AssetHandle create_sdf_font(const std::string& path, uint32_t base_size = 48, uint32_t spread = 6, ThreadPool* pool = nullptr);
+
+    /// @brief Create a font rasterizing its glyphs on demand, for UTF-8 text
+    /// @param path Path of the font file, read in memory
+    /// @param font_size Height of the glyphs in pixels
+    /// @param page_size Width and height of the atlas pages
+    /// @param max_pages Maximum number of atlas pages, bounds the video memory
+    /// @return Handle of the dynamic font, invalid if the file can not be read
+    AssetHandle create_dynamic_font(const std::string& path, uint32_t font_size, uint32_t page_size = 512, uint32_t max_pages = 4);
+
+    // Creation from an amber pack, the names are the paths relative to the packed directory
+
+    /// @brief Create a music streamed from the pack, the pack must outlive the music
+    AssetHandle create_music(const AssetPack& pack, const std::string& name);
+
+    AssetHandle create_sound(const AssetPack& pack, const std::string& name);
+
+    AssetHandle create_shader(const AssetPack& pack, const std::string& vertex_name, const std::string& fragment_name);
+
+    AssetHandle create_texture(const AssetPack& pack, const std::string& name);
+
+    AssetHandle create_font(const AssetPack& pack, const std::string& name, uint32_t font_size);
+
+    // Creation from data decoded on another thread, the GL upload is done here
+
+    /// @brief Upload a decoded image
+    AssetHandle create_texture(const ImageData& image);
+
+    /// @brief Upload a rasterized font atlas and create the font
+    AssetHandle create_font(const FontBitmap& bitmap, const std::string& name);
+
+    /// @brief Decode a sound file in memory, the data is not needed after
+    AssetHandle create_sound(const uint8_t* data, size_t size, const std::string& name);
+
 private:
     AssetManager& m_manager;
 
     FontSystem& m_font_system;
 
+    ShaderCache* m_shader_cache;
+
     bool load_shader_source(const std::string path, std::string& source);
 
-    bool create_shader_partial(GLenum type, uint32_t& shader_index, const std::string& source);
+    AssetHandle create_font_from_face(FT_Face face, const std::string& name, uint32_t font_size);
+
+    uint32_t create_shader_partial(GLenum type, const std::string& source);
 
-    bool create_shader_program(uint32_t vertex_shader, uint32_t fragment_shader, uint32_t& shader_program);
+    AssetHandle create_shader_program(const std::string& vertex_code, const std::string& fragment_code);
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <inttypes.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "Asset/AssetHandle.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Asset/AssetCache.hpp"
+#include "Asset/ImageData.hpp"
+#include "Text/FontBitmap.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+/// @brief Time spent to load an asset, in milliseconds from the start of the load
+struct AssetLoadTiming {
+    std::string name;
+    AssetType type;
+    float start_ms;
+    float end_ms;
+    float worker_ms;    // Reading and decoding on the thread pool
+    float render_ms;    // Uploading on the render thread
+    bool critical;      // On the critical path of the load
+};
+
+/// @brief Load a set of assets described by a manifest as a dependency graph.
+/// Each asset is split in steps: the file reading and decoding steps run in parallel on the thread
+/// pool, the GL steps run on the thread calling update() or load(). A step starts as soon as the steps
+/// it depends on are done, so the uploads of the first assets overlap the decoding of the others.
+///
+/// Manifest, one asset per line, '#' starts a comment:
+///     texture <name> <path> [after <name>...]
+///     shader <name> <vertex path> <fragment path> [after <name>...]
+///     font <name> <path> <size> [after <name>...]
+///     sound <name> <path> [after <name>...]
+///     music <name> <path> [after <name>...]
+/// "after" delays the GL step of the asset until the named assets are loaded.
+class AssetGraphLoader {
+public:
+    /// @brief Constructor
+    /// @param factory Factory creating the assets on the render thread
+    /// @param pool Thread pool reading and decoding the files
+    AssetGraphLoader(AssetFactory& factory, ThreadPool& pool);
+
+    /// @brief Destructor, waits for the steps running on the pool
+    ~AssetGraphLoader();
+
+    AssetGraphLoader(const AssetGraphLoader&) = delete;
+    AssetGraphLoader& operator=(const AssetGraphLoader&) = delete;
+
+    /// @brief Add the assets of a manifest file
+    /// @param path Path of the manifest, the asset paths are relative to the working directory
+    /// @return False if the file can not be read or a line is malformed
+    bool add_manifest(const std::string& path);
+
+    void add_texture(const std::string& name, const std::string& path, const std::vector<std::string>& after = {});
+
+    void add_shader(const std::string& name, const std::string& vertex_path, const std::string& fragment_path, const std::vector<std::string>& after = {});
+
+    void add_font(const std::string& name, const std::string& path, uint32_t font_size, const std::vector<std::string>& after = {});
+
+    void add_sound(const std::string& name, const std::string& path, const std::vector<std::string>& after = {});
+
+    void add_music(const std::string& name, const std::string& path, const std::vector<std::string>& after = {});
+
+    /// @brief Build the graph and start the steps with no dependency
+    /// @return False if a dependency is unknown or cyclic, nothing is started then
+    bool start();
+
+    /// @brief Run the ready GL steps, to call on the render thread (e.g. once per frame)
+    /// @param budget_ms Time allowed for the GL steps, at least one step is run if one is ready
+    /// @return True when all the assets are loaded
+    bool update(float budget_ms);
+
+    /// @brief Start and block until all the assets are loaded, the GL steps run on this thread
+    /// @return False if the graph can not be started or an asset failed
+    bool load();
+
+    /// @brief Check if all the assets are loaded
+    bool is_done() const;
+
+    /// @brief Get the handle of a loaded asset
+    /// @param name Name of the asset in the manifest
+    /// @return Handle of the asset, invalid if unknown, failed or not loaded yet
+    AssetHandle get(const std::string& name) const;
+
+    /// @brief Get the number of assets which could not be loaded
+    uint32_t get_failed_count() const;
+
+    /// @brief Get the timings of the assets, available once the load is done
+    std::vector<AssetLoadTiming> get_timings() const;
+
+    /// @brief Get the assets on the critical path, in loading order
+    /// @return Names of the assets whose steps made the load last that long
+    std::vector<std::string> get_critical_path() const;
+
+    /// @brief Get the duration of the whole load
+    float get_total_ms() const;
+
+    /// @brief Log the timings of the assets and the critical path
+    void report() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Asset {
+        std::string name;
+        AssetType type;
+        std::string paths[2];
+        uint32_t font_size;
+        std::vector<std::string> after;
+
+        // Intermediate data, written by one step and read by the next one
+        std::vector<uint8_t> files[2];
+        ImageData image;
+        FontBitmap font;
+
+        AssetHandle handle;
+        bool failed;
+        std::vector<uint32_t> steps;
+    };
+
+    struct Step {
+        uint32_t asset;
+        bool render;                    // Runs on the render thread
+        std::function<bool(Asset&)> run;
+        std::vector<uint32_t> next;
+        uint32_t pending;               // Dependencies not done yet
+
+        float start_ms, end_ms;
+        int32_t critical_previous;      // Dependency which was done last, -1 if none
+    };
+
+    Asset& add_asset(const std::string& name, AssetType type, const std::vector<std::string>& after);
+    uint32_t add_step(uint32_t asset, bool render, std::function<bool(Asset&)> run, std::vector<uint32_t> previous);
+    void build_steps(uint32_t asset_index);
+
+    void run_step(uint32_t step);
+    void complete_step(uint32_t step, float start_ms, bool success);
+    void schedule(uint32_t step);
+    float elapsed_ms() const;
+
+    AssetFactory& m_factory;
+    ThreadPool& m_pool;
+
+    std::vector<Asset> m_assets;
+    std::unordered_map<std::string, uint32_t> m_names;
+    std::vector<Step> m_steps;
+    bool m_started;
+
+    Clock::time_point m_start;
+
+    // Shared with the workers
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<uint32_t> m_render_ready;
+    uint32_t m_done;
+    uint32_t m_running;
+};
+
+}
@@ -7,6 +7,7 @@
 #include "Graphic/Shader.hpp"
 #include "Graphic/Texture.hpp"
 #include "Text/Font.hpp"
+#include "Text/DynamicFont.hpp"
 
 namespace AMB {
 
@@ -16,6 +17,7 @@ struct AssetManager {
     AssetStorage<Shader> shaders;
     AssetStorage<Texture> textures;
     AssetStorage<Font> fonts;
+    AssetStorage<DynamicFont> dynamic_fonts;
 };
 
 }
\ No newline at end of file
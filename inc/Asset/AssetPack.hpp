@@ -0,0 +1,82 @@
+#pragma once
+
+#include <inttypes.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Asset/PackFormat.hpp"
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+/// @brief Content of a pack entry. Points directly in the mapped file for the
+/// uncompressed entries, owns a decompressed copy otherwise
+struct PackData {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::shared_ptr<uint8_t> owned;
+
+    bool valid() const { return data != nullptr; }
+};
+
+/// @brief Read only, memory mapped amber pack (see tools/AmberPack.cpp to build one)
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /// @brief Map a pack file and check its index
+    /// @param path Path of the pack
+    /// @return True if the pack is usable
+    bool open(const std::string& path);
+
+    /// @brief Unmap the pack, the PackData pointing in the file become invalid
+    void close();
+
+    bool is_open() const { return m_base != nullptr; }
+
+    /// @brief Check if the pack contains an asset
+    /// @param name Name of the asset (path relative to the packed directory)
+    /// @return True if the asset is in the pack
+    bool contains(std::string_view name) const;
+
+    /// @brief Get the content of an asset
+    /// @param name Name of the asset (path relative to the packed directory)
+    /// @return The content, invalid if the asset does not exist or can not be decompressed
+    PackData get(std::string_view name) const;
+
+    /// @brief Keep a decompressed copy alive as long as the pack (for streamed assets like musics)
+    /// @param data Content to keep
+    void retain(const PackData& data) const;
+
+    /// @brief Get the names of all the entries
+    /// @return The names, in index order
+    std::vector<std::string> list() const;
+
+    size_t get_entry_count() const { return m_entry_count; }
+
+private:
+    const PackEntry* find(std::string_view name) const;
+
+    const uint8_t* m_base;
+    size_t m_size;
+    const PackEntry* m_entries;
+    size_t m_entry_count;
+    const char* m_names;
+    size_t m_names_size;
+
+    mutable std::vector<std::shared_ptr<uint8_t>> m_retained;
+
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+};
+
+}
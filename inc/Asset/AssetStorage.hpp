@@ -26,6 +26,11 @@ public:
 
     bool validity(AssetHandle handle) const;
 
+    /// @brief Find the handle of a stored object (linear search)
+    /// @param object Object stored in this storage
+    /// @return Handle of the object, invalid if not found
+    AssetHandle find(const T& object) const;
+
 private:
     std::vector<std::unique_ptr<T>> m_storage;
     std::stack<int32_t> m_free_id;
@@ -87,4 +92,14 @@ bool AssetStorage<T>::validity(AssetHandle handle) const {
         handle.index < (int32_t)m_storage.size() && m_storage[handle.index] != nullptr;
 }
 
+template<typename T>
+AssetHandle AssetStorage<T>::find(const T& object) const {
+    for (size_t i = 0; i < m_storage.size(); i++) {
+        if (m_storage[i].get() == &object) {
+            return AssetHandle{(int32_t)i, typeid(T)};
+        }
+    }
+    return AssetHandle{-1, typeid(T)};
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <inttypes.h>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <unordered_set>
+#include <glad/glad.h>
+
+#include "Asset/AssetHandle.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/ImageData.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+/// @brief Load textures without blocking the GL thread.
+/// load() returns at once a handle on a 1x1 transparent placeholder, the file is decoded on the
+/// thread pool and update() uploads the decoded images in slices of rows through pixel buffer
+/// objects, within a time budget per frame. The placeholder is replaced when the upload is complete.
+class AsyncTextureLoader {
+public:
+    /// @brief Constructor
+    /// @param manager Asset manager receiving the textures
+    /// @param pool Thread pool decoding the images
+    AsyncTextureLoader(AssetManager& manager, ThreadPool& pool);
+
+    /// @brief Destructor, waits for the images being decoded
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader&) = delete;
+    AsyncTextureLoader& operator=(const AsyncTextureLoader&) = delete;
+
+    /// @brief Queue the loading of a texture
+    /// @param path Path of the image
+    /// @return Handle of the texture, usable at once (placeholder until loaded)
+    AssetHandle load(const std::string& path);
+
+    /// @brief Upload decoded images, to call on the GL thread once per frame
+    /// @param budget_ms Time allowed for the uploads, at least one slice is uploaded
+    void update(float budget_ms);
+
+    /// @brief Block until all the queued textures are loaded
+    void finish();
+
+    /// @brief Check if a texture is still being decoded or uploaded
+    /// @param handle Handle returned by load
+    /// @return True if the texture is still the placeholder
+    bool is_pending(AssetHandle handle) const;
+
+    /// @brief Get the number of textures not loaded yet
+    /// @return Number of textures being decoded or uploaded
+    size_t get_pending_count() const;
+
+private:
+    struct Job {
+        AssetHandle handle;
+        std::string path;
+        ImageData image;
+        bool success;
+        uint32_t texture_id;
+        int32_t next_row;
+    };
+
+    bool upload_slice(Job& job);
+    void complete(Job& job);
+
+    AssetManager& m_manager;
+    ThreadPool& m_pool;
+
+    // Shared with the workers
+    std::mutex m_mutex;
+    std::condition_variable m_decoded_cv;
+    std::vector<std::unique_ptr<Job>> m_decoded;
+    uint32_t m_decoding;
+
+    // GL thread only
+    std::deque<std::unique_ptr<Job>> m_uploading;
+    std::unordered_set<int32_t> m_pending;
+    uint32_t m_pbo[2];
+    uint32_t m_pbo_index;
+};
+
+}
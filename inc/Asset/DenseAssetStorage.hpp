@@ -0,0 +1,214 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <new>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <inttypes.h>
+
+#include <Asset/Handle.hpp>
+#include <Logger/Logger.hpp>
+
+namespace AMB {
+
+/// @brief Tell if a DenseAssetStorage of T grows by moving its assets when full.
+/// By default only the types which can not be copied and are nothrow movable, or which are trivially
+/// copyable: the assets of the engine own OpenGL/SDL objects through implicit copy constructors, a
+/// copy followed by the destruction of the original would free the objects still in use.
+/// Specialize it to std::true_type for a copyable type whose move constructor really moves.
+template<typename T>
+struct DenseGrowable : std::bool_constant<
+    std::is_trivially_copyable_v<T> || (!std::is_copy_constructible_v<T> && std::is_nothrow_move_constructible_v<T>)> {};
+
+/// @brief Slot map storing the assets contiguously, addressed by generational typed handles.
+/// get() is a single indexed load (checked only in DEBUG), validity() compares the generation of the slot.
+/// The capacity is fixed at construction, unless DenseGrowable<T> allows to grow like a vector.
+template<typename T>
+class DenseAssetStorage {
+public:
+    /// @brief Constructor
+    /// @param capacity Maximum number of assets alive at the same time
+    DenseAssetStorage(uint32_t capacity = 1024);
+
+    ~DenseAssetStorage();
+
+    DenseAssetStorage(const DenseAssetStorage&) = delete;
+    DenseAssetStorage& operator=(const DenseAssetStorage&) = delete;
+
+    template<typename ...ARGS>
+    Handle<T> add(ARGS&&... args);
+
+    bool remove(Handle<T> handle);
+
+    void remove_all();
+
+    T& get(Handle<T> handle);
+
+    const T& get(Handle<T> handle) const;
+
+    /// @brief Get the asset if the handle is valid
+    /// @param handle Handle of the asset
+    /// @return A pointer to the asset, nullptr if the handle is stale
+    T* try_get(Handle<T> handle);
+
+    bool validity(Handle<T> handle) const;
+
+    uint32_t size() const { return m_count; }
+
+    uint32_t capacity() const { return m_capacity; }
+
+private:
+    struct Deleter {
+        void operator()(T* data) const { ::operator delete(data, std::align_val_t(alignof(T))); }
+    };
+
+    static T* allocate(uint32_t capacity);
+    void grow();
+
+    std::unique_ptr<T, Deleter> m_data;   // Slots, constructed in place
+    std::vector<uint32_t> m_generation;   // Odd when the slot is alive
+    std::vector<uint32_t> m_free_id;
+    uint32_t m_used;                      // Slots ever used, [m_used, m_capacity) are fresh
+    uint32_t m_count;
+    uint32_t m_capacity;
+};
+
+template<typename T>
+T* DenseAssetStorage<T>::allocate(uint32_t capacity) {
+    return static_cast<T*>(::operator new(sizeof(T) * std::max(capacity, 1u), std::align_val_t(alignof(T))));
+}
+
+template<typename T>
+DenseAssetStorage<T>::DenseAssetStorage(uint32_t capacity)
+: m_data(allocate(capacity)), m_generation(std::max(capacity, 1u), 0), m_used(0), m_count(0), m_capacity(std::max(capacity, 1u))
+{
+    m_free_id.reserve(m_capacity);
+}
+
+template<typename T>
+DenseAssetStorage<T>::~DenseAssetStorage() {
+    remove_all();
+}
+
+template<typename T>
+void DenseAssetStorage<T>::grow() {
+    uint32_t capacity = std::max(m_capacity * 2, 16u);
+    std::unique_ptr<T, Deleter> data(allocate(capacity));
+
+    for (uint32_t i = 0; i < m_used; ++i) {
+        if (m_generation[i] & 1u) {
+            new (data.get() + i) T(std::move(m_data.get()[i]));
+            m_data.get()[i].~T();
+        }
+    }
+
+    m_data = std::move(data);
+    m_generation.resize(capacity, 0);
+    m_capacity = capacity;
+}
+
+template<typename T>
+template<typename ...ARGS>
+Handle<T> DenseAssetStorage<T>::add(ARGS&&... args) {
+    uint32_t index;
+
+    if (!m_free_id.empty()) {
+        index = m_free_id.back();
+        m_free_id.pop_back();
+
+    }else{
+        if (m_used == m_capacity) {
+            if constexpr (DenseGrowable<T>::value) {
+                grow();
+            }else{
+                Logger::instance().log(Error, "DenseAssetStorage is full (capacity " + std::to_string(m_capacity) + ").");
+                return Handle<T>{};
+            }
+        }
+        index = m_used++;
+    }
+
+    new (m_data.get() + index) T(std::forward<ARGS>(args)...);
+    ++m_generation[index]; // Even -> odd: alive
+    ++m_count;
+
+    return Handle<T>{index, m_generation[index]};
+}
+
+template<typename T>
+bool DenseAssetStorage<T>::remove(Handle<T> handle) {
+    // Check if the handle refer to an existing object
+    if (!validity(handle)) {
+        return false;
+    }
+
+    m_data.get()[handle.index].~T();
+    ++m_generation[handle.index]; // Odd -> even: dead, all the handles on this slot become stale
+    --m_count;
+
+    // A slot whose generation would wrap is retired instead of reused
+    if (m_generation[handle.index] != UINT32_MAX - 1) {
+        m_free_id.push_back(handle.index);
+    }
+
+    return true;
+}
+
+template<typename T>
+void DenseAssetStorage<T>::remove_all() {
+    for (uint32_t i = 0; i < m_used; ++i) {
+        if (m_generation[i] & 1u) {
+            m_data.get()[i].~T();
+            ++m_generation[i];
+        }
+    }
+
+    // Generations are kept so that the old handles stay stale
+    m_free_id.clear();
+    for (uint32_t i = m_used; i > 0; --i) {
+        if (m_generation[i - 1] != UINT32_MAX - 1) {
+            m_free_id.push_back(i - 1);
+        }
+    }
+    m_count = 0;
+}
+
+template<typename T>
+T& DenseAssetStorage<T>::get(Handle<T> handle) {
+#ifdef DEBUG
+    if (!validity(handle)) {
+        Logger::instance().log(Fatal, "DenseAssetStorage::get with a stale handle.");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    return m_data.get()[handle.index];
+}
+
+template<typename T>
+const T& DenseAssetStorage<T>::get(Handle<T> handle) const {
+#ifdef DEBUG
+    if (!validity(handle)) {
+        Logger::instance().log(Fatal, "DenseAssetStorage::get with a stale handle.");
+        exit(EXIT_FAILURE);
+    }
+#endif
+    return m_data.get()[handle.index];
+}
+
+template<typename T>
+T* DenseAssetStorage<T>::try_get(Handle<T> handle) {
+    return validity(handle) ? m_data.get() + handle.index : nullptr;
+}
+
+template<typename T>
+bool DenseAssetStorage<T>::validity(Handle<T> handle) const {
+    // Out of range handles compare with a dead generation, no second branch
+    bool in_range = handle.index < m_capacity;
+    uint32_t generation = m_generation[in_range ? handle.index : 0];
+    return in_range & (generation == handle.generation) & ((handle.generation & 1u) != 0);
+}
+
+}
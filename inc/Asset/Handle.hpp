@@ -0,0 +1,19 @@
+#pragma once
+
+#include <inttypes.h>
+
+namespace AMB {
+
+/// @brief Typed handle of a DenseAssetStorage<T>, a Handle<Texture> can not be given to the storage of an other type.
+/// The generation is odd while the slot is alive, so a default handle (generation 0) is never valid
+/// and a handle on a removed then reused slot is detected.
+template<typename T>
+struct Handle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <inttypes.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace AMB {
+
+/// @brief Release a pixel buffer allocated by stb_image
+struct ImageDataDeleter {
+    void operator()(uint8_t* pixels) const;
+};
+
+/// @brief Decoded RGBA8 image, can be produced on any thread
+struct ImageData {
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t bpp = 0; // Channels in the file, the pixels are always RGBA
+    std::unique_ptr<uint8_t, ImageDataDeleter> pixels;
+
+    bool valid() const { return pixels != nullptr; }
+    size_t size() const { return size_t(width) * size_t(height) * 4; }
+};
+
+/// @brief Decode an image file to RGBA8, thread safe (the flip is a thread local setting of stb_image)
+/// @param path Path of the image
+/// @param image Decoded image
+/// @param flip True to store the bottom row first (OpenGL order)
+/// @return True if the image is decoded
+bool decode_image_file(const std::string& path, ImageData& image, bool flip = true);
+
+/// @brief Decode an image in memory to RGBA8, thread safe
+/// @param data Encoded image
+/// @param size Size of the encoded image in bytes
+/// @param image Decoded image
+/// @param flip True to store the bottom row first (OpenGL order)
+/// @return True if the image is decoded
+bool decode_image_memory(const uint8_t* data, size_t size, ImageData& image, bool flip = true);
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <inttypes.h>
+#include <string>
+#include <string_view>
+
+namespace AMB {
+
+// Amber pack (.amb) layout, little endian:
+//
+//  +----------------+
+//  | PackHeader     |
+//  +----------------+
+//  | PackEntry[n]   |  sorted by hash, binary searched at runtime
+//  +----------------+
+//  | names          |  '\0' terminated, used to resolve hash collisions
+//  +----------------+
+//  | payloads       |  each aligned on PackHeader::alignment
+//  +----------------+
+
+constexpr uint32_t PACK_MAGIC = 0x50424D41; // "AMBP"
+constexpr uint32_t PACK_VERSION = 1;
+constexpr uint32_t PACK_DEFAULT_ALIGNMENT = 64;
+
+/// @brief Flags of a pack entry
+enum PackEntryFlags : uint32_t {
+    PACK_ENTRY_NONE = 0,
+    PACK_ENTRY_ZLIB = 1 << 0    // Payload compressed with zlib (stb)
+};
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t alignment;
+    uint64_t index_offset;
+    uint64_t names_offset;
+    uint64_t names_size;
+    uint64_t file_size;
+};
+
+struct PackEntry {
+    uint64_t hash;
+    uint64_t offset;        // Offset of the payload from the start of the file
+    uint64_t size;          // Size of the payload in the file
+    uint64_t original_size; // Size once decompressed
+    uint32_t flags;
+    uint32_t name_offset;   // Offset of the name in the names block
+};
+
+static_assert(sizeof(PackHeader) == 48, "PackHeader layout must not depend on the compiler");
+static_assert(sizeof(PackEntry) == 40, "PackEntry layout must not depend on the compiler");
+
+/// @brief Normalize an asset name: forward slashes, no leading "./"
+/// @param name Name or relative path of the asset
+/// @return The normalized name
+inline std::string pack_normalize_name(std::string_view name) {
+    std::string result(name);
+    for (char& c : result) {
+        if (c == '\\') c = '/';
+    }
+    while (result.rfind("./", 0) == 0) {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+/// @brief Hash of a normalized asset name (FNV-1a 64 bits)
+/// @param name Normalized name
+/// @return The hash
+inline uint64_t pack_hash(std::string_view name) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+}
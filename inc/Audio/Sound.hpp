@@ -24,6 +24,10 @@ public:
 
     void play_fade(int time, int channel = -1, int loop = 0);
 
+    /// @brief Get the size of the decoded samples
+    /// @return Size in bytes
+    size_t get_memory_size() const;
+
 private:
     Mix_Chunk* m_sound;
 
@@ -14,6 +14,10 @@ public:
 
     mat::Mat4f get_vp();
 
+    mat::Mat4f get_inverse_vp();
+
+    mat::Vec2f unproject(const mat::Vec2f& ndc);
+
     mat::Vec2f get_position() const;
 
     void set_position(mat::Vec2f position);
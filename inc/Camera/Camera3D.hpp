@@ -19,6 +19,10 @@ public:
 
     mat::Mat4f get_vp();
 
+    mat::Mat4f get_inverse_vp();
+
+    mat::Vec3f unproject(const mat::Vec3f& ndc);
+
     mat::Vec3f get_position() const;
 
     void set_position(const mat::Vec3f& pos);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <inttypes.h>
+#include <memory>
+#include <vector>
+
+#include "Graphic/BloomReference.hpp"
+#include "Graphic/FrameBuffer.hpp"
+#include "Graphic/RenderTargetPool.hpp"
+#include "Graphic/Shader.hpp"
+#include "Graphic/VertexArray.hpp"
+
+#include "Asset/AssetHandle.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+
+namespace AMB {
+
+/// @brief Dual-filter (Kawase) bloom: the bright parts of the scene are progressively downsampled
+/// in a half resolution mip chain then upsampled back with a tent filter and added on the scene.
+/// Each level costs 5 taps down and 8 taps up on a quarter of the pixels of the previous one,
+/// so the whole chain is cheaper than a single full resolution gaussian pass.
+/// The CPU reference of the filter is AMB::bloom_reference.
+class Bloom {
+public:
+    /// @brief Constructor
+    /// @param pool Pool providing the mip chain, the scene has the size of the pool screen
+    /// @param asset_manager Asset manager owning the shaders
+    /// @param asset_factory Asset factory used to compile the shaders
+    /// @param quad Full screen quad (position and uv attributes)
+    /// @param settings Bloom parameters
+    Bloom(RenderTargetPool& pool, AssetManager& asset_manager, AssetFactory& asset_factory, std::shared_ptr<VertexArray> quad, const BloomSettings& settings = BloomSettings{});
+
+    /// @brief Change the parameters
+    /// @param settings Bloom parameters
+    void set_settings(const BloomSettings& settings);
+
+    /// @brief Get the parameters
+    /// @return A constant reference to the parameters
+    const BloomSettings& get_settings() const;
+
+    /// @brief Apply the bloom, depth test and blending must be disabled
+    /// @param scene_texture OpenGL id of the scene texture
+    /// @return Target of the pool with the scene and the bloom, to release by the caller
+    FrameBuffer* apply(uint32_t scene_texture);
+
+private:
+    void draw_quad();
+
+    RenderTargetPool& m_pool;
+    std::vector<FrameBuffer*> m_chain;
+
+    std::shared_ptr<VertexArray> m_quad;
+
+    Shader* m_downsample_shader;
+    Shader* m_upsample_shader;
+    Shader* m_composite_shader;
+
+    BloomSettings m_settings;
+};
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <inttypes.h>
+#include <cstddef>
+#include <vector>
+
+namespace AMB {
+
+/// @brief Parameters of the dual-filter bloom (shared by the GPU effect and the CPU reference)
+struct BloomSettings {
+    float threshold = 0.8f;     // Brightness where the bloom starts
+    float knee = 0.4f;          // Width of the soft transition around the threshold
+    float intensity = 1.0f;     // Strength of the bloom added back on the scene
+    float radius = 1.0f;        // Spread of the filter taps, in texel of the sampled level
+    uint32_t levels = 5;        // Number of downsample steps of the mip chain
+};
+
+/// @brief Floating point RGBA image used by the CPU reference of the bloom
+struct BloomImage {
+    int32_t width = 0;
+    int32_t height = 0;
+    std::vector<float> pixels; // RGBA, row major, first row is the bottom row (OpenGL order)
+
+    BloomImage() = default;
+    BloomImage(int32_t w, int32_t h) : width(w), height(h), pixels(size_t(w) * size_t(h) * 4, 0.0f) {}
+
+    float* at(int32_t x, int32_t y) { return &pixels[(size_t(y) * width + x) * 4]; }
+    const float* at(int32_t x, int32_t y) const { return &pixels[(size_t(y) * width + x) * 4]; }
+};
+
+/// @brief Size of the level of the bloom mip chain (level 0 is half the scene size)
+/// @param size Size of the scene
+/// @param level Level in the chain
+/// @return Size of the level, never lower than 1
+int32_t bloom_level_size(int32_t size, uint32_t level);
+
+/// @brief Number of usable levels for a scene size (the chain stops when a level reaches 1 pixel)
+/// @param width Width of the scene
+/// @param height Height of the scene
+/// @param levels Requested number of levels
+/// @return Number of levels actually used
+uint32_t bloom_level_count(int32_t width, int32_t height, uint32_t levels);
+
+/// @brief CPU reference of the dual-filter bloom, mirroring exactly the shaders of AMB::Bloom
+/// (bilinear sampling at texel centers with clamp to edge, same taps, same weights)
+/// @param scene Input scene
+/// @param settings Bloom parameters
+/// @return The composited image (scene + bloom), same size as the scene
+BloomImage bloom_reference(const BloomImage& scene, const BloomSettings& settings);
+
+}
@@ -3,15 +3,25 @@
 #include <inttypes.h>
 #include <glad/glad.h>
 
+#include "Graphic/Texture.hpp"
 #include "Logger/Logger.hpp"
 
 namespace AMB{
 
+/// @brief Storage format of the color attachment of a framebuffer
+enum class FrameBufferFormat {
+    RGBA8,
+    RGBA16F
+};
+
 class FrameBuffer {
 public:
-    FrameBuffer(int width, int height);
+    FrameBuffer(int width, int height, FrameBufferFormat format = FrameBufferFormat::RGBA8, TextureFilter filter = TextureFilter::NEAREST, bool depth = true);
     ~FrameBuffer();
 
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
     void reset();
 
     void bind();
@@ -19,6 +29,20 @@ public:
 
     uint32_t get_color_texture() const;
 
+    FrameBufferFormat get_format() const { return m_format; }
+
+    bool has_depth() const { return m_depth; }
+
+    /// @brief Change the filter of the color texture without recreating the framebuffer
+    /// @param filter Nearest or linear
+    void set_filter(TextureFilter filter);
+
+    TextureFilter get_filter() const { return m_filter; }
+
+    /// @brief Get the GPU memory used by the attachments
+    /// @return Size in bytes
+    size_t get_memory_size() const;
+
     int get_width() { return m_width; }
     int get_height() {return m_height; }
 
@@ -27,6 +51,9 @@ private:
     uint32_t m_color_texture;
     uint32_t m_rbo; // depth/stencil
     int m_width, m_height;
+    FrameBufferFormat m_format;
+    TextureFilter m_filter;
+    bool m_depth;
 };
 
-}
\ No newline at end of file
+}
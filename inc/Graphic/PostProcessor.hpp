@@ -3,7 +3,9 @@
 #include <inttypes.h>
 #include <memory>
 
+#include "Graphic/Bloom.hpp"
 #include "Graphic/FrameBuffer.hpp"
+#include "Graphic/RenderTargetPool.hpp"
 #include "Graphic/Shader.hpp"
 #include "Graphic/VertexArray.hpp"
 #include "Graphic/VertexBuffer.hpp"
@@ -34,21 +36,47 @@ struct PostProcessEffects {
 
 class PostProcessor {
 public:
+    /// @brief Constructor with an internal render target pool
     PostProcessor(uint32_t width, uint32_t height, AssetManager& asset_manager, AssetFactory& asset_factory);
 
+    /// @brief Constructor sharing the render targets of a pool (begin_frame is called by the owner of the pool)
+    PostProcessor(RenderTargetPool& pool, AssetManager& asset_manager, AssetFactory& asset_factory);
+
+    /// @brief Change the size of the screen
+    /// @param width Width of the screen
+    /// @param height Height of the screen
+    void resize(uint32_t width, uint32_t height);
+
+    /// @brief Get the pool of render targets
+    /// @return A reference to the pool
+    RenderTargetPool& get_pool();
+
     void begin();
 
     void add_effect(Shader* shader, PostProcessMode mode, bool scene_modifier);
 
     void clear_effect();
 
+    /// @brief Enable the built-in dual-filter bloom, applied after the effects
+    /// @param settings Bloom parameters
+    void enable_bloom(const BloomSettings& settings = BloomSettings{});
+
+    /// @brief Disable the built-in bloom
+    void disable_bloom();
+
+    /// @brief Get the built-in bloom
+    /// @return A pointer to the bloom, nullptr if it is disabled
+    Bloom* get_bloom();
+
     void end();
 
 private:
+    void init();
     void draw_full_screen_quad();
 
-    FrameBuffer m_scene_fbo;
-    FrameBuffer m_pingpong_fbo[2];
+    std::unique_ptr<RenderTargetPool> m_own_pool;
+    RenderTargetPool* m_pool;
+    FrameBuffer* m_scene_fbo;
 
     std::vector<PostProcessEffects> m_effects;
     std::shared_ptr<VertexArray> m_vao;
@@ -56,8 +84,10 @@ private:
     std::shared_ptr<IndexBuffer> m_ibo;
 
     Shader* m_final_shader;
+    std::unique_ptr<Bloom> m_bloom;
 
-    int m_width, m_height;
+    AssetManager& m_asset_manager;
+    AssetFactory& m_asset_factory;
 };
 
 }
\ No newline at end of file
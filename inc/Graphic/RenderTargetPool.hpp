@@ -0,0 +1,94 @@
+#pragma once
+
+#include <inttypes.h>
+#include <memory>
+#include <vector>
+
+#include "Graphic/FrameBuffer.hpp"
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+/// @brief Description of a render target, the key of the pool
+struct RenderTargetDesc {
+    int32_t width;
+    int32_t height;
+    FrameBufferFormat format = FrameBufferFormat::RGBA8;
+    bool depth = false;
+
+    bool operator==(const RenderTargetDesc& other) const {
+        return width == other.width && height == other.height && format == other.format && depth == other.depth;
+    }
+};
+
+/// @brief Pool of framebuffers reused between the passes and the frames.
+/// Targets are acquired for the time of a pass and released after, a released target
+/// can be handed out again for the same description without any OpenGL allocation.
+/// Targets unused for a number of frames are freed by begin_frame.
+class RenderTargetPool {
+public:
+    /// @brief Constructor
+    /// @param screen_width Width of the screen
+    /// @param screen_height Height of the screen
+    /// @param max_idle_frames Number of frames a free target is kept before being deleted
+    RenderTargetPool(int32_t screen_width, int32_t screen_height, uint32_t max_idle_frames = 3);
+
+    /// @brief Start a new frame, delete the targets unused for too long
+    void begin_frame();
+
+    /// @brief Get a target matching the description, create it if none is free
+    /// @param desc Description of the target
+    /// @param filter Filter of the color texture
+    /// @return A pointer to the target, valid until released
+    FrameBuffer* acquire(const RenderTargetDesc& desc, TextureFilter filter = TextureFilter::NEAREST);
+
+    /// @brief Get a target of the screen size divided by 2^downscale
+    /// @param format Format of the color attachment
+    /// @param depth Depth/stencil attachment
+    /// @param downscale Power of two dividing the screen size
+    /// @param filter Filter of the color texture
+    /// @return A pointer to the target, valid until released
+    FrameBuffer* acquire_screen(FrameBufferFormat format, bool depth, uint32_t downscale = 0, TextureFilter filter = TextureFilter::NEAREST);
+
+    /// @brief Give back a target to the pool
+    /// @param target Target acquired from this pool
+    void release(FrameBuffer* target);
+
+    /// @brief Change the screen size, free targets which do not match anymore are deleted
+    /// @param width Width of the screen
+    /// @param height Height of the screen
+    void set_screen_size(int32_t width, int32_t height);
+
+    int32_t get_screen_width() const { return m_screen_width; }
+    int32_t get_screen_height() const { return m_screen_height; }
+
+    /// @brief Delete all the free targets
+    void trim();
+
+    /// @brief Get the GPU memory used by all the targets of the pool
+    /// @return Size in bytes
+    size_t memory_usage() const;
+
+    /// @brief Get the number of targets (free and in use)
+    /// @return Number of targets
+    size_t get_target_count() const;
+
+    /// @brief Log the content of the pool
+    void report() const;
+
+private:
+    struct Entry {
+        std::unique_ptr<FrameBuffer> target;
+        RenderTargetDesc desc;
+        bool in_use;
+        uint64_t last_used;
+    };
+
+    std::vector<Entry> m_entries;
+
+    int32_t m_screen_width, m_screen_height;
+    uint32_t m_max_idle_frames;
+    uint64_t m_frame;
+};
+
+}
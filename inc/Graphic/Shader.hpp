@@ -9,18 +9,37 @@
 
 namespace AMB {
 
+class ShaderCache;
+
 class Shader {
 public:
     /// @brief Constructor
     /// @param index OpenGL index
     Shader(int32_t index);
 
+    /// @brief Constructor of a program whose compile and link are still running in the driver.
+    /// The status is checked at first use, then the binary is stored in the cache
+    /// @param index OpenGL index
+    /// @param vertex_shader OpenGL index of the vertex shader attached to the program
+    /// @param fragment_shader OpenGL index of the fragment shader attached to the program
+    /// @param cache Cache receiving the program binary, can be nullptr
+    /// @param cache_key Key of the program in the cache
+    Shader(int32_t index, uint32_t vertex_shader, uint32_t fragment_shader, ShaderCache* cache, uint64_t cache_key);
+
     /// @brief Destructor
     ~Shader();
 
     /// @brief Use the shader for draw
     void use_shader() const;
 
+    /// @brief Check if the program is linked, waits for the driver if the link is pending
+    /// @return True if the program can be used
+    bool is_valid() const;
+
+    /// @brief Check if the driver finished the compile and link, never blocks with KHR_parallel_shader_compile
+    /// @return True if the first use will not wait
+    bool is_ready() const;
+
     /// @brief Get the map of the uniform
     /// @return A constant reference to the map of uniform
     const std::unordered_map<std::string, int>& get_uniform_map() const;
@@ -55,11 +74,30 @@ public:
     void set_mat4d(const std::string& var_name, const mat::Mat4d& var);
 
 private:
+    /// @brief Check the pending compile and link, then query the uniforms
+    void resolve() const;
+
+    /// @brief Query the location of the uniforms
+    void find_uniforms() const;
+
+    /// @brief Get the location of a uniform variable
+    /// @param var_name Name of the variable
+    /// @return Location, -1 if the variable does not exist (ignored by OpenGL)
+    int get_location(const std::string& var_name) const;
+
     /// @brief Map linking the name of the variables and the location
-    std::unordered_map<std::string, int> m_uniform_map;
+    mutable std::unordered_map<std::string, int> m_uniform_map;
 
     /// @brief OpenGL index of the shader
     uint32_t m_index;
+
+    /// @brief Deferred link state
+    mutable bool m_pending;
+    mutable bool m_valid;
+    mutable uint32_t m_vertex_shader;
+    mutable uint32_t m_fragment_shader;
+    ShaderCache* m_cache;
+    uint64_t m_cache_key;
 };
 
 }
\ No newline at end of file
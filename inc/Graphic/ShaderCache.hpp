@@ -0,0 +1,62 @@
+#pragma once
+
+#include <inttypes.h>
+#include <string>
+#include <glad/glad.h>
+
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+/// @brief On-disk cache of linked shader programs (glGetProgramBinary / glProgramBinary).
+/// Entries are keyed by a hash of the sources and of the driver (vendor, renderer, version),
+/// so a driver update or a source change simply misses and falls back to a full compile.
+/// Must be used with a current OpenGL context and outlive the shaders created with it.
+class ShaderCache {
+public:
+    /// @brief Constructor
+    /// @param directory Directory of the cache files, created if needed
+    ShaderCache(const std::string& directory);
+
+    /// @brief Check if the driver can export program binaries
+    /// @return True if the cache is usable
+    bool is_supported();
+
+    /// @brief Compute the key of a program
+    /// @param vertex_code Source of the vertex shader
+    /// @param fragment_code Source of the fragment shader
+    /// @return Hash of the sources and the driver
+    uint64_t get_key(const std::string& vertex_code, const std::string& fragment_code);
+
+    /// @brief Load a program binary from the cache
+    /// @param key Key of the program
+    /// @param program OpenGL program receiving the binary
+    /// @return True if the program is linked from the cache, False if it must be compiled
+    bool load(uint64_t key, uint32_t program);
+
+    /// @brief Store the binary of a linked program
+    /// @param key Key of the program
+    /// @param program OpenGL program linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    void store(uint64_t key, uint32_t program);
+
+    /// @brief Remove all the files of the cache
+    void clear();
+
+    uint32_t get_hit_count() const { return m_hit_count; }
+    uint32_t get_miss_count() const { return m_miss_count; }
+
+private:
+    void init();
+    std::string get_path(uint64_t key) const;
+
+    std::string m_directory;
+    std::string m_driver;
+
+    bool m_initialized;
+    bool m_supported;
+
+    uint32_t m_hit_count;
+    uint32_t m_miss_count;
+};
+
+}
@@ -42,6 +42,19 @@ public:
 
     void set_wrap(TextureWrap wrap_s, TextureWrap wrap_t);
 
+    /// @brief Replace the OpenGL texture (e.g. a placeholder by the loaded image), keeps the filter and wrap
+    /// @param texture_id New OpenGL texture, owned by this texture from now on
+    /// @param width Width of the new texture
+    /// @param height Height of the new texture
+    /// @param bpp Bytes per pixel of the new texture
+    void replace(uint32_t texture_id, int32_t width, int32_t height, int32_t bpp);
+
+    uint32_t get_id() const { return m_texture_id; }
+
+    /// @brief Get the size of the texture in video memory (level 0)
+    /// @return Size in bytes
+    size_t get_memory_size() const { return (size_t)m_width * m_height * m_bpp; }
+
     static void set_default_filter(TextureFilter filter_min, TextureFilter filter_mag);
 
     static void set_default_wrap(TextureWrap wrap_s, TextureWrap wrap_t);
@@ -82,6 +95,9 @@ private:
     int32_t m_height;
     int32_t m_bpp;
 
+    TextureFilter m_filter_min, m_filter_mag;
+    TextureWrap m_wrap_s, m_wrap_t;
+
     static TextureFilter s_default_filter_min;
     static TextureFilter s_default_filter_mag;
     static TextureWrap s_default_wrap_s;
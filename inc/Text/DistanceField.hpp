@@ -0,0 +1,17 @@
+#pragma once
+
+#include <inttypes.h>
+
+namespace AMB {
+
+/// @brief Compute the signed distance field of a coverage bitmap (exact Euclidean distance transform,
+/// Felzenszwalb and Huttenlocher). Thread safe, the glyphs of a font can be transformed in parallel.
+/// @param coverage Coverage of the glyph, a pixel is inside when >= 128
+/// @param width Width of the glyph
+/// @param height Height of the glyph
+/// @param pitch Bytes between two rows of the coverage
+/// @param spread Distance in pixels mapped to the full range, the field is padded by it on each side
+/// @param field Output of (width + 2 * spread) * (height + 2 * spread) bytes, 128 on the outline, higher inside
+void distance_field(const uint8_t* coverage, int32_t width, int32_t height, int32_t pitch, int32_t spread, uint8_t* field);
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <inttypes.h>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Text/Character.hpp"
+#include "Graphic/Texture.hpp"
+#include "Logger/Logger.hpp"
+
+struct FT_FaceRec_;   // forward declaration FreeType
+typedef struct FT_FaceRec_* FT_Face;
+
+namespace AMB {
+
+/// @brief Glyph of a dynamic font, placed on one page of the atlas
+struct DynamicGlyph {
+    Character character;    // u, v, w, h relative to the page
+    uint32_t codepoint;
+    uint16_t page;
+    uint16_t shelf;
+    uint16_t slot_x, slot_width;
+    uint64_t last_frame;
+    std::list<uint32_t>::iterator lru_it;
+};
+
+/// @brief Font rasterizing its glyphs on demand, for any code point.
+/// The glyphs are shelf packed in square 8 bits pages, created as needed up to a maximum count. When
+/// the pages are full the least recently used glyphs are evicted, except the ones used since the last
+/// flush(), so the video memory is bounded whatever the size of the character set. The rasterized
+/// glyphs are written to a CPU copy of the pages, flush() uploads the modified area once per frame.
+class DynamicFont {
+public:
+    /// @brief Constructor
+    /// @param face FreeType face, owned by the font
+    /// @param data Font file the face reads from, kept as long as the face
+    /// @param font_size Height of the glyphs in pixels
+    /// @param page_size Width and height of the pages in pixels
+    /// @param max_pages Maximum number of pages
+    DynamicFont(FT_Face face, std::vector<uint8_t> data, uint32_t font_size, uint32_t page_size = 512, uint32_t max_pages = 4);
+
+    ~DynamicFont();
+
+    DynamicFont(const DynamicFont&) = delete;
+    DynamicFont& operator=(const DynamicFont&) = delete;
+
+    /// @brief Get a glyph, rasterized on the first use. The reference is valid until the next flush
+    /// @param codepoint Unicode code point
+    /// @return The glyph, an empty glyph if the atlas is full of glyphs used this frame
+    const DynamicGlyph& get_glyph(uint32_t codepoint);
+
+    /// @brief Upload the glyphs rasterized since the last flush and start a new frame, call once per frame before drawing
+    void flush();
+
+    int32_t get_height() const { return m_height; }
+
+    uint32_t get_font_size() const { return m_font_size; }
+
+    uint32_t get_page_count() const { return m_pages.size(); }
+
+    Texture& get_page(uint32_t page) const { return *m_pages[page].texture; }
+
+    size_t get_glyph_count() const { return m_glyphs.size(); }
+
+    uint32_t get_eviction_count() const { return m_evictions; }
+
+    /// @brief Get the number of bytes uploaded by the last flush
+    size_t get_upload_size() const { return m_upload_size; }
+
+    /// @brief Get the size of the pages in video memory
+    size_t get_memory_size() const { return m_pages.size() * size_t(m_page_size) * m_page_size; }
+
+private:
+    struct Slot {
+        uint16_t x, width;
+    };
+
+    struct Shelf {
+        uint16_t y, height;
+        uint16_t next_x;
+        uint16_t used;
+        std::vector<Slot> free_slots;
+    };
+
+    struct Page {
+        std::unique_ptr<Texture> texture;
+        std::vector<uint8_t> pixels;
+        std::vector<Shelf> shelves;
+        uint16_t next_y;
+        int32_t dirty_x0, dirty_y0, dirty_x1, dirty_y1;
+    };
+
+    DynamicGlyph* rasterize(uint32_t codepoint);
+    bool allocate(uint16_t width, uint16_t height, DynamicGlyph& glyph);
+    bool allocate_in_shelf(Shelf& shelf, uint16_t width, uint16_t& x);
+    bool add_page();
+    bool evict_oldest();
+    void touch(DynamicGlyph& glyph);
+
+    FT_Face m_face;
+    std::vector<uint8_t> m_data;
+    uint32_t m_font_size;
+    int32_t m_height;
+    uint32_t m_page_size;
+    uint32_t m_max_pages;
+
+    std::vector<Page> m_pages;
+    std::unordered_map<uint32_t, DynamicGlyph> m_glyphs;
+    DynamicGlyph* m_ascii[128];
+    std::list<uint32_t> m_lru;  // Code points, least recently used first
+    DynamicGlyph m_empty;
+
+    uint64_t m_frame;
+    uint32_t m_evictions;
+    size_t m_upload_size;
+    bool m_full_warned;
+};
+
+}
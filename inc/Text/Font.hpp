@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <array>
 
 #include "Text/Character.hpp"
 #include "Graphic/Texture.hpp"
@@ -11,24 +12,53 @@ namespace AMB {
 
 class Font {
 public:
-    Font(const std::map<char, Character>& char_map, uint32_t height, Texture& texture);
+    /// @brief Constructor
+    /// @param char_map Glyphs of the font
+    /// @param height Line height at the rasterized size
+    /// @param texture Atlas of the glyphs
+    /// @param sdf_base_size Rasterized size of a signed distance field font, 0 for a bitmap font
+    /// @param sdf_spread Distance range of the field in pixels
+    Font(const std::map<char, Character>& char_map, uint32_t height, Texture& texture, uint32_t sdf_base_size = 0, uint32_t sdf_spread = 0);
 
     ~Font();
 
-    Character get_char(char c);
+    /// @brief Get the glyph of a character, direct lookup in the glyph table
+    /// @param c Character, the fallback glyph is returned if the font does not have it
+    /// @return The glyph
+    const Character& get_char(char c) const { return m_glyphs[(uint8_t)c]; }
+
+    /// @brief Check if the font has a glyph for a character
+    bool has_char(char c) const;
 
     int32_t get_height() const;
 
     Texture& get_texture() const;
 
+    /// @brief Get the size of the glyph table, the atlas is counted by its texture
+    /// @return Size in bytes
+    size_t get_memory_size() const;
+
     static uint32_t get_char_px_space();
 
+    /// @brief Check if the atlas holds signed distance fields, drawn with the SDF text shader
+    bool is_sdf() const { return m_sdf_base_size > 0; }
+
+    /// @brief Get the rasterized size of a distance field font, text sizes are relative to it
+    uint32_t get_sdf_base_size() const { return m_sdf_base_size; }
+
+    uint32_t get_sdf_spread() const { return m_sdf_spread; }
+
 private:
-    std::map<char, Character> m_char_map;
+    // Indexed by the byte value, the characters missing from the font hold the fallback glyph
+    std::array<Character, 256> m_glyphs;
+    std::array<bool, 256> m_present;
     uint32_t m_height;
     Texture& m_texture;
+    uint32_t m_sdf_base_size;
+    uint32_t m_sdf_spread;
 
     constexpr static uint32_t CHAR_PX_SPACE = 2;
+    constexpr static char FALLBACK_CHAR = '?';
 };
 
 }
\ No newline at end of file
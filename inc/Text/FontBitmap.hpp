@@ -0,0 +1,72 @@
+#pragma once
+
+#include <inttypes.h>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "Text/Character.hpp"
+#include "Thread/ThreadPool.hpp"
+
+struct FT_FaceRec_;   // forward declaration FreeType
+typedef struct FT_FaceRec_* FT_Face;
+
+namespace AMB {
+
+/// @brief Glyphs of a font rasterized on one row of an 8 bits atlas, can be produced on any thread
+struct FontBitmap {
+    std::map<char, Character> char_map;
+    uint32_t font_size = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t line_height = 0;
+    std::vector<uint8_t> pixels; // width * height, top row first
+
+    // Signed distance field: the pixels are distances, 128 on the outline, +-spread pixels over the range
+    bool sdf = false;
+    uint32_t sdf_spread = 0;
+
+    bool valid() const { return !char_map.empty(); }
+};
+
+/// @brief Rasterize the ASCII glyphs of a face, the face must not be used by another thread
+/// @param face FreeType face
+/// @param font_size Height of the glyphs in pixels
+/// @param bitmap Rasterized glyphs
+/// @return True if the atlas is not empty
+bool rasterize_font(FT_Face face, uint32_t font_size, FontBitmap& bitmap);
+
+/// @brief Rasterize the ASCII glyphs of a font file in memory, thread safe (uses its own FreeType library)
+/// @param data Font file
+/// @param size Size of the font file in bytes
+/// @param font_size Height of the glyphs in pixels
+/// @param bitmap Rasterized glyphs
+/// @return True if the font is read and the atlas is not empty
+bool rasterize_font_memory(const uint8_t* data, size_t size, uint32_t font_size, FontBitmap& bitmap);
+
+/// @brief Font file in memory to rasterize at a size
+struct FontSource {
+    const uint8_t* data;
+    size_t size;
+    uint32_t font_size;
+};
+
+/// @brief Rasterize the ASCII glyphs of several fonts on a thread pool. The characters of each font
+/// are split in ranges rendered by the workers, each with its own FreeType library and face, then
+/// packed on the calling thread. The atlases are the ones of rasterize_font.
+/// @param sources Font files, read until the function returns
+/// @param pool Thread pool rendering the glyphs
+/// @param bitmaps Rasterized glyphs, in the order of the sources, empty for a font which can not be read
+/// @return True if all the fonts are rasterized
+bool rasterize_fonts(const std::vector<FontSource>& sources, ThreadPool& pool, std::vector<FontBitmap>& bitmaps);
+
+/// @brief Rasterize the ASCII glyphs of a face as signed distance fields, drawable at any size with the SDF text shader
+/// @param face FreeType face, only used by the calling thread
+/// @param base_size Height of the rasterized glyphs in pixels, the size drawn without scale
+/// @param spread Distance range in pixels of the field around the outlines
+/// @param pool Thread pool computing the distance transforms of the glyphs in parallel, nullptr to compute them here
+/// @param bitmap Glyph fields packed in rows
+/// @return True if the atlas is not empty
+bool rasterize_font_sdf(FT_Face face, uint32_t base_size, uint32_t spread, ThreadPool* pool, FontBitmap& bitmap);
+
+}
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "Text/Font.hpp"
+#include "Text/DynamicFont.hpp"
+#include "Text/TextLayout.hpp"
+#include "Text/Utf8.hpp"
 #include "mat/Math.hpp"
 #include "Graphic/Shader.hpp"
 #include "Graphic/VertexArray.hpp"
@@ -18,35 +22,74 @@ struct VertexText {
     float u, v;        // Texture coordinates
 };
 
+/// @brief Build and draw the mesh of texts, the texts are UTF-8.
+/// With a dynamic font the glyphs are grouped per atlas page and drawn with one call per page; the
+/// font must be flushed once per frame, after all the submissions and before the draws.
 class TextRenderer {
 public:
     TextRenderer(Font& font, Shader& shader, uint32_t reserve = 1024);
 
+    TextRenderer(DynamicFont& font, Shader& shader, uint32_t reserve = 1024);
+
     ~TextRenderer();
 
+    /// @brief Get the font of a renderer created with a static font
     Font& get_font();
 
-    void submit_text(const std::string& text, mat::Vec3f position, float r, float g, float b, float a = 1.0f);
+    /// @brief Get the font of a renderer created with a dynamic font, nullptr otherwise
+    DynamicFont* get_dynamic_font();
+
+    int32_t get_line_height() const;
+
+    /// @brief Add a text to the mesh, no allocation unless the reserved glyph count is exceeded
+    /// @param text UTF-8 text, '\n' starts a new line. A static font draws its fallback glyph for the non ASCII characters
+    /// @param position Position of the baseline of the first line
+    /// @param scale Size relative to the rasterized size, for a distance field font: pixel size / base size
+    void submit_text(std::string_view text, mat::Vec3f position, float r, float g, float b, float a = 1.0f, float scale = 1.0f);
 
+    /// @brief Add a laid out text to the mesh, its quads are copied with a translation
+    /// @param layout Layout made with the static font of the renderer
+    /// @param position Position of the baseline of the first line
+    void submit_layout(const TextLayout& layout, mat::Vec3f position, float r, float g, float b, float a = 1.0f);
+
+    /// @brief Upload the submitted glyphs, the indices are uploaded only when the capacity grew
     void build_mesh();
 
+    uint32_t get_char_count() const { return m_char_count; }
+
     void reset();
 
     void draw(const mat::Mat4f& mvp);
 
 private:
-    Font& m_font;
+    // Glyphs of one atlas page
+    struct Batch {
+        std::vector<VertexText> vertex;
+        uint32_t char_count;
+        uint32_t first_char;
+    };
+
+    Font* m_font;
+    DynamicFont* m_dynamic_font;
     Shader& m_shader;
 
     uint32_t m_char_count;
+    bool m_index_dirty;
 
-    std::vector<VertexText> m_vertex;
+    std::vector<Batch> m_batches;
+    std::vector<VertexText> m_staging;
     std::vector<uint32_t> m_index;
 
     std::shared_ptr<VertexArray> m_vao;
     std::shared_ptr<VertexBuffer> m_vbo;
     std::shared_ptr<IndexBuffer> m_ibo;
     VertexAttribLayout m_text_layout;
+
+    void init(uint32_t reserve);
+    void grow(Batch& batch, uint32_t char_count);
+    void grow_index(uint32_t char_count);
+    void submit_static(std::string_view text, mat::Vec3f position, float r, float g, float b, float a, float scale);
+    void submit_dynamic(std::string_view text, mat::Vec3f position, float r, float g, float b, float a, float scale);
 };
 
 }
\ No newline at end of file
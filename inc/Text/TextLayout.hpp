@@ -0,0 +1,105 @@
+#pragma once
+
+#include <inttypes.h>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Text/Font.hpp"
+#include "Text/Utf8.hpp"
+
+namespace AMB {
+
+/// @brief Positioned glyph of a layout, relative to the baseline of the first line
+struct GlyphQuad {
+    float x0, y0, x1, y1;   // Bottom left and top right corners
+    float u0, v0, u1, v1;   // Texture coordinates of these corners
+};
+
+/// @brief Glyph quads of a string laid out with a static font.
+/// Submitting a layout copies its quads with a translation, no glyph is looked up. When the text
+/// changes, only the characters between the common prefix and the common suffix are laid out
+/// again, the suffix is moved by the change of the pen position (score counters, timers).
+class TextLayout {
+public:
+    TextLayout();
+
+    /// @brief Set the text, laid out again from the first changed character
+    /// @param font Font of the layout, a different font or scale lays out the whole text
+    /// @param text UTF-8 text, '\n' starts a new line
+    /// @param scale Size relative to the rasterized size of the font
+    void set_text(const Font& font, std::string_view text, float scale = 1.0f);
+
+    const std::vector<GlyphQuad>& get_quads() const { return m_quads; }
+
+    const std::string& get_text() const { return m_text; }
+
+    const Font* get_font() const { return m_font; }
+
+    float get_scale() const { return m_scale; }
+
+    /// @brief Get the width of the longest line
+    float get_width() const { return m_width; }
+
+    uint32_t get_line_count() const { return m_line_count; }
+
+    /// @brief Get the number of quads written by the last set_text, to measure the incremental updates
+    uint32_t get_written_count() const { return m_written; }
+
+private:
+    uint32_t count_quads(size_t begin, size_t end) const;
+    void layout_range(size_t begin, size_t end, float& pen_x, float& pen_y, uint32_t quad);
+    void measure();
+
+    const Font* m_font;
+    float m_scale;
+    std::string m_text;
+    std::vector<GlyphQuad> m_quads;
+
+    // Before each byte of the text, and after the last one
+    std::vector<float> m_pen_x, m_pen_y;
+    std::vector<uint32_t> m_first_quad;
+
+    float m_width;
+    uint32_t m_line_count;
+    uint32_t m_written;
+};
+
+/// @brief Layouts of the strings drawn every frame, keyed by font, text and scale. The color is
+/// given at submission so it does not split the entries.
+class TextLayoutCache {
+public:
+    /// @brief Constructor
+    /// @param capacity Number of static strings kept, the least recently used are dropped
+    TextLayoutCache(uint32_t capacity = 256);
+
+    /// @brief Get the layout of a string which rarely changes, laid out on the first request
+    const TextLayout& get(const Font& font, std::string_view text, float scale = 1.0f);
+
+    /// @brief Get the layout of a changing string identified by a key, patched from its previous text
+    /// @param id Key of the string (e.g. the hash of "score"), kept until clear()
+    const TextLayout& update(uint64_t id, const Font& font, std::string_view text, float scale = 1.0f);
+
+    void clear();
+
+    size_t get_size() const { return m_entries.size() + m_dynamic.size(); }
+    uint32_t get_hit_count() const { return m_hits; }
+    uint32_t get_miss_count() const { return m_misses; }
+
+private:
+    struct Entry {
+        TextLayout layout;
+        std::list<uint64_t>::iterator lru_it;
+    };
+
+    uint32_t m_capacity;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::list<uint64_t> m_lru;  // Keys, least recently used first
+    std::unordered_map<uint64_t, TextLayout> m_dynamic;
+
+    uint32_t m_hits, m_misses;
+};
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <inttypes.h>
+
+namespace AMB {
+
+constexpr uint32_t UTF8_REPLACEMENT = 0xFFFD;
+
+/// @brief Decode the next code point of an UTF-8 string
+/// @param it Current position, moved after the decoded sequence (at least one byte)
+/// @param end End of the string
+/// @return The code point, U+FFFD for a malformed or truncated sequence
+inline uint32_t utf8_next(const char*& it, const char* end) {
+    uint8_t lead = (uint8_t)*it++;
+    if (lead < 0x80) {
+        return lead;
+    }
+
+    uint32_t count, codepoint, min;
+    if ((lead & 0xE0) == 0xC0) {
+        count = 1; codepoint = lead & 0x1F; min = 0x80;
+    }else if ((lead & 0xF0) == 0xE0) {
+        count = 2; codepoint = lead & 0x0F; min = 0x800;
+    }else if ((lead & 0xF8) == 0xF0) {
+        count = 3; codepoint = lead & 0x07; min = 0x10000;
+    }else{
+        return UTF8_REPLACEMENT;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (it == end || ((uint8_t)*it & 0xC0) != 0x80) {
+            return UTF8_REPLACEMENT; // the byte is not consumed, it may start the next sequence
+        }
+        codepoint = (codepoint << 6) | ((uint8_t)*it++ & 0x3F);
+    }
+
+    // Overlong encodings, surrogates and values past the Unicode range
+    if (codepoint < min || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF) {
+        return UTF8_REPLACEMENT;
+    }
+    return codepoint;
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <inttypes.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <deque>
+#include <vector>
+
+namespace AMB {
+
+class ThreadPool {
+public:
+    /// @brief Constructor
+    /// @param thread_count Number of workers, 0 to use all the hardware threads
+    ThreadPool(uint32_t thread_count = 0);
+
+    /// @brief Destructor, finish the queued tasks then join the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Queue a task
+    /// @param task Function to run on a worker
+    /// @return A future on the result of the task
+    template<typename F>
+    auto submit(F&& task) -> std::future<decltype(task())>;
+
+    /// @brief Wait until all the queued tasks are done
+    void wait_idle();
+
+    /// @brief Get the number of workers
+    /// @return Number of workers
+    uint32_t get_thread_count() const;
+
+private:
+    void push(std::function<void()> task);
+    void worker_loop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_task_available;
+    std::condition_variable m_idle;
+
+    uint32_t m_active;
+    bool m_stop;
+};
+
+template<typename F>
+auto ThreadPool::submit(F&& task) -> std::future<decltype(task())> {
+    using R = decltype(task());
+
+    // std::function needs a copyable callable, the packaged task is shared
+    auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+    std::future<R> future = packaged->get_future();
+    push([packaged]() { (*packaged)(); });
+    return future;
+}
+
+}
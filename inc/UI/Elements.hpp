@@ -5,6 +5,7 @@
 #include "Graphic/Texture.hpp"
 #include "Logger/Logger.hpp"
 #include "UI/Renderer.hpp"
+#include "Text/TextLayout.hpp"
 #include "Event/Event.hpp"
 
 #include <memory>
@@ -147,12 +148,18 @@ public:
 
     mat::Vec2f compute_dimension(Font& font);
 
+    /// @brief Set the text, only the changed characters are laid out again at the next submission
+    void set_text(const std::string& text);
+
+    const std::string& get_text() const { return m_text; }
+
     virtual void update(const EventManager& event_manager) override;
 
     virtual void submit(UI_Renderer& ui_renderer) override;
 
 private:
     std::string m_text;
+    TextLayout m_layout;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <inttypes.h>
+
+#include "Constexpr.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "QuaternionFunction.hpp"
+#include "Transform.hpp"
+
+namespace mat {
+
+/*
+Inverses of the 4x4 transforms of known structure, chosen by the caller
+
+The general inverse is an elimination on the 16 elements. The transforms built by Transform.hpp have
+a known structure, their inverses are direct:
+- Rigid: rotation and translation (views of the cameras), the rotation is transposed
+- Affine: any 3x3 part and a translation (models with scale), the 3x3 part is inverted by cofactors
+- Orthographic: scale and translation on each axis (orthographic3, scale3, translate3)
+- Perspective: the matrices of perspective, with m(3,2) != 0
+
+The structure is not checked: the result is wrong for a matrix of another kind. The tags select the
+inverse at compile time, e.g. inverse(view, Rigid{}).
+
+The general inverse of Mat4f has a SIMD overload in Simd.hpp, so has inverse_affine: the scalar
+cofactors below are not faster than it in float.
+*/
+
+/// @brief Tag of the rotations and translations
+struct Rigid {};
+
+/// @brief Tag of the affine transforms (last row 0 0 0 1)
+struct Affine {};
+
+/// @brief Tag of the scales and translations on each axis
+struct Orthographic {};
+
+/// @brief Tag of the perspective projections
+struct Perspective {};
+
+/// @brief Inverse of a rotation and a translation
+/// @param m The matrix, its 3x3 part must be orthonormal
+/// @return The inverse of the matrix
+template<typename T>
+constexpr Matrix<T,4,4> inverse_rigid(const Matrix<T,4,4>& m) {
+    Matrix<T,4,4> result;
+    for (uint32_t i(0) ; i < 3 ; ++i) {
+        for (uint32_t j(0) ; j < 3 ; ++j) {
+            result(i,j) = m(j,i);
+        }
+    }
+    for (uint32_t i(0) ; i < 3 ; ++i) {
+        result(i,3) = -(result(i,0) * m(0,3) + result(i,1) * m(1,3) + result(i,2) * m(2,3));
+    }
+    result(3,3) = T(1);
+    return result;
+}
+
+/// @brief Determinant of an affine transform, the one of its 3x3 part
+/// @param m The matrix, its last row must be 0 0 0 1
+/// @return The determinant
+template<typename T>
+constexpr T determinant_affine(const Matrix<T,4,4>& m) {
+    return m(0,0) * (m(1,1) * m(2,2) - m(1,2) * m(2,1))
+         + m(0,1) * (m(1,2) * m(2,0) - m(1,0) * m(2,2))
+         + m(0,2) * (m(1,0) * m(2,1) - m(1,1) * m(2,0));
+}
+
+/// @brief Inverse of an affine transform
+/// @param m The matrix, its last row must be 0 0 0 1
+/// @return The inverse of the matrix
+/// @warning Does not check if the determinant is non null
+template<typename T>
+constexpr Matrix<T,4,4> inverse_affine(const Matrix<T,4,4>& m) {
+    // Adjugate of the 3x3 part
+    Matrix<T,4,4> result;
+    result(0,0) = m(1,1) * m(2,2) - m(1,2) * m(2,1);
+    result(0,1) = m(0,2) * m(2,1) - m(0,1) * m(2,2);
+    result(0,2) = m(0,1) * m(1,2) - m(0,2) * m(1,1);
+    result(1,0) = m(1,2) * m(2,0) - m(1,0) * m(2,2);
+    result(1,1) = m(0,0) * m(2,2) - m(0,2) * m(2,0);
+    result(1,2) = m(0,2) * m(1,0) - m(0,0) * m(1,2);
+    result(2,0) = m(1,0) * m(2,1) - m(1,1) * m(2,0);
+    result(2,1) = m(0,1) * m(2,0) - m(0,0) * m(2,1);
+    result(2,2) = m(0,0) * m(1,1) - m(0,1) * m(1,0);
+
+    T inv_det = T(1) / (m(0,0) * result(0,0) + m(0,1) * result(1,0) + m(0,2) * result(2,0));
+    for (uint32_t i(0) ; i < 3 ; ++i) {
+        for (uint32_t j(0) ; j < 3 ; ++j) {
+            result(i,j) *= inv_det;
+        }
+    }
+    for (uint32_t i(0) ; i < 3 ; ++i) {
+        result(i,3) = -(result(i,0) * m(0,3) + result(i,1) * m(1,3) + result(i,2) * m(2,3));
+    }
+    result(3,3) = T(1);
+    return result;
+}
+
+/// @brief Inverse of a scale and a translation on each axis, e.g. an orthographic projection
+/// @param m The matrix, only the diagonal and the last column are read
+/// @return The inverse of the matrix
+template<typename T>
+constexpr Matrix<T,4,4> inverse_orthographic(const Matrix<T,4,4>& m) {
+    Matrix<T,4,4> result;
+    for (uint32_t i(0) ; i < 3 ; ++i) {
+        result(i,i) = T(1) / m(i,i);
+        result(i,3) = -m(i,3) * result(i,i);
+    }
+    result(3,3) = T(1);
+    return result;
+}
+
+/// @brief Inverse of a perspective projection
+/// @param m The matrix, of non null elements (0,0) (0,2) (1,1) (1,2) (2,2) (2,3) (3,2)
+/// @return The inverse of the matrix
+template<typename T>
+constexpr Matrix<T,4,4> inverse_perspective(const Matrix<T,4,4>& m) {
+    // z and w only depend on the last two rows: w_clip = m(3,2) z, z_clip = m(2,2) z + m(2,3) w
+    T inv_a = T(1) / m(0,0);
+    T inv_b = T(1) / m(1,1);
+    T inv_f = T(1) / m(2,3);
+    T inv_g = T(1) / m(3,2);
+
+    Matrix<T,4,4> result;
+    result(0,0) = inv_a;
+    result(0,3) = -m(0,2) * inv_a * inv_g;
+    result(1,1) = inv_b;
+    result(1,3) = -m(1,2) * inv_b * inv_g;
+    result(2,3) = inv_g;
+    result(3,2) = inv_f;
+    result(3,3) = -m(2,2) * inv_f * inv_g;
+    return result;
+}
+
+/// @brief Inverse of a rotation and a translation
+template<typename T>
+constexpr Matrix<T,4,4> inverse(const Matrix<T,4,4>& m, Rigid) { return inverse_rigid(m); }
+
+/// @brief Inverse of an affine transform
+template<typename T>
+constexpr Matrix<T,4,4> inverse(const Matrix<T,4,4>& m, Affine) { return inverse_affine(m); }
+
+/// @brief Inverse of a scale and a translation on each axis
+template<typename T>
+constexpr Matrix<T,4,4> inverse(const Matrix<T,4,4>& m, Orthographic) { return inverse_orthographic(m); }
+
+/// @brief Inverse of a perspective projection
+template<typename T>
+constexpr Matrix<T,4,4> inverse(const Matrix<T,4,4>& m, Perspective) { return inverse_perspective(m); }
+
+/// @brief Translation, rotation and scale of an affine transform
+template<typename T>
+struct TRS {
+    Vector<T,3> translation;
+    Quaternion<T> rotation;
+    Vector<T,3> scale;
+};
+
+/// @brief Decompose an affine transform made of a translation, a rotation and a scale (T R S)
+/// @param m The matrix, without shear
+/// @return The translation, the rotation and the scale, a reflection gives a negative x scale
+template<typename T>
+constexpr TRS<T> decompose_trs(const Matrix<T,4,4>& m) {
+    TRS<T> result;
+    Matrix<T,3,3> rotation;
+    for (uint32_t j(0) ; j < 3 ; ++j) {
+        T scale = cx::sqrt(m(0,j) * m(0,j) + m(1,j) * m(1,j) + m(2,j) * m(2,j));
+        if (j == 0 && determinant_affine(m) < T(0)) {
+            scale = -scale;
+        }
+        for (uint32_t i(0) ; i < 3 ; ++i) {
+            rotation(i,j) = m(i,j) / scale;
+        }
+        result.scale[j] = scale;
+        result.translation[j] = m(j,3);
+    }
+    result.rotation = quat_from_rotation3(rotation);
+    return result;
+}
+
+/// @brief Compose a translation, a rotation and a scale (T R S), without the matrix products
+/// @param trs The translation, the rotation of norm 1 and the scale
+/// @return The transform
+template<typename T>
+constexpr Matrix<T,4,4> compose_trs(const TRS<T>& trs) {
+    Matrix<T,4,4> result = graph::rotate3(trs.rotation);
+    for (uint32_t j(0) ; j < 3 ; ++j) {
+        for (uint32_t i(0) ; i < 3 ; ++i) {
+            result(i,j) *= trs.scale[j];
+        }
+        result(j,3) = trs.translation[j];
+    }
+    return result;
+}
+
+}
@@ -36,7 +36,7 @@ std::ostream& operator<<(std::ostream& stream, const BaseVector<T,N>& v) {
 /// @param v The current vector
 /// @return The vector of the new type
 template<typename T1, typename T2, uint32_t N>
-BaseVector<T2,N> cast(const BaseVector<T1,N>& v) {
+constexpr BaseVector<T2,N> cast(const BaseVector<T1,N>& v) {
     BaseVector<T2,N> result;
     T2* it = result.begin();
     for (auto i : v) {
@@ -52,7 +52,7 @@ BaseVector<T2,N> cast(const BaseVector<T1,N>& v) {
 /// @param v The vector
 /// @return The smallest component
 template<typename T, uint32_t N>
-T min(const BaseVector<T,N>& v) {
+constexpr T min(const BaseVector<T,N>& v) {
     T m = v[0];
     for (auto i : v) {
         if (i < m){
@@ -69,7 +69,7 @@ T min(const BaseVector<T,N>& v) {
 /// @param a The scalar
 /// @return A vector with minimum between the component and the scalar
 template<typename T, uint32_t N>
-BaseVector<T,N> min(BaseVector<T,N> v, T a) {
+constexpr BaseVector<T,N> min(BaseVector<T,N> v, T a) {
     for (auto& i : v) {
         if (a < i) {
             i = a;
@@ -85,7 +85,7 @@ BaseVector<T,N> min(BaseVector<T,N> v, T a) {
 /// @param v2 Second vector
 /// @return A vector containing the smallest values between the components of the two vectors
 template<typename T, uint32_t N>
-BaseVector<T,N> min(BaseVector<T,N> v1, const BaseVector<T,N>& v2) {
+constexpr BaseVector<T,N> min(BaseVector<T,N> v1, const BaseVector<T,N>& v2) {
     for (uint32_t i(0) ; i < N ; ++i) {
         if (v2[i] < v1[i]) {
             v1[i] = v2[i];
@@ -100,7 +100,7 @@ BaseVector<T,N> min(BaseVector<T,N> v1, const BaseVector<T,N>& v2) {
 /// @param v The vector
 /// @return The biggest component
 template<typename T, uint32_t N>
-T max(const BaseVector<T,N>& v) {
+constexpr T max(const BaseVector<T,N>& v) {
     T m = v[0];
     for (auto i : v) {
         if (i > m){
@@ -117,7 +117,7 @@ T max(const BaseVector<T,N>& v) {
 /// @param a The scalar
 /// @return A vector with maximum between the component and the scalar
 template<typename T, uint32_t N>
-BaseVector<T,N> max(BaseVector<T,N> v, T a) {
+constexpr BaseVector<T,N> max(BaseVector<T,N> v, T a) {
     for (auto& i : v) {
         if (a > i) {
             i = a;
@@ -133,7 +133,7 @@ BaseVector<T,N> max(BaseVector<T,N> v, T a) {
 /// @param v2 Second vector
 /// @return A vector containing the biggest values between the components of the two vectors
 template<typename T, uint32_t N>
-BaseVector<T,N> max(BaseVector<T,N> v1, const BaseVector<T,N>& v2) {
+constexpr BaseVector<T,N> max(BaseVector<T,N> v1, const BaseVector<T,N>& v2) {
     for (uint32_t i(0) ; i < N ; ++i) {
         if (v2[i] > v1[i]) {
             v1[i] = v2[i];
@@ -148,7 +148,7 @@ BaseVector<T,N> max(BaseVector<T,N> v1, const BaseVector<T,N>& v2) {
 /// @param v The vector
 /// @return The vector with absolute component
 template<typename T, uint32_t N>
-BaseVector<T,N> abs(const BaseVector<T,N>& v) {
+constexpr BaseVector<T,N> abs(const BaseVector<T,N>& v) {
     BaseVector<T,N> result;
     T* it = result.begin();
     T zero(0);
@@ -165,7 +165,7 @@ BaseVector<T,N> abs(const BaseVector<T,N>& v) {
 /// @param v The vector
 /// @return A vector of the sign of the components
 template<typename T, uint32_t N>
-BaseVector<T,N> sign(BaseVector<T,N> v) {
+constexpr BaseVector<T,N> sign(BaseVector<T,N> v) {
     T zero(0);
     T mone(-1);
     T one(1);
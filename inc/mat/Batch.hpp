@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstddef>
+#include <inttypes.h>
+
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Quaternion.hpp"
+#include "Simd.hpp"
+
+namespace mat {
+
+/*
+Batch kernels: transform arrays of points with one matrix or quaternion
+
+Two layouts are accepted :
+- SoA, one array per component : x[count], y[count], z[count]
+- AoS, an array of vectors : Vector<float,3>[count]
+
+The SoA kernels process four elements per iteration with SIMD, the remaining elements one by one with
+the same operations, so every element gets the same result whatever its position. The AoS kernels
+process one element per iteration, the matrix columns in registers. The outputs may be the inputs.
+*/
+
+namespace batch {
+
+namespace detail {
+
+// Per element operations, in the order of the SIMD lanes and of the generic dot
+inline void point(const Matrix<float,4,4>& m, float x, float y, float z, float& ox, float& oy, float& oz) {
+    ox = m(0,0)*x + m(0,1)*y + m(0,2)*z + m(0,3);
+    oy = m(1,0)*x + m(1,1)*y + m(1,2)*z + m(1,3);
+    oz = m(2,0)*x + m(2,1)*y + m(2,2)*z + m(2,3);
+}
+
+inline void direction(const Matrix<float,4,4>& m, float x, float y, float z, float& ox, float& oy, float& oz) {
+    ox = m(0,0)*x + m(0,1)*y + m(0,2)*z;
+    oy = m(1,0)*x + m(1,1)*y + m(1,2)*z;
+    oz = m(2,0)*x + m(2,1)*y + m(2,2)*z;
+}
+
+inline void rotation(const Quaternion<float>& q, float x, float y, float z, float& ox, float& oy, float& oz) {
+    // v + w t + u x t with t = 2 u x v
+    float tx = q.j()*z - q.k()*y;
+    float ty = q.k()*x - q.i()*z;
+    float tz = q.i()*y - q.j()*x;
+    tx += tx; ty += ty; tz += tz;
+    ox = x + q.r()*tx + (q.j()*tz - q.k()*ty);
+    oy = y + q.r()*ty + (q.k()*tx - q.i()*tz);
+    oz = z + q.r()*tz + (q.i()*ty - q.j()*tx);
+}
+
+}
+
+// SoA, one array per component
+
+/// @brief Transform points (w = 1) by an affine matrix, the last row of the matrix is ignored
+/// @param m The matrix
+/// @param x, y, z Components of the points
+/// @param out_x, out_y, out_z Components of the transformed points, may be the inputs
+/// @param count Number of points
+inline void transform_points(const Matrix<float,4,4>& m, const float* x, const float* y, const float* z,
+                             float* out_x, float* out_y, float* out_z, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 m00 = simd::splat(m(0,0)), m01 = simd::splat(m(0,1)), m02 = simd::splat(m(0,2)), m03 = simd::splat(m(0,3));
+    simd::f4 m10 = simd::splat(m(1,0)), m11 = simd::splat(m(1,1)), m12 = simd::splat(m(1,2)), m13 = simd::splat(m(1,3));
+    simd::f4 m20 = simd::splat(m(2,0)), m21 = simd::splat(m(2,1)), m22 = simd::splat(m(2,2)), m23 = simd::splat(m(2,3));
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 vx = simd::load(x + i), vy = simd::load(y + i), vz = simd::load(z + i);
+        simd::store(out_x + i, simd::add(simd::add(simd::add(simd::mul(m00, vx), simd::mul(m01, vy)), simd::mul(m02, vz)), m03));
+        simd::store(out_y + i, simd::add(simd::add(simd::add(simd::mul(m10, vx), simd::mul(m11, vy)), simd::mul(m12, vz)), m13));
+        simd::store(out_z + i, simd::add(simd::add(simd::add(simd::mul(m20, vx), simd::mul(m21, vy)), simd::mul(m22, vz)), m23));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        detail::point(m, x[i], y[i], z[i], out_x[i], out_y[i], out_z[i]);
+    }
+}
+
+/// @brief Transform points (w = 1) by a projection, the clip coordinates are used by the culling
+/// @param m The matrix, e.g. a view projection
+/// @param x, y, z Components of the points
+/// @param out_x, out_y, out_z, out_w Clip coordinates of the points
+/// @param count Number of points
+inline void transform_points_clip(const Matrix<float,4,4>& m, const float* x, const float* y, const float* z,
+                                  float* out_x, float* out_y, float* out_z, float* out_w, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 c[4][4];
+    for (uint32_t r(0) ; r < 4 ; ++r) {
+        for (uint32_t k(0) ; k < 4 ; ++k) {
+            c[r][k] = simd::splat(m(r,k));
+        }
+    }
+    float* out[4] = {out_x, out_y, out_z, out_w};
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 vx = simd::load(x + i), vy = simd::load(y + i), vz = simd::load(z + i);
+        for (uint32_t r(0) ; r < 4 ; ++r) {
+            simd::store(out[r] + i, simd::add(simd::add(simd::add(simd::mul(c[r][0], vx), simd::mul(c[r][1], vy)), simd::mul(c[r][2], vz)), c[r][3]));
+        }
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        float px(x[i]), py(y[i]), pz(z[i]);
+        detail::point(m, px, py, pz, out_x[i], out_y[i], out_z[i]);
+        out_w[i] = m(3,0)*px + m(3,1)*py + m(3,2)*pz + m(3,3);
+    }
+}
+
+/// @brief Transform directions (w = 0), the translation is ignored
+/// @param m The matrix
+/// @param x, y, z Components of the directions
+/// @param out_x, out_y, out_z Components of the transformed directions, may be the inputs
+/// @param count Number of directions
+inline void transform_directions(const Matrix<float,4,4>& m, const float* x, const float* y, const float* z,
+                                 float* out_x, float* out_y, float* out_z, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 m00 = simd::splat(m(0,0)), m01 = simd::splat(m(0,1)), m02 = simd::splat(m(0,2));
+    simd::f4 m10 = simd::splat(m(1,0)), m11 = simd::splat(m(1,1)), m12 = simd::splat(m(1,2));
+    simd::f4 m20 = simd::splat(m(2,0)), m21 = simd::splat(m(2,1)), m22 = simd::splat(m(2,2));
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 vx = simd::load(x + i), vy = simd::load(y + i), vz = simd::load(z + i);
+        simd::store(out_x + i, simd::add(simd::add(simd::mul(m00, vx), simd::mul(m01, vy)), simd::mul(m02, vz)));
+        simd::store(out_y + i, simd::add(simd::add(simd::mul(m10, vx), simd::mul(m11, vy)), simd::mul(m12, vz)));
+        simd::store(out_z + i, simd::add(simd::add(simd::mul(m20, vx), simd::mul(m21, vy)), simd::mul(m22, vz)));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        detail::direction(m, x[i], y[i], z[i], out_x[i], out_y[i], out_z[i]);
+    }
+}
+
+/// @brief Rotate vectors by a unit quaternion
+/// @param q The quaternion, of norm 1
+/// @param x, y, z Components of the vectors
+/// @param out_x, out_y, out_z Components of the rotated vectors, may be the inputs
+/// @param count Number of vectors
+inline void rotate(const Quaternion<float>& q, const float* x, const float* y, const float* z,
+                   float* out_x, float* out_y, float* out_z, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 qw = simd::splat(q.r()), qx = simd::splat(q.i()), qy = simd::splat(q.j()), qz = simd::splat(q.k());
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 vx = simd::load(x + i), vy = simd::load(y + i), vz = simd::load(z + i);
+        simd::f4 tx = simd::sub(simd::mul(qy, vz), simd::mul(qz, vy));
+        simd::f4 ty = simd::sub(simd::mul(qz, vx), simd::mul(qx, vz));
+        simd::f4 tz = simd::sub(simd::mul(qx, vy), simd::mul(qy, vx));
+        tx = simd::add(tx, tx);
+        ty = simd::add(ty, ty);
+        tz = simd::add(tz, tz);
+        simd::store(out_x + i, simd::add(simd::add(vx, simd::mul(qw, tx)), simd::sub(simd::mul(qy, tz), simd::mul(qz, ty))));
+        simd::store(out_y + i, simd::add(simd::add(vy, simd::mul(qw, ty)), simd::sub(simd::mul(qz, tx), simd::mul(qx, tz))));
+        simd::store(out_z + i, simd::add(simd::add(vz, simd::mul(qw, tz)), simd::sub(simd::mul(qx, ty), simd::mul(qy, tx))));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        detail::rotation(q, x[i], y[i], z[i], out_x[i], out_y[i], out_z[i]);
+    }
+}
+
+/// @brief Transform 2D points by an affine matrix, e.g. the corners of sprites
+/// @param m The matrix (rotation, scale and translation in the last column), the last row is ignored
+/// @param x, y Components of the points
+/// @param out_x, out_y Components of the transformed points, may be the inputs
+/// @param count Number of points
+inline void transform2(const Matrix<float,3,3>& m, const float* x, const float* y, float* out_x, float* out_y, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 m00 = simd::splat(m(0,0)), m01 = simd::splat(m(0,1)), m02 = simd::splat(m(0,2));
+    simd::f4 m10 = simd::splat(m(1,0)), m11 = simd::splat(m(1,1)), m12 = simd::splat(m(1,2));
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 vx = simd::load(x + i), vy = simd::load(y + i);
+        simd::store(out_x + i, simd::add(simd::add(simd::mul(m00, vx), simd::mul(m01, vy)), m02));
+        simd::store(out_y + i, simd::add(simd::add(simd::mul(m10, vx), simd::mul(m11, vy)), m12));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        float px(x[i]), py(y[i]);
+        out_x[i] = m(0,0)*px + m(0,1)*py + m(0,2);
+        out_y[i] = m(1,0)*px + m(1,1)*py + m(1,2);
+    }
+}
+
+// AoS, an array of vectors
+
+/// @brief Transform points (w = 1) by an affine matrix, the last row of the matrix is ignored
+/// @param m The matrix
+/// @param points The points
+/// @param out The transformed points, may be the points
+/// @param count Number of points
+inline void transform_points(const Matrix<float,4,4>& m, const Vector<float,3>* points, Vector<float,3>* out, size_t count) {
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 c0 = simd::load(m.begin()), c1 = simd::load(m.begin() + 4), c2 = simd::load(m.begin() + 8), c3 = simd::load(m.begin() + 12);
+    for (size_t i(0) ; i < count ; ++i) {
+        const Vector<float,3>& p = points[i];
+        simd::f4 r = simd::add(simd::add(simd::add(simd::mul(c0, simd::splat(p[0])), simd::mul(c1, simd::splat(p[1]))), simd::mul(c2, simd::splat(p[2]))), c3);
+
+        // The fourth lane would overwrite the next point
+        float result[4];
+        simd::store(result, r);
+        out[i][0] = result[0]; out[i][1] = result[1]; out[i][2] = result[2];
+    }
+#else
+    for (size_t i(0) ; i < count ; ++i) {
+        Vector<float,3> p = points[i];
+        detail::point(m, p[0], p[1], p[2], out[i][0], out[i][1], out[i][2]);
+    }
+#endif
+}
+
+/// @brief Transform directions (w = 0), the translation is ignored
+/// @param m The matrix
+/// @param directions The directions
+/// @param out The transformed directions, may be the directions
+/// @param count Number of directions
+inline void transform_directions(const Matrix<float,4,4>& m, const Vector<float,3>* directions, Vector<float,3>* out, size_t count) {
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    simd::f4 c0 = simd::load(m.begin()), c1 = simd::load(m.begin() + 4), c2 = simd::load(m.begin() + 8);
+    for (size_t i(0) ; i < count ; ++i) {
+        const Vector<float,3>& d = directions[i];
+        simd::f4 r = simd::add(simd::add(simd::mul(c0, simd::splat(d[0])), simd::mul(c1, simd::splat(d[1]))), simd::mul(c2, simd::splat(d[2])));
+
+        float result[4];
+        simd::store(result, r);
+        out[i][0] = result[0]; out[i][1] = result[1]; out[i][2] = result[2];
+    }
+#else
+    for (size_t i(0) ; i < count ; ++i) {
+        Vector<float,3> d = directions[i];
+        detail::direction(m, d[0], d[1], d[2], out[i][0], out[i][1], out[i][2]);
+    }
+#endif
+}
+
+/// @brief Rotate vectors by a unit quaternion
+/// @param q The quaternion, of norm 1
+/// @param vectors The vectors
+/// @param out The rotated vectors, may be the vectors
+/// @param count Number of vectors
+inline void rotate(const Quaternion<float>& q, const Vector<float,3>* vectors, Vector<float,3>* out, size_t count) {
+    for (size_t i(0) ; i < count ; ++i) {
+        Vector<float,3> v = vectors[i];
+        detail::rotation(q, v[0], v[1], v[2], out[i][0], out[i][1], out[i][2]);
+    }
+}
+
+/// @brief Transform 2D points by an affine matrix, e.g. the corners of sprites
+/// @param m The matrix (rotation, scale and translation in the last column), the last row is ignored
+/// @param points The points
+/// @param out The transformed points, may be the points
+/// @param count Number of points
+inline void transform2(const Matrix<float,3,3>& m, const Vector<float,2>* points, Vector<float,2>* out, size_t count) {
+    for (size_t i(0) ; i < count ; ++i) {
+        float px(points[i][0]), py(points[i][1]);
+        out[i][0] = m(0,0)*px + m(0,1)*py + m(0,2);
+        out[i][1] = m(1,0)*px + m(1,1)*py + m(1,2);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <inttypes.h>
+
+#include "DoubleDouble.hpp"
+
+namespace mat {
+
+/*
+BigFixed: a signed fixed-point real number of chosen precision, an integer part of 32 bits and up to
+MAX_LIMBS fractional limbs of 32 bits
+
+    value = sign * (limb(0) + limb(1) 2^-32 + limb(2) 2^-64 + ... + limb(n) 2^-32n)
+
+It is meant for the few values that need more than the 106 bits of DoubleDouble, e.g. the center of
+a deep zoom in the Mandelbrot set and its reference orbit: everything else stays in double. The
+precision is chosen at run time, limbs_for gives the number of limbs to resolve a distance. The
+result of an operation has the precision of its most precise operand, the mixed operations with a
+double convert the double to the precision of the other operand. No allocation, the limbs are stored
+inline: a copy is about 170 bytes.
+
+The products are truncated below the last limb, the error is a few units of 2^-32n. The integer part
+must stay below 2^32, it is not checked.
+
+    mat::BigFixed center = mat::BigFixed(-0.75, mat::BigFixed::limbs_for(1e-100)) + 3.1e-101;
+*/
+
+//    ___  _        ___  _               _
+//   | _ )(_) __ _ | __|(_)__ __ ___  __| |
+//   | _ \| |/ _` || _| | |\ \ // -_)/ _` |
+//   |___/|_|\__, ||_|  |_|/_\_\\___|\__,_|
+//           |___/
+//
+
+class BigFixed {
+public:
+    /// @brief Largest number of fractional limbs, 1280 bits: a resolution of 1e-385
+    static constexpr uint32_t MAX_LIMBS = 40;
+
+    /// @brief Number of fractional limbs by default, 128 bits
+    static constexpr uint32_t DEFAULT_LIMBS = 4;
+
+    /// @brief Default constructor, the value 0
+    BigFixed() : m_limb{}, m_limbs(DEFAULT_LIMBS), m_negative(false) {}
+
+    /// @brief Constructor from a double, exact if its bits are above 2^-32 limbs
+    /// @param a The value, |a| < 2^32
+    /// @param limbs The number of fractional limbs, up to MAX_LIMBS
+    BigFixed(double a, uint32_t limbs = DEFAULT_LIMBS) : m_limb{}, m_limbs(std::min(limbs, MAX_LIMBS)), m_negative(a < 0.0) {
+        double x = std::fabs(a);
+        m_limb[0] = uint32_t(x);
+        x -= m_limb[0];
+        for (uint32_t k = 1; k <= m_limbs && x != 0.0; ++k) {
+            x = std::ldexp(x, 32);
+            m_limb[k] = uint32_t(x);
+            x -= m_limb[k];
+        }
+        m_negative = m_negative && !is_zero();
+    }
+
+    /// @brief Constructor from a double-double
+    /// @param a The value, |a| < 2^32
+    /// @param limbs The number of fractional limbs, up to MAX_LIMBS
+    BigFixed(const DoubleDouble& a, uint32_t limbs = DEFAULT_LIMBS) : BigFixed(a.hi(), limbs) {
+        *this += a.lo();
+    }
+
+    /// @brief Get the number of bits resolving a distance, with 64 bits of margin
+    /// @param resolution The smallest distance to resolve, e.g. the size of a pixel
+    /// @return The number of fractional limbs, between 2 and MAX_LIMBS
+    static uint32_t limbs_for(double resolution) {
+        int32_t bits = int32_t(std::ceil(-std::log2(std::fabs(resolution)))) + 64;
+        return uint32_t(std::clamp((bits + 31) / 32, 2, int32_t(MAX_LIMBS)));
+    }
+
+    /// @brief Get the number of fractional limbs
+    /// @return The number of limbs after the integer part
+    uint32_t limbs() const { return m_limbs; }
+
+    /// @brief Get a limb of the magnitude
+    /// @param k The index, 0 for the integer part, k for the weight 2^-32k
+    /// @return The limb
+    uint32_t limb(uint32_t k) const { return m_limb[k]; }
+
+    /// @brief Know if the value is negative
+    /// @return True if the value is below 0
+    bool is_negative() const { return m_negative; }
+
+    /// @brief Know if the value is zero
+    /// @return True if all the limbs are 0
+    bool is_zero() const {
+        return std::all_of(m_limb.begin(), m_limb.begin() + m_limbs + 1, [](uint32_t l) { return l == 0; });
+    }
+
+    /// @brief Change the precision, truncate or extend with zeros
+    /// @param limbs The number of fractional limbs, up to MAX_LIMBS
+    /// @return The value with the new precision
+    BigFixed with_limbs(uint32_t limbs) const {
+        BigFixed result(*this);
+        result.m_limbs = std::min(limbs, MAX_LIMBS);
+        std::fill(result.m_limb.begin() + result.m_limbs + 1, result.m_limb.end(), 0);
+        result.m_negative = result.m_negative && !result.is_zero();
+        return result;
+    }
+
+    /// @brief Round down to a multiple of a power of 2, exact
+    /// @param exponent The power, from -32 limbs to 31
+    /// @return The largest multiple of 2^exponent not above the value
+    BigFixed floor_to(int32_t exponent) const {
+        BigFixed result(*this);
+        Limbs unit{};
+        bool dropped = false;
+        for (uint32_t k = 0; k <= m_limbs; ++k) {
+            // The bit t of the limb k weighs 2^(t - 32k), the bits below 2^exponent are cleared
+            int32_t cut = exponent + 32 * int32_t(k);
+            if (cut >= 0 && cut < 32) {
+                unit[k] = 1u << cut;
+            }
+            if (cut > 0) {
+                uint32_t mask = cut >= 32 ? 0xFFFFFFFFu : (1u << cut) - 1;
+                dropped |= (result.m_limb[k] & mask) != 0;
+                result.m_limb[k] &= ~mask;
+            }
+        }
+        // The magnitude was truncated, a negative value goes one unit further down
+        if (m_negative && dropped) {
+            add_magnitude(result.m_limb, unit, result.m_limbs);
+        }
+        result.m_negative = result.m_negative && !result.is_zero();
+        return result;
+    }
+
+    /// @brief Round to a double
+    explicit operator double() const {
+        double result = 0.0;
+        for (uint32_t k = m_limbs + 1; k-- > 0;) {
+            result += std::ldexp(double(m_limb[k]), -32 * int32_t(k));
+        }
+        return m_negative ? -result : result;
+    }
+
+    /// @brief Round to a double-double
+    explicit operator DoubleDouble() const {
+        double hi = double(*this);
+        return DoubleDouble(hi) + double(*this - hi);
+    }
+
+    BigFixed operator-() const {
+        BigFixed result(*this);
+        result.m_negative = !m_negative && !is_zero();
+        return result;
+    }
+
+    BigFixed& operator+=(const BigFixed& b) {
+        m_limbs = std::max(m_limbs, b.m_limbs);
+        if (m_negative == b.m_negative) {
+            add_magnitude(m_limb, b.m_limb, m_limbs);
+        } else if (compare_magnitude(m_limb, b.m_limb, m_limbs) >= 0) {
+            sub_magnitude(m_limb, b.m_limb, m_limbs);
+        } else {
+            Limbs difference = b.m_limb;
+            sub_magnitude(difference, m_limb, m_limbs);
+            m_limb = difference;
+            m_negative = b.m_negative;
+        }
+        m_negative = m_negative && !is_zero();
+        return *this;
+    }
+
+    BigFixed& operator+=(double b) { return *this += BigFixed(b, m_limbs); }
+
+    BigFixed& operator-=(const BigFixed& b) { return *this += -b; }
+
+    BigFixed& operator-=(double b) { return *this += BigFixed(-b, m_limbs); }
+
+    BigFixed& operator*=(const BigFixed& b) {
+        // Schoolbook product, the columns of weight below 2^-32(n+1) are dropped
+        const uint32_t n = std::max(m_limbs, b.m_limbs);
+        std::array<uint64_t, MAX_LIMBS + 2> column{};
+        for (uint32_t i = 0; i <= n; ++i) {
+            if (m_limb[i] == 0) {
+                continue;
+            }
+            for (uint32_t j = 0; j <= std::min(n, n + 1 - i); ++j) {
+                uint64_t product = uint64_t(m_limb[i]) * b.m_limb[j];
+                column[i + j] += product & 0xffffffffu;
+                if (i + j > 0) {
+                    column[i + j - 1] += product >> 32;
+                }
+            }
+        }
+        for (uint32_t k = n + 1; k > 0; --k) {
+            column[k - 1] += column[k] >> 32;
+        }
+        for (uint32_t k = 0; k <= n; ++k) {
+            m_limb[k] = uint32_t(column[k]);
+        }
+        m_limbs = n;
+        m_negative = (m_negative != b.m_negative) && !is_zero();
+        return *this;
+    }
+
+    BigFixed& operator*=(double b) { return *this *= BigFixed(b, m_limbs); }
+
+    friend BigFixed operator+(BigFixed a, const BigFixed& b) { return a += b; }
+    friend BigFixed operator+(BigFixed a, double b) { return a += b; }
+    friend BigFixed operator+(double a, BigFixed b) { return b += a; }
+    friend BigFixed operator-(BigFixed a, const BigFixed& b) { return a -= b; }
+    friend BigFixed operator-(BigFixed a, double b) { return a -= b; }
+    friend BigFixed operator-(double a, const BigFixed& b) { return -b + a; }
+    friend BigFixed operator*(BigFixed a, const BigFixed& b) { return a *= b; }
+    friend BigFixed operator*(BigFixed a, double b) { return a *= b; }
+    friend BigFixed operator*(double a, BigFixed b) { return b *= a; }
+
+    friend bool operator==(const BigFixed& a, const BigFixed& b) {
+        return a.m_negative == b.m_negative && compare_magnitude(a.m_limb, b.m_limb, std::max(a.m_limbs, b.m_limbs)) == 0;
+    }
+    friend bool operator!=(const BigFixed& a, const BigFixed& b) { return !(a == b); }
+    friend bool operator<(const BigFixed& a, const BigFixed& b) {
+        if (a.m_negative != b.m_negative) {
+            return a.m_negative;
+        }
+        int32_t order = compare_magnitude(a.m_limb, b.m_limb, std::max(a.m_limbs, b.m_limbs));
+        return a.m_negative ? order > 0 : order < 0;
+    }
+    friend bool operator>(const BigFixed& a, const BigFixed& b) { return b < a; }
+    friend bool operator<=(const BigFixed& a, const BigFixed& b) { return !(b < a); }
+    friend bool operator>=(const BigFixed& a, const BigFixed& b) { return !(a < b); }
+
+    // Found by argument-dependent lookup only, so they do not hide the functions of <cmath> in mat
+
+    /// @brief Square of a value
+    /// @param a The value
+    /// @return a * a
+    friend BigFixed sqr(const BigFixed& a) { return a * a; }
+
+    /// @brief Absolute value
+    /// @param a The value
+    /// @return |a|
+    friend BigFixed abs(const BigFixed& a) { return a.m_negative ? -a : a; }
+
+private:
+    typedef std::array<uint32_t, MAX_LIMBS + 1> Limbs;
+
+    /// @brief a += b on the limbs 0 to n
+    static void add_magnitude(Limbs& a, const Limbs& b, uint32_t n) {
+        uint64_t carry = 0;
+        for (uint32_t k = n + 1; k-- > 0;) {
+            uint64_t sum = uint64_t(a[k]) + b[k] + carry;
+            a[k] = uint32_t(sum);
+            carry = sum >> 32;
+        }
+    }
+
+    /// @brief a -= b on the limbs 0 to n, with a >= b
+    static void sub_magnitude(Limbs& a, const Limbs& b, uint32_t n) {
+        uint64_t borrow = 0;
+        for (uint32_t k = n + 1; k-- > 0;) {
+            uint64_t difference = uint64_t(a[k]) - b[k] - borrow;
+            a[k] = uint32_t(difference);
+            borrow = difference >> 63;
+        }
+    }
+
+    /// @brief Compare the limbs 0 to n
+    /// @return -1, 0 or 1 if a is below, equal or above b
+    static int32_t compare_magnitude(const Limbs& a, const Limbs& b, uint32_t n) {
+        for (uint32_t k = 0; k <= n; ++k) {
+            if (a[k] != b[k]) {
+                return a[k] < b[k] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    Limbs m_limb;           // The limbs beyond m_limbs are 0
+    uint32_t m_limbs;
+    bool m_negative;        // Never true for 0
+};
+
+/// @brief Decimal writing of a fixed-point value, in scientific notation
+/// @param a The value
+/// @param digits The number of significant digits, the ones beyond the precision are 0
+/// @return The string, e.g. -7.4364388703715870475219150611477e-01
+inline std::string to_string(const BigFixed& a, uint32_t digits = 32) {
+    if (a.is_zero()) {
+        return std::to_string(0.0);
+    }
+
+    std::string mantissa;
+    int32_t exponent = -1;
+    if (a.limb(0) != 0) {
+        mantissa = std::to_string(a.limb(0));
+        exponent = int32_t(mantissa.size()) - 1;
+    }
+
+    // The fraction times 10, the digit is the carry of the integer part
+    std::array<uint32_t, BigFixed::MAX_LIMBS + 1> fraction;
+    for (uint32_t k = 1; k <= a.limbs(); ++k) {
+        fraction[k] = a.limb(k);
+    }
+    const uint32_t fraction_digits = uint32_t(a.limbs() * 32 * 0.30103) + 1;
+    for (uint32_t d = 0; d < fraction_digits && mantissa.size() < digits; ++d) {
+        uint64_t carry = 0;
+        for (uint32_t k = a.limbs(); k > 0; --k) {
+            uint64_t product = uint64_t(fraction[k]) * 10 + carry;
+            fraction[k] = uint32_t(product);
+            carry = product >> 32;
+        }
+        if (mantissa.empty() && carry == 0) {
+            --exponent;
+        } else {
+            mantissa += char('0' + carry);
+        }
+    }
+    mantissa.resize(std::max(digits, 1u), '0');
+
+    std::string exponent_string = std::to_string(std::abs(exponent));
+    return (a.is_negative() ? "-" : "") + mantissa.substr(0, 1) + "." + mantissa.substr(1) + (exponent < 0 ? "e-" : "e+")
+         + (exponent_string.size() < 2 ? "0" : "") + exponent_string;
+}
+
+/// @brief Stream operator, write the value with 32 digits
+inline std::ostream& operator<<(std::ostream& stream, const BigFixed& a) {
+    return stream << to_string(a);
+}
+
+}
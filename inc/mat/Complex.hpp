@@ -5,6 +5,7 @@
 
 #include "BaseVector.hpp"
 #include "Vector.hpp"
+#include "Constexpr.hpp"
 
 namespace mat {
 
@@ -39,24 +40,24 @@ public:
 //                                                 
 
     /// @brief Default constructor, fill the vector with value 0
-    Complex();
+    constexpr Complex();
 
     /// @brief Constructor with only a real part
     /// @param re Real part
-    Complex(T re);
+    constexpr Complex(T re);
 
     /// @brief Constructor with a real and an imaginary part
     /// @param re Real part
     /// @param im Imaginary part
-    Complex(T re, T im);
+    constexpr Complex(T re, T im);
 
     /// @brief Constructor, copy an array
     /// @param init_array Initial array
-    Complex(const std::array<T,2>& init_array);
+    constexpr Complex(const std::array<T,2>& init_array);
 
     /// @brief Constructor, copy an initializer list
     /// @param init_list Initializer list
-    Complex(const std::initializer_list<T>& init_list);
+    constexpr Complex(const std::initializer_list<T>& init_list);
 
 //    __  __     _   _            _    
 //   |  \/  |___| |_| |_  ___  __| |___
@@ -66,42 +67,42 @@ public:
 
     /// @brief Get the real part
     /// @return A reference to the real part
-    T& real();
+    constexpr T& real();
 
     /// @brief Get the imaginary part
     /// @return A reference to the imaginary part
-    T& imag();
+    constexpr T& imag();
 
     /// @brief Get the real part
     /// @return A constant reference to the real part
-    const T& real() const;
+    constexpr const T& real() const;
 
     /// @brief Get the imaginary part
     /// @return A constant reference to the imaginary part
-    const T& imag() const;
+    constexpr const T& imag() const;
 
     /// @brief Compute the square modulus
     /// @return The square modulus
-    T modulus2() const;
+    constexpr T modulus2() const;
 
     /// @brief Compute the modulus
     /// @return The modulus
-    T modulus() const;
+    constexpr T modulus() const;
 
     /// @brief Compute the argument
     /// @return The argument
     T argument() const;
 
     /// @brief Conjugate the complex
-    void conjugate();
+    constexpr void conjugate();
 
     /// @brief Normalize the complex
-    void normalize();
+    constexpr void normalize();
 
     /// @brief Set the component from a polar form
     /// @param mod The modulus of the complex
     /// @param argu The argument of the complex
-    void set_polar(T mod, T argu);
+    constexpr void set_polar(T mod, T argu);
 
     /// @brief Get the component from a polar form
     /// @param mod A reference to the modulus of the complex
@@ -124,42 +125,42 @@ public:
     /// @brief Add a real number
     /// @param a The real number
     /// @return Reference to the complex
-    Complex& operator+=(T a);
+    constexpr Complex& operator+=(T a);
 
     /// @brief Substract a real number
     /// @param a The real number 
     /// @return Reference to the complex
-    Complex& operator-=(T a);
+    constexpr Complex& operator-=(T a);
 
     /// @brief Multiply by a real number
     /// @param a The real number 
     /// @return Reference to the complex
-    Complex& operator*=(T a);
+    constexpr Complex& operator*=(T a);
 
     /// @brief Divide by a real number
     /// @param a The real number 
     /// @return Reference to the complex
-    Complex& operator/=(T a);
+    constexpr Complex& operator/=(T a);
 
     /// @brief Add two complex
     /// @param c Complex
     /// @return Reference to the complex
-    Complex& operator+=(const Complex<T>& c);
+    constexpr Complex& operator+=(const Complex<T>& c);
 
     /// @brief Substract two complex
     /// @param c Complex
     /// @return Reference to the complex
-    Complex& operator-=(const Complex<T>& c);
+    constexpr Complex& operator-=(const Complex<T>& c);
 
     /// @brief Multiply two complex
     /// @param c Complex
     /// @return Reference to the complex
-    Complex& operator*=(const Complex<T>& c);
+    constexpr Complex& operator*=(const Complex<T>& c);
 
     /// @brief Divide two complex
     /// @param c Complex
     /// @return Reference to the complex
-    Complex& operator/=(const Complex<T>& c);
+    constexpr Complex& operator/=(const Complex<T>& c);
 };
 
 
@@ -174,58 +175,58 @@ public:
 //                                            
 
 template<typename T>
-Complex<T>::Complex()
+constexpr Complex<T>::Complex()
 : BaseVector<T,2>()
 {}
 
 template<typename T>
-Complex<T>::Complex(T re)
+constexpr Complex<T>::Complex(T re)
 : BaseVector<T,2>{re}
 {}
 
 template<typename T>
-Complex<T>::Complex(T re, T im)
+constexpr Complex<T>::Complex(T re, T im)
 : BaseVector<T,2>{re, im}
 {}
 
 template<typename T>
-Complex<T>::Complex(const std::array<T,2>& init_array) 
+constexpr Complex<T>::Complex(const std::array<T,2>& init_array) 
 : BaseVector<T,2>(init_array)
 {}
 
 template<typename T>
-Complex<T>::Complex(const std::initializer_list<T>& init_list) 
+constexpr Complex<T>::Complex(const std::initializer_list<T>& init_list) 
 : BaseVector<T,2>(init_list)
 {}
 
 template<typename T>
-T& Complex<T>::real() { 
+constexpr T& Complex<T>::real() { 
     return m_component[0]; 
 }
 
 template<typename T>
-T& Complex<T>::imag() { 
+constexpr T& Complex<T>::imag() { 
     return m_component[1]; 
 }
 
 template<typename T>
-const T& Complex<T>::real() const { 
+constexpr const T& Complex<T>::real() const { 
     return m_component[0]; 
 }
 
 template<typename T>
-const T& Complex<T>::imag() const { 
+constexpr const T& Complex<T>::imag() const { 
     return m_component[1]; 
 }
 
 template<typename T>
-T Complex<T>::modulus2() const { 
+constexpr T Complex<T>::modulus2() const { 
     return m_component[0] * m_component[0] + m_component[1] * m_component[1]; 
 }
 
 template<typename T>
-T Complex<T>::modulus() const { 
-    return sqrt(modulus2()); 
+constexpr T Complex<T>::modulus() const { 
+    return cx::sqrt(modulus2()); 
 }
 
 template<typename T>
@@ -234,21 +235,21 @@ T Complex<T>::argument() const {
 }
 
 template<typename T>
-void Complex<T>::conjugate() { 
+constexpr void Complex<T>::conjugate() { 
     m_component[1] = -m_component[1]; 
 }
 
 template<typename T>
-void Complex<T>::normalize() {
+constexpr void Complex<T>::normalize() {
     T m = modulus();
     m_component[0] /= m;
     m_component[1] /= m;
 }
 
 template<typename T>
-void Complex<T>::set_polar(T magn, T argu) { 
-    m_component[0] = magn * cos(argu); 
-    m_component[1] = magn * sin(argu); 
+constexpr void Complex<T>::set_polar(T magn, T argu) { 
+    m_component[0] = magn * cx::cos(argu); 
+    m_component[1] = magn * cx::sin(argu); 
 }
 
 template<typename T>
@@ -263,47 +264,47 @@ Complex<T>::operator BaseVector<T,2>&() {
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator+=(T a) {
+constexpr Complex<T>& Complex<T>::operator+=(T a) {
     m_component[0] += a;
     return *this;
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator-=(T a) {
+constexpr Complex<T>& Complex<T>::operator-=(T a) {
     m_component[0] -= a;
     return *this;
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator*=(T a) { 
+constexpr Complex<T>& Complex<T>::operator*=(T a) { 
     m_component[0] *= a;
     m_component[1] *= a;
     return *this;
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator/=(T a) { 
+constexpr Complex<T>& Complex<T>::operator/=(T a) { 
     m_component[0] /= a; 
     m_component[1] /= a; 
     return *this;
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator+=(const Complex<T>& c) { 
+constexpr Complex<T>& Complex<T>::operator+=(const Complex<T>& c) { 
     m_component[0] += c.real();
     m_component[1] += c.imag();
     return *this;
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator-=(const Complex<T>& c) { 
+constexpr Complex<T>& Complex<T>::operator-=(const Complex<T>& c) { 
     m_component[0] -= c.real();
     m_component[1] -= c.imag();
     return *this;
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator*=(const Complex<T>& c) { 
+constexpr Complex<T>& Complex<T>::operator*=(const Complex<T>& c) { 
     T r = m_component[0] * c.real() - m_component[1] * c.imag();
     T i = m_component[0] * c.imag() + m_component[1] * c.real();
     m_component[0] = r;
@@ -312,7 +313,7 @@ Complex<T>& Complex<T>::operator*=(const Complex<T>& c) {
 }
 
 template<typename T>
-Complex<T>& Complex<T>::operator/=(const Complex<T>& c) { 
+constexpr Complex<T>& Complex<T>::operator/=(const Complex<T>& c) { 
     T r = (m_component[0]*c.real() + m_component[1]*c.imag()) / c.modulus2();
     T i = (m_component[1]*c.real() - m_component[0]*c.imag()) / c.modulus2();
     m_component[0] = r;
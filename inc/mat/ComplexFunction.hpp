@@ -2,6 +2,7 @@
 
 #include "Complex.hpp"
 #include "Matrix.hpp"
+#include "Constexpr.hpp"
 
 namespace mat {
 
@@ -28,7 +29,7 @@ std::ostream& operator<<(std::ostream& stream, const Complex<T>& c) {
 /// @param a The real number
 /// @return The new complex
 template<typename T>
-Complex<T> operator+(Complex<T> c, T a) {
+constexpr Complex<T> operator+(Complex<T> c, T a) {
     return c += a;
 }
 
@@ -38,7 +39,7 @@ Complex<T> operator+(Complex<T> c, T a) {
 /// @param c The complex
 /// @return The new complex
 template<typename T>
-Complex<T> operator+(T a, Complex<T> c) {
+constexpr Complex<T> operator+(T a, Complex<T> c) {
     return c += a;
 }
 
@@ -48,7 +49,7 @@ Complex<T> operator+(T a, Complex<T> c) {
 /// @param a The real number
 /// @return The new complex
 template<typename T>
-Complex<T> operator-(Complex<T> c, T a) {
+constexpr Complex<T> operator-(Complex<T> c, T a) {
     return c -= a;
 }
 
@@ -58,7 +59,7 @@ Complex<T> operator-(Complex<T> c, T a) {
 /// @param c The complex
 /// @return The new complex
 template<typename T>
-Complex<T> operator-(T a, Complex<T> c) {
+constexpr Complex<T> operator-(T a, Complex<T> c) {
     return -c += a;
 }
 
@@ -68,7 +69,7 @@ Complex<T> operator-(T a, Complex<T> c) {
 /// @param a The real number
 /// @return The new complex
 template<typename T>
-Complex<T> operator*(Complex<T> c, T a) {
+constexpr Complex<T> operator*(Complex<T> c, T a) {
     return c *= a;
 }
 
@@ -78,7 +79,7 @@ Complex<T> operator*(Complex<T> c, T a) {
 /// @param c The complex
 /// @return The new complex
 template<typename T>
-Complex<T> operator*(T a, Complex<T> c) {
+constexpr Complex<T> operator*(T a, Complex<T> c) {
     return c *= a;
 }
 
@@ -88,7 +89,7 @@ Complex<T> operator*(T a, Complex<T> c) {
 /// @param a The real number
 /// @return The newcomplex
 template<typename T>
-Complex<T> operator/(Complex<T> c, T a) {
+constexpr Complex<T> operator/(Complex<T> c, T a) {
     return c /= a;
 }
 
@@ -98,7 +99,7 @@ Complex<T> operator/(Complex<T> c, T a) {
 /// @param c The complex
 /// @return The new complex
 template<typename T>
-Complex<T> operator/(T a, const Complex<T>& c) {
+constexpr Complex<T> operator/(T a, const Complex<T>& c) {
     return Complex<T>(a*c.real() / c.modulus2(), -a*c.imag() / c.modulus2());
 }
 
@@ -108,7 +109,7 @@ Complex<T> operator/(T a, const Complex<T>& c) {
 /// @param c2 Second complex
 /// @return The addition of the two complex
 template<typename T>
-Complex<T> operator+(Complex<T> c1, const Complex<T>& c2) {
+constexpr Complex<T> operator+(Complex<T> c1, const Complex<T>& c2) {
     return c1 += c2;
 }
 
@@ -118,7 +119,7 @@ Complex<T> operator+(Complex<T> c1, const Complex<T>& c2) {
 /// @param c2 Second complex
 /// @return The substraction of the two complex
 template<typename T>
-Complex<T> operator-(Complex<T> c1, const Complex<T>& c2) {
+constexpr Complex<T> operator-(Complex<T> c1, const Complex<T>& c2) {
     return c1 -= c2;
 }
 
@@ -128,7 +129,7 @@ Complex<T> operator-(Complex<T> c1, const Complex<T>& c2) {
 /// @param c2 Second complex
 /// @return The multiplication of the two complex
 template<typename T>
-Complex<T> operator*(Complex<T> c1, const Complex<T>& c2) {
+constexpr Complex<T> operator*(Complex<T> c1, const Complex<T>& c2) {
     return c1 *= c2;
 }
 
@@ -138,7 +139,7 @@ Complex<T> operator*(Complex<T> c1, const Complex<T>& c2) {
 /// @param c2 Second complex
 /// @return The division of the two complex
 template<typename T>
-Complex<T> operator/(Complex<T> c1, const Complex<T>& c2) {
+constexpr Complex<T> operator/(Complex<T> c1, const Complex<T>& c2) {
     return c1 /= c2;
 }
 
@@ -147,7 +148,7 @@ Complex<T> operator/(Complex<T> c1, const Complex<T>& c2) {
 /// @param c The complex
 /// @return Minus the complex (-z)
 template<typename T>
-Complex<T> operator-(const Complex<T>& c) {
+constexpr Complex<T> operator-(const Complex<T>& c) {
     return Complex<T>{-c.real(), -c.imag()};
 }
 
@@ -162,7 +163,7 @@ Complex<T> operator-(const Complex<T>& c) {
 /// @param c The complex
 /// @return The rotation matrix
 template<typename T>
-Matrix<T,2,2> complex_to_rotation_matrix(const Complex<T>& c) {
+constexpr Matrix<T,2,2> complex_to_rotation_matrix(const Complex<T>& c) {
     T co = c.real() / c.modulus();
     T si = c.imag() / c.modulus();
     return Matrix<T,2,2>(std::array<T,4>{co, si, -si, co});
@@ -173,8 +174,8 @@ Matrix<T,2,2> complex_to_rotation_matrix(const Complex<T>& c) {
 /// @param angle The angle of rotation
 /// @return The complex
 template<typename T>
-Complex<T> angle_to_complex(T angle) {
-    return Complex<T>(cos(angle), sin(angle));
+constexpr Complex<T> angle_to_complex(T angle) {
+    return Complex<T>(cx::cos(angle), cx::sin(angle));
 }
 
 /// @brief Rotate a vector using a complex as rotation
@@ -183,7 +184,7 @@ Complex<T> angle_to_complex(T angle) {
 /// @param v The vector
 /// @return The rotated vector
 template<typename T>
-Vector<T,2> complex_rotate_vec(const Complex<T>& c, Vector<T,2> v) {
+constexpr Vector<T,2> complex_rotate_vec(const Complex<T>& c, Vector<T,2> v) {
     return (Vector<T,2>)(c * (Complex<T>)v);
 }
 
@@ -192,7 +193,7 @@ Vector<T,2> complex_rotate_vec(const Complex<T>& c, Vector<T,2> v) {
 /// @param c The complex
 /// @return The conjugate of the complex
 template<typename T>
-Complex<T> conjugate(Complex<T> c) {
+constexpr Complex<T> conjugate(Complex<T> c) {
     return c.conjugate();
 }
 
@@ -203,7 +204,7 @@ Complex<T> conjugate(Complex<T> c) {
 /// @param m The complex matrix
 /// @return The conjugate of the matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<Complex<T>, N, M> conjugate(Matrix<Complex<T>, N, M> m) {
+constexpr Matrix<Complex<T>, N, M> conjugate(Matrix<Complex<T>, N, M> m) {
     for (Complex<T>& i : m) {
         i.conjugate();
     }
@@ -216,7 +217,7 @@ Matrix<Complex<T>, N, M> conjugate(Matrix<Complex<T>, N, M> m) {
 /// @tparam M Column of the matrix
 /// @param m The complex matrix
 template<typename T, uint32_t N, uint32_t M>
-void self_conjugate(Matrix<Complex<T>, N, M>& m) {
+constexpr void self_conjugate(Matrix<Complex<T>, N, M>& m) {
     for (Complex<T>& i : m) {
         i.conjugate();
     }
@@ -229,7 +230,7 @@ void self_conjugate(Matrix<Complex<T>, N, M>& m) {
 /// @param m The complex matrix
 /// @return The conjugate transpose of the complex matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<Complex<T>, M, N> conjugate_transpose(const Matrix<Complex<T>, N, M>& m) {
+constexpr Matrix<Complex<T>, M, N> conjugate_transpose(const Matrix<Complex<T>, N, M>& m) {
     Matrix<Complex<T>, M, N> result = mat::transpose(m);
     for (Complex<T>& i : result) {
         i.conjugate();
@@ -242,7 +243,7 @@ Matrix<Complex<T>, M, N> conjugate_transpose(const Matrix<Complex<T>, N, M>& m)
 /// @tparam N The row and column of the matrix
 /// @param m The complex matrix
 template<typename T, uint32_t N>
-void self_conjugate_transpose(Matrix<Complex<T>, N, N>& m) {
+constexpr void self_conjugate_transpose(Matrix<Complex<T>, N, N>& m) {
     mat::self_transpose(m);
     for (Complex<T>& i : m) {
         i.conjugate();
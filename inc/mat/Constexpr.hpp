@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <inttypes.h>
+
+namespace mat {
+
+/*
+Functions of <cmath> usable in constant expressions
+
+At run time they call the std functions. In constant expressions they use a range reduction and a
+series evaluated in double, within 2 ulp of the std functions for the arguments of the transforms
+(|x| < 1e6 for the trigonometric functions). The tables built from them are therefore the values
+computed at run time, up to the last bits.
+*/
+
+namespace cx {
+
+namespace detail {
+
+// pi/2 and ln(2) in several parts, the first ones have trailing zeros so k * part is exact
+constexpr double pio2_1 = 1.57079632673412561417e+00;
+constexpr double pio2_2 = 6.07710050630396597660e-11;
+constexpr double pio2_3 = 2.02226624879595063154e-21;
+constexpr double ln2_hi = 6.93147180369123816490e-01;
+constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+constexpr double round(double x) {
+    return double(int64_t(x < 0.0 ? x - 0.5 : x + 0.5));
+}
+
+// Series on [-pi/4, pi/4], evaluated from the smallest terms
+constexpr double sin_kernel(double r) {
+    double r2 = r * r;
+    double sum = 0.0;
+    for (int n = 11; n >= 1; --n) {
+        sum = (1.0 - sum) * r2 / double((2*n) * (2*n + 1));
+    }
+    return r - r * sum;
+}
+
+constexpr double cos_kernel(double r) {
+    double r2 = r * r;
+    double sum = 0.0;
+    for (int n = 11; n >= 1; --n) {
+        sum = (1.0 - sum) * r2 / double((2*n - 1) * (2*n));
+    }
+    return 1.0 - sum;
+}
+
+/// @brief Reduce an angle to [-pi/4, pi/4]
+/// @param x The angle
+/// @param quadrant The number of pi/2 removed, modulo 4
+/// @return The reduced angle
+constexpr double reduce(double x, int& quadrant) {
+    double k = round(x * (2.0 / 3.14159265358979323846));
+    quadrant = int(int64_t(k) & 3);
+    return ((x - k * pio2_1) - k * pio2_2) - k * pio2_3;
+}
+
+constexpr double sin(double x) {
+    int quadrant = 0;
+    double r = reduce(x, quadrant);
+    switch (quadrant) {
+        case 0: return sin_kernel(r);
+        case 1: return cos_kernel(r);
+        case 2: return -sin_kernel(r);
+        default: return -cos_kernel(r);
+    }
+}
+
+constexpr double cos(double x) {
+    int quadrant = 0;
+    double r = reduce(x, quadrant);
+    switch (quadrant) {
+        case 0: return cos_kernel(r);
+        case 1: return -sin_kernel(r);
+        case 2: return -cos_kernel(r);
+        default: return sin_kernel(r);
+    }
+}
+
+constexpr double sqrt(double x) {
+    if (x != x || x < 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (x == 0.0 || x == std::numeric_limits<double>::infinity()) {
+        return x;
+    }
+
+    // x = m * 4^e with m in [1, 4), the scaling by powers of 2 is exact
+    double m = x;
+    double scale = 1.0;
+    while (m >= 4.0) {
+        m *= 0.25;
+        scale *= 2.0;
+    }
+    while (m < 1.0) {
+        m *= 4.0;
+        scale *= 0.5;
+    }
+
+    double y = 1.5;
+    for (int i = 0; i < 6; ++i) {
+        y = 0.5 * (y + m / y);
+    }
+    return y * scale;
+}
+
+constexpr double exp(double x) {
+    if (x != x) {
+        return x;
+    }
+    if (x > 709.8) {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (x < -745.2) {
+        return 0.0;
+    }
+
+    // x = k ln(2) + r with |r| <= ln(2)/2
+    double k = round(x * 1.44269504088896340736);
+    double r = (x - k * ln2_hi) - k * ln2_lo;
+    double sum = 0.0;
+    for (int n = 18; n >= 1; --n) {
+        sum = r / double(n) * (1.0 + sum);
+    }
+    sum += 1.0;
+
+    for (int64_t i = 0; i < int64_t(k); ++i) {
+        sum *= 2.0;
+    }
+    for (int64_t i = 0; i > int64_t(k); --i) {
+        sum *= 0.5;
+    }
+    return sum;
+}
+
+}
+
+/// @brief Absolute value
+/// @param x The value
+/// @return The absolute value of x
+template<typename T>
+constexpr T abs(T x) {
+    return x < T(0) ? -x : x;
+}
+
+/// @brief Square root, std::sqrt at run time
+/// @param x The value
+/// @return The square root of x
+template<typename T>
+constexpr T sqrt(T x) {
+    if constexpr (std::is_class_v<T>) {
+        // The scalar classes give their own square root, found by argument-dependent lookup
+        return sqrt(x);
+    } else {
+        if (std::is_constant_evaluated()) {
+            return T(detail::sqrt(double(x)));
+        }
+        return std::sqrt(x);
+    }
+}
+
+/// @brief Sine, std::sin at run time
+/// @param x The angle in radian
+/// @return The sine of x
+template<typename T>
+constexpr T sin(T x) {
+    if (std::is_constant_evaluated()) {
+        return T(detail::sin(double(x)));
+    }
+    return std::sin(x);
+}
+
+/// @brief Cosine, std::cos at run time
+/// @param x The angle in radian
+/// @return The cosine of x
+template<typename T>
+constexpr T cos(T x) {
+    if (std::is_constant_evaluated()) {
+        return T(detail::cos(double(x)));
+    }
+    return std::cos(x);
+}
+
+/// @brief Tangent, std::tan at run time
+/// @param x The angle in radian
+/// @return The tangent of x
+template<typename T>
+constexpr T tan(T x) {
+    if (std::is_constant_evaluated()) {
+        return T(detail::sin(double(x)) / detail::cos(double(x)));
+    }
+    return std::tan(x);
+}
+
+/// @brief Exponential, std::exp at run time
+/// @param x The value
+/// @return e to the power of x
+template<typename T>
+constexpr T exp(T x) {
+    if (std::is_constant_evaluated()) {
+        return T(detail::exp(double(x)));
+    }
+    return std::exp(x);
+}
+
+}
+
+}
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <type_traits>
+#include <inttypes.h>
+
+#include "Constexpr.hpp"
+
+namespace mat {
+
+/*
+Double-double: a real number as the unevaluated sum of two doubles, hi + lo with |lo| <= ulp(hi) / 2
+
+It keeps about 106 bits of mantissa (32 decimal digits) with the exponent range of double, for
+about 10 times the cost of double on the hardware with FMA. The operations are built on the
+error-free transformations (two_sum, two_prod): the rounding error of a sum or a product of two
+doubles is itself a double, computed exactly. No branch, no table: loops over double-doubles
+vectorize like loops over doubles.
+
+It is a scalar of mat, Complex<DoubleDouble> and Vector<DoubleDouble,N> work, e.g. for the deep
+zooms of the Mandelbrot set, where the coordinates of neighbour pixels differ below 1e-13.
+
+    mat::Complex<mat::DoubleDouble> z(0.0, 0.0), c(x, y);
+    z = z * z + c;
+*/
+
+namespace dd {
+
+/// @brief Sum of two doubles and its rounding error, a + b = s + e exactly
+constexpr double two_sum(double a, double b, double& e) {
+    double s = a + b;
+    double bb = s - a;
+    e = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+/// @brief Sum of two doubles with |a| >= |b| and its rounding error, a + b = s + e exactly
+constexpr double quick_two_sum(double a, double b, double& e) {
+    double s = a + b;
+    e = b - (s - a);
+    return s;
+}
+
+/// @brief Split a double in two halves of 26 bits, a = hi + lo exactly (Dekker)
+constexpr void split(double a, double& hi, double& lo) {
+    double t = 134217729.0 * a;     // 2^27 + 1
+    hi = t - (t - a);
+    lo = a - hi;
+}
+
+/// @brief Product of two doubles and its rounding error, a * b = p + e exactly
+constexpr double two_prod(double a, double b, double& e) {
+    double p = a * b;
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+    if (!std::is_constant_evaluated()) {
+        e = std::fma(a, b, -p);
+        return p;
+    }
+#endif
+    double a_hi, a_lo, b_hi, b_lo;
+    split(a, a_hi, a_lo);
+    split(b, b_hi, b_lo);
+    e = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+    return p;
+}
+
+}
+
+//    ___           _    _     ___           _    _
+//   |   \ ___ _  _| |__| |___|   \ ___ _  _| |__| |___
+//   | |) / _ \ || | '_ \ / -_) |) / _ \ || | '_ \ / -_)
+//   |___/\___/\_,_|_.__/_\___|___/\___/\_,_|_.__/_\___|
+//
+
+class DoubleDouble {
+public:
+    /// @brief Default constructor, the value 0
+    constexpr DoubleDouble() : m_hi(0.0), m_lo(0.0) {}
+
+    /// @brief Constructor from a double, exact
+    /// @param a The value
+    constexpr DoubleDouble(double a) : m_hi(a), m_lo(0.0) {}
+
+    /// @brief Constructor from the two parts
+    /// @param hi The leading part
+    /// @param lo The trailing part, |lo| <= ulp(hi) / 2
+    constexpr DoubleDouble(double hi, double lo) : m_hi(hi), m_lo(lo) {}
+
+    /// @brief Get the leading part
+    /// @return The leading part, the value rounded to a double
+    constexpr double hi() const { return m_hi; }
+
+    /// @brief Get the trailing part
+    /// @return The trailing part
+    constexpr double lo() const { return m_lo; }
+
+    /// @brief Round to a double
+    constexpr explicit operator double() const { return m_hi; }
+
+    /// @brief Round to a float
+    constexpr explicit operator float() const { return float(m_hi); }
+
+    constexpr DoubleDouble operator-() const { return DoubleDouble(-m_hi, -m_lo); }
+
+    constexpr DoubleDouble& operator+=(const DoubleDouble& b) {
+        // Both parts summed with their errors, the "IEEE" addition of the QD library
+        double t1, t2;
+        double s1 = dd::two_sum(m_hi, b.m_hi, t1);
+        double s2 = dd::two_sum(m_lo, b.m_lo, t2);
+        t1 += s2;
+        s1 = dd::quick_two_sum(s1, t1, t1);
+        t1 += t2;
+        m_hi = dd::quick_two_sum(s1, t1, m_lo);
+        return *this;
+    }
+
+    constexpr DoubleDouble& operator+=(double b) {
+        double e;
+        double s = dd::two_sum(m_hi, b, e);
+        e += m_lo;
+        m_hi = dd::quick_two_sum(s, e, m_lo);
+        return *this;
+    }
+
+    constexpr DoubleDouble& operator-=(const DoubleDouble& b) { return *this += -b; }
+
+    constexpr DoubleDouble& operator-=(double b) { return *this += -b; }
+
+    constexpr DoubleDouble& operator*=(const DoubleDouble& b) {
+        double e;
+        double p = dd::two_prod(m_hi, b.m_hi, e);
+        e += m_hi * b.m_lo + m_lo * b.m_hi;
+        m_hi = dd::quick_two_sum(p, e, m_lo);
+        return *this;
+    }
+
+    constexpr DoubleDouble& operator*=(double b) {
+        double e;
+        double p = dd::two_prod(m_hi, b, e);
+        e += m_lo * b;
+        m_hi = dd::quick_two_sum(p, e, m_lo);
+        return *this;
+    }
+
+    constexpr DoubleDouble& operator/=(const DoubleDouble& b) {
+        // Long division, three quotients of double precision
+        double q1 = m_hi / b.m_hi;
+        DoubleDouble r = *this - b * q1;
+        double q2 = r.m_hi / b.m_hi;
+        r -= b * q2;
+        double q3 = r.m_hi / b.m_hi;
+        double e;
+        q1 = dd::quick_two_sum(q1, q2, e);
+        *this = DoubleDouble(q1, e) + q3;
+        return *this;
+    }
+
+    constexpr DoubleDouble& operator/=(double b) { return *this /= DoubleDouble(b); }
+
+    friend constexpr DoubleDouble operator+(DoubleDouble a, const DoubleDouble& b) { return a += b; }
+    friend constexpr DoubleDouble operator+(DoubleDouble a, double b) { return a += b; }
+    friend constexpr DoubleDouble operator+(double a, DoubleDouble b) { return b += a; }
+    friend constexpr DoubleDouble operator-(DoubleDouble a, const DoubleDouble& b) { return a -= b; }
+    friend constexpr DoubleDouble operator-(DoubleDouble a, double b) { return a -= b; }
+    friend constexpr DoubleDouble operator-(double a, const DoubleDouble& b) { return -b + a; }
+    friend constexpr DoubleDouble operator*(DoubleDouble a, const DoubleDouble& b) { return a *= b; }
+    friend constexpr DoubleDouble operator*(DoubleDouble a, double b) { return a *= b; }
+    friend constexpr DoubleDouble operator*(double a, DoubleDouble b) { return b *= a; }
+    friend constexpr DoubleDouble operator/(DoubleDouble a, const DoubleDouble& b) { return a /= b; }
+    friend constexpr DoubleDouble operator/(DoubleDouble a, double b) { return a /= b; }
+    friend constexpr DoubleDouble operator/(double a, const DoubleDouble& b) { return DoubleDouble(a) /= b; }
+
+    friend constexpr bool operator==(const DoubleDouble& a, const DoubleDouble& b) { return a.m_hi == b.m_hi && a.m_lo == b.m_lo; }
+    friend constexpr bool operator!=(const DoubleDouble& a, const DoubleDouble& b) { return !(a == b); }
+    friend constexpr bool operator<(const DoubleDouble& a, const DoubleDouble& b) { return a.m_hi < b.m_hi || (a.m_hi == b.m_hi && a.m_lo < b.m_lo); }
+    friend constexpr bool operator>(const DoubleDouble& a, const DoubleDouble& b) { return b < a; }
+    friend constexpr bool operator<=(const DoubleDouble& a, const DoubleDouble& b) { return !(b < a); }
+    friend constexpr bool operator>=(const DoubleDouble& a, const DoubleDouble& b) { return !(a < b); }
+
+    // Found by argument-dependent lookup only, so they do not hide the functions of <cmath> in mat
+
+    /// @brief Square of a double-double, cheaper than a product
+    /// @param a The value
+    /// @return a * a
+    friend constexpr DoubleDouble sqr(const DoubleDouble& a) {
+        double e;
+        double p = dd::two_prod(a.m_hi, a.m_hi, e);
+        e += 2.0 * a.m_hi * a.m_lo;
+        double lo;
+        double hi = dd::quick_two_sum(p, e, lo);
+        return DoubleDouble(hi, lo);
+    }
+
+    /// @brief Absolute value
+    /// @param a The value
+    /// @return |a|
+    friend constexpr DoubleDouble abs(const DoubleDouble& a) {
+        return a.m_hi < 0.0 ? -a : a;
+    }
+
+    /// @brief Square root, one Newton step from the square root of the leading part
+    /// @param a The value, positive
+    /// @return The square root of a
+    friend constexpr DoubleDouble sqrt(const DoubleDouble& a) {
+        if (a.m_hi <= 0.0) {
+            return DoubleDouble(cx::sqrt(a.m_hi));
+        }
+        double x = 1.0 / cx::sqrt(a.m_hi);
+        double ax = a.m_hi * x;
+        return DoubleDouble(ax) + (a - sqr(DoubleDouble(ax))).m_hi * (x * 0.5);
+    }
+
+    /// @brief Round down to an integer
+    /// @param a The value
+    /// @return The largest integer not greater than a
+    friend DoubleDouble floor(const DoubleDouble& a) {
+        double hi = std::floor(a.m_hi);
+        if (hi != a.m_hi) {
+            return DoubleDouble(hi);
+        }
+        double lo;
+        hi = dd::quick_two_sum(hi, std::floor(a.m_lo), lo);
+        return DoubleDouble(hi, lo);
+    }
+
+private:
+    double m_hi;
+    double m_lo;
+};
+
+/// @brief Decimal writing of a double-double, in scientific notation
+/// @param a The value
+/// @param digits The number of significant digits, up to 32
+/// @return The string, e.g. -7.4364388703715870475219150611477e-01
+inline std::string to_string(const DoubleDouble& a, uint32_t digits = 32) {
+    if (a.hi() == 0.0 || !std::isfinite(a.hi())) {
+        return std::to_string(a.hi());
+    }
+    std::string result = a.hi() < 0.0 ? "-" : "";
+    DoubleDouble r = abs(a);
+
+    // r = m 10^e with m in [1, 10), the powers of 10 in double-double
+    int32_t e = int32_t(std::floor(std::log10(r.hi())));
+    DoubleDouble power(1.0);
+    for (int32_t i = 0; i < std::abs(e); ++i) {
+        power *= 10.0;
+    }
+    r = e >= 0 ? r / power : r * power;
+    if (r.hi() >= 10.0) {
+        r /= 10.0;
+        ++e;
+    } else if (r.hi() < 1.0) {
+        r *= 10.0;
+        --e;
+    }
+
+    for (uint32_t i = 0; i < digits; ++i) {
+        int32_t digit = std::min(std::max(int32_t(floor(r).hi()), 0), 9);
+        result += char('0' + digit);
+        if (i == 0) {
+            result += '.';
+        }
+        r = (r - double(digit)) * 10.0;
+    }
+    std::string exponent = std::to_string(std::abs(e));
+    return result + (e < 0 ? "e-" : "e+") + (exponent.size() < 2 ? "0" : "") + exponent;
+}
+
+/// @brief Stream operator, write the value with all its digits
+inline std::ostream& operator<<(std::ostream& stream, const DoubleDouble& a) {
+    return stream << to_string(a);
+}
+
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include <inttypes.h>
+
+#include "BaseVector.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+namespace mat {
+
+/*
+Expression templates: element-wise operations evaluated in one loop, without temporary vectors
+
+The operators of Vector and Matrix return a new object at each step, p + a * (b - c) creates three
+vectors. In the namespace lazy, an operation returns a node that records its operands, the whole
+expression is computed element by element when it is converted to a Vector or a Matrix.
+
+It is opt-in: lazy::ref(v) wraps a vector or a matrix, then the operators of Vector, Matrix and
+scalars on this expression give expressions.
+
+    mat::Vec2f pos = parent_pos + anchor * (mat::lazy::ref(parent_cell) - dimension);
+    position += mat::lazy::ref(velocity) * dt;
+
+The nodes keep references to the vectors: an expression must be evaluated in the statement that
+builds it, never stored with auto.
+*/
+
+namespace lazy {
+
+/// @brief Base of the expressions, E gives the element i with operator[]
+/// @tparam E Type of the expression
+template<typename E>
+struct Expression {
+    /// @brief Get the expression
+    /// @return The expression as its type
+    constexpr const E& self() const { return static_cast<const E&>(*this); }
+
+    /// @brief Evaluate the expression in a vector
+    template<typename T, uint32_t N>
+    constexpr operator Vector<T,N>() const {
+        static_assert(E::size == N, "Error : the expression and the vector have different sizes");
+        return Vector<T,N>(evaluate<T>(std::make_integer_sequence<uint32_t, N>()));
+    }
+
+    /// @brief Evaluate the expression in a matrix
+    template<typename T, uint32_t N, uint32_t M>
+    constexpr operator Matrix<T,N,M>() const {
+        static_assert(E::size == N*M, "Error : the expression and the matrix have different sizes");
+        return Matrix<T,N,M>(evaluate<T>(std::make_integer_sequence<uint32_t, N*M>()));
+    }
+
+    /// @brief Compute all the elements, unrolled so the compiler can vectorize the whole expression
+    /// @return The elements
+    template<typename T, uint32_t... I>
+    constexpr std::array<T, sizeof...(I)> evaluate(std::integer_sequence<uint32_t, I...>) const {
+        return std::array<T, sizeof...(I)>{T(self()[I])...};
+    }
+};
+
+/// @brief Leaf: the components of a vector or a matrix
+template<typename T, uint32_t N>
+struct Ref : Expression<Ref<T,N>> {
+    typedef T value_type;
+    static constexpr uint32_t size = N;
+
+    const T* data;
+
+    constexpr Ref(const T* data_) : data(data_) {}
+    constexpr T operator[](uint32_t i) const { return data[i]; }
+};
+
+/// @brief Leaf: a scalar, the same for all the elements
+template<typename T>
+struct Scalar : Expression<Scalar<T>> {
+    typedef T value_type;
+    static constexpr uint32_t size = 0;
+
+    T value;
+
+    constexpr Scalar(T value_) : value(value_) {}
+    constexpr T operator[](uint32_t) const { return value; }
+};
+
+/// @brief Node: an element-wise operation of two expressions
+template<typename Op, typename L, typename R>
+struct Binary : Expression<Binary<Op,L,R>> {
+    typedef typename L::value_type value_type;
+    static constexpr uint32_t size = L::size ? L::size : R::size;
+    static_assert(L::size == R::size || L::size == 0 || R::size == 0, "Error : the operands have different sizes");
+
+    L left;
+    R right;
+
+    constexpr Binary(const L& left_, const R& right_) : left(left_), right(right_) {}
+    constexpr value_type operator[](uint32_t i) const { return Op()(left[i], right[i]); }
+};
+
+/// @brief Node: the opposite of an expression
+template<typename E>
+struct Negate : Expression<Negate<E>> {
+    typedef typename E::value_type value_type;
+    static constexpr uint32_t size = E::size;
+
+    E inner;
+
+    constexpr Negate(const E& inner_) : inner(inner_) {}
+    constexpr value_type operator[](uint32_t i) const { return -inner[i]; }
+};
+
+/// @brief Start an expression from a vector
+/// @param v The vector, it must outlive the evaluation of the expression
+/// @return The expression
+template<typename T, uint32_t N>
+constexpr Ref<T,N> ref(const BaseVector<T,N>& v) {
+    return Ref<T,N>(v.begin());
+}
+
+/// @brief Start an expression from a matrix
+/// @param m The matrix, it must outlive the evaluation of the expression
+/// @return The expression
+template<typename T, uint32_t N, uint32_t M>
+constexpr Ref<T,N*M> ref(const Matrix<T,N,M>& m) {
+    return Ref<T,N*M>(m.begin());
+}
+
+// Operands: the expressions stay as they are, the vectors, matrices and scalars become leaves
+
+template<typename E>
+constexpr const E& operand(const Expression<E>& e) { return e.self(); }
+
+template<typename T, uint32_t N>
+constexpr Ref<T,N> operand(const BaseVector<T,N>& v) { return ref(v); }
+
+template<typename T, uint32_t N, uint32_t M>
+constexpr Ref<T,N*M> operand(const Matrix<T,N,M>& m) { return ref(m); }
+
+template<typename T> requires std::is_arithmetic_v<T>
+constexpr Scalar<T> operand(T a) { return Scalar<T>(a); }
+
+template<typename Op, typename A, typename B>
+constexpr auto make_binary(const A& a, const B& b) {
+    typedef std::decay_t<decltype(operand(a))> L;
+    typedef std::decay_t<decltype(operand(b))> R;
+    return Binary<Op,L,R>(operand(a), operand(b));
+}
+
+// Operators with an expression on at least one side, found by the lookup of the expressions
+
+#define MAT_LAZY_OPERATOR(op, Op)                                                                               \
+template<typename L, typename R>                                                                                \
+constexpr auto operator op(const Expression<L>& a, const Expression<R>& b) { return make_binary<Op>(a, b); }    \
+template<typename L, typename T, uint32_t N>                                                                    \
+constexpr auto operator op(const Expression<L>& a, const Vector<T,N>& b) { return make_binary<Op>(a, b); }      \
+template<typename R, typename T, uint32_t N>                                                                    \
+constexpr auto operator op(const Vector<T,N>& a, const Expression<R>& b) { return make_binary<Op>(a, b); }      \
+template<typename L, typename T, uint32_t N, uint32_t M>                                                        \
+constexpr auto operator op(const Expression<L>& a, const Matrix<T,N,M>& b) { return make_binary<Op>(a, b); }    \
+template<typename R, typename T, uint32_t N, uint32_t M>                                                        \
+constexpr auto operator op(const Matrix<T,N,M>& a, const Expression<R>& b) { return make_binary<Op>(a, b); }    \
+template<typename L>                                                                                            \
+constexpr auto operator op(const Expression<L>& a, typename L::value_type b) { return make_binary<Op>(a, b); }  \
+template<typename R>                                                                                            \
+constexpr auto operator op(typename R::value_type a, const Expression<R>& b) { return make_binary<Op>(a, b); }
+
+MAT_LAZY_OPERATOR(+, std::plus<>)
+MAT_LAZY_OPERATOR(-, std::minus<>)
+MAT_LAZY_OPERATOR(*, std::multiplies<>)
+MAT_LAZY_OPERATOR(/, std::divides<>)
+
+#undef MAT_LAZY_OPERATOR
+
+template<typename E>
+constexpr Negate<E> operator-(const Expression<E>& e) {
+    return Negate<E>(e.self());
+}
+
+// Compound assignments, in one loop and without the temporary of the conversion
+
+#define MAT_LAZY_ASSIGNMENT(op)                                                             \
+template<typename T, uint32_t N, typename E>                                                \
+constexpr Vector<T,N>& operator op(Vector<T,N>& v, const Expression<E>& e) {                \
+    static_assert(E::size == N, "Error : the expression and the vector have different sizes"); \
+    for (uint32_t i(0) ; i < N ; ++i) {                                                     \
+        v[i] op e.self()[i];                                                                \
+    }                                                                                       \
+    return v;                                                                               \
+}                                                                                           \
+template<typename T, uint32_t N, uint32_t M, typename E>                                    \
+constexpr Matrix<T,N,M>& operator op(Matrix<T,N,M>& m, const Expression<E>& e) {            \
+    static_assert(E::size == N*M, "Error : the expression and the matrix have different sizes"); \
+    T* it = m.begin();                                                                      \
+    for (uint32_t i(0) ; i < N*M ; ++i) {                                                   \
+        it[i] op e.self()[i];                                                               \
+    }                                                                                       \
+    return m;                                                                               \
+}
+
+MAT_LAZY_ASSIGNMENT(+=)
+MAT_LAZY_ASSIGNMENT(-=)
+MAT_LAZY_ASSIGNMENT(*=)
+MAT_LAZY_ASSIGNMENT(/=)
+
+#undef MAT_LAZY_ASSIGNMENT
+
+}
+
+}
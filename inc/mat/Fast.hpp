@@ -0,0 +1,442 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <inttypes.h>
+
+#include "Simd.hpp"
+
+namespace mat {
+
+/*
+Fast approximations of the functions of <cmath> for float, opt-in for the hot loops
+
+The functions of <cmath> are exact to the last bit and handle every input, the ones of the namespace
+fast are polynomials without branches on a restricted domain. Each one has a scalar form and a batch
+form over arrays, which processes four elements per iteration with SIMD and the remaining ones with
+the scalar form. The maximum errors, measured by test/Fast.cpp against the double functions:
+
+    function    domain                      max error
+    sin, cos    |x| <= 8192                 2 ulp, 1e-7 absolute for the results below 1e-4
+    sincos      |x| <= 8192                 as sin and cos
+    rsqrt       x normal and > 0            3 ulp
+    exp         -86.5 <= x <= 88.7          2 ulp, clamped outside
+    log         x normal and > 0            2 ulp
+    atan2       finite                      4 ulp, atan2(0, 0) = 0
+
+Outside of the domain the result is unspecified: no NaN or infinity is handled. The batch form may
+differ from the scalar form by the contraction of the products in FMA, both stay within the bounds.
+They are faster with optimizations only (-O2), the batch forms 4 to 20 times faster than <cmath>;
+without, the calls of the small functions cost more than the polynomials.
+
+A loop over <cmath> and its batch form, for angles of |x| <= 8192:
+
+    for (size_t i = 0; i < count; ++i) {
+        dir_x[i] = std::cos(angle[i]);
+        dir_y[i] = std::sin(angle[i]);
+    }
+    mat::fast::sincos(angle, dir_y, dir_x, count);
+*/
+
+namespace fast {
+
+namespace detail {
+
+// Adding 1.5 * 2^23 rounds to an integer (|x| < 2^22), its value is in the low bits of the sum
+constexpr float round_shift = 12582912.0f;
+constexpr uint32_t round_shift_bits = 0x4b400000u;
+constexpr uint32_t sign_bit = 0x80000000u;
+
+// pi/2 in three parts, the first ones have trailing zeros so k * part is exact for |k| < 2^14
+constexpr float two_over_pi = 0.636619772367581343f;
+constexpr float pio2_1 = 1.5703125f;
+constexpr float pio2_2 = 4.837512969970703125e-4f;
+constexpr float pio2_3 = 7.54978995489188216e-8f;
+
+// Minimax polynomials of sin and cos on [-pi/4, pi/4] (Cephes)
+constexpr float sin_1 = -1.6666654611e-1f;
+constexpr float sin_2 = 8.3321608736e-3f;
+constexpr float sin_3 = -1.9515295891e-4f;
+constexpr float cos_1 = 4.166664568298827e-2f;
+constexpr float cos_2 = -1.388731625493765e-3f;
+constexpr float cos_3 = 2.443315711809948e-5f;
+
+// exp(r) = 1 + r + r^2 P(r) on [-ln(2)/2, ln(2)/2], ln(2) in two parts
+constexpr float log2e = 1.44269504088896341f;
+constexpr float ln2_hi = 0.693359375f;
+constexpr float ln2_lo = -2.12194440e-4f;
+constexpr float exp_min = -86.5f;
+constexpr float exp_max = 88.7f;
+constexpr float exp_0 = 1.9875691500e-4f;
+constexpr float exp_1 = 1.3981999507e-3f;
+constexpr float exp_2 = 8.3334519073e-3f;
+constexpr float exp_3 = 4.1665795894e-2f;
+constexpr float exp_4 = 1.6666665459e-1f;
+constexpr float exp_5 = 5.0000001201e-1f;
+
+// log(1 + m) = m - m^2/2 + m^3 P(m) on [sqrt(1/2) - 1, sqrt(2) - 1]
+constexpr float sqrt_half = 0.707106781186547524f;
+constexpr float log_0 = 7.0376836292e-2f;
+constexpr float log_1 = -1.1514610310e-1f;
+constexpr float log_2 = 1.1676998740e-1f;
+constexpr float log_3 = -1.2420140846e-1f;
+constexpr float log_4 = 1.4249322787e-1f;
+constexpr float log_5 = -1.6668057665e-1f;
+constexpr float log_6 = 2.0000714765e-1f;
+constexpr float log_7 = -2.4999993993e-1f;
+constexpr float log_8 = 3.3333331174e-1f;
+
+// atan(t) = t + t^3 P(t^2) on [-tan(pi/8), tan(pi/8)]
+constexpr float tan_pi_8 = 0.414213562373095049f;
+constexpr float pi = 3.14159265358979323846f;
+constexpr float pi_2 = 1.57079632679489661923f;
+constexpr float pi_4 = 0.78539816339744830962f;
+constexpr float atan_0 = 8.05374449538e-2f;
+constexpr float atan_1 = -1.38776856032e-1f;
+constexpr float atan_2 = 1.99777106478e-1f;
+constexpr float atan_3 = -3.33329491539e-1f;
+
+constexpr uint32_t rsqrt_magic = 0x5f375a86u;
+
+inline uint32_t bits(float x) { return std::bit_cast<uint32_t>(x); }
+inline float from_bits(uint32_t b) { return std::bit_cast<float>(b); }
+
+}
+
+/// @brief Sine and cosine of the same angle, for the price of one
+/// @param x The angle in radian, |x| <= 8192
+/// @param s The sine, within 2 ulp
+/// @param c The cosine, within 2 ulp
+inline void sincos(float x, float& s, float& c) {
+    using namespace detail;
+    // x = k pi/2 + r, the quadrant k modulo 4 is in the low bits of the rounding sum
+    float shifted = x * two_over_pi + round_shift;
+    uint32_t quadrant = bits(shifted);
+    float k = shifted - round_shift;
+    float r = ((x - k * pio2_1) - k * pio2_2) - k * pio2_3;
+
+    float r2 = r * r;
+    float sin_r = r + r * r2 * (sin_1 + r2 * (sin_2 + r2 * sin_3));
+    float cos_r = 1.0f - 0.5f * r2 + r2 * r2 * (cos_1 + r2 * (cos_2 + r2 * cos_3));
+
+    // The odd quadrants swap sine and cosine, the sine is negative in 2 and 3, the cosine in 1 and 2
+    bool swap = quadrant & 1u;
+    s = from_bits(bits(swap ? cos_r : sin_r) ^ ((quadrant & 2u) << 30));
+    c = from_bits(bits(swap ? sin_r : cos_r) ^ (((quadrant + 1u) & 2u) << 30));
+}
+
+/// @brief Sine
+/// @param x The angle in radian, |x| <= 8192
+/// @return The sine of x, within 2 ulp
+inline float sin(float x) {
+    float s, c;
+    sincos(x, s, c);
+    return s;
+}
+
+/// @brief Cosine
+/// @param x The angle in radian, |x| <= 8192
+/// @return The cosine of x, within 2 ulp
+inline float cos(float x) {
+    float s, c;
+    sincos(x, s, c);
+    return c;
+}
+
+/// @brief Inverse of the square root, an estimation from the bits refined by Newton's method
+/// @param x The value, normal and positive
+/// @return 1 / sqrt(x), within 3 ulp
+inline float rsqrt(float x) {
+    using namespace detail;
+    float y = from_bits(rsqrt_magic - (bits(x) >> 1));
+    float half = 0.5f * x;
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return y;
+}
+
+/// @brief Exponential
+/// @param x The value, clamped to [-86.5, 88.7]
+/// @return e to the power of x, within 2 ulp
+inline float exp(float x) {
+    using namespace detail;
+    x = x < exp_min ? exp_min : x;
+    x = x > exp_max ? exp_max : x;
+    // x = k ln(2) + r, 2^k from the bits of k, built as 2 * 2^(k-1) so k = 128 stays finite
+    float shifted = x * log2e + round_shift;
+    float k = shifted - round_shift;
+    float r = (x - k * ln2_hi) - k * ln2_lo;
+    float p = (((((exp_0 * r + exp_1) * r + exp_2) * r + exp_3) * r + exp_4) * r + exp_5);
+    float y = p * r * r + r + 1.0f;
+    float scale = from_bits((bits(shifted) - round_shift_bits + 126u) << 23);
+    return (y + y) * scale;
+}
+
+/// @brief Natural logarithm
+/// @param x The value, normal and positive
+/// @return The logarithm of x, within 2 ulp
+inline float log(float x) {
+    using namespace detail;
+    // x = 2^e m with m in [1/2, 1), then in [sqrt(1/2), sqrt(2)) minus 1
+    uint32_t b = bits(x);
+    float e = float(int32_t(b >> 23) - 126);
+    float m = from_bits((b & 0x007fffffu) | 0x3f000000u);
+    bool small = m < sqrt_half;
+    e = small ? e - 1.0f : e;
+    m = (small ? m + m : m) - 1.0f;
+
+    float z = m * m;
+    float p = ((((((((log_0 * m + log_1) * m + log_2) * m + log_3) * m + log_4) * m + log_5) * m + log_6) * m + log_7) * m + log_8);
+    float y = m * z * p + e * ln2_lo - 0.5f * z;
+    return m + y + e * ln2_hi;
+}
+
+/// @brief Angle of the point (x, y)
+/// @param y The ordinate
+/// @param x The abscissa
+/// @return The angle in [-pi, pi], within 4 ulp
+inline float atan2(float y, float x) {
+    using namespace detail;
+    float ax = from_bits(bits(x) & ~sign_bit);
+    float ay = from_bits(bits(y) & ~sign_bit);
+    // t = tan of the angle to the nearest axis in [0, 1], reduced to [-tan(pi/8), tan(pi/8)]
+    float den = ax > ay ? ax : ay;
+    den = den > 1e-38f ? den : 1e-38f;
+    float t = (ax < ay ? ax : ay) / den;
+    bool reduce = t > tan_pi_8;
+    float offset = reduce ? pi_4 : 0.0f;
+    t = reduce ? (t - 1.0f) / (t + 1.0f) : t;
+
+    float z = t * t;
+    float r = offset + t + t * z * (((atan_0 * z + atan_1) * z + atan_2) * z + atan_3);
+    r = ax < ay ? pi_2 - r : r;
+    r = bits(x) & sign_bit ? pi - r : r;
+    return from_bits(bits(r) ^ (bits(y) & sign_bit));
+}
+
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+
+namespace detail {
+
+// The scalar functions on four lanes, the same operations in the same order
+
+inline void sincos(simd::f4 x, simd::f4& s, simd::f4& c) {
+    using namespace simd;
+    f4 shifted = add(mul(x, splat(two_over_pi)), splat(round_shift));
+    i4 quadrant = as_int(shifted);
+    f4 k = sub(shifted, splat(round_shift));
+    f4 r = sub(sub(sub(x, mul(k, splat(pio2_1))), mul(k, splat(pio2_2))), mul(k, splat(pio2_3)));
+
+    f4 r2 = mul(r, r);
+    f4 sin_r = add(r, mul(mul(r, r2), add(splat(sin_1), mul(r2, add(splat(sin_2), mul(r2, splat(sin_3)))))));
+    f4 cos_r = add(sub(splat(1.0f), mul(splat(0.5f), r2)), mul(mul(r2, r2), add(splat(cos_1), mul(r2, add(splat(cos_2), mul(r2, splat(cos_3)))))));
+
+    i4 one = splat_int(1), two = splat_int(2);
+    f4 swap = as_float(equal_int(and_int(quadrant, one), one));
+    s = bit_xor(select(swap, cos_r, sin_r), as_float(shift_left<30>(and_int(quadrant, two))));
+    c = bit_xor(select(swap, sin_r, cos_r), as_float(shift_left<30>(and_int(add_int(quadrant, one), two))));
+}
+
+inline simd::f4 rsqrt(simd::f4 x) {
+    using namespace simd;
+    f4 y = as_float(sub_int(splat_int(int32_t(rsqrt_magic)), shift_right<1>(as_int(x))));
+    f4 half = mul(splat(0.5f), x);
+    f4 three_half = splat(1.5f);
+    y = mul(y, sub(three_half, mul(mul(half, y), y)));
+    y = mul(y, sub(three_half, mul(mul(half, y), y)));
+    y = mul(y, sub(three_half, mul(mul(half, y), y)));
+    return y;
+}
+
+inline simd::f4 exp(simd::f4 x) {
+    using namespace simd;
+    x = min(max(x, splat(exp_min)), splat(exp_max));
+    f4 shifted = add(mul(x, splat(log2e)), splat(round_shift));
+    f4 k = sub(shifted, splat(round_shift));
+    f4 r = sub(sub(x, mul(k, splat(ln2_hi))), mul(k, splat(ln2_lo)));
+    f4 p = mul(splat(exp_0), r);
+    p = mul(add(p, splat(exp_1)), r);
+    p = mul(add(p, splat(exp_2)), r);
+    p = mul(add(p, splat(exp_3)), r);
+    p = mul(add(p, splat(exp_4)), r);
+    p = add(p, splat(exp_5));
+    f4 y = add(add(mul(mul(p, r), r), r), splat(1.0f));
+    f4 scale = as_float(shift_left<23>(add_int(sub_int(as_int(shifted), splat_int(int32_t(round_shift_bits))), splat_int(126))));
+    return mul(add(y, y), scale);
+}
+
+inline simd::f4 log(simd::f4 x) {
+    using namespace simd;
+    i4 b = as_int(x);
+    f4 e = to_float(sub_int(shift_right<23>(b), splat_int(126)));
+    f4 m = as_float(add_int(and_int(b, splat_int(0x007fffff)), splat_int(0x3f000000)));
+    f4 small = less(m, splat(sqrt_half));
+    f4 one = splat(1.0f);
+    e = sub(e, bit_and(small, one));
+    m = sub(add(m, bit_and(small, m)), one);
+
+    f4 z = mul(m, m);
+    f4 p = mul(splat(log_0), m);
+    p = mul(add(p, splat(log_1)), m);
+    p = mul(add(p, splat(log_2)), m);
+    p = mul(add(p, splat(log_3)), m);
+    p = mul(add(p, splat(log_4)), m);
+    p = mul(add(p, splat(log_5)), m);
+    p = mul(add(p, splat(log_6)), m);
+    p = mul(add(p, splat(log_7)), m);
+    p = add(p, splat(log_8));
+    f4 y = sub(add(mul(mul(m, z), p), mul(e, splat(ln2_lo))), mul(splat(0.5f), z));
+    return add(add(m, y), mul(e, splat(ln2_hi)));
+}
+
+inline simd::f4 atan2(simd::f4 y, simd::f4 x) {
+    using namespace simd;
+    f4 sign = as_float(splat_int(int32_t(sign_bit)));
+    f4 ax = bit_andnot(x, sign);
+    f4 ay = bit_andnot(y, sign);
+    f4 den = max(max(ax, ay), splat(1e-38f));
+    f4 t = div(min(ax, ay), den);
+    f4 reduce = less(splat(tan_pi_8), t);
+    f4 one = splat(1.0f);
+    f4 offset = bit_and(reduce, splat(pi_4));
+    t = select(reduce, div(sub(t, one), add(t, one)), t);
+
+    f4 z = mul(t, t);
+    f4 p = add(mul(add(mul(add(mul(splat(atan_0), z), splat(atan_1)), z), splat(atan_2)), z), splat(atan_3));
+    f4 r = add(add(offset, t), mul(mul(t, z), p));
+    r = select(less(ax, ay), sub(splat(pi_2), r), r);
+    f4 negative_x = as_float(equal_int(as_int(bit_and(x, sign)), as_int(sign)));
+    r = select(negative_x, sub(splat(pi), r), r);
+    return bit_xor(r, bit_and(y, sign));
+}
+
+}
+
+#endif
+
+// Batch forms, out may be the input
+
+/// @brief Sine and cosine of an array of angles
+/// @param x The angles in radian, |x| <= 8192
+/// @param out_sin, out_cos The sines and the cosines
+/// @param count Number of angles
+inline void sincos(const float* x, float* out_sin, float* out_cos, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 s, c;
+        detail::sincos(simd::load(x + i), s, c);
+        simd::store(out_sin + i, s);
+        simd::store(out_cos + i, c);
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        sincos(x[i], out_sin[i], out_cos[i]);
+    }
+}
+
+/// @brief Sine of an array of angles
+/// @param x The angles in radian, |x| <= 8192
+/// @param out The sines
+/// @param count Number of angles
+inline void sin(const float* x, float* out, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 s, c;
+        detail::sincos(simd::load(x + i), s, c);
+        simd::store(out + i, s);
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        out[i] = sin(x[i]);
+    }
+}
+
+/// @brief Cosine of an array of angles
+/// @param x The angles in radian, |x| <= 8192
+/// @param out The cosines
+/// @param count Number of angles
+inline void cos(const float* x, float* out, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::f4 s, c;
+        detail::sincos(simd::load(x + i), s, c);
+        simd::store(out + i, c);
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        out[i] = cos(x[i]);
+    }
+}
+
+/// @brief Inverse of the square roots of an array
+/// @param x The values, normal and positive
+/// @param out The inverses of the square roots
+/// @param count Number of values
+inline void rsqrt(const float* x, float* out, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::store(out + i, detail::rsqrt(simd::load(x + i)));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        out[i] = rsqrt(x[i]);
+    }
+}
+
+/// @brief Exponential of an array
+/// @param x The values, clamped to [-86.5, 88.7]
+/// @param out The exponentials
+/// @param count Number of values
+inline void exp(const float* x, float* out, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::store(out + i, detail::exp(simd::load(x + i)));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        out[i] = exp(x[i]);
+    }
+}
+
+/// @brief Natural logarithm of an array
+/// @param x The values, normal and positive
+/// @param out The logarithms
+/// @param count Number of values
+inline void log(const float* x, float* out, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::store(out + i, detail::log(simd::load(x + i)));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        out[i] = log(x[i]);
+    }
+}
+
+/// @brief Angles of an array of points
+/// @param y The ordinates
+/// @param x The abscissas
+/// @param out The angles in [-pi, pi]
+/// @param count Number of points
+inline void atan2(const float* y, const float* x, float* out, size_t count) {
+    size_t i(0);
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+    for ( ; i + 4 <= count ; i += 4) {
+        simd::store(out + i, detail::atan2(simd::load(y + i), simd::load(x + i)));
+    }
+#endif
+    for ( ; i < count ; ++i) {
+        out[i] = atan2(y[i], x[i]);
+    }
+}
+
+}
+
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "Constexpr.hpp"
+#include "DoubleDouble.hpp"
+#include "BigFixed.hpp"
 #include "Formula.hpp"
 #include "Transform.hpp"
 
@@ -18,6 +21,8 @@
 #include "Quaternion.hpp"
 #include "QuaternionFunction.hpp"
 
+#include "Affine.hpp"
+
 // A macro used to know if the premade typedef have to be used 
 // If 1: Use the typedef
 // Otherwise, does not use them.
@@ -70,6 +75,7 @@ typedef Matrix<double,4,4> Mat4d;
 typedef Complex<int> Comi;
 typedef Complex<float> Comf;
 typedef Complex<double> Comd;
+typedef Complex<DoubleDouble> Comdd;
 
 
 
@@ -79,4 +85,16 @@ typedef Quaternion<double> Quatd;
 
 #endif
 
-}
\ No newline at end of file
+}
+
+// Overloads of the float types, after the generic templates
+#include "Simd.hpp"
+
+// Kernels over arrays of points, SoA and AoS
+#include "Batch.hpp"
+
+// Element-wise expressions evaluated in one loop, opt-in with mat::lazy::ref
+#include "Expression.hpp"
+
+// Approximations of sin, cos, rsqrt, exp, log and atan2 for float, opt-in with mat::fast
+#include "Fast.hpp"
@@ -4,6 +4,7 @@
 
 #include "Matrix.hpp"
 #include "Vector.hpp"
+#include "Constexpr.hpp"
 
 namespace mat {
 
@@ -40,7 +41,7 @@ std::ostream& operator<<(std::ostream& stream, const Matrix<T,N,M>& m) {
 /// @param a The scalar
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator+(Matrix<T,N,M> m1, T a) {
+constexpr Matrix<T,N,M> operator+(Matrix<T,N,M> m1, T a) {
     return m1 += a;
 }
 
@@ -52,7 +53,7 @@ Matrix<T,N,M> operator+(Matrix<T,N,M> m1, T a) {
 /// @param m1 The matrix
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator+(T a, Matrix<T,N,M> m1) {
+constexpr Matrix<T,N,M> operator+(T a, Matrix<T,N,M> m1) {
     return m1 += a;
 }
 
@@ -64,7 +65,7 @@ Matrix<T,N,M> operator+(T a, Matrix<T,N,M> m1) {
 /// @param a The scalar
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator-(Matrix<T,N,M> m1, T a) {
+constexpr Matrix<T,N,M> operator-(Matrix<T,N,M> m1, T a) {
     return m1 -= a;
 }
 
@@ -76,7 +77,7 @@ Matrix<T,N,M> operator-(Matrix<T,N,M> m1, T a) {
 /// @param m1 The matrix
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator-(T a, Matrix<T,N,M> m1) {
+constexpr Matrix<T,N,M> operator-(T a, Matrix<T,N,M> m1) {
     return m1 -= a;
 }
 
@@ -88,7 +89,7 @@ Matrix<T,N,M> operator-(T a, Matrix<T,N,M> m1) {
 /// @param a The scalar
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator*(Matrix<T,N,M> m1, T a) {
+constexpr Matrix<T,N,M> operator*(Matrix<T,N,M> m1, T a) {
     return m1 *= a;
 }
 
@@ -100,7 +101,7 @@ Matrix<T,N,M> operator*(Matrix<T,N,M> m1, T a) {
 /// @param m1 The matrix
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator*(T a, Matrix<T,N,M> m1) {
+constexpr Matrix<T,N,M> operator*(T a, Matrix<T,N,M> m1) {
     return m1 *= a;
 }
 
@@ -112,7 +113,7 @@ Matrix<T,N,M> operator*(T a, Matrix<T,N,M> m1) {
 /// @param a The scalar
 /// @return The new matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator/(Matrix<T,N,M> m1, T a) {
+constexpr Matrix<T,N,M> operator/(Matrix<T,N,M> m1, T a) {
     return m1 /= a;
 }
 
@@ -124,7 +125,7 @@ Matrix<T,N,M> operator/(Matrix<T,N,M> m1, T a) {
 /// @param m2 The second matrix
 /// @return The addition of the matrices
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator+(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
+constexpr Matrix<T,N,M> operator+(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
     return m1 += m2;
 }
 
@@ -136,7 +137,7 @@ Matrix<T,N,M> operator+(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
 /// @param m2 The second matrix
 /// @return The substraction of the matrices
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator-(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
+constexpr Matrix<T,N,M> operator-(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
     return m1 -= m2;
 }
 
@@ -149,7 +150,7 @@ Matrix<T,N,M> operator-(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
 /// @return The multiplication of each element of the matrices
 /// @warning This is not the matrix product. Use dot function for the matrix product
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator*(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
+constexpr Matrix<T,N,M> operator*(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
     return m1 *= m2;
 }
 
@@ -162,7 +163,7 @@ Matrix<T,N,M> operator*(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
 /// @return The division of each element of the matrices
 /// @warning This is not the matrix product. Use dot function for the matrix product
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> operator/(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
+constexpr Matrix<T,N,M> operator/(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
     return m1 /= m2;
 }
 
@@ -173,7 +174,7 @@ Matrix<T,N,M> operator/(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
 //                                      
 
 template<typename T, uint32_t N, uint32_t M>
-T min(const Matrix<T,N,M>& m) {
+constexpr T min(const Matrix<T,N,M>& m) {
     T result = m(0,0);
     for (auto i : m) {
         if (i < result) {
@@ -184,7 +185,7 @@ T min(const Matrix<T,N,M>& m) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> min(Matrix<T,N,M> m, T a) {
+constexpr Matrix<T,N,M> min(Matrix<T,N,M> m, T a) {
     for (auto& i : a) {
         if (a < i) {
             i = a;
@@ -194,7 +195,7 @@ Matrix<T,N,M> min(Matrix<T,N,M> m, T a) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> min(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
+constexpr Matrix<T,N,M> min(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
     for (uint32_t i(0) ; i < N*M ; ++i) {
         if (m2[i] < m1[i]) {
             m1[i] = m2[i];
@@ -204,7 +205,7 @@ Matrix<T,N,M> min(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-T max(const Matrix<T,N,M>& m) {
+constexpr T max(const Matrix<T,N,M>& m) {
     T result = m(0,0);
     for (auto i : m) {
         if (i > result) {
@@ -215,7 +216,7 @@ T max(const Matrix<T,N,M>& m) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> max(Matrix<T,N,M> m, T a) {
+constexpr Matrix<T,N,M> max(Matrix<T,N,M> m, T a) {
     for (auto& i : a) {
         if (a > i) {
             i = a;
@@ -225,7 +226,7 @@ Matrix<T,N,M> max(Matrix<T,N,M> m, T a) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> max(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
+constexpr Matrix<T,N,M> max(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
     for (uint32_t i(0) ; i < N*M ; ++i) {
         if (m2[i] > m1[i]) {
             m1[i] = m2[i];
@@ -235,7 +236,7 @@ Matrix<T,N,M> max(Matrix<T,N,M> m1, const Matrix<T,N,M>& m2) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> abs(Matrix<T,N,M> m) {
+constexpr Matrix<T,N,M> abs(Matrix<T,N,M> m) {
     T zero(0);
     for (auto& i : m) {
         if (i < zero) {
@@ -246,7 +247,7 @@ Matrix<T,N,M> abs(Matrix<T,N,M> m) {
 }
 
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,N,M> sign(Matrix<T,N,M> m) {
+constexpr Matrix<T,N,M> sign(Matrix<T,N,M> m) {
     T zero(0);
     T one(1);
     T mone(-1);
@@ -268,7 +269,7 @@ Matrix<T,N,M> sign(Matrix<T,N,M> m) {
 /// @param v The vector
 /// @return The row matrix
 template<typename T, uint32_t N>
-Matrix<T,1,N> to_row_matrix(const Vector<T,N>& v) {
+constexpr Matrix<T,1,N> to_row_matrix(const Vector<T,N>& v) {
     Matrix<T,1,N> result;
     auto it(v.begin());
     for (auto& i : result) {
@@ -284,7 +285,7 @@ Matrix<T,1,N> to_row_matrix(const Vector<T,N>& v) {
 /// @param v The vector
 /// @return The column matrix
 template<typename T, uint32_t N>
-Matrix<T,N,1> to_column_matrix(const Vector<T,N>& v) {
+constexpr Matrix<T,N,1> to_column_matrix(const Vector<T,N>& v) {
     Matrix<T,N,1> result;
     auto it(v.begin());
     for (auto& i : result) {
@@ -300,7 +301,7 @@ Matrix<T,N,1> to_column_matrix(const Vector<T,N>& v) {
 /// @param m The column matrix
 /// @return The vector
 template<typename T, uint32_t N>
-Vector<T,N> to_vector(const Matrix<T,N,1>& m) {
+constexpr Vector<T,N> to_vector(const Matrix<T,N,1>& m) {
     Vector<T,N> result;
     auto it(m.begin());
     for (auto& i : result) {
@@ -316,7 +317,7 @@ Vector<T,N> to_vector(const Matrix<T,N,1>& m) {
 /// @param m The row matrix
 /// @return The vector
 template<typename T, uint32_t N>
-Vector<T,N> to_vector(const Matrix<T,1,N>& m) {
+constexpr Vector<T,N> to_vector(const Matrix<T,1,N>& m) {
     Vector<T,N> result;
     auto it(m.begin());
     for (auto& i : result) {
@@ -335,7 +336,7 @@ Vector<T,N> to_vector(const Matrix<T,1,N>& m) {
 /// @param m2 The second matrix
 /// @return The result matrix
 template<typename T, uint32_t N, uint32_t M, uint32_t P>
-Matrix<T,N,P> dot(const Matrix<T,N,M>& m1, const Matrix<T,M,P>& m2) {
+constexpr Matrix<T,N,P> dot(const Matrix<T,N,M>& m1, const Matrix<T,M,P>& m2) {
     Matrix<T,N,P> result;
 
     for (uint32_t i(0) ; i < N ; ++i) {
@@ -359,7 +360,7 @@ Matrix<T,N,P> dot(const Matrix<T,N,M>& m1, const Matrix<T,M,P>& m2) {
 /// @param v The vector
 /// @return The result vector
 template<typename T, uint32_t N, uint32_t M>
-BaseVector<T,N> dot(const Matrix<T,N,M>& m, const BaseVector<T,M>& v) {
+constexpr BaseVector<T,N> dot(const Matrix<T,N,M>& m, const BaseVector<T,M>& v) {
     BaseVector<T,N> result;
 
     for (uint32_t i(0) ; i < N ; ++i) {
@@ -381,7 +382,7 @@ BaseVector<T,N> dot(const Matrix<T,N,M>& m, const BaseVector<T,M>& v) {
 /// @param m The matrix
 /// @return The result vector
 template<typename T, uint32_t N, uint32_t M>
-BaseVector<T,M> dot(const BaseVector<T,N>& v, const Matrix<T,N,M>& m) {
+constexpr BaseVector<T,M> dot(const BaseVector<T,N>& v, const Matrix<T,N,M>& m) {
     BaseVector<T,M> result;
 
     for (uint32_t i(0) ; i < M ; ++i) {
@@ -400,7 +401,7 @@ BaseVector<T,M> dot(const BaseVector<T,N>& v, const Matrix<T,N,M>& m) {
 /// @tparam N Row and column of the matrix
 /// @return The identity matrix
 template<typename T, uint32_t N>
-Matrix<T,N,N> identity() {
+constexpr Matrix<T,N,N> identity() {
     Matrix<T,N,N> result;
     for (uint32_t i(0) ; i < N ; ++i) {
         result(i,i) = 1;
@@ -415,7 +416,7 @@ Matrix<T,N,N> identity() {
 /// @param m The matrix
 /// @return The transpose matrix
 template<typename T, uint32_t N, uint32_t M>
-Matrix<T,M,N> transpose(const Matrix<T,N,M>& m) {
+constexpr Matrix<T,M,N> transpose(const Matrix<T,N,M>& m) {
     Matrix<T,M,N> result;
     for (uint32_t i(0) ; i < N ; ++i) {
         for (uint32_t j(0) ; j < M ; ++j) {
@@ -430,7 +431,7 @@ Matrix<T,M,N> transpose(const Matrix<T,N,M>& m) {
 /// @tparam N Row and column of the matrix
 /// @param m The matrix
 template<typename T, uint32_t N>
-void self_transpose(Matrix<T,N,N>& m) {
+constexpr void self_transpose(Matrix<T,N,N>& m) {
     for (uint32_t i(0) ; i < N ; ++i) {
         for (uint32_t j(i+1) ; j < N ; ++j) {
             std::swap(m(i,j), m(j,i));
@@ -448,7 +449,7 @@ void self_transpose(Matrix<T,N,N>& m) {
 /// @param m2 The second matrix
 /// @return The direct sum of the matrices
 template<typename T, uint32_t N, uint32_t M, uint32_t P, uint32_t Q>
-Matrix<T,N+P,M+Q> direct_sum(const Matrix<T,N,M>& m1, const Matrix<T,P,Q>& m2) {
+constexpr Matrix<T,N+P,M+Q> direct_sum(const Matrix<T,N,M>& m1, const Matrix<T,P,Q>& m2) {
     Matrix<T,N+P,M+Q> result;
 
     for (uint32_t i(0) ; i < N ; ++i) {
@@ -476,7 +477,7 @@ Matrix<T,N+P,M+Q> direct_sum(const Matrix<T,N,M>& m1, const Matrix<T,P,Q>& m2) {
 /// @param m2 The second matrix
 /// @return The kronecker product of the matrices
 template<typename T, uint32_t N, uint32_t M, uint32_t P, uint32_t Q>
-Matrix<T,N*P,M*Q> kronecker_product(const Matrix<T,N,M>& m1, const Matrix<T,P,Q>& m2) {
+constexpr Matrix<T,N*P,M*Q> kronecker_product(const Matrix<T,N,M>& m1, const Matrix<T,P,Q>& m2) {
     Matrix<T,N*P,M*Q> result;
 
     for (uint32_t i(0) ; i < N*P ; ++i) {
@@ -537,57 +538,49 @@ T determinant(Matrix<T,N,N> m) {
 /// @return The inverse of the matrix
 /// @warning Does not check if the determinant is non null
 template<typename T, uint32_t N>
-Matrix<T,N,N> inverse(Matrix<T,N,N> m) {
+constexpr Matrix<T,N,N> inverse(Matrix<T,N,N> m) {
     // The matrix result is the augmented part of the matrix m
-    Matrix<T,N,N> result;
-    for (uint32_t i(0) ; i < N ; ++i) {
-        result(i,i) = 1;
-    }
+    Matrix<T,N,N> result = identity<T,N>();
     T temp;
- 
-    // Interchange the row of matrix,
-    // interchanging of row will start from the last row
-    for (uint32_t i(N-1); i > 0; i--) {
- 
-        // Swapping each and every element of the two rows
-        for (uint32_t j(0) ; j < N ; ++j) {
-            std::swap(result(i-1,j), result(i,j));
-            std::swap(m(i-1,j), m(i,j));
-        }
-    }
- 
-    // Replace a row by sum of itself and a
-    // constant multiple of another row of the matrix
+
     for (uint32_t i(0) ; i < N ; i++) {
+
+        // Partial pivoting: the largest element of the column is moved to the diagonal,
+        // the affine transforms have zeros there
+        uint32_t pivot(i);
+        for (uint32_t j(i+1) ; j < N ; j++) {
+            if (cx::abs(m(j,i)) > cx::abs(m(pivot,i))) {
+                pivot = j;
+            }
+        }
+        if (pivot != i) {
+            for (uint32_t k(0) ; k < N ; ++k) {
+                std::swap(m(i,k), m(pivot,k));
+                std::swap(result(i,k), result(pivot,k));
+            }
+        }
+
+        // Replace a row by sum of itself and a
+        // constant multiple of another row of the matrix
         for (uint32_t j(0); j < N; j++) {
- 
             if (j != i) {
                 temp = m(j,i) / m(i,i);
-                for (uint32_t k(0) ; k < 2 * N ; k++) {
-                    
-                    if (k < N){
-                        m(j,k) -= m(i,k) * temp;
-                    }else{
-                        result(j,k-N) -= result(i,k-N) * temp;
-                    }
+                for (uint32_t k(0) ; k < N ; k++) {
+                    m(j,k) -= m(i,k) * temp;
+                    result(j,k) -= result(i,k) * temp;
                 }
             }
         }
     }
- 
-    // Multiply each row by a nonzero integer.
+
     // Divide row element by the diagonal element
     for (uint32_t i(0) ; i < N ; i++) {
         temp = m(i,i);
-        for (uint32_t j(0) ; j < 2 * N ; j++) {
-            if (j < N){
-                m(i,j) = m(i,j) / temp;
-            }else{
-                result(i,j-N) = result(i,j-N) / temp;
-            }
+        for (uint32_t j(0) ; j < N ; j++) {
+            result(i,j) = result(i,j) / temp;
         }
     }
-  
+
     return result;
 }
 
@@ -597,7 +590,7 @@ Matrix<T,N,N> inverse(Matrix<T,N,N> m) {
 /// @param m The matrix
 /// @return The expand matrix
 template<typename T, uint32_t N>
-Matrix<T,N+1,N+1> expand(const Matrix<T,N,N>& m) {
+constexpr Matrix<T,N+1,N+1> expand(const Matrix<T,N,N>& m) {
     Matrix<T,N+1,N+1> result;
     std::array<T,N> tmp;
 
@@ -620,7 +613,7 @@ Matrix<T,N+1,N+1> expand(const Matrix<T,N,N>& m) {
 /// @return The exponential of a matrix
 /// @warning Tolerence must be smaller than 1, max_iteration must be smaller than 33
 template<typename T, uint32_t N>
-Matrix<T,N,N> exp(const Matrix<T,N,N>& m, T tolerence = 1e-3, uint32_t max_iteration = 30) {
+constexpr Matrix<T,N,N> exp(const Matrix<T,N,N>& m, T tolerence = 1e-3, uint32_t max_iteration = 30) {
     T one(1);
     uint32_t fact(1);                       // Factorial
     Matrix<T,N,N> m_pow = identity<T,N>();  // m power k
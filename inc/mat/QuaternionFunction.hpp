@@ -3,6 +3,7 @@
 #include "Quaternion.hpp"
 #include "Vector.hpp"
 #include <cmath>
+#include "Constexpr.hpp"
 
 namespace mat {
 
@@ -29,7 +30,7 @@ std::ostream& operator<<(std::ostream& stream, const Quaternion<T>& q) {
 /// @param a The real
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator+(Quaternion<T> q, T a) {
+constexpr Quaternion<T> operator+(Quaternion<T> q, T a) {
     return q += a;
 }
 
@@ -39,7 +40,7 @@ Quaternion<T> operator+(Quaternion<T> q, T a) {
 /// @param q The quaternion
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator+(T a, Quaternion<T> q) {
+constexpr Quaternion<T> operator+(T a, Quaternion<T> q) {
     return q += a;
 }
 
@@ -49,7 +50,7 @@ Quaternion<T> operator+(T a, Quaternion<T> q) {
 /// @param a The real
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator-(Quaternion<T> q, T a) {
+constexpr Quaternion<T> operator-(Quaternion<T> q, T a) {
     return q -= a;
 }
 
@@ -59,7 +60,7 @@ Quaternion<T> operator-(Quaternion<T> q, T a) {
 /// @param q The quaternion
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator-(T a, Quaternion<T> q) {
+constexpr Quaternion<T> operator-(T a, Quaternion<T> q) {
     return -q += a;
 }
 
@@ -69,7 +70,7 @@ Quaternion<T> operator-(T a, Quaternion<T> q) {
 /// @param a The real
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator*(Quaternion<T> q, T a) {
+constexpr Quaternion<T> operator*(Quaternion<T> q, T a) {
     return q *= a;
 }
 
@@ -79,7 +80,7 @@ Quaternion<T> operator*(Quaternion<T> q, T a) {
 /// @param q The quaternion
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator*(T a, Quaternion<T> q) {
+constexpr Quaternion<T> operator*(T a, Quaternion<T> q) {
     return q *= a;
 }
 
@@ -89,7 +90,7 @@ Quaternion<T> operator*(T a, Quaternion<T> q) {
 /// @param a The real
 /// @return The new quaternion
 template<typename T>
-Quaternion<T> operator/(Quaternion<T> q, T a) {
+constexpr Quaternion<T> operator/(Quaternion<T> q, T a) {
     return q /= a;
 }
 
@@ -99,7 +100,7 @@ Quaternion<T> operator/(Quaternion<T> q, T a) {
 /// @param q2 Second quaternion
 /// @return The addition of the quaternion
 template<typename T>
-Quaternion<T> operator+(Quaternion<T> q1, const Quaternion<T>& q2) {
+constexpr Quaternion<T> operator+(Quaternion<T> q1, const Quaternion<T>& q2) {
     return q1 += q2;
 }
 
@@ -109,7 +110,7 @@ Quaternion<T> operator+(Quaternion<T> q1, const Quaternion<T>& q2) {
 /// @param q2 Second quaternion
 /// @return The substraction of the quaternion
 template<typename T>
-Quaternion<T> operator-(Quaternion<T> q1, const Quaternion<T>& q2) {
+constexpr Quaternion<T> operator-(Quaternion<T> q1, const Quaternion<T>& q2) {
     return q1 -= q2;
 }
 
@@ -119,7 +120,7 @@ Quaternion<T> operator-(Quaternion<T> q1, const Quaternion<T>& q2) {
 /// @param q2 Second quaternion
 /// @return The multiplication of the quaternion
 template<typename T>
-Quaternion<T> operator*(Quaternion<T> q1, const Quaternion<T>& q2) {
+constexpr Quaternion<T> operator*(Quaternion<T> q1, const Quaternion<T>& q2) {
     return q1 *= q2;
 }
 
@@ -128,7 +129,7 @@ Quaternion<T> operator*(Quaternion<T> q1, const Quaternion<T>& q2) {
 /// @param q The quaternion
 /// @return Minus the quaternion (-q)
 template<typename T>
-Quaternion<T> operator-(const Quaternion<T>& q) {
+constexpr Quaternion<T> operator-(const Quaternion<T>& q) {
     return Quaternion<T>(-q.r(), -q.i(), -q.j(), -q.k());
 }
 
@@ -143,7 +144,7 @@ Quaternion<T> operator-(const Quaternion<T>& q) {
 /// @param q The quaternion
 /// @return The rotation matrix (3x3)
 template<typename T>
-Matrix<T,3,3> quat_to_rotation3(const Quaternion<T>& q) {
+constexpr Matrix<T,3,3> quat_to_rotation3(const Quaternion<T>& q) {
     T two(2);
     T one(1);
     return Matrix<T,3,3>{
@@ -154,12 +155,12 @@ Matrix<T,3,3> quat_to_rotation3(const Quaternion<T>& q) {
 }
 
 template<typename T>
-Quaternion<T> quat_from_rotation3(const Matrix<T,3,3>& m)
+constexpr Quaternion<T> quat_from_rotation3(const Matrix<T,3,3>& m)
 {
     T trace = m(0,0) + m(1,1) + m(2,2);
 
     if (trace > T(0)) {
-        T s = sqrt(trace + T(1)) * T(2);
+        T s = cx::sqrt(trace + T(1)) * T(2);
         return Quaternion<T>{
             s * T(0.25),
             (m(2,1) - m(1,2)) / s,
@@ -168,7 +169,7 @@ Quaternion<T> quat_from_rotation3(const Matrix<T,3,3>& m)
         };
     }
     else if (m(0,0) > m(1,1) && m(0,0) > m(2,2)) {
-        T s = sqrt(T(1) + m(0,0) - m(1,1) - m(2,2)) * T(2);
+        T s = cx::sqrt(T(1) + m(0,0) - m(1,1) - m(2,2)) * T(2);
         return Quaternion<T>{
             (m(2,1) - m(1,2)) / s,
             s * T(0.25),
@@ -177,7 +178,7 @@ Quaternion<T> quat_from_rotation3(const Matrix<T,3,3>& m)
         };
     }
     else if (m(1,1) > m(2,2)) {
-        T s = sqrt(T(1) + m(1,1) - m(0,0) - m(2,2)) * T(2);
+        T s = cx::sqrt(T(1) + m(1,1) - m(0,0) - m(2,2)) * T(2);
         return Quaternion<T>{
             (m(0,2) - m(2,0)) / s,
             (m(0,1) + m(1,0)) / s,
@@ -186,7 +187,7 @@ Quaternion<T> quat_from_rotation3(const Matrix<T,3,3>& m)
         };
     }
     else {
-        T s = sqrt(T(1) + m(2,2) - m(0,0) - m(1,1)) * T(2);
+        T s = cx::sqrt(T(1) + m(2,2) - m(0,0) - m(1,1)) * T(2);
         return Quaternion<T>{
             (m(1,0) - m(0,1)) / s,
             (m(0,2) + m(2,0)) / s,
@@ -201,7 +202,7 @@ Quaternion<T> quat_from_rotation3(const Matrix<T,3,3>& m)
 /// @param q The quaternion
 /// @return The rotation matrix (4x4) (last line and column fill with 0 except the diagonal term which is 1)
 template<typename T>
-Matrix<T,4,4> quat_to_rotation4(const Quaternion<T>& q) {
+constexpr Matrix<T,4,4> quat_to_rotation4(const Quaternion<T>& q) {
     T two(2);
     T one(1);
     T zero(0);
@@ -218,7 +219,7 @@ Matrix<T,4,4> quat_to_rotation4(const Quaternion<T>& q) {
 /// @param q The quaternion
 /// @return The vector of rotation
 template<typename T>
-Vector<T,3> quat_to_vec_of_rotation(const Quaternion<T>& q) {
+constexpr Vector<T,3> quat_to_vec_of_rotation(const Quaternion<T>& q) {
     return q.imag();
 }
 
@@ -237,10 +238,10 @@ T quat_to_angle_of_rotation(const Quaternion<T>& q) {
 /// @param vec The vector of rotation
 /// @return The quaternion that represent the rotation
 template<typename T>
-Quaternion<T> quat_from_angle_vec_of_rotation(T angle, Vector<T,3> vec) {
+constexpr Quaternion<T> quat_from_angle_vec_of_rotation(T angle, Vector<T,3> vec) {
     vec.normalize();
-    T C = cos(angle/2);
-    T S = sin(angle/2);
+    T C = cx::cos(angle/2);
+    T S = cx::sin(angle/2);
     return Quaternion<T>{C, S*vec[0], S*vec[1], S*vec[2]};
 }
 
@@ -251,14 +252,14 @@ Quaternion<T> quat_from_angle_vec_of_rotation(T angle, Vector<T,3> vec) {
 /// @param yaw Yaw angle (around z)
 /// @return The quaternion that represent the rotation
 template<typename T>
-Quaternion<T> euler_angle_to_quat(T roll, T pitch, T yaw) {
+constexpr Quaternion<T> euler_angle_to_quat(T roll, T pitch, T yaw) {
     T half(0.5);
-    T cr = cos(roll * half);
-    T sr = sin(roll * half);
-    T cp = cos(pitch * half);
-    T sp = sin(pitch * half);
-    T cy = cos(yaw * half);
-    T sy = sin(yaw * half);
+    T cr = cx::cos(roll * half);
+    T sr = cx::sin(roll * half);
+    T cp = cx::cos(pitch * half);
+    T sp = cx::sin(pitch * half);
+    T cy = cx::cos(yaw * half);
+    T sy = cx::sin(yaw * half);
 
     return Quaternion<T>{
         cr*cp*cy + sr*sp*sy,
@@ -290,7 +291,7 @@ void quat_to_euler_angle(const Quaternion<T>& q, T& roll, T& pitch, T& yaw) {
 /// @param v The vector
 /// @return The rotated vector
 template<typename T>
-Vector<T,3> quat_rotate_vec(const Quaternion<T>& q, const Vector<T,3>& v) {
+constexpr Vector<T,3> quat_rotate_vec(const Quaternion<T>& q, const Vector<T,3>& v) {
     Quaternion<T> vq{0, v[0], v[1], v[2]};
     return (q * vq * conjugate(q)).imag();
 }
@@ -300,7 +301,7 @@ Vector<T,3> quat_rotate_vec(const Quaternion<T>& q, const Vector<T,3>& v) {
 /// @param q The quaternion
 /// @return The conjugated quaternion
 template<typename T>
-Quaternion<T> conjugate(Quaternion<T> q) {
+constexpr Quaternion<T> conjugate(Quaternion<T> q) {
     q.conjugate();
     return q;
 }
@@ -310,7 +311,7 @@ Quaternion<T> conjugate(Quaternion<T> q) {
 /// @param q The quaternion
 /// @return The inversed quaternion
 template<typename T>
-Quaternion<T> inverse(const Quaternion<T>& q) {
+constexpr Quaternion<T> inverse(const Quaternion<T>& q) {
     return conjugate(q) * 1.0/(q.norm2());
 }
 
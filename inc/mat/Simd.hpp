@@ -0,0 +1,454 @@
+#pragma once
+
+#include <inttypes.h>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "VectorFunction.hpp"
+#include "Matrix.hpp"
+#include "MatrixFunction.hpp"
+#include "Quaternion.hpp"
+#include "QuaternionFunction.hpp"
+#include "Affine.hpp"
+
+// A macro used to know if the SIMD overloads of the float types have to be used
+// If 1: Use SSE (AVX when enabled) or NEON when the target has them
+// Otherwise, the generic templates are used for every type.
+// The generic templates stay callable with explicit template arguments, e.g. mat::dot<float,4,4,4>(m1, m2)
+#ifndef MAT_SIMD
+#define MAT_SIMD 1
+#endif
+
+#if MAT_SIMD == 1 && (defined(__SSE__) || defined(_M_X64))
+#define MAT_SIMD_SSE 1
+#include <immintrin.h>
+#elif MAT_SIMD == 1 && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define MAT_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(MAT_SIMD_SSE) || defined(MAT_SIMD_NEON)
+
+namespace mat {
+
+namespace simd {
+
+//    ___     _ _        _
+//   | __|__ _  | | ___ _| |_
+//   | _/ _ \ || |/ -_) '_|  _|
+//   |_|\___/_||_\___|_|  \__|
+//
+
+// Four floats in a register, the kernels below only use these functions
+
+#if defined(MAT_SIMD_SSE)
+
+typedef __m128 f4;
+
+inline f4 load(const float* p) { return _mm_loadu_ps(p); }
+inline void store(float* p, f4 a) { _mm_storeu_ps(p, a); }
+inline f4 set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+inline f4 splat(float a) { return _mm_set1_ps(a); }
+inline f4 add(f4 a, f4 b) { return _mm_add_ps(a, b); }
+inline f4 sub(f4 a, f4 b) { return _mm_sub_ps(a, b); }
+inline f4 mul(f4 a, f4 b) { return _mm_mul_ps(a, b); }
+inline f4 div(f4 a, f4 b) { return _mm_div_ps(a, b); }
+inline float first(f4 a) { return _mm_cvtss_f32(a); }
+
+/// @brief Select (a[X], a[Y], b[Z], b[W])
+template<int X, int Y, int Z, int W>
+inline f4 shuffle(f4 a, f4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+
+inline f4 min(f4 a, f4 b) { return _mm_min_ps(a, b); }
+inline f4 max(f4 a, f4 b) { return _mm_max_ps(a, b); }
+inline f4 less(f4 a, f4 b) { return _mm_cmplt_ps(a, b); }
+inline f4 bit_and(f4 a, f4 b) { return _mm_and_ps(a, b); }
+inline f4 bit_or(f4 a, f4 b) { return _mm_or_ps(a, b); }
+inline f4 bit_xor(f4 a, f4 b) { return _mm_xor_ps(a, b); }
+/// @brief a and not b
+inline f4 bit_andnot(f4 a, f4 b) { return _mm_andnot_ps(b, a); }
+
+// Four 32 bits integers, for the bits of the floats
+
+typedef __m128i i4;
+
+inline i4 as_int(f4 a) { return _mm_castps_si128(a); }
+inline f4 as_float(i4 a) { return _mm_castsi128_ps(a); }
+inline f4 to_float(i4 a) { return _mm_cvtepi32_ps(a); }
+inline i4 splat_int(int32_t a) { return _mm_set1_epi32(a); }
+inline i4 add_int(i4 a, i4 b) { return _mm_add_epi32(a, b); }
+inline i4 sub_int(i4 a, i4 b) { return _mm_sub_epi32(a, b); }
+inline i4 and_int(i4 a, i4 b) { return _mm_and_si128(a, b); }
+inline i4 equal_int(i4 a, i4 b) { return _mm_cmpeq_epi32(a, b); }
+template<int S>
+inline i4 shift_left(i4 a) { return _mm_slli_epi32(a, S); }
+/// @brief Logical shift, the high bits become 0
+template<int S>
+inline i4 shift_right(i4 a) { return _mm_srli_epi32(a, S); }
+
+#else
+
+typedef float32x4_t f4;
+
+inline f4 load(const float* p) { return vld1q_f32(p); }
+inline void store(float* p, f4 a) { vst1q_f32(p, a); }
+inline f4 set(float x, float y, float z, float w) { float v[4] = {x, y, z, w}; return vld1q_f32(v); }
+inline f4 splat(float a) { return vdupq_n_f32(a); }
+inline f4 add(f4 a, f4 b) { return vaddq_f32(a, b); }
+inline f4 sub(f4 a, f4 b) { return vsubq_f32(a, b); }
+inline f4 mul(f4 a, f4 b) { return vmulq_f32(a, b); }
+inline f4 div(f4 a, f4 b) { return vdivq_f32(a, b); }
+inline float first(f4 a) { return vgetq_lane_f32(a, 0); }
+
+/// @brief Select (a[X], a[Y], b[Z], b[W])
+template<int X, int Y, int Z, int W>
+inline f4 shuffle(f4 a, f4 b) { return __builtin_shufflevector(a, b, X, Y, Z + 4, W + 4); }
+
+inline f4 min(f4 a, f4 b) { return vminq_f32(a, b); }
+inline f4 max(f4 a, f4 b) { return vmaxq_f32(a, b); }
+inline f4 less(f4 a, f4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+inline f4 bit_and(f4 a, f4 b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline f4 bit_or(f4 a, f4 b) { return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+inline f4 bit_xor(f4 a, f4 b) { return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+/// @brief a and not b
+inline f4 bit_andnot(f4 a, f4 b) { return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+
+// Four 32 bits integers, for the bits of the floats
+
+typedef int32x4_t i4;
+
+inline i4 as_int(f4 a) { return vreinterpretq_s32_f32(a); }
+inline f4 as_float(i4 a) { return vreinterpretq_f32_s32(a); }
+inline f4 to_float(i4 a) { return vcvtq_f32_s32(a); }
+inline i4 splat_int(int32_t a) { return vdupq_n_s32(a); }
+inline i4 add_int(i4 a, i4 b) { return vaddq_s32(a, b); }
+inline i4 sub_int(i4 a, i4 b) { return vsubq_s32(a, b); }
+inline i4 and_int(i4 a, i4 b) { return vandq_s32(a, b); }
+inline i4 equal_int(i4 a, i4 b) { return vreinterpretq_s32_u32(vceqq_s32(a, b)); }
+template<int S>
+inline i4 shift_left(i4 a) { return vshlq_n_s32(a, S); }
+/// @brief Logical shift, the high bits become 0
+template<int S>
+inline i4 shift_right(i4 a) { return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), S)); }
+
+#endif
+
+/// @brief Lanes of a where the mask is set, of b elsewhere
+inline f4 select(f4 mask, f4 a, f4 b) { return bit_or(bit_and(mask, a), bit_andnot(b, mask)); }
+
+/// @brief Copy a lane to the four lanes
+template<int L>
+inline f4 broadcast(f4 a) { return shuffle<L, L, L, L>(a, a); }
+
+/// @brief Sum of the lanes, (x + y) + (z + w)
+inline float hsum(f4 a) {
+    f4 pairs = add(a, shuffle<1, 0, 3, 2>(a, a));
+    return first(add(pairs, shuffle<2, 2, 2, 2>(pairs, pairs)));
+}
+
+/// @brief Transpose four registers in place
+inline void transpose(f4& r0, f4& r1, f4& r2, f4& r3) {
+    f4 t0 = shuffle<0, 1, 0, 1>(r0, r1);    // r00 r01 r10 r11
+    f4 t1 = shuffle<2, 3, 2, 3>(r0, r1);    // r02 r03 r12 r13
+    f4 t2 = shuffle<0, 1, 0, 1>(r2, r3);    // r20 r21 r30 r31
+    f4 t3 = shuffle<2, 3, 2, 3>(r2, r3);    // r22 r23 r32 r33
+    r0 = shuffle<0, 2, 0, 2>(t0, t2);
+    r1 = shuffle<1, 3, 1, 3>(t0, t2);
+    r2 = shuffle<0, 2, 0, 2>(t1, t3);
+    r3 = shuffle<1, 3, 1, 3>(t1, t3);
+}
+
+// 2x2 matrices stored in a register as (a00, a01, a10, a11)
+
+/// @brief Product a * b
+inline f4 mat2_mul(f4 a, f4 b) {
+    return add(mul(a, shuffle<0, 3, 0, 3>(b, b)), mul(shuffle<1, 0, 3, 2>(a, a), shuffle<2, 1, 2, 1>(b, b)));
+}
+
+/// @brief Product adjugate(a) * b
+inline f4 mat2_adj_mul(f4 a, f4 b) {
+    return sub(mul(shuffle<3, 3, 0, 0>(a, a), b), mul(shuffle<1, 1, 2, 2>(a, a), shuffle<2, 3, 0, 1>(b, b)));
+}
+
+/// @brief Product a * adjugate(b)
+inline f4 mat2_mul_adj(f4 a, f4 b) {
+    return sub(mul(a, shuffle<3, 0, 3, 0>(b, b)), mul(shuffle<1, 0, 3, 2>(a, a), shuffle<2, 1, 2, 1>(b, b)));
+}
+
+/// @brief Cross product of the first three lanes, the last lane is 0
+inline f4 cross3(f4 a, f4 b) {
+    return sub(mul(shuffle<1, 2, 0, 3>(a, a), shuffle<2, 0, 1, 3>(b, b)), mul(shuffle<2, 0, 1, 3>(a, a), shuffle<1, 2, 0, 3>(b, b)));
+}
+
+}
+
+//    ___             _   _
+//   | __|  _ _ _  __| |_(_)___ _ _  ___
+//   | _| || | ' \/ _|  _| / _ \ ' \(_-<
+//   |_| \_,_|_||_\__|\__|_\___/_||_/__/
+//
+
+// Overloads of the generic templates for the float types, preferred by the overload resolution.
+// The products accumulate in the order of the templates, they give the same results without FMA.
+// In constant expressions they call the generic templates.
+
+/// @brief Dot product of two vectors of dimension 4
+/// @param v1 First vector
+/// @param v2 Second vector
+/// @return Result of the dot product, summed as (x + y) + (z + w)
+constexpr float dot(const Vector<float,4>& v1, const Vector<float,4>& v2) {
+    if (std::is_constant_evaluated()) {
+        return dot<float,4>(v1, v2);
+    }
+
+    return simd::hsum(simd::mul(simd::load(v1.begin()), simd::load(v2.begin())));
+}
+
+/// @brief Matrix product of two 4x4 matrices
+/// @param m1 The first matrix
+/// @param m2 The second matrix
+/// @return The result matrix
+constexpr Matrix<float,4,4> dot(const Matrix<float,4,4>& m1, const Matrix<float,4,4>& m2) {
+    if (std::is_constant_evaluated()) {
+        return dot<float,4,4,4>(m1, m2);
+    }
+
+    Matrix<float,4,4> result;
+    const float* a = m1.begin();
+    const float* b = m2.begin();
+    float* r = result.begin();
+
+#if defined(MAT_SIMD_SSE) && defined(__AVX__)
+    // Two result columns per register: column j is the sum of the columns of m1 scaled by m2(k,j)
+    __m256 a0 = _mm256_broadcast_ps((const __m128*)(a + 0));
+    __m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+    __m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+    __m256 a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+    for (uint32_t j(0) ; j < 4 ; j += 2) {
+        __m256 bj = _mm256_loadu_ps(b + 4*j);
+        __m256 c = _mm256_mul_ps(a0, _mm256_shuffle_ps(bj, bj, 0x00));
+        c = _mm256_add_ps(c, _mm256_mul_ps(a1, _mm256_shuffle_ps(bj, bj, 0x55)));
+        c = _mm256_add_ps(c, _mm256_mul_ps(a2, _mm256_shuffle_ps(bj, bj, 0xAA)));
+        c = _mm256_add_ps(c, _mm256_mul_ps(a3, _mm256_shuffle_ps(bj, bj, 0xFF)));
+        _mm256_storeu_ps(r + 4*j, c);
+    }
+#else
+    // Column j is the sum of the columns of m1 scaled by m2(k,j)
+    simd::f4 a0 = simd::load(a + 0);
+    simd::f4 a1 = simd::load(a + 4);
+    simd::f4 a2 = simd::load(a + 8);
+    simd::f4 a3 = simd::load(a + 12);
+    for (uint32_t j(0) ; j < 4 ; ++j) {
+        simd::f4 bj = simd::load(b + 4*j);
+        simd::f4 c = simd::mul(a0, simd::broadcast<0>(bj));
+        c = simd::add(c, simd::mul(a1, simd::broadcast<1>(bj)));
+        c = simd::add(c, simd::mul(a2, simd::broadcast<2>(bj)));
+        c = simd::add(c, simd::mul(a3, simd::broadcast<3>(bj)));
+        simd::store(r + 4*j, c);
+    }
+#endif
+
+    return result;
+}
+
+/// @brief Product of a 4x4 matrix and a vector
+/// @param m The matrix
+/// @param v The vector
+/// @return The result vector
+constexpr BaseVector<float,4> dot(const Matrix<float,4,4>& m, const BaseVector<float,4>& v) {
+    if (std::is_constant_evaluated()) {
+        return dot<float,4,4>(m, v);
+    }
+
+    const float* a = m.begin();
+    simd::f4 x = simd::load(v.begin());
+
+    simd::f4 c = simd::mul(simd::load(a + 0), simd::broadcast<0>(x));
+    c = simd::add(c, simd::mul(simd::load(a + 4), simd::broadcast<1>(x)));
+    c = simd::add(c, simd::mul(simd::load(a + 8), simd::broadcast<2>(x)));
+    c = simd::add(c, simd::mul(simd::load(a + 12), simd::broadcast<3>(x)));
+
+    BaseVector<float,4> result;
+    simd::store(result.begin(), c);
+    return result;
+}
+
+/// @brief Get the transpose of a 4x4 matrix
+/// @param m The matrix
+/// @return The transpose matrix
+constexpr Matrix<float,4,4> transpose(const Matrix<float,4,4>& m) {
+    if (std::is_constant_evaluated()) {
+        return transpose<float,4,4>(m);
+    }
+
+    const float* a = m.begin();
+    simd::f4 c0 = simd::load(a + 0);
+    simd::f4 c1 = simd::load(a + 4);
+    simd::f4 c2 = simd::load(a + 8);
+    simd::f4 c3 = simd::load(a + 12);
+    simd::transpose(c0, c1, c2, c3);
+
+    Matrix<float,4,4> result;
+    float* r = result.begin();
+    simd::store(r + 0, c0);
+    simd::store(r + 4, c1);
+    simd::store(r + 8, c2);
+    simd::store(r + 12, c3);
+    return result;
+}
+
+/// @brief Compute the inverse of a 4x4 matrix by 2x2 blocks (adjugates and determinants, no division but one)
+/// @param m The matrix
+/// @return The inverse of the matrix
+/// @warning Does not check if the determinant is non null
+constexpr Matrix<float,4,4> inverse(const Matrix<float,4,4>& m) {
+    if (std::is_constant_evaluated()) {
+        return inverse<float,4>(m);
+    }
+
+    // Written for rows, applied to the columns: the result is the transpose of the inverse of the transpose
+    const float* p = m.begin();
+    simd::f4 r0 = simd::load(p + 0);
+    simd::f4 r1 = simd::load(p + 4);
+    simd::f4 r2 = simd::load(p + 8);
+    simd::f4 r3 = simd::load(p + 12);
+
+    // Blocks | A B |
+    //        | C D |
+    simd::f4 a = simd::shuffle<0, 1, 0, 1>(r0, r1);
+    simd::f4 b = simd::shuffle<2, 3, 2, 3>(r0, r1);
+    simd::f4 c = simd::shuffle<0, 1, 0, 1>(r2, r3);
+    simd::f4 d = simd::shuffle<2, 3, 2, 3>(r2, r3);
+
+    // Determinants of the blocks (|A|, |B|, |C|, |D|)
+    simd::f4 det_sub = simd::sub(
+        simd::mul(simd::shuffle<0, 2, 0, 2>(r0, r2), simd::shuffle<1, 3, 1, 3>(r1, r3)),
+        simd::mul(simd::shuffle<1, 3, 1, 3>(r0, r2), simd::shuffle<0, 2, 0, 2>(r1, r3))
+    );
+    simd::f4 det_a = simd::broadcast<0>(det_sub);
+    simd::f4 det_b = simd::broadcast<1>(det_sub);
+    simd::f4 det_c = simd::broadcast<2>(det_sub);
+    simd::f4 det_d = simd::broadcast<3>(det_sub);
+
+    simd::f4 d_c = simd::mat2_adj_mul(d, c);
+    simd::f4 a_b = simd::mat2_adj_mul(a, b);
+
+    // Adjugates of the blocks of the inverse, scaled by |M|
+    simd::f4 x = simd::sub(simd::mul(det_d, a), simd::mat2_mul(b, d_c));
+    simd::f4 w = simd::sub(simd::mul(det_a, d), simd::mat2_mul(c, a_b));
+    simd::f4 y = simd::sub(simd::mul(det_b, c), simd::mat2_mul_adj(d, a_b));
+    simd::f4 z = simd::sub(simd::mul(det_c, b), simd::mat2_mul_adj(a, d_c));
+
+    // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+    float trace = simd::hsum(simd::mul(a_b, simd::shuffle<0, 2, 1, 3>(d_c, d_c)));
+    float det = simd::first(det_a) * simd::first(det_d) + simd::first(det_b) * simd::first(det_c) - trace;
+    simd::f4 inv_det = simd::div(simd::set(1.0f, -1.0f, -1.0f, 1.0f), simd::splat(det));
+
+    x = simd::mul(x, inv_det);
+    y = simd::mul(y, inv_det);
+    z = simd::mul(z, inv_det);
+    w = simd::mul(w, inv_det);
+
+    // The adjugate of each block is applied by the shuffles
+    Matrix<float,4,4> result;
+    float* r = result.begin();
+    simd::store(r + 0, simd::shuffle<3, 1, 3, 1>(x, y));
+    simd::store(r + 4, simd::shuffle<2, 0, 2, 0>(x, y));
+    simd::store(r + 8, simd::shuffle<3, 1, 3, 1>(z, w));
+    simd::store(r + 12, simd::shuffle<2, 0, 2, 0>(z, w));
+    return result;
+}
+
+/// @brief Inverse of an affine transform, the 3x3 part by cross products of its columns
+/// @param m The matrix, its last row must be 0 0 0 1
+/// @return The inverse of the matrix
+/// @warning Does not check if the determinant is non null
+constexpr Matrix<float,4,4> inverse_affine(const Matrix<float,4,4>& m) {
+    if (std::is_constant_evaluated()) {
+        return inverse_affine<float>(m);
+    }
+
+    const float* p = m.begin();
+    simd::f4 c0 = simd::load(p + 0);
+    simd::f4 c1 = simd::load(p + 4);
+    simd::f4 c2 = simd::load(p + 8);
+    simd::f4 t = simd::load(p + 12);
+
+    // The rows of the inverse of the 3x3 part are the cross products of its columns over the determinant
+    simd::f4 r0 = simd::cross3(c1, c2);
+    simd::f4 r1 = simd::cross3(c2, c0);
+    simd::f4 r2 = simd::cross3(c0, c1);
+    simd::f4 inv_det = simd::div(simd::splat(1.0f), simd::splat(simd::hsum(simd::mul(c0, r0))));
+    r0 = simd::mul(r0, inv_det);
+    r1 = simd::mul(r1, inv_det);
+    r2 = simd::mul(r2, inv_det);
+    simd::f4 r3 = simd::splat(0.0f);
+    simd::transpose(r0, r1, r2, r3);
+
+    // Translation -R^-1 t, and the last row 0 0 0 1
+    simd::f4 translation = simd::add(simd::add(
+        simd::mul(r0, simd::broadcast<0>(t)), simd::mul(r1, simd::broadcast<1>(t))), simd::mul(r2, simd::broadcast<2>(t)));
+    translation = simd::sub(simd::set(0.0f, 0.0f, 0.0f, 1.0f), translation);
+
+    Matrix<float,4,4> result;
+    float* r = result.begin();
+    simd::store(r + 0, r0);
+    simd::store(r + 4, r1);
+    simd::store(r + 8, r2);
+    simd::store(r + 12, translation);
+    return result;
+}
+
+/// @brief Product of two quaternions
+/// @param q1 The first quaternion
+/// @param q2 The second quaternion
+/// @return The Hamilton product q1 q2
+constexpr Quaternion<float> operator*(const Quaternion<float>& q1, const Quaternion<float>& q2) {
+    if (std::is_constant_evaluated()) {
+        return operator*<float>(q1, q2);
+    }
+
+    simd::f4 a = simd::load(q1.begin());
+    simd::f4 b = simd::load(q2.begin());
+
+    // Each component of q1 scales a signed permutation of q2
+    simd::f4 c = simd::mul(simd::broadcast<0>(a), b);
+    c = simd::add(c, simd::mul(simd::broadcast<1>(a), simd::mul(simd::shuffle<1, 0, 3, 2>(b, b), simd::set(-1.0f, 1.0f, -1.0f, 1.0f))));
+    c = simd::add(c, simd::mul(simd::broadcast<2>(a), simd::mul(simd::shuffle<2, 3, 0, 1>(b, b), simd::set(-1.0f, 1.0f, 1.0f, -1.0f))));
+    c = simd::add(c, simd::mul(simd::broadcast<3>(a), simd::mul(simd::shuffle<3, 2, 1, 0>(b, b), simd::set(-1.0f, -1.0f, 1.0f, 1.0f))));
+
+    Quaternion<float> result;
+    simd::store(result.begin(), c);
+    return result;
+}
+
+/// @brief Rotate a vector using a unit quaternion, as v + w t + u x t with t = 2 u x v (u the imaginary part, w the real part)
+/// @param q The quaternion, of norm 1
+/// @param v The vector
+/// @return The rotated vector
+constexpr Vector<float,3> quat_rotate_vec(const Quaternion<float>& q, const Vector<float,3>& v) {
+    if (std::is_constant_evaluated()) {
+        return quat_rotate_vec<float>(q, v);
+    }
+
+    auto cross = [](simd::f4 a, simd::f4 b) {
+        return simd::sub(simd::mul(simd::shuffle<1, 2, 0, 3>(a, a), simd::shuffle<2, 0, 1, 3>(b, b)),
+                         simd::mul(simd::shuffle<2, 0, 1, 3>(a, a), simd::shuffle<1, 2, 0, 3>(b, b)));
+    };
+
+    simd::f4 r = simd::load(q.begin());
+    simd::f4 u = simd::shuffle<1, 2, 3, 0>(r, r);
+    simd::f4 x = simd::set(v[0], v[1], v[2], 0.0f);
+
+    simd::f4 t = cross(u, x);
+    t = simd::add(t, t);
+    simd::f4 result = simd::add(simd::add(x, simd::mul(simd::broadcast<0>(r), t)), cross(u, t));
+
+    float out[4];
+    simd::store(out, result);
+    return Vector<float,3>({out[0], out[1], out[2]});
+}
+
+}
+
+#endif
@@ -5,17 +5,16 @@
 #include "Matrix.hpp"
 #include "Complex.hpp"
 #include "Quaternion.hpp"
+#include "Constexpr.hpp"
 
 namespace mat {
 
 // 2D Transformations
 
 template<typename T>
-Matrix<T, 2, 2> rotate2(T angle) {
-    T c = cos(angle);
-    T s = sin(angle);
-    T zero(0);
-    T one(1);
+constexpr Matrix<T, 2, 2> rotate2(T angle) {
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return  Matrix<T, 2, 2>{
         c,      s,
         -s,     c
@@ -23,11 +22,9 @@ Matrix<T, 2, 2> rotate2(T angle) {
 }
 
 template<typename T>
-Matrix<T, 2, 2> rotate2(const Complex<T>& c) {
+constexpr Matrix<T, 2, 2> rotate2(const Complex<T>& c) {
     T co = c.real() / c.modulus();
     T si = c.imag() / c.modulus();
-    T zero(0);
-    T one(1);
     return Matrix<T, 2, 2>{
         co,     si,
         -si,    co
@@ -37,11 +34,11 @@ Matrix<T, 2, 2> rotate2(const Complex<T>& c) {
 // 3D Transformations
 
 template<typename T>
-Matrix<T, 3, 3> rotateX(T angle) {
+constexpr Matrix<T, 3, 3> rotateX(T angle) {
     T zero(0);
     T one(1);
-    T c = cos(angle);
-    T s = sin(angle);
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return Matrix<T, 3, 3>{
         one,    zero,   zero,
         zero,   c,      s,
@@ -50,11 +47,11 @@ Matrix<T, 3, 3> rotateX(T angle) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> rotateY(T angle) {
+constexpr Matrix<T, 3, 3> rotateY(T angle) {
     T zero(0);
     T one(1);
-    T c = cos(angle);
-    T s = sin(angle);
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return Matrix<T, 3, 3>{
         c,      zero,   -s,
         zero,   one,     zero,
@@ -63,11 +60,11 @@ Matrix<T, 3, 3> rotateY(T angle) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> rotateZ(T angle) {
+constexpr Matrix<T, 3, 3> rotateZ(T angle) {
     T zero(0);
     T one(1);
-    T c = cos(angle);
-    T s = sin(angle);
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return Matrix<T, 3, 3>{
         c,      s,      zero,
         -s,     c,      zero,
@@ -76,7 +73,7 @@ Matrix<T, 3, 3> rotateZ(T angle) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> rotate3(const Quaternion<T>& q) {
+constexpr Matrix<T, 3, 3> rotate3(const Quaternion<T>& q) {
     T two(2);
     T one(1);
     return Matrix<T, 3, 3>{
@@ -91,7 +88,7 @@ namespace graph {
 // 2D Transformations
 
 template<typename T>
-Matrix<T, 3, 3> translate2(const Vector<T,2>& v) {
+constexpr Matrix<T, 3, 3> translate2(const Vector<T,2>& v) {
     T zero(0);
     T one(1);
     return Matrix<T,3,3>{
@@ -102,9 +99,9 @@ Matrix<T, 3, 3> translate2(const Vector<T,2>& v) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> rotate2(T angle) {
-    T c = cos(angle);
-    T s = sin(angle);
+constexpr Matrix<T, 3, 3> rotate2(T angle) {
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     T zero(0);
     T one(1);
     return  Matrix<T, 3, 3>{
@@ -115,7 +112,7 @@ Matrix<T, 3, 3> rotate2(T angle) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> rotate2(const Complex<T>& c) {
+constexpr Matrix<T, 3, 3> rotate2(const Complex<T>& c) {
     T co = c.real() / c.modulus();
     T si = c.imag() / c.modulus();
     T zero(0);
@@ -128,7 +125,7 @@ Matrix<T, 3, 3> rotate2(const Complex<T>& c) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> scale2(T sx, T sy) {
+constexpr Matrix<T, 3, 3> scale2(T sx, T sy) {
     T zero(0);
     T one(1);
     return Matrix<T,3,3>{
@@ -139,7 +136,7 @@ Matrix<T, 3, 3> scale2(T sx, T sy) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> scale2(T s) {
+constexpr Matrix<T, 3, 3> scale2(T s) {
     T zero(0);
     T one(1);
     return Matrix<T,3,3>{
@@ -150,7 +147,7 @@ Matrix<T, 3, 3> scale2(T s) {
 }
 
 template<typename T>
-Matrix<T, 3, 3> orthographic2(T left, T right, T bottom, T top) {
+constexpr Matrix<T, 3, 3> orthographic2(T left, T right, T bottom, T top) {
     T zero(0);
     T one(1);
     T two(2);
@@ -165,7 +162,7 @@ Matrix<T, 3, 3> orthographic2(T left, T right, T bottom, T top) {
 // 3D Transformations
 
 template<typename T>
-Matrix<T, 4, 4> translate3(const Vector<T,3>& vect) {
+constexpr Matrix<T, 4, 4> translate3(const Vector<T,3>& vect) {
     T zero(0);
     T one(1);
     return Matrix<T,4,4>{
@@ -177,11 +174,11 @@ Matrix<T, 4, 4> translate3(const Vector<T,3>& vect) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> rotateX(T angle) {
+constexpr Matrix<T, 4, 4> rotateX(T angle) {
     T zero(0);
     T one(1);
-    T c = cos(angle);
-    T s = sin(angle);
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return Matrix<T,4,4>{
         one,    zero,   zero,   zero,
         zero,   c,      s,      zero,
@@ -191,11 +188,11 @@ Matrix<T, 4, 4> rotateX(T angle) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> rotateY(T angle) {
+constexpr Matrix<T, 4, 4> rotateY(T angle) {
     T zero(0);
     T one(1);
-    T c = cos(angle);
-    T s = sin(angle);
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return Matrix<T,4,4>{
         c,      zero,   -s,     zero,
         zero,   one,     zero,  zero,
@@ -205,11 +202,11 @@ Matrix<T, 4, 4> rotateY(T angle) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> rotateZ(T angle) {
+constexpr Matrix<T, 4, 4> rotateZ(T angle) {
     T zero(0);
     T one(1);
-    T c = cos(angle);
-    T s = sin(angle);
+    T c = cx::cos(angle);
+    T s = cx::sin(angle);
     return Matrix<T,4,4>{
         c,      s,      zero,   zero,
         -s,     c,      zero,   zero,
@@ -219,7 +216,7 @@ Matrix<T, 4, 4> rotateZ(T angle) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> rotate3(const Quaternion<T>& q) {
+constexpr Matrix<T, 4, 4> rotate3(const Quaternion<T>& q) {
     T two(2);
     T one(1);
     T zero(0);
@@ -232,7 +229,7 @@ Matrix<T, 4, 4> rotate3(const Quaternion<T>& q) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> scale3(T sx, T sy, T sz) {
+constexpr Matrix<T, 4, 4> scale3(T sx, T sy, T sz) {
     T zero(0);
     T one(1);
     return Matrix<T,4,4>{
@@ -244,7 +241,7 @@ Matrix<T, 4, 4> scale3(T sx, T sy, T sz) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> scale3(T s) {
+constexpr Matrix<T, 4, 4> scale3(T s) {
     T zero(0);
     T one(1);
     return Matrix<T,4,4>{
@@ -256,7 +253,7 @@ Matrix<T, 4, 4> scale3(T s) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> orthographic3(T left, T right, T bottom, T top, T near, T far) {
+constexpr Matrix<T, 4, 4> orthographic3(T left, T right, T bottom, T top, T near, T far) {
     T zero(0);
     T one(1);
     T two(2);
@@ -269,8 +266,8 @@ Matrix<T, 4, 4> orthographic3(T left, T right, T bottom, T top, T near, T far) {
 }
 
 template<typename T>
-Matrix<T, 4, 4> perspective(T aspectRatio, T fov, T n, T f) {
-    T t = tanf(0.5f*fov)*n;
+constexpr Matrix<T, 4, 4> perspective(T aspectRatio, T fov, T n, T f) {
+    T t = cx::tan(T(0.5)*fov)*n;
     T b = -t;
     T r = t*aspectRatio;
     T l = -r;
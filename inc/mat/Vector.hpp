@@ -9,6 +9,7 @@
 
 #include "BaseVector.hpp"
 #include "Complex.hpp"
+#include "Constexpr.hpp"
 
 namespace mat {
 
@@ -40,19 +41,19 @@ public:
 //                                                 
 
     /// @brief Default constructor, fill the vector with value 0
-    Vector();
+    constexpr Vector();
 
     /// @brief Constructor, fill the vector with a value
     /// @param fill_val Value that fill the vector
-    Vector(T fill_val);
+    constexpr Vector(T fill_val);
 
     /// @brief Constructor, copy an array
     /// @param init_array Initial array
-    Vector(const std::array<T,N>& init_array);
+    constexpr Vector(const std::array<T,N>& init_array);
 
     /// @brief Constructor, copy an initializer list
     /// @param init_list Initializer list
-    Vector(const std::initializer_list<T>& init_list);
+    constexpr Vector(const std::initializer_list<T>& init_list);
 
 //    __  __     _   _            _    
 //   |  \/  |___| |_| |_  ___  __| |___
@@ -62,14 +63,14 @@ public:
 
     /// @brief Compute the square of the norm
     /// @return The square of the norm
-    T norm2() const;
+    constexpr T norm2() const;
 
     /// @brief Compute the the norm
     /// @return The norm
-    T norm() const;
+    constexpr T norm() const;
 
     /// @brief Normalize the vector
-    void normalize();
+    constexpr void normalize();
 
 //     ___                     _              
 //    / _ \ _ __  ___ _ _ __ _| |_ ___ _ _ ___
@@ -87,43 +88,43 @@ public:
     /// @brief Sum each vector element with a scalar
     /// @param a Scalar
     /// @return Reference to the vector
-    Vector& operator+=(T a);
+    constexpr Vector& operator+=(T a);
 
     /// @brief Subtract each vector element with a scalar
     /// @param a Scalar
     /// @return Reference to the vector
-    Vector& operator-=(T a);
+    constexpr Vector& operator-=(T a);
 
     /// @brief Multiply each vector element with a scalar
     /// @param a Scalar
     /// @return Reference to the vector
-    Vector& operator*=(T a);
+    constexpr Vector& operator*=(T a);
 
     /// @brief Divide each vector element with a scalar
     /// @param a Scalar
     /// @return Reference to the vector
-    Vector& operator/=(T a);
+    constexpr Vector& operator/=(T a);
 
     /// @brief Add two vectors
     /// @param v Vector
     /// @return Reference to the vector
-    Vector& operator+=(const Vector<T,N>& v);
+    constexpr Vector& operator+=(const Vector<T,N>& v);
 
     /// @brief Substract two vectors
     /// @param v Vector
     /// @return Reference to the vector
-    Vector& operator-=(const Vector<T,N>& v);
+    constexpr Vector& operator-=(const Vector<T,N>& v);
 
     /// @brief Multiply each element of the two vectors
     /// @param v Vector
     /// @return Reference to the vector
     /// @warning It is not a dot product, use the function dot
-    Vector& operator*=(const Vector<T,N>& v);
+    constexpr Vector& operator*=(const Vector<T,N>& v);
 
     /// @brief Divide each element of the two vectors
     /// @param v Vector
     /// @return Reference to the vector
-    Vector& operator/=(const Vector<T,N>& v);
+    constexpr Vector& operator/=(const Vector<T,N>& v);
 };
 
 
@@ -138,29 +139,29 @@ public:
 //                                            
 
 template<typename T, uint32_t N>
-Vector<T,N>::Vector() 
+constexpr Vector<T,N>::Vector() 
 : BaseVector<T,N>()
 {}
 
 template<typename T, uint32_t N>
-Vector<T,N>::Vector(T fill_val) 
+constexpr Vector<T,N>::Vector(T fill_val) 
 : BaseVector<T,N>()
 {
     m_component.fill(fill_val);
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>::Vector(const std::array<T,N>& init_array)
+constexpr Vector<T,N>::Vector(const std::array<T,N>& init_array)
 : BaseVector<T,N>(init_array)
 {}
 
 template<typename T, uint32_t N>
-Vector<T,N>::Vector(const std::initializer_list<T>& init_list)
+constexpr Vector<T,N>::Vector(const std::initializer_list<T>& init_list)
 : BaseVector<T,N>(init_list)
 {}
 
 template<typename T, uint32_t N>
-T Vector<T,N>::norm2() const {
+constexpr T Vector<T,N>::norm2() const {
     T result(0);
     for (auto i : m_component) {
         result += i * i;
@@ -169,12 +170,12 @@ T Vector<T,N>::norm2() const {
 }
 
 template<typename T, uint32_t N>
-T Vector<T,N>::norm() const {
-    return sqrt(norm2()); 
+constexpr T Vector<T,N>::norm() const {
+    return cx::sqrt(norm2()); 
 }
 
 template<typename T, uint32_t N>
-void Vector<T,N>::normalize() {
+constexpr void Vector<T,N>::normalize() {
     T n = norm();
     for (auto& i : m_component) {
         i /= n;
@@ -187,7 +188,7 @@ Vector<T,N>::operator BaseVector<T,N>&() {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator+=(T a) {
+constexpr Vector<T,N>& Vector<T,N>::operator+=(T a) {
     for (auto& i : m_component) {
         i += a;
     }
@@ -195,7 +196,7 @@ Vector<T,N>& Vector<T,N>::operator+=(T a) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator-=(T a) {
+constexpr Vector<T,N>& Vector<T,N>::operator-=(T a) {
     for (auto& i : m_component) {
         i -= a;
     }
@@ -203,7 +204,7 @@ Vector<T,N>& Vector<T,N>::operator-=(T a) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator*=(T a) {
+constexpr Vector<T,N>& Vector<T,N>::operator*=(T a) {
     for (auto& i : m_component) {
         i *= a;
     }
@@ -211,7 +212,7 @@ Vector<T,N>& Vector<T,N>::operator*=(T a) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator/=(T a) {
+constexpr Vector<T,N>& Vector<T,N>::operator/=(T a) {
     for (auto& i : m_component) {
         i /= a;
     }
@@ -219,7 +220,7 @@ Vector<T,N>& Vector<T,N>::operator/=(T a) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator+=(const Vector<T,N>& v) {
+constexpr Vector<T,N>& Vector<T,N>::operator+=(const Vector<T,N>& v) {
     const_iterator it = v.begin();
     for (auto& i : m_component) {
         i += *it;
@@ -229,7 +230,7 @@ Vector<T,N>& Vector<T,N>::operator+=(const Vector<T,N>& v) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator-=(const Vector<T,N>& v) {
+constexpr Vector<T,N>& Vector<T,N>::operator-=(const Vector<T,N>& v) {
     const_iterator it = v.begin();
     for (auto& i : m_component) {
         i -= *it;
@@ -239,7 +240,7 @@ Vector<T,N>& Vector<T,N>::operator-=(const Vector<T,N>& v) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator*=(const Vector<T,N>& v) {
+constexpr Vector<T,N>& Vector<T,N>::operator*=(const Vector<T,N>& v) {
     const_iterator it = v.begin();
     for (auto& i : m_component) {
         i *= *it;
@@ -249,7 +250,7 @@ Vector<T,N>& Vector<T,N>::operator*=(const Vector<T,N>& v) {
 }
 
 template<typename T, uint32_t N>
-Vector<T,N>& Vector<T,N>::operator/=(const Vector<T,N>& v)  {
+constexpr Vector<T,N>& Vector<T,N>::operator/=(const Vector<T,N>& v)  {
     const_iterator it = v.begin();
     for (auto& i : m_component) {
         i /= *it;
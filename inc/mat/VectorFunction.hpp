@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Vector.hpp"
+#include "Constexpr.hpp"
 
 namespace mat {
 
@@ -33,7 +34,7 @@ std::ostream& operator<<(std::ostream& stream, const Vector<T,N>& v) {
 /// @param a The scalar
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator+(Vector<T,N> v1, T a) {
+constexpr Vector<T,N> operator+(Vector<T,N> v1, T a) {
     return v1 += a;
 }
 
@@ -44,7 +45,7 @@ Vector<T,N> operator+(Vector<T,N> v1, T a) {
 /// @param v1 The vector
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator+(T a, Vector<T,N> v1) {
+constexpr Vector<T,N> operator+(T a, Vector<T,N> v1) {
     return v1 += a;
 }
 
@@ -55,7 +56,7 @@ Vector<T,N> operator+(T a, Vector<T,N> v1) {
 /// @param a The scalar
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator-(Vector<T,N> v1, T a) {
+constexpr Vector<T,N> operator-(Vector<T,N> v1, T a) {
     return v1 -= a;
 }
 
@@ -66,7 +67,7 @@ Vector<T,N> operator-(Vector<T,N> v1, T a) {
 /// @param v1 The vector
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator-(T a, Vector<T,N> v1) {
+constexpr Vector<T,N> operator-(T a, Vector<T,N> v1) {
     return v1 -= a;
 }
 
@@ -77,7 +78,7 @@ Vector<T,N> operator-(T a, Vector<T,N> v1) {
 /// @param a The scalar
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator*(Vector<T,N> v1, T a) {
+constexpr Vector<T,N> operator*(Vector<T,N> v1, T a) {
     return v1 *= a;
 }
 
@@ -88,7 +89,7 @@ Vector<T,N> operator*(Vector<T,N> v1, T a) {
 /// @param v1 The vector
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator*(T a, Vector<T,N> v1) {
+constexpr Vector<T,N> operator*(T a, Vector<T,N> v1) {
     return v1 *= a;
 }
 
@@ -99,7 +100,7 @@ Vector<T,N> operator*(T a, Vector<T,N> v1) {
 /// @param a The scalar
 /// @return The new vector
 template<typename T, uint32_t N>
-Vector<T,N> operator/(Vector<T,N> v1, T a) {
+constexpr Vector<T,N> operator/(Vector<T,N> v1, T a) {
     return v1 /= a;
 }
 
@@ -110,7 +111,7 @@ Vector<T,N> operator/(Vector<T,N> v1, T a) {
 /// @param v2 Second vector
 /// @return The addition of the two vectors
 template<typename T, uint32_t N>
-Vector<T,N> operator+(Vector<T,N> v1, const Vector<T,N>& v2) {
+constexpr Vector<T,N> operator+(Vector<T,N> v1, const Vector<T,N>& v2) {
     return v1 += v2;
 }
 
@@ -121,7 +122,7 @@ Vector<T,N> operator+(Vector<T,N> v1, const Vector<T,N>& v2) {
 /// @param v2 Second vector
 /// @return The substraction of the two vectors
 template<typename T, uint32_t N>
-Vector<T,N> operator-(Vector<T,N> v1, const Vector<T,N>& v2) {
+constexpr Vector<T,N> operator-(Vector<T,N> v1, const Vector<T,N>& v2) {
     return v1 -= v2;
 }
 
@@ -133,7 +134,7 @@ Vector<T,N> operator-(Vector<T,N> v1, const Vector<T,N>& v2) {
 /// @return The multiplication result
 /// @warning It is not a dot product, use the function dot
 template<typename T, uint32_t N>
-Vector<T,N> operator*(Vector<T,N> v1, const Vector<T,N>& v2) {
+constexpr Vector<T,N> operator*(Vector<T,N> v1, const Vector<T,N>& v2) {
     return v1 *= v2;
 }
 
@@ -144,7 +145,7 @@ Vector<T,N> operator*(Vector<T,N> v1, const Vector<T,N>& v2) {
 /// @param v2 Second vector
 /// @return The division result
 template<typename T, uint32_t N>
-Vector<T,N> operator/(Vector<T,N> v1, const Vector<T,N>& v2) {
+constexpr Vector<T,N> operator/(Vector<T,N> v1, const Vector<T,N>& v2) {
     return v1 /= v2;
 }
 
@@ -154,7 +155,7 @@ Vector<T,N> operator/(Vector<T,N> v1, const Vector<T,N>& v2) {
 /// @param v1 The vector
 /// @return Minus the vector (-v)
 template<typename T, uint32_t N>
-Vector<T,N> operator-(Vector<T,N> v1) {
+constexpr Vector<T,N> operator-(Vector<T,N> v1) {
     for (auto& i : v1) {
         i = -i;
     }
@@ -173,7 +174,7 @@ Vector<T,N> operator-(Vector<T,N> v1) {
 /// @param vec The vector
 /// @return A reference to the normalize vector
 template<typename T, uint32_t N>
-mat::Vector<T,N> normalize(mat::Vector<T,N> vec) {
+constexpr mat::Vector<T,N> normalize(mat::Vector<T,N> vec) {
     T norm = vec.norm();
     vec /= norm;
     return vec;
@@ -185,7 +186,7 @@ mat::Vector<T,N> normalize(mat::Vector<T,N> vec) {
 /// @param v The vector
 /// @return The sum of the component of the vector
 template<typename T, uint32_t N>
-T sum(const Vector<T,N>& v) {
+constexpr T sum(const Vector<T,N>& v) {
     T result(0);
     for (auto i : v) {
         result += i;
@@ -201,7 +202,7 @@ T sum(const Vector<T,N>& v) {
 /// @param v2 Second vector
 /// @return Merged vector
 template<typename T, uint32_t N, uint32_t M>
-Vector<T, N+M> merge(const Vector<T,N>& v1, const Vector<T,M>& v2) {
+constexpr Vector<T, N+M> merge(const Vector<T,N>& v1, const Vector<T,M>& v2) {
     Vector<T, N+M> result;
     uint32_t current(0);
     for (T& i : result) {
@@ -218,7 +219,7 @@ Vector<T, N+M> merge(const Vector<T,N>& v1, const Vector<T,M>& v2) {
 /// @param value The new component
 /// @return Vector with the new element
 template<typename T, uint32_t N>
-Vector<T,N+1> append(const Vector<T,N>& v, T value) {
+constexpr Vector<T,N+1> append(const Vector<T,N>& v, T value) {
     Vector<T,N+1> result;
     std::copy(v.begin(), v.begin()+N, result.begin());
     result[N] = value;
@@ -233,7 +234,7 @@ Vector<T,N+1> append(const Vector<T,N>& v, T value) {
 /// @param index The index where the component will be inserted
 /// @return Vector with the new element
 template<typename T, uint32_t N>
-Vector<T,N+1> insert(const Vector<T,N>& v, T value, uint32_t index) {
+constexpr Vector<T,N+1> insert(const Vector<T,N>& v, T value, uint32_t index) {
     Vector<T,N+1> result;
     std::copy(v.begin(), v.begin()+index, result.begin());
     std::copy(v.begin()+index, v.begin()+N, result.begin()+index+1);
@@ -248,7 +249,7 @@ Vector<T,N+1> insert(const Vector<T,N>& v, T value, uint32_t index) {
 /// @param index The index of the component that will be removed
 /// @return Vector without the component
 template<typename T, uint32_t N>
-Vector<T,N-1> remove(const Vector<T,N>&v, uint32_t index) {
+constexpr Vector<T,N-1> remove(const Vector<T,N>&v, uint32_t index) {
     Vector<T,N-1> result;
     std::copy(v.begin(), v.begin()+index, result.begin());
     std::copy(v.begin()+index+1, v.begin()+N, result.begin()+index);
@@ -263,7 +264,7 @@ Vector<T,N-1> remove(const Vector<T,N>&v, uint32_t index) {
 /// @param v The vector
 /// @return The sub vector
 template<typename T, uint32_t N, uint32_t I1, uint32_t I2>
-Vector<T,I2-I1+1> sub_vector(const Vector<T,N>& v) {
+constexpr Vector<T,I2-I1+1> sub_vector(const Vector<T,N>& v) {
     Vector<T,I2-I1+1> result;
     std::copy(v.begin()+I1, v.begin()+I2+1, result.begin());
     return result;
@@ -276,7 +277,7 @@ Vector<T,I2-I1+1> sub_vector(const Vector<T,N>& v) {
 /// @param v2 Second vector
 /// @return Result of the dot product
 template<typename T, uint32_t N>
-T dot(Vector<T,N> v1, const Vector<T,N>& v2) {
+constexpr T dot(Vector<T,N> v1, const Vector<T,N>& v2) {
     return sum(v1*=v2);
 }
 
@@ -286,7 +287,7 @@ T dot(Vector<T,N> v1, const Vector<T,N>& v2) {
 /// @param v2 Second vector
 /// @return Result of the cross product (a scalar)
 template<typename T>
-T cross(const Vector<T,2>& v1, const Vector<T,2>& v2) {
+constexpr T cross(const Vector<T,2>& v1, const Vector<T,2>& v2) {
     return v1[0] * v2[1] - v1[1] * v2[0];
 }
 
@@ -296,7 +297,7 @@ T cross(const Vector<T,2>& v1, const Vector<T,2>& v2) {
 /// @param v2 Second vector
 /// @return Result of the cross product (a vector 3)
 template<typename T>
-Vector<T,3> cross(const Vector<T,3>& v1, const Vector<T,3>& v2) {
+constexpr Vector<T,3> cross(const Vector<T,3>& v1, const Vector<T,3>& v2) {
     return Vector<T,3>{ v1[1] * v2[2] - v1[2] * v2[1],
                         v1[2] * v2[0] - v1[0] * v2[2],
                         v1[0] * v2[1] - v1[1] * v2[0]};
@@ -366,7 +367,7 @@ void spherical(const Vector<T,3>& v, T& radius, T& theta, T& phi) {
 /// @param v2 Second vector
 /// @return The distance between the vectors
 template<typename T, uint32_t N>
-T distance(const Vector<T,N>& v1, const Vector<T,N>& v2) {
+constexpr T distance(const Vector<T,N>& v1, const Vector<T,N>& v2) {
     return (v1 - v2).norm();
 }
 
@@ -377,7 +378,7 @@ T distance(const Vector<T,N>& v1, const Vector<T,N>& v2) {
 /// @param surface_normal The surface normal
 /// @return The refleted vector
 template<typename T, uint32_t N>
-Vector<T,N> reflect(const Vector<T,N>& incident, Vector<T,N> surface_normal) {
+constexpr Vector<T,N> reflect(const Vector<T,N>& incident, Vector<T,N> surface_normal) {
     surface_normal.normalize();
     T two(2);
     return  incident - two*dot(incident,surface_normal)*surface_normal;
@@ -392,12 +393,12 @@ Vector<T,N> reflect(const Vector<T,N>& incident, Vector<T,N> surface_normal) {
 /// @param n2 The refraction index of the medium of the surface
 /// @return The refracted vector
 template<typename T, uint32_t N>
-Vector<T,N> refract(const Vector<T,N>& incident, Vector<T,N> surface_normal, T n1, T n2) {
+constexpr Vector<T,N> refract(const Vector<T,N>& incident, Vector<T,N> surface_normal, T n1, T n2) {
     surface_normal.normalize();
     T one(1);
     T eta(n1/n2);
     T tmp_dot(dot(surface_normal,incident));
-    return sqrt(one - eta*eta*(one - tmp_dot*tmp_dot)) * surface_normal +
+    return cx::sqrt(one - eta*eta*(one - tmp_dot*tmp_dot)) * surface_normal +
         eta * (incident - tmp_dot * surface_normal);
 }
 
@@ -408,7 +409,7 @@ Vector<T,N> refract(const Vector<T,N>& incident, Vector<T,N> surface_normal, T n
 /// @param v2 Second vector
 /// @return True if dot(v1, v2) > 0, false otherwise
 template<typename T, uint32_t N>
-bool face_same_direction(const Vector<T,N>& v1, const Vector<T,N>& v2) {
+constexpr bool face_same_direction(const Vector<T,N>& v1, const Vector<T,N>& v2) {
     return dot(v1, v2) > T(0);
 }
 
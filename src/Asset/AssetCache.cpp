@@ -0,0 +1,185 @@
+#include "Asset/AssetCache.hpp"
+
+#include "Asset/PackFormat.hpp"
+
+namespace AMB {
+
+static const char* asset_type_name(AssetType type) {
+    switch (type) {
+        case AssetType::MUSIC: return "music";
+        case AssetType::SOUND: return "sound";
+        case AssetType::SHADER: return "shader";
+        case AssetType::TEXTURE: return "texture";
+        case AssetType::FONT: return "font";
+        default: return "unknown";
+    }
+}
+
+static std::string make_key(AssetType type, const std::string& path) {
+    return std::string(asset_type_name(type)) + ":" + pack_normalize_name(path);
+}
+
+AssetCache::AssetCache(AssetManager& manager, AssetFactory& factory)
+: m_manager(manager), m_factory(factory),
+  m_cpu_budget(SIZE_MAX), m_gpu_budget(SIZE_MAX),
+  m_cpu_bytes(0), m_gpu_bytes(0), m_cpu_bytes_type{}, m_gpu_bytes_type{},
+  m_hits(0), m_misses(0), m_evictions(0) {}
+
+AssetCache::~AssetCache() {
+#ifdef DEBUG
+    for (const auto& [key, entry] : m_entries) {
+        if (entry.ref_count > 0) {
+            Logger::instance().log(Warning, "Asset cache destroyed while " + key + " is still referenced");
+        }
+    }
+#endif
+    for (auto& [key, entry] : m_entries) {
+        evict(entry);
+    }
+    m_entries.clear();
+    m_lru.clear();
+}
+
+AssetRef<Music> AssetCache::music(const std::string& path) {
+    return acquire<Music>(AssetType::MUSIC, make_key(AssetType::MUSIC, path),
+        [&]() { return m_factory.create_music(path); });
+}
+
+AssetRef<Sound> AssetCache::sound(const std::string& path) {
+    return acquire<Sound>(AssetType::SOUND, make_key(AssetType::SOUND, path),
+        [&]() { return m_factory.create_sound(path); });
+}
+
+AssetRef<Shader> AssetCache::shader(const std::string& vertex_path, const std::string& fragment_path) {
+    std::string key = make_key(AssetType::SHADER, vertex_path) + "|" + pack_normalize_name(fragment_path);
+    return acquire<Shader>(AssetType::SHADER, key,
+        [&]() { return m_factory.create_shader(vertex_path, fragment_path); });
+}
+
+AssetRef<Texture> AssetCache::texture(const std::string& path) {
+    return acquire<Texture>(AssetType::TEXTURE, make_key(AssetType::TEXTURE, path),
+        [&]() { return m_factory.create_texture(path); });
+}
+
+AssetRef<Font> AssetCache::font(const std::string& path, uint32_t font_size) {
+    std::string key = make_key(AssetType::FONT, path) + "@" + std::to_string(font_size);
+    return acquire<Font>(AssetType::FONT, key,
+        [&]() { return m_factory.create_font(path, font_size); });
+}
+
+void AssetCache::set_budget(size_t cpu_bytes, size_t gpu_bytes) {
+    m_cpu_budget = cpu_bytes;
+    m_gpu_budget = gpu_bytes;
+    collect();
+}
+
+void AssetCache::collect() {
+    while (over_budget() && !m_lru.empty()) {
+        AssetCacheEntry* entry = m_lru.front();
+        m_lru.pop_front();
+        m_evictions++;
+        evict(*entry);
+        m_entries.erase(entry->key);
+    }
+}
+
+void AssetCache::purge() {
+    while (!m_lru.empty()) {
+        AssetCacheEntry* entry = m_lru.front();
+        m_lru.pop_front();
+        m_evictions++;
+        evict(*entry);
+        m_entries.erase(entry->key);
+    }
+}
+
+void AssetCache::report() const {
+    Logger::instance().log(Info, "Asset cache: " + std::to_string(m_entries.size()) + " assets, " +
+        std::to_string(m_lru.size()) + " unreferenced, " + std::to_string(m_hits) + " hits, " +
+        std::to_string(m_misses) + " misses, " + std::to_string(m_evictions) + " evictions");
+
+    for (size_t i = 0; i < (size_t)AssetType::COUNT; i++) {
+        Logger::instance().log(Info, std::string("  ") + asset_type_name((AssetType)i) + ": " +
+            std::to_string(m_cpu_bytes_type[i] / 1024) + " KiB CPU, " +
+            std::to_string(m_gpu_bytes_type[i] / 1024) + " KiB GPU");
+    }
+}
+
+void AssetCache::add_ref(AssetCacheEntry* entry) {
+    if (entry->ref_count++ == 0 && entry->in_lru) {
+        m_lru.erase(entry->lru_it);
+        entry->in_lru = false;
+    }
+}
+
+void AssetCache::release(AssetCacheEntry* entry) {
+    if (--entry->ref_count == 0) {
+        entry->lru_it = m_lru.insert(m_lru.end(), entry);
+        entry->in_lru = true;
+        collect();
+    }
+}
+
+void AssetCache::measure(AssetCacheEntry& entry) {
+    switch (entry.type) {
+        case AssetType::SOUND:
+            entry.cpu_bytes = m_manager.sounds.get(entry.handle).get_memory_size();
+            break;
+        case AssetType::TEXTURE:
+            entry.gpu_bytes = m_manager.textures.get(entry.handle).get_memory_size();
+            break;
+        case AssetType::FONT: {
+            Font& font = m_manager.fonts.get(entry.handle);
+            entry.cpu_bytes = font.get_memory_size();
+            entry.gpu_bytes = font.get_texture().get_memory_size();
+            break;
+        }
+        default:
+            // Musics are streamed and the program binaries are owned by the driver
+            break;
+    }
+
+    m_cpu_bytes += entry.cpu_bytes;
+    m_gpu_bytes += entry.gpu_bytes;
+    m_cpu_bytes_type[(size_t)entry.type] += entry.cpu_bytes;
+    m_gpu_bytes_type[(size_t)entry.type] += entry.gpu_bytes;
+}
+
+void AssetCache::evict(AssetCacheEntry& entry) {
+    m_cpu_bytes -= entry.cpu_bytes;
+    m_gpu_bytes -= entry.gpu_bytes;
+    m_cpu_bytes_type[(size_t)entry.type] -= entry.cpu_bytes;
+    m_gpu_bytes_type[(size_t)entry.type] -= entry.gpu_bytes;
+
+    switch (entry.type) {
+        case AssetType::MUSIC:
+            m_manager.musics.remove(entry.handle);
+            break;
+        case AssetType::SOUND:
+            m_manager.sounds.remove(entry.handle);
+            break;
+        case AssetType::SHADER:
+            m_manager.shaders.remove(entry.handle);
+            break;
+        case AssetType::TEXTURE:
+            m_manager.textures.remove(entry.handle);
+            break;
+        case AssetType::FONT: {
+            // The atlas texture was created with the font and belongs to it
+            if (m_manager.fonts.validity(entry.handle)) {
+                AssetHandle atlas = m_manager.textures.find(m_manager.fonts.get(entry.handle).get_texture());
+                m_manager.fonts.remove(entry.handle);
+                m_manager.textures.remove(atlas);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool AssetCache::over_budget() const {
+    return m_cpu_bytes > m_cpu_budget || m_gpu_bytes > m_gpu_budget;
+}
+
+}
@@ -1,4 +1,5 @@
 #include "Asset/AssetFactory.hpp"
+#include "Asset/ImageData.hpp"
 
 // Using stb_image
 #define STB_IMAGE_IMPLEMENTATION
@@ -9,10 +10,13 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
+#include <fstream>
+#include <iterator>
+
 namespace AMB {
 
 AssetFactory::AssetFactory(AssetManager& manager, FontSystem& font_system)
-: m_manager(manager), m_font_system(font_system)
+: m_manager(manager), m_font_system(font_system), m_shader_cache(nullptr)
 {}
 
 AssetHandle AssetFactory::create_music(const std::string& path) {
@@ -54,95 +58,39 @@ AssetHandle AssetFactory::create_shader(const std::string& vertex_path, const st
         return handle;
     }
 
-    // Create shaders
-    uint32_t vertex_shader;
-    uint32_t fragment_shader;
-
-    if (!create_shader_partial(GL_VERTEX_SHADER, vertex_shader, vertex_source_code)) {
-        glDeleteShader(vertex_shader);
-        return handle;
-    }
-
-    if (!create_shader_partial(GL_FRAGMENT_SHADER, fragment_shader, fragment_source_code)) {
-        glDeleteShader(vertex_shader);
-        glDeleteShader(fragment_shader);
-        return handle;
-    }
-
-    // Create shader program
-    uint32_t shader_program;
-    if (!create_shader_program(vertex_shader, fragment_shader, shader_program)) {
-        glDeleteShader(vertex_shader);
-        glDeleteShader(fragment_shader);
-        return handle;
-    }
-
-    // Delete shaders
-    glDeleteShader(vertex_shader);
-    glDeleteShader(fragment_shader);
-
-    return m_manager.shaders.add(shader_program);
+    return create_shader_program(vertex_source_code, fragment_source_code);
 }
 
 AssetHandle AssetFactory::create_shader_from_code(const std::string& vertex_code, const std::string& fragment_code) {
-    // Create shaders
-    uint32_t vertex_shader;
-    uint32_t fragment_shader;
-    AssetHandle handle{-1, typeid(Shader)};
-
-    if (!create_shader_partial(GL_VERTEX_SHADER, vertex_shader, vertex_code)) {
-        glDeleteShader(vertex_shader);
-        return handle;
-    }
-
-    if (!create_shader_partial(GL_FRAGMENT_SHADER, fragment_shader, fragment_code)) {
-        glDeleteShader(vertex_shader);
-        glDeleteShader(fragment_shader);
-        return handle;
-    }
-
-    // Create shader program
-    uint32_t shader_program;
-    if (!create_shader_program(vertex_shader, fragment_shader, shader_program)) {
-        glDeleteShader(vertex_shader);
-        glDeleteShader(fragment_shader);
-        return handle;
-    }
-
-    // Delete shaders
-    glDeleteShader(vertex_shader);
-    glDeleteShader(fragment_shader);
+    return create_shader_program(vertex_code, fragment_code);
+}
 
-    return m_manager.shaders.add(shader_program);
+void AssetFactory::set_shader_cache(ShaderCache* cache) {
+    m_shader_cache = cache;
 }
 
 AssetHandle AssetFactory::create_texture(const std::string& path) {
-    // Read the file from top to bottom
-    stbi_set_flip_vertically_on_load(true);
+    // Load the image, read from top to bottom
+    ImageData image;
+    if (!decode_image_file(path, image, true)) {
+        Logger::instance().log(Error, "Can't load texture : " + path);
+        return AssetHandle{-1, typeid(Texture)};
+    }
 
-    // Load the image
-    int width(-1), height(-1), bpp;
-    unsigned char* buffer = stbi_load(path.c_str(), &width, &height, &bpp, 4); // 4 because RGBA
+    return create_texture(image);
+}
 
+AssetHandle AssetFactory::create_texture(const ImageData& image) {
     // Generate the texture and bind it
     uint32_t texture_index;
     glGenTextures(1, &texture_index);
     glBindTexture(GL_TEXTURE_2D, texture_index);
 
     // Send the texture to openGL
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.get());
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Check if the buffer contains data
-    if (buffer) {
-        stbi_image_free(buffer);
-    }else{
-        Logger::instance().log(Error, "Can't load texture : " + path);
-        glDeleteTextures(1, &texture_index);
-        return AssetHandle{-1, typeid(Texture)};
-    }
-
-    return m_manager.textures.add(texture_index, width, height, bpp);
+    return m_manager.textures.add(texture_index, image.width, image.height, 4); // stored as RGBA8 whatever the file channels
 }
 
 AssetHandle AssetFactory::create_texture(int32_t width, int32_t height, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
@@ -184,76 +132,190 @@ AssetHandle AssetFactory::create_font(const std::string& path, uint32_t font_siz
         return AssetHandle{-1, typeid(Font)};
     }
 
-    // Set font size
-    FT_Set_Pixel_Sizes(face, 0, font_size);
+    return create_font_from_face(face, path, font_size);
+}
 
-    // Prepare byte size unpacking
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+AssetHandle AssetFactory::create_font(const std::string& path, uint32_t font_size, ThreadPool& pool) {
+    return create_fonts({{path, font_size}}, pool)[0];
+}
+
+std::vector<AssetHandle> AssetFactory::create_fonts(const std::vector<std::pair<std::string, uint32_t>>& fonts, ThreadPool& pool) {
+    // Each worker opens its own face on the file in memory
+    std::vector<std::vector<uint8_t>> files(fonts.size());
+    std::vector<FontSource> sources(fonts.size());
+    for (size_t i = 0; i < fonts.size(); ++i) {
+        std::ifstream file(fonts[i].first, std::ios::binary);
+        files[i].assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        sources[i] = FontSource{files[i].data(), files[i].size(), fonts[i].second};
+    }
 
-    // Create the characters
-    std::map<char, Character> char_map;
-    int char_px_space = Font::get_char_px_space();
-    int atlas_width(0);
-    int atlas_height(0);
-
-    for (unsigned char c(32) ; c < 128 ; ++c) {
-
-        // Load a character
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {    // Check validity
-            logger.log(Error, "FreeType Failed to load Glyph : " + c);
-
-        }else{                                          // Create Character
-            Character character = {
-                0.0f, 0.0f, 0.0f, 0.0f, 
-                (int)face->glyph->bitmap.width, (int)face->glyph->bitmap.rows,
-                face->glyph->bitmap_left, face->glyph->bitmap_top,
-                face->glyph->advance.x
-            };
-
-            char_map[c] = character;                    // Set the character in the map
-
-            // Update atlas parameters
-            atlas_width += character.width;
-            if (c < 128) {
-                atlas_width += char_px_space;
-            }
-            atlas_height = std::max(atlas_height, character.height);
+    std::vector<FontBitmap> bitmaps;
+    rasterize_fonts(sources, pool, bitmaps);
+
+    // The atlases are uploaded on this thread, the one of the GL context
+    std::vector<AssetHandle> handles;
+    for (size_t i = 0; i < fonts.size(); ++i) {
+        if (!bitmaps[i].valid()) {
+            Logger::instance().log(Error, "Can not load font : " + fonts[i].first);
+            handles.push_back(AssetHandle{-1, typeid(Font)});
+            continue;
         }
+        handles.push_back(create_font(bitmaps[i], fonts[i].first));
+    }
+    return handles;
+}
+
+AssetHandle AssetFactory::create_dynamic_font(const std::string& path, uint32_t font_size, uint32_t page_size, uint32_t max_pages) {
+    // FreeType reads the glyphs from memory as long as the face lives, the font keeps the file
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    FT_Face face;
+    if (data.empty() || FT_New_Memory_Face(m_font_system.get_library(), data.data(), static_cast<FT_Long>(data.size()), 0, &face)) {
+        Logger::instance().log(Error, "Can not load font : " + path);
+        return AssetHandle{-1, typeid(DynamicFont)};
+    }
+
+    return m_manager.dynamic_fonts.add(face, std::move(data), font_size, page_size, max_pages);
+}
+
+AssetHandle AssetFactory::create_sdf_font(const std::string& path, uint32_t base_size, uint32_t spread, ThreadPool* pool) {
+    FT_Face face;
+    if (FT_New_Face(m_font_system.get_library(), path.c_str(), 0, &face)) {
+        Logger::instance().log(Error, "Can not load font : " + path);
+        return AssetHandle{-1, typeid(Font)};
+    }
+
+    FontBitmap bitmap;
+    bool success = rasterize_font_sdf(face, base_size, spread, pool, bitmap);
+    FT_Done_Face(face);
+
+    if (!success) {
+        Logger::instance().log(Error, "Can not rasterize font : " + path);
+        return AssetHandle{-1, typeid(Font)};
     }
 
+    return create_font(bitmap, path);
+}
+
+AssetHandle AssetFactory::create_font_from_face(FT_Face face, const std::string& name, uint32_t font_size) {
+    FontBitmap bitmap;
+    bool success = rasterize_font(face, font_size, bitmap);
+
+    // Free face
+    FT_Done_Face(face);
+
+    if (!success) {
+        Logger::instance().log(Error, "Can not rasterize font : " + name);
+        return AssetHandle{-1, typeid(Font)};
+    }
+
+    return create_font(bitmap, name);
+}
+
+AssetHandle AssetFactory::create_font(const FontBitmap& bitmap, const std::string& name) {
     // Create the font texture atlas
-    AssetHandle texture_font_handle = create_texture(atlas_width, atlas_height, 0, 0, 0, 0);
+    AssetHandle texture_font_handle = create_texture(bitmap.width, bitmap.height, 0, 0, 0, 0);
     if (!m_manager.textures.validity(texture_font_handle)) {
-        FT_Done_Face(face);
-        logger.log(Error, "Can not create texture for font");
+        Logger::instance().log(Error, "Can not create texture for font : " + name);
         return AssetHandle{-1, typeid(Font)};
     }
     Texture& texture = m_manager.textures.get(texture_font_handle);
 
-    // Populate the texture with the characters
+    // Populate the texture with the characters, one byte per pixel
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     texture.bind();
-    int x_progression(0);
-    for (auto& c : char_map) {
-        FT_Load_Char(face, c.first, FT_LOAD_RENDER);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, x_progression, 0, c.second.width, c.second.height, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
-        //glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlas_width, atlas_height, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr);
-
-        // Set the position and dimension on the texture atlas
-        c.second.u = x_progression/(float)atlas_width;
-        c.second.w = c.second.width/(float)atlas_width;
-        c.second.h = c.second.height/(float)atlas_height;
-
-        // Progress
-        x_progression += c.second.width + char_px_space;
-    }
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, bitmap.width, bitmap.height, GL_RED, GL_UNSIGNED_BYTE, bitmap.pixels.data());
 
-    // Free face
-    FT_Done_Face(face);
+    // The distance fields are interpolated
+    if (bitmap.sdf) {
+        texture.set_filter(TextureFilter::LINEAR, TextureFilter::LINEAR);
+    }
 
     // Create the font
-    return m_manager.fonts.add(char_map, atlas_height, texture);
+    return m_manager.fonts.add(bitmap.char_map, bitmap.line_height, texture, bitmap.sdf ? bitmap.font_size : 0, bitmap.sdf_spread);
+}
+
+AssetHandle AssetFactory::create_music(const AssetPack& pack, const std::string& name) {
+    PackData data = pack.get(name);
+    if (!data.valid()) {
+        Logger::instance().log(Error, "Can not load music. Music name : " + name);
+        exit(EXIT_FAILURE);
+    }
+
+    // The music is streamed, a decompressed copy must live as long as the pack
+    pack.retain(data);
+
+    SDL_RWops* rw = SDL_RWFromConstMem(data.data, static_cast<int>(data.size));
+    Mix_Music* music = rw ? Mix_LoadMUS_RW(rw, 1) : nullptr;
+    if (!music) {
+        Logger::instance().log(Error, "Can not load music. Music name : " + name + ". Mix Error : " + std::string(Mix_GetError()));
+        exit(EXIT_FAILURE);
+    }
+
+    return m_manager.musics.add(music);
+}
+
+AssetHandle AssetFactory::create_sound(const AssetPack& pack, const std::string& name) {
+    PackData data = pack.get(name);
+    if (!data.valid()) {
+        Logger::instance().log(Error, "Can not load sound. Sound name : " + name);
+        exit(EXIT_FAILURE);
+    }
+
+    return create_sound(data.data, data.size, name);
+}
+
+AssetHandle AssetFactory::create_sound(const uint8_t* data, size_t size, const std::string& name) {
+    // The sound is fully decoded, the data is not needed after
+    SDL_RWops* rw = SDL_RWFromConstMem(data, static_cast<int>(size));
+    Mix_Chunk* sound = rw ? Mix_LoadWAV_RW(rw, 1) : nullptr;
+    if (!sound) {
+        Logger::instance().log(Error, "Can not load sound. Sound name : " + name + ". Mix Error : " + std::string(Mix_GetError()));
+        exit(EXIT_FAILURE);
+    }
+
+    return m_manager.sounds.add(sound);
+}
+
+AssetHandle AssetFactory::create_shader(const AssetPack& pack, const std::string& vertex_name, const std::string& fragment_name) {
+    PackData vertex = pack.get(vertex_name);
+    PackData fragment = pack.get(fragment_name);
+    if (!vertex.valid() || !fragment.valid()) {
+        Logger::instance().log(Error, "Can not load shader source. Shader names : " + vertex_name + ", " + fragment_name);
+        return AssetHandle{-1, typeid(Shader)};
+    }
+
+    return create_shader_program(
+        std::string(reinterpret_cast<const char*>(vertex.data), vertex.size),
+        std::string(reinterpret_cast<const char*>(fragment.data), fragment.size)
+    );
+}
+
+AssetHandle AssetFactory::create_texture(const AssetPack& pack, const std::string& name) {
+    PackData data = pack.get(name);
+
+    ImageData image;
+    if (!data.valid() || !decode_image_memory(data.data, data.size, image, true)) {
+        Logger::instance().log(Error, "Can't load texture : " + name);
+        return AssetHandle{-1, typeid(Texture)};
+    }
+
+    return create_texture(image);
 }
 
+AssetHandle AssetFactory::create_font(const AssetPack& pack, const std::string& name, uint32_t font_size) {
+    // FreeType reads the memory until FT_Done_Face, done before returning
+    PackData data = pack.get(name);
+
+    FT_Face face;
+    if (!data.valid() || FT_New_Memory_Face(m_font_system.get_library(), data.data, static_cast<FT_Long>(data.size), 0, &face)) {
+        Logger::instance().log(Error, "Can not load font : " + name);
+        return AssetHandle{-1, typeid(Font)};
+    }
+
+    return create_font_from_face(face, name, font_size);
+}
 
 bool AssetFactory::load_shader_source(const std::string path, std::string& source) {
     // Open file
@@ -275,59 +337,49 @@ bool AssetFactory::load_shader_source(const std::string path, std::string& sourc
     return true;
 }
 
-bool AssetFactory::create_shader_partial(GLenum type, uint32_t& shader_index, const std::string& source) {
-    // Define error variable
-    int success;
-    char info_log[512];
-
-    // Compile the shader
-    shader_index = glCreateShader(type);
+uint32_t AssetFactory::create_shader_partial(GLenum type, const std::string& source) {
+    // Compile the shader, the status is checked by the Shader at first use
+    uint32_t shader_index = glCreateShader(type);
     const char* sourceChar = source.c_str();
     glShaderSource(shader_index, 1, &sourceChar, nullptr);
     glCompileShader(shader_index);
 
-    // Check for errors
-    glGetShaderiv(shader_index, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(shader_index, 512, NULL, info_log);
-        std::string shader_type_str;
-        switch (type) {
-            case GL_VERTEX_SHADER:
-                shader_type_str = "vertex";
-                break;
-            case GL_FRAGMENT_SHADER:
-                shader_type_str = "fragment";
-                break;
-            default:
-                break;
-        }
-        Logger::instance().log(Error, "Can not compile " + shader_type_str + " shader. Error :\n" + std::string(info_log));
-        return false;
+    return shader_index;
+}
+
+AssetHandle AssetFactory::create_shader_program(const std::string& vertex_code, const std::string& fragment_code) {
+    // Let the driver compile on its own threads, the first status query waits for it
+    static bool s_parallel_compile = false;
+    if (!s_parallel_compile && GLAD_GL_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        s_parallel_compile = true;
     }
 
-    return true;
-}
+    uint32_t shader_program = glCreateProgram();
+
+    // Try the cache first, a hit needs no compile at all
+    uint64_t key = 0;
+    if (m_shader_cache && m_shader_cache->is_supported()) {
+        key = m_shader_cache->get_key(vertex_code, fragment_code);
+        if (m_shader_cache->load(key, shader_program)) {
+            return m_manager.shaders.add(shader_program);
+        }
+
+        // A rejected binary leaves the program in an undefined state
+        glDeleteProgram(shader_program);
+        shader_program = glCreateProgram();
+        glProgramParameteri(shader_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
-bool AssetFactory::create_shader_program(uint32_t vertex_shader, uint32_t fragment_shader, uint32_t& shader_program) {
-    // Define error variable
-    int success;
-    char info_log[512];
+    // Create shaders and the program without waiting for the results
+    uint32_t vertex_shader = create_shader_partial(GL_VERTEX_SHADER, vertex_code);
+    uint32_t fragment_shader = create_shader_partial(GL_FRAGMENT_SHADER, fragment_code);
 
-    // Create shader program
-    shader_program = glCreateProgram();
     glAttachShader(shader_program, vertex_shader);
     glAttachShader(shader_program, fragment_shader);
     glLinkProgram(shader_program);
-    
-    // Check for errors
-    glGetProgramiv(shader_program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shader_program, 512, NULL, info_log);
-        Logger::instance().log(Info, "Can not bind shader to shader program. Error :\n" + std::string(info_log));
-        return false;
-    }
 
-    return true;
+    return m_manager.shaders.add(shader_program, vertex_shader, fragment_shader, m_shader_cache, key);
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,478 @@
+#include "Asset/AssetGraphLoader.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cfloat>
+
+namespace AMB {
+
+static bool read_file(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        Logger::instance().log(Error, "Can not read asset file : " + path);
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    data.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(data.data()), size)) {
+        Logger::instance().log(Error, "Can not read asset file : " + path);
+        return false;
+    }
+    return true;
+}
+
+static AssetHandle invalid_handle(AssetType type) {
+    switch (type) {
+        case AssetType::MUSIC: return AssetHandle{-1, typeid(Music)};
+        case AssetType::SOUND: return AssetHandle{-1, typeid(Sound)};
+        case AssetType::SHADER: return AssetHandle{-1, typeid(Shader)};
+        case AssetType::TEXTURE: return AssetHandle{-1, typeid(Texture)};
+        default: return AssetHandle{-1, typeid(Font)};
+    }
+}
+
+AssetGraphLoader::AssetGraphLoader(AssetFactory& factory, ThreadPool& pool)
+: m_factory(factory), m_pool(pool), m_started(false), m_done(0), m_running(0) {}
+
+AssetGraphLoader::~AssetGraphLoader() {
+    // The steps on the pool reference this loader
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this]() { return m_running == 0; });
+}
+
+bool AssetGraphLoader::add_manifest(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        Logger::instance().log(Error, "Can not read asset manifest : " + path);
+        return false;
+    }
+
+    bool success = true;
+    std::string line;
+    uint32_t line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream stream(line);
+        std::vector<std::string> words;
+        std::string word;
+        while (stream >> word) {
+            words.push_back(word);
+        }
+        if (words.empty()) {
+            continue;
+        }
+
+        // Split the arguments and the "after" list
+        auto after_it = std::find(words.begin(), words.end(), "after");
+        std::vector<std::string> after(after_it == words.end() ? after_it : after_it + 1, words.end());
+        words.erase(after_it, words.end());
+
+        const std::string& type = words[0];
+        bool valid = true;
+        if (type == "texture" && words.size() == 3) {
+            add_texture(words[1], words[2], after);
+        }else if (type == "shader" && words.size() == 4) {
+            add_shader(words[1], words[2], words[3], after);
+        }else if (type == "font" && words.size() == 4) {
+            uint32_t font_size = std::strtoul(words[3].c_str(), nullptr, 10);
+            valid = font_size > 0;
+            if (valid) {
+                add_font(words[1], words[2], font_size, after);
+            }
+        }else if (type == "sound" && words.size() == 3) {
+            add_sound(words[1], words[2], after);
+        }else if (type == "music" && words.size() == 3) {
+            add_music(words[1], words[2], after);
+        }else{
+            valid = false;
+        }
+
+        if (!valid) {
+            Logger::instance().log(Error, "Malformed asset manifest line " + path + ":" + std::to_string(line_number));
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+void AssetGraphLoader::add_texture(const std::string& name, const std::string& path, const std::vector<std::string>& after) {
+    add_asset(name, AssetType::TEXTURE, after).paths[0] = path;
+}
+
+void AssetGraphLoader::add_shader(const std::string& name, const std::string& vertex_path, const std::string& fragment_path, const std::vector<std::string>& after) {
+    Asset& asset = add_asset(name, AssetType::SHADER, after);
+    asset.paths[0] = vertex_path;
+    asset.paths[1] = fragment_path;
+}
+
+void AssetGraphLoader::add_font(const std::string& name, const std::string& path, uint32_t font_size, const std::vector<std::string>& after) {
+    Asset& asset = add_asset(name, AssetType::FONT, after);
+    asset.paths[0] = path;
+    asset.font_size = font_size;
+}
+
+void AssetGraphLoader::add_sound(const std::string& name, const std::string& path, const std::vector<std::string>& after) {
+    add_asset(name, AssetType::SOUND, after).paths[0] = path;
+}
+
+void AssetGraphLoader::add_music(const std::string& name, const std::string& path, const std::vector<std::string>& after) {
+    add_asset(name, AssetType::MUSIC, after).paths[0] = path;
+}
+
+bool AssetGraphLoader::start() {
+    if (m_started) {
+        Logger::instance().log(Warning, "Asset graph already started");
+        return false;
+    }
+
+    m_steps.clear();
+    for (uint32_t i = 0; i < m_assets.size(); i++) {
+        build_steps(i);
+    }
+
+    // The last step of an asset waits for the last steps of the assets it is loaded after
+    for (Asset& asset : m_assets) {
+        for (const std::string& name : asset.after) {
+            auto it = m_names.find(name);
+            if (it == m_names.end()) {
+                Logger::instance().log(Error, "Asset " + asset.name + " is loaded after an unknown asset : " + name);
+                return false;
+            }
+            uint32_t previous = m_assets[it->second].steps.back();
+            m_steps[previous].next.push_back(asset.steps.back());
+            m_steps[asset.steps.back()].pending++;
+        }
+    }
+
+    // Check that the graph can be sorted (no cycle)
+    std::vector<uint32_t> pending(m_steps.size());
+    std::vector<uint32_t> ready;
+    for (uint32_t i = 0; i < m_steps.size(); i++) {
+        pending[i] = m_steps[i].pending;
+        if (pending[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+    size_t sorted = 0;
+    while (!ready.empty()) {
+        uint32_t step = ready.back();
+        ready.pop_back();
+        sorted++;
+        for (uint32_t next : m_steps[step].next) {
+            if (--pending[next] == 0) {
+                ready.push_back(next);
+            }
+        }
+    }
+    if (sorted != m_steps.size()) {
+        Logger::instance().log(Error, "Asset graph has a dependency cycle");
+        return false;
+    }
+
+    // Start the steps with no dependency
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_started = true;
+    m_start = Clock::now();
+    for (uint32_t i = 0; i < m_steps.size(); i++) {
+        if (m_steps[i].pending == 0) {
+            schedule(i);
+        }
+    }
+    return true;
+}
+
+bool AssetGraphLoader::update(float budget_ms) {
+    auto start = Clock::now();
+
+    while (true) {
+        uint32_t step;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_render_ready.empty()) {
+                break;
+            }
+            step = m_render_ready.front();
+            m_render_ready.pop_front();
+        }
+
+        run_step(step);
+
+        if (std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= budget_ms) {
+            break;
+        }
+    }
+
+    return is_done();
+}
+
+bool AssetGraphLoader::load() {
+    if (!start()) {
+        return false;
+    }
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait(lock, [this]() { return !m_render_ready.empty() || m_done == m_steps.size(); });
+            if (m_done == m_steps.size()) {
+                break;
+            }
+        }
+        update(FLT_MAX);
+    }
+
+    return get_failed_count() == 0;
+}
+
+bool AssetGraphLoader::is_done() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_started && m_done == m_steps.size();
+}
+
+AssetHandle AssetGraphLoader::get(const std::string& name) const {
+    auto it = m_names.find(name);
+    if (it == m_names.end()) {
+        return AssetHandle{-1, typeid(void)};
+    }
+    return m_assets[it->second].handle;
+}
+
+uint32_t AssetGraphLoader::get_failed_count() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::count_if(m_assets.begin(), m_assets.end(), [](const Asset& asset) { return asset.failed; });
+}
+
+std::vector<AssetLoadTiming> AssetGraphLoader::get_timings() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<AssetLoadTiming> timings;
+    for (const Asset& asset : m_assets) {
+        AssetLoadTiming timing{asset.name, asset.type, FLT_MAX, 0.0f, 0.0f, 0.0f, false};
+        for (uint32_t index : asset.steps) {
+            const Step& step = m_steps[index];
+            timing.start_ms = std::min(timing.start_ms, step.start_ms);
+            timing.end_ms = std::max(timing.end_ms, step.end_ms);
+            (step.render ? timing.render_ms : timing.worker_ms) += step.end_ms - step.start_ms;
+        }
+        timings.push_back(timing);
+    }
+
+    for (const std::string& name : get_critical_path()) {
+        timings[m_names.at(name)].critical = true;
+    }
+    return timings;
+}
+
+std::vector<std::string> AssetGraphLoader::get_critical_path() const {
+    std::vector<std::string> path;
+    if (m_steps.empty()) {
+        return path;
+    }
+
+    // Walk back from the step done last through the dependencies which were done last
+    int32_t step = 0;
+    for (uint32_t i = 1; i < m_steps.size(); i++) {
+        if (m_steps[i].end_ms > m_steps[step].end_ms) {
+            step = i;
+        }
+    }
+
+    while (step >= 0) {
+        const std::string& name = m_assets[m_steps[step].asset].name;
+        if (path.empty() || path.back() != name) {
+            path.push_back(name);
+        }
+        step = m_steps[step].critical_previous;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+float AssetGraphLoader::get_total_ms() const {
+    float total = 0.0f;
+    for (const Step& step : m_steps) {
+        total = std::max(total, step.end_ms);
+    }
+    return total;
+}
+
+void AssetGraphLoader::report() const {
+    const Logger& logger = Logger::instance();
+    std::vector<AssetLoadTiming> timings = get_timings();
+    std::sort(timings.begin(), timings.end(), [](const AssetLoadTiming& a, const AssetLoadTiming& b) { return a.start_ms < b.start_ms; });
+
+    logger.log(Info, "Asset graph: " + std::to_string(m_assets.size()) + " assets, " + std::to_string(m_steps.size()) +
+        " steps, " + std::to_string(get_total_ms()) + " ms, " + std::to_string(get_failed_count()) + " failed");
+
+    for (const AssetLoadTiming& timing : timings) {
+        logger.log(Info, std::string(timing.critical ? "* " : "  ") + timing.name + ": " +
+            std::to_string(timing.start_ms) + " -> " + std::to_string(timing.end_ms) + " ms (worker " +
+            std::to_string(timing.worker_ms) + " ms, render " + std::to_string(timing.render_ms) + " ms)");
+    }
+
+    std::string path;
+    for (const std::string& name : get_critical_path()) {
+        path += (path.empty() ? "" : " -> ") + name;
+    }
+    logger.log(Info, "Critical path: " + path);
+}
+
+AssetGraphLoader::Asset& AssetGraphLoader::add_asset(const std::string& name, AssetType type, const std::vector<std::string>& after) {
+    auto it = m_names.find(name);
+    if (it != m_names.end()) {
+        Logger::instance().log(Warning, "Asset " + name + " added twice to the asset graph, the last one is kept");
+        m_assets[it->second] = Asset{name, type, {}, 0, after, {}, {}, {}, invalid_handle(type), false, {}};
+        return m_assets[it->second];
+    }
+
+    m_names[name] = m_assets.size();
+    return m_assets.emplace_back(Asset{name, type, {}, 0, after, {}, {}, {}, invalid_handle(type), false, {}});
+}
+
+uint32_t AssetGraphLoader::add_step(uint32_t asset, bool render, std::function<bool(Asset&)> run, std::vector<uint32_t> previous) {
+    uint32_t index = m_steps.size();
+    m_steps.push_back(Step{asset, render, std::move(run), {}, (uint32_t)previous.size(), 0.0f, 0.0f, -1});
+    for (uint32_t step : previous) {
+        m_steps[step].next.push_back(index);
+    }
+    m_assets[asset].steps.push_back(index);
+    return index;
+}
+
+void AssetGraphLoader::build_steps(uint32_t asset_index) {
+    Asset& asset = m_assets[asset_index];
+    asset.steps.clear();
+
+    switch (asset.type) {
+        case AssetType::TEXTURE: {
+            uint32_t read = add_step(asset_index, false, [](Asset& a) { return read_file(a.paths[0], a.files[0]); }, {});
+            uint32_t decode = add_step(asset_index, false, [](Asset& a) {
+                bool success = decode_image_memory(a.files[0].data(), a.files[0].size(), a.image, true);
+                if (!success) {
+                    Logger::instance().log(Error, "Can't load texture : " + a.paths[0]);
+                }
+                a.files[0] = {};
+                return success;
+            }, {read});
+            add_step(asset_index, true, [this](Asset& a) {
+                a.handle = m_factory.create_texture(a.image);
+                a.image = ImageData();
+                return true;
+            }, {decode});
+            break;
+        }
+        case AssetType::SHADER: {
+            uint32_t vertex = add_step(asset_index, false, [](Asset& a) { return read_file(a.paths[0], a.files[0]); }, {});
+            uint32_t fragment = add_step(asset_index, false, [](Asset& a) { return read_file(a.paths[1], a.files[1]); }, {});
+            add_step(asset_index, true, [this](Asset& a) {
+                a.handle = m_factory.create_shader_from_code(
+                    std::string(a.files[0].begin(), a.files[0].end()),
+                    std::string(a.files[1].begin(), a.files[1].end())
+                );
+                a.files[0] = {};
+                a.files[1] = {};
+                return a.handle.index >= 0;
+            }, {vertex, fragment});
+            break;
+        }
+        case AssetType::FONT: {
+            uint32_t read = add_step(asset_index, false, [](Asset& a) { return read_file(a.paths[0], a.files[0]); }, {});
+            uint32_t rasterize = add_step(asset_index, false, [](Asset& a) {
+                bool success = rasterize_font_memory(a.files[0].data(), a.files[0].size(), a.font_size, a.font);
+                if (!success) {
+                    Logger::instance().log(Error, "Can not load font : " + a.paths[0]);
+                }
+                a.files[0] = {};
+                return success;
+            }, {read});
+            add_step(asset_index, true, [this](Asset& a) {
+                a.handle = m_factory.create_font(a.font, a.paths[0]);
+                a.font = FontBitmap();
+                return a.handle.index >= 0;
+            }, {rasterize});
+            break;
+        }
+        case AssetType::SOUND: {
+            // SDL_mixer converts to the device format, kept on the render thread with the other SDL calls
+            uint32_t read = add_step(asset_index, false, [](Asset& a) { return read_file(a.paths[0], a.files[0]); }, {});
+            add_step(asset_index, true, [this](Asset& a) {
+                a.handle = m_factory.create_sound(a.files[0].data(), a.files[0].size(), a.paths[0]);
+                a.files[0] = {};
+                return true;
+            }, {read});
+            break;
+        }
+        case AssetType::MUSIC: {
+            // The music is streamed from its file, nothing to read ahead
+            add_step(asset_index, true, [this](Asset& a) {
+                a.handle = m_factory.create_music(a.paths[0]);
+                return true;
+            }, {});
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void AssetGraphLoader::run_step(uint32_t step_index) {
+    Step& step = m_steps[step_index];
+    Asset& asset = m_assets[step.asset];
+    float start_ms = elapsed_ms();
+
+    // The steps after a failure are skipped, the failure is already logged
+    bool failed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        failed = asset.failed;
+    }
+
+    bool success = failed || step.run(asset);
+    complete_step(step_index, start_ms, success);
+}
+
+void AssetGraphLoader::complete_step(uint32_t step_index, float start_ms, bool success) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Step& step = m_steps[step_index];
+    step.start_ms = start_ms;
+    step.end_ms = elapsed_ms();
+    if (!success) {
+        m_assets[step.asset].failed = true;
+    }
+
+    for (uint32_t next : step.next) {
+        if (--m_steps[next].pending == 0) {
+            m_steps[next].critical_previous = step_index;
+            schedule(next);
+        }
+    }
+
+    m_done++;
+    if (!step.render) {
+        m_running--;
+    }
+    m_changed.notify_all();
+}
+
+void AssetGraphLoader::schedule(uint32_t step) {
+    if (m_steps[step].render) {
+        m_render_ready.push_back(step);
+    }else{
+        m_running++;
+        m_pool.submit([this, step]() { run_step(step); });
+    }
+}
+
+float AssetGraphLoader::elapsed_ms() const {
+    return std::chrono::duration<float, std::milli>(Clock::now() - m_start).count();
+}
+
+}
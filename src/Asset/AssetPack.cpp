@@ -0,0 +1,222 @@
+#include "Asset/AssetPack.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "External/stb_image/stb_image.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace AMB {
+
+AssetPack::AssetPack()
+: m_base(nullptr), m_size(0), m_entries(nullptr), m_entry_count(0), m_names(nullptr), m_names_size(0)
+#ifdef _WIN32
+, m_file(nullptr), m_mapping(nullptr)
+#endif
+{}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+
+    // Map the whole file, the pages are only read when an asset is accessed
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        Logger::instance().log(Error, "Can not open pack : " + path);
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(file, &file_size);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!base) {
+        if (mapping) { CloseHandle(mapping); }
+        CloseHandle(file);
+        Logger::instance().log(Error, "Can not map pack : " + path);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_size = static_cast<size_t>(file_size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        Logger::instance().log(Error, "Can not open pack : " + path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        Logger::instance().log(Error, "Can not read pack : " + path);
+        return false;
+    }
+
+    void* base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        Logger::instance().log(Error, "Can not map pack : " + path);
+        return false;
+    }
+
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    m_base = static_cast<const uint8_t*>(base);
+
+    // Check the header and the bounds of the index
+    PackHeader header;
+    bool valid = m_size >= sizeof(PackHeader);
+    if (valid) {
+        std::memcpy(&header, m_base, sizeof(PackHeader));
+        valid = header.magic == PACK_MAGIC
+             && header.version == PACK_VERSION
+             && header.file_size == m_size
+             && header.index_offset + uint64_t(header.entry_count) * sizeof(PackEntry) <= m_size
+             && header.names_offset + header.names_size <= m_size
+             && header.index_offset % alignof(PackEntry) == 0;
+    }
+    if (!valid) {
+        Logger::instance().log(Error, "Invalid pack : " + path);
+        close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const PackEntry*>(m_base + header.index_offset);
+    m_entry_count = header.entry_count;
+    m_names = reinterpret_cast<const char*>(m_base + header.names_offset);
+    m_names_size = header.names_size;
+
+    return true;
+}
+
+void AssetPack::close() {
+    m_retained.clear();
+
+    if (m_base) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_base);
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        m_mapping = nullptr;
+        m_file = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_base), m_size);
+#endif
+    }
+
+    m_base = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entry_count = 0;
+    m_names = nullptr;
+    m_names_size = 0;
+}
+
+const PackEntry* AssetPack::find(std::string_view name) const {
+    if (!m_base) {
+        return nullptr;
+    }
+
+    std::string normalized = pack_normalize_name(name);
+    uint64_t hash = pack_hash(normalized);
+
+    // Lower bound on the hash, then compare the names of the entries with the same hash
+    size_t low = 0, high = m_entry_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (m_entries[middle].hash < hash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for (size_t i = low; i < m_entry_count && m_entries[i].hash == hash; ++i) {
+        const PackEntry& entry = m_entries[i];
+        if (entry.name_offset < m_names_size && normalized == std::string_view(m_names + entry.name_offset)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPack::contains(std::string_view name) const {
+    return find(name) != nullptr;
+}
+
+PackData AssetPack::get(std::string_view name) const {
+    PackData result;
+
+    const PackEntry* entry = find(name);
+    if (!entry) {
+        Logger::instance().log(Error, "Asset not found in pack : " + std::string(name));
+        return result;
+    }
+    if (entry->offset + entry->size > m_size) {
+        Logger::instance().log(Error, "Corrupted pack entry : " + std::string(name));
+        return result;
+    }
+
+    const uint8_t* payload = m_base + entry->offset;
+
+    // Zero copy
+    if (!(entry->flags & PACK_ENTRY_ZLIB)) {
+        result.data = payload;
+        result.size = entry->size;
+        return result;
+    }
+
+    int decoded_size = 0;
+    char* decoded = stbi_zlib_decode_malloc_guesssize(
+        reinterpret_cast<const char*>(payload), static_cast<int>(entry->size),
+        static_cast<int>(entry->original_size), &decoded_size
+    );
+    if (!decoded || uint64_t(decoded_size) != entry->original_size) {
+        std::free(decoded);
+        Logger::instance().log(Error, "Can not decompress pack entry : " + std::string(name));
+        return result;
+    }
+
+    result.owned = std::shared_ptr<uint8_t>(reinterpret_cast<uint8_t*>(decoded), [](uint8_t* p) { std::free(p); });
+    result.data = result.owned.get();
+    result.size = static_cast<size_t>(decoded_size);
+    return result;
+}
+
+void AssetPack::retain(const PackData& data) const {
+    if (data.owned) {
+        m_retained.push_back(data.owned);
+    }
+}
+
+std::vector<std::string> AssetPack::list() const {
+    std::vector<std::string> names;
+    names.reserve(m_entry_count);
+    for (size_t i = 0; i < m_entry_count; ++i) {
+        if (m_entries[i].name_offset < m_names_size) {
+            names.emplace_back(m_names + m_entries[i].name_offset);
+        }
+    }
+    return names;
+}
+
+}
@@ -0,0 +1,177 @@
+#include "Asset/AsyncTextureLoader.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace AMB {
+
+namespace {
+
+// Bytes uploaded per slice, small enough to keep a slice well under a millisecond
+constexpr size_t SLICE_BYTES = 256 * 1024;
+
+}
+
+AsyncTextureLoader::AsyncTextureLoader(AssetManager& manager, ThreadPool& pool)
+: m_manager(manager), m_pool(pool), m_decoding(0), m_pbo{0, 0}, m_pbo_index(0)
+{
+    glGenBuffers(2, m_pbo);
+}
+
+AsyncTextureLoader::~AsyncTextureLoader() {
+    // The workers push in m_decoded, wait for them before leaving
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_decoded_cv.wait(lock, [this]() { return m_decoding == 0; });
+    }
+
+    for (auto& job : m_uploading) {
+        if (job->texture_id) {
+            glDeleteTextures(1, &job->texture_id);
+        }
+    }
+    glDeleteBuffers(2, m_pbo);
+}
+
+AssetHandle AsyncTextureLoader::load(const std::string& path) {
+    // Placeholder: 1x1 transparent texture
+    uint32_t texture_index;
+    uint8_t placeholder[4] = {0, 0, 0, 0};
+    glGenTextures(1, &texture_index);
+    glBindTexture(GL_TEXTURE_2D, texture_index);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    AssetHandle handle = m_manager.textures.add(texture_index, 1, 1, 4);
+    m_pending.insert(handle.index);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_decoding;
+    }
+
+    // The worker owns the job until it is pushed in m_decoded
+    Job* job = new Job{handle, path, ImageData{}, false, 0, 0};
+    m_pool.submit([this, job]() {
+        job->success = decode_image_file(job->path, job->image, true);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decoded.emplace_back(job);
+        --m_decoding;
+        m_decoded_cv.notify_all();
+    });
+
+    return handle;
+}
+
+void AsyncTextureLoader::update(float budget_ms) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    // Take the decoded images
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& job : m_decoded) {
+            m_uploading.push_back(std::move(job));
+        }
+        m_decoded.clear();
+    }
+
+    bool first = true;
+    while (!m_uploading.empty()) {
+        float elapsed = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+        if (!first && elapsed >= budget_ms) {
+            break;
+        }
+        first = false;
+
+        Job& job = *m_uploading.front();
+        if (upload_slice(job)) {
+            complete(job);
+            m_uploading.pop_front();
+        }
+    }
+}
+
+void AsyncTextureLoader::finish() {
+    while (get_pending_count() > 0) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_decoded_cv.wait(lock, [this]() { return !m_decoded.empty() || m_decoding == 0; });
+        }
+        update(1000.0f);
+    }
+}
+
+bool AsyncTextureLoader::is_pending(AssetHandle handle) const {
+    return m_pending.count(handle.index) > 0;
+}
+
+size_t AsyncTextureLoader::get_pending_count() const {
+    return m_pending.size();
+}
+
+bool AsyncTextureLoader::upload_slice(Job& job) {
+    // Failed decode, the placeholder stays
+    if (!job.success) {
+        return true;
+    }
+
+    // Storage of the final texture, the placeholder is shown until the last slice
+    if (job.texture_id == 0) {
+        glGenTextures(1, &job.texture_id);
+        glBindTexture(GL_TEXTURE_2D, job.texture_id);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, job.image.width, job.image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    size_t row_bytes = size_t(job.image.width) * 4;
+    int32_t rows = std::max<int32_t>(1, int32_t(SLICE_BYTES / row_bytes));
+    rows = std::min(rows, job.image.height - job.next_row);
+    size_t bytes = row_bytes * size_t(rows);
+    const uint8_t* source = job.image.pixels.get() + row_bytes * size_t(job.next_row);
+
+    glBindTexture(GL_TEXTURE_2D, job.texture_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Orphan the buffer so the driver never waits for the previous transfer, then copy the rows
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo[m_pbo_index]);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    void* staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    if (staging) {
+        std::memcpy(staging, source, bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, job.next_row, job.image.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        // Mapping failed, direct upload from the CPU memory
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, job.next_row, job.image.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, source);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_pbo_index = 1 - m_pbo_index;
+
+    job.next_row += rows;
+    return job.next_row >= job.image.height;
+}
+
+void AsyncTextureLoader::complete(Job& job) {
+    m_pending.erase(job.handle.index);
+
+    if (!job.success) {
+        Logger::instance().log(Error, "Can't load texture : " + job.path);
+        return;
+    }
+
+    // The texture may have been removed while loading
+    if (!m_manager.textures.validity(job.handle)) {
+        glDeleteTextures(1, &job.texture_id);
+        return;
+    }
+
+    m_manager.textures.get(job.handle).replace(job.texture_id, job.image.width, job.image.height, 4);
+    job.image.pixels.reset();
+}
+
+}
@@ -0,0 +1,38 @@
+#include "Asset/ImageData.hpp"
+
+#include "External/stb_image/stb_image.h"
+
+namespace AMB {
+
+void ImageDataDeleter::operator()(uint8_t* pixels) const {
+    stbi_image_free(pixels);
+}
+
+bool decode_image_file(const std::string& path, ImageData& image, bool flip) {
+    // Thread local, stbi_set_flip_vertically_on_load would race with the other workers
+    stbi_set_flip_vertically_on_load_thread(flip);
+
+    int width(-1), height(-1), bpp(0);
+    uint8_t* pixels = stbi_load(path.c_str(), &width, &height, &bpp, 4); // 4 because RGBA
+
+    image.pixels.reset(pixels);
+    image.width = pixels ? width : 0;
+    image.height = pixels ? height : 0;
+    image.bpp = bpp;
+    return pixels != nullptr;
+}
+
+bool decode_image_memory(const uint8_t* data, size_t size, ImageData& image, bool flip) {
+    stbi_set_flip_vertically_on_load_thread(flip);
+
+    int width(-1), height(-1), bpp(0);
+    uint8_t* pixels = stbi_load_from_memory(data, static_cast<int>(size), &width, &height, &bpp, 4);
+
+    image.pixels.reset(pixels);
+    image.width = pixels ? width : 0;
+    image.height = pixels ? height : 0;
+    image.bpp = bpp;
+    return pixels != nullptr;
+}
+
+}
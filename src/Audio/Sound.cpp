@@ -26,4 +26,8 @@ void Sound::play_fade(int time, int channel, int loop) {
     Mix_FadeInChannel(channel, m_sound, loop, time);
 }
 
+size_t Sound::get_memory_size() const {
+    return m_sound->alen;
+}
+
 }
\ No newline at end of file
@@ -23,6 +23,17 @@ mat::Mat4f CameraOrthographic::get_vp() {
     return mat::dot(m_projection, m_view);
 }
 
+mat::Mat4f CameraOrthographic::get_inverse_vp() {
+    compute_matrices();
+    // The view is a rotation and a translation, the projection a scale and a translation
+    return mat::dot(mat::inverse_rigid(m_view), mat::inverse_orthographic(m_projection));
+}
+
+mat::Vec2f CameraOrthographic::unproject(const mat::Vec2f& ndc) {
+    mat::BaseVector<float,4> world = mat::dot(get_inverse_vp(), mat::BaseVector<float,4>{ndc[0], ndc[1], 0.0f, 1.0f});
+    return mat::Vec2f{world[0], world[1]};
+}
+
 mat::Vec2f CameraOrthographic::get_position() const {
     return m_position;
 }
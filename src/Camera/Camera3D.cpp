@@ -34,6 +34,17 @@ mat::Mat4f CameraPerspective::get_vp() {
     return mat::dot(m_projection, m_view);
 }
 
+mat::Mat4f CameraPerspective::get_inverse_vp() {
+    compute_matrices();
+    // The view is a rotation and a translation
+    return mat::dot(mat::inverse_rigid(m_view), mat::inverse_perspective(m_projection));
+}
+
+mat::Vec3f CameraPerspective::unproject(const mat::Vec3f& ndc) {
+    mat::BaseVector<float,4> world = mat::dot(get_inverse_vp(), mat::BaseVector<float,4>{ndc[0], ndc[1], ndc[2], 1.0f});
+    return mat::Vec3f{world[0] / world[3], world[1] / world[3], world[2] / world[3]};
+}
+
 mat::Vec3f CameraPerspective::get_position() const {
     return m_position;
 }
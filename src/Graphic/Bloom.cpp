@@ -0,0 +1,221 @@
+#include "Graphic/Bloom.hpp"
+
+namespace AMB {
+
+namespace {
+
+const char* s_bloom_vert =
+"#version 330 core\n"
+"layout(location = 0) in vec2 a_position;\n"
+"layout(location = 1) in vec2 a_uv;\n"
+"out vec2 v_uv;\n"
+"void main() {\n"
+"    v_uv = a_uv;\n"
+"    gl_Position = vec4(a_position, 0.0, 1.0);\n"
+"}\n";
+
+// 5 taps, the first level also applies the soft threshold
+const char* s_bloom_downsample_frag =
+"#version 330 core\n"
+"in vec2 v_uv;\n"
+"out vec4 frag;\n"
+"uniform sampler2D u_texture;\n"
+"uniform vec2 u_offset;\n"
+"uniform int u_prefilter;\n"
+"uniform float u_threshold;\n"
+"uniform float u_knee;\n"
+
+"void main() {\n"
+"    vec4 sum = texture(u_texture, v_uv) * 4.0;\n"
+"    sum += texture(u_texture, v_uv - u_offset);\n"
+"    sum += texture(u_texture, v_uv + u_offset);\n"
+"    sum += texture(u_texture, v_uv + vec2(u_offset.x, -u_offset.y));\n"
+"    sum += texture(u_texture, v_uv - vec2(u_offset.x, -u_offset.y));\n"
+"    vec4 color = sum / 8.0;\n"
+"    if (u_prefilter != 0) {\n"
+"        float brightness = max(color.r, max(color.g, color.b));\n"
+"        float knee = max(u_knee, 1e-5);\n"
+"        float soft = clamp(brightness - u_threshold + knee, 0.0, 2.0 * knee);\n"
+"        soft = soft * soft / (4.0 * knee);\n"
+"        color.rgb *= max(soft, brightness - u_threshold) / max(brightness, 1e-5);\n"
+"    }\n"
+"    frag = color;\n"
+"}\n";
+
+// 8 taps tent filter, also used by the composite
+const char* s_bloom_upsample_frag =
+"#version 330 core\n"
+"in vec2 v_uv;\n"
+"out vec4 frag;\n"
+"uniform sampler2D u_texture;\n"
+"uniform vec2 u_offset;\n"
+
+"vec4 upsample(sampler2D tex, vec2 uv, vec2 d) {\n"
+"    vec4 sum = texture(tex, uv + vec2(-2.0 * d.x, 0.0));\n"
+"    sum += texture(tex, uv + vec2(2.0 * d.x, 0.0));\n"
+"    sum += texture(tex, uv + vec2(0.0, -2.0 * d.y));\n"
+"    sum += texture(tex, uv + vec2(0.0, 2.0 * d.y));\n"
+"    sum += texture(tex, uv + vec2(-d.x, -d.y)) * 2.0;\n"
+"    sum += texture(tex, uv + vec2(d.x, -d.y)) * 2.0;\n"
+"    sum += texture(tex, uv + vec2(-d.x, d.y)) * 2.0;\n"
+"    sum += texture(tex, uv + vec2(d.x, d.y)) * 2.0;\n"
+"    return sum / 12.0;\n"
+"}\n"
+
+"void main() {\n"
+"    frag = upsample(u_texture, v_uv, u_offset);\n"
+"}\n";
+
+const char* s_bloom_composite_frag =
+"#version 330 core\n"
+"in vec2 v_uv;\n"
+"out vec4 frag;\n"
+"uniform sampler2D u_scene;\n"
+"uniform sampler2D u_bloom;\n"
+"uniform vec2 u_offset;\n"
+"uniform float u_intensity;\n"
+
+"vec4 upsample(sampler2D tex, vec2 uv, vec2 d) {\n"
+"    vec4 sum = texture(tex, uv + vec2(-2.0 * d.x, 0.0));\n"
+"    sum += texture(tex, uv + vec2(2.0 * d.x, 0.0));\n"
+"    sum += texture(tex, uv + vec2(0.0, -2.0 * d.y));\n"
+"    sum += texture(tex, uv + vec2(0.0, 2.0 * d.y));\n"
+"    sum += texture(tex, uv + vec2(-d.x, -d.y)) * 2.0;\n"
+"    sum += texture(tex, uv + vec2(d.x, -d.y)) * 2.0;\n"
+"    sum += texture(tex, uv + vec2(-d.x, d.y)) * 2.0;\n"
+"    sum += texture(tex, uv + vec2(d.x, d.y)) * 2.0;\n"
+"    return sum / 12.0;\n"
+"}\n"
+
+"void main() {\n"
+"    vec4 scene = texture(u_scene, v_uv);\n"
+"    vec3 bloom = upsample(u_bloom, v_uv, u_offset).rgb;\n"
+"    frag = vec4(scene.rgb + bloom * u_intensity, scene.a);\n"
+"}\n";
+
+Shader* load_bloom_shader(AssetManager& asset_manager, AssetFactory& asset_factory, const char* frag) {
+    AssetHandle handle = asset_factory.create_shader_from_code(s_bloom_vert, frag);
+    if (!asset_manager.shaders.validity(handle)) {
+        Logger::instance().log(Fatal, "Bloom can not load its shaders.");
+        exit(EXIT_FAILURE);
+    }
+    return &asset_manager.shaders.get(handle);
+}
+
+}
+
+Bloom::Bloom(RenderTargetPool& pool, AssetManager& asset_manager, AssetFactory& asset_factory, std::shared_ptr<VertexArray> quad, const BloomSettings& settings)
+: m_pool(pool), m_quad(quad), m_settings(settings)
+{
+    m_downsample_shader = load_bloom_shader(asset_manager, asset_factory, s_bloom_downsample_frag);
+    m_upsample_shader = load_bloom_shader(asset_manager, asset_factory, s_bloom_upsample_frag);
+    m_composite_shader = load_bloom_shader(asset_manager, asset_factory, s_bloom_composite_frag);
+}
+
+void Bloom::set_settings(const BloomSettings& settings) {
+    m_settings = settings;
+}
+
+const BloomSettings& Bloom::get_settings() const {
+    return m_settings;
+}
+
+FrameBuffer* Bloom::apply(uint32_t scene_texture) {
+    int32_t width = m_pool.get_screen_width();
+    int32_t height = m_pool.get_screen_height();
+    uint32_t levels = bloom_level_count(width, height, m_settings.levels);
+    if (levels == 0) {
+        return nullptr;
+    }
+
+    // Half float levels keep the values above 1 and the precision of the accumulation
+    m_chain.clear();
+    for (uint32_t i = 0; i < levels; ++i) {
+        m_chain.push_back(m_pool.acquire_screen(FrameBufferFormat::RGBA16F, false, i + 1, TextureFilter::LINEAR));
+    }
+
+    // Scene texture may be nearest filtered, the taps rely on bilinear fetches
+    glBindTexture(GL_TEXTURE_2D, scene_texture);
+    GLint scene_min_filter, scene_mag_filter;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &scene_min_filter);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &scene_mag_filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // --- down chain ---
+    m_downsample_shader->use_shader();
+    m_downsample_shader->set_1i("u_texture", 0);
+    m_downsample_shader->set_1f("u_threshold", m_settings.threshold);
+    m_downsample_shader->set_1f("u_knee", m_settings.knee);
+
+    uint32_t source = scene_texture;
+    float source_width = float(width);
+    float source_height = float(height);
+    for (size_t i = 0; i < m_chain.size(); ++i) {
+        m_chain[i]->bind();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, source);
+        m_downsample_shader->set_1i("u_prefilter", i == 0);
+        m_downsample_shader->set_2f("u_offset", mat::Vec2f{m_settings.radius / source_width, m_settings.radius / source_height});
+        draw_quad();
+
+        source = m_chain[i]->get_color_texture();
+        source_width = float(m_chain[i]->get_width());
+        source_height = float(m_chain[i]->get_height());
+    }
+
+    // --- up chain, accumulated in the down chain ---
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    m_upsample_shader->use_shader();
+    m_upsample_shader->set_1i("u_texture", 0);
+    for (size_t i = m_chain.size() - 1; i > 0; --i) {
+        FrameBuffer& src = *m_chain[i];
+        m_chain[i - 1]->bind();
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, src.get_color_texture());
+        m_upsample_shader->set_2f("u_offset", mat::Vec2f{0.5f * m_settings.radius / float(src.get_width()), 0.5f * m_settings.radius / float(src.get_height())});
+        draw_quad();
+    }
+
+    glDisable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // --- composite ---
+    FrameBuffer& level0 = *m_chain[0];
+    FrameBuffer* output = m_pool.acquire_screen(FrameBufferFormat::RGBA8, false);
+    output->bind();
+    m_composite_shader->use_shader();
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, scene_texture);
+    m_composite_shader->set_1i("u_scene", 0);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, level0.get_color_texture());
+    m_composite_shader->set_1i("u_bloom", 1);
+
+    m_composite_shader->set_2f("u_offset", mat::Vec2f{0.5f * m_settings.radius / float(level0.get_width()), 0.5f * m_settings.radius / float(level0.get_height())});
+    m_composite_shader->set_1f("u_intensity", m_settings.intensity / float(m_chain.size()));
+    draw_quad();
+
+    // Restore the scene filtering
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, scene_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, scene_min_filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, scene_mag_filter);
+
+    for (FrameBuffer* level : m_chain) {
+        m_pool.release(level);
+    }
+
+    return output;
+}
+
+void Bloom::draw_quad() {
+    m_quad->bind();
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+}
+
+}
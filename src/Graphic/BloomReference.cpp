@@ -0,0 +1,183 @@
+#include "Graphic/BloomReference.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AMB {
+
+namespace {
+
+// Bilinear fetch with clamp to edge, uv in [0, 1] like texture() in GLSL
+void sample(const BloomImage& image, float u, float v, float* out) {
+    float x = u * float(image.width) - 0.5f;
+    float y = v * float(image.height) - 0.5f;
+
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    float tx = x - fx;
+    float ty = y - fy;
+
+    int32_t x0 = std::clamp(int32_t(fx), 0, image.width - 1);
+    int32_t y0 = std::clamp(int32_t(fy), 0, image.height - 1);
+    int32_t x1 = std::clamp(int32_t(fx) + 1, 0, image.width - 1);
+    int32_t y1 = std::clamp(int32_t(fy) + 1, 0, image.height - 1);
+
+    const float* p00 = image.at(x0, y0);
+    const float* p10 = image.at(x1, y0);
+    const float* p01 = image.at(x0, y1);
+    const float* p11 = image.at(x1, y1);
+
+    for (int c = 0; c < 4; ++c) {
+        float bottom = p00[c] + (p10[c] - p00[c]) * tx;
+        float top = p01[c] + (p11[c] - p01[c]) * tx;
+        out[c] = bottom + (top - bottom) * ty;
+    }
+}
+
+// Accumulate a weighted sample
+void add_sample(const BloomImage& image, float u, float v, float weight, float* acc) {
+    float color[4];
+    sample(image, u, v, color);
+    for (int c = 0; c < 4; ++c) {
+        acc[c] += color[c] * weight;
+    }
+}
+
+// Soft threshold: quadratic curve in [threshold - knee, threshold + knee], linear after
+void prefilter(float* color, const BloomSettings& settings) {
+    float brightness = std::max(color[0], std::max(color[1], color[2]));
+    float knee = std::max(settings.knee, 1e-5f);
+    float soft = std::clamp(brightness - settings.threshold + knee, 0.0f, 2.0f * knee);
+    soft = soft * soft / (4.0f * knee);
+    float contribution = std::max(soft, brightness - settings.threshold) / std::max(brightness, 1e-5f);
+    for (int c = 0; c < 3; ++c) {
+        color[c] *= contribution;
+    }
+}
+
+// 5 taps: center x4 and the 4 diagonals, each bilinear fetch averages 4 texels
+void downsample(const BloomImage& src, BloomImage& dst, const BloomSettings& settings, bool first) {
+    float ox = settings.radius / float(src.width);
+    float oy = settings.radius / float(src.height);
+
+    for (int32_t y = 0; y < dst.height; ++y) {
+        for (int32_t x = 0; x < dst.width; ++x) {
+            float u = (float(x) + 0.5f) / float(dst.width);
+            float v = (float(y) + 0.5f) / float(dst.height);
+
+            float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            add_sample(src, u, v, 4.0f, acc);
+            add_sample(src, u - ox, v - oy, 1.0f, acc);
+            add_sample(src, u + ox, v + oy, 1.0f, acc);
+            add_sample(src, u + ox, v - oy, 1.0f, acc);
+            add_sample(src, u - ox, v + oy, 1.0f, acc);
+
+            float* out = dst.at(x, y);
+            for (int c = 0; c < 4; ++c) {
+                out[c] = acc[c] / 8.0f;
+            }
+            if (first) {
+                prefilter(out, settings);
+            }
+        }
+    }
+}
+
+// 8 taps tent: 4 axis taps at twice the offset (weight 1) and 4 diagonals (weight 2)
+void upsample_at(const BloomImage& src, float u, float v, const BloomSettings& settings, float* out) {
+    float ox = 0.5f * settings.radius / float(src.width);
+    float oy = 0.5f * settings.radius / float(src.height);
+
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    add_sample(src, u - 2.0f * ox, v, 1.0f, acc);
+    add_sample(src, u + 2.0f * ox, v, 1.0f, acc);
+    add_sample(src, u, v - 2.0f * oy, 1.0f, acc);
+    add_sample(src, u, v + 2.0f * oy, 1.0f, acc);
+    add_sample(src, u - ox, v - oy, 2.0f, acc);
+    add_sample(src, u + ox, v - oy, 2.0f, acc);
+    add_sample(src, u - ox, v + oy, 2.0f, acc);
+    add_sample(src, u + ox, v + oy, 2.0f, acc);
+
+    for (int c = 0; c < 4; ++c) {
+        out[c] = acc[c] / 12.0f;
+    }
+}
+
+// Upsample src and add it on dst (additive blending on the GPU)
+void upsample_add(const BloomImage& src, BloomImage& dst, const BloomSettings& settings) {
+    for (int32_t y = 0; y < dst.height; ++y) {
+        for (int32_t x = 0; x < dst.width; ++x) {
+            float u = (float(x) + 0.5f) / float(dst.width);
+            float v = (float(y) + 0.5f) / float(dst.height);
+
+            float color[4];
+            upsample_at(src, u, v, settings, color);
+
+            float* out = dst.at(x, y);
+            for (int c = 0; c < 4; ++c) {
+                out[c] += color[c];
+            }
+        }
+    }
+}
+
+}
+
+int32_t bloom_level_size(int32_t size, uint32_t level) {
+    return std::max(size >> (level + 1), 1);
+}
+
+uint32_t bloom_level_count(int32_t width, int32_t height, uint32_t levels) {
+    uint32_t count = 0;
+    while (count < levels) {
+        ++count;
+        if (bloom_level_size(width, count - 1) == 1 && bloom_level_size(height, count - 1) == 1) {
+            break;
+        }
+    }
+    return count;
+}
+
+BloomImage bloom_reference(const BloomImage& scene, const BloomSettings& settings) {
+    uint32_t levels = bloom_level_count(scene.width, scene.height, settings.levels);
+    if (levels == 0 || scene.width <= 0 || scene.height <= 0) {
+        return scene;
+    }
+
+    // Down chain
+    std::vector<BloomImage> chain;
+    chain.reserve(levels);
+    for (uint32_t i = 0; i < levels; ++i) {
+        chain.emplace_back(bloom_level_size(scene.width, i), bloom_level_size(scene.height, i));
+        downsample(i == 0 ? scene : chain[i - 1], chain[i], settings, i == 0);
+    }
+
+    // Up chain, accumulated in the down chain
+    for (uint32_t i = levels - 1; i > 0; --i) {
+        upsample_add(chain[i], chain[i - 1], settings);
+    }
+
+    // Composite: the accumulated bloom is normalized by the number of levels
+    BloomImage result(scene.width, scene.height);
+    float scale = settings.intensity / float(levels);
+    for (int32_t y = 0; y < scene.height; ++y) {
+        for (int32_t x = 0; x < scene.width; ++x) {
+            float u = (float(x) + 0.5f) / float(scene.width);
+            float v = (float(y) + 0.5f) / float(scene.height);
+
+            float bloom[4];
+            upsample_at(chain[0], u, v, settings, bloom);
+
+            const float* in = scene.at(x, y);
+            float* out = result.at(x, y);
+            for (int c = 0; c < 3; ++c) {
+                out[c] = in[c] + bloom[c] * scale;
+            }
+            out[3] = in[3];
+        }
+    }
+
+    return result;
+}
+
+}
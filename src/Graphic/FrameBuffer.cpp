@@ -2,8 +2,8 @@
 
 namespace AMB{
 
-FrameBuffer::FrameBuffer(int width, int height) 
-: m_width(width), m_height(height)
+FrameBuffer::FrameBuffer(int width, int height, FrameBufferFormat format, TextureFilter filter, bool depth) 
+: m_fbo(0), m_color_texture(0), m_rbo(0), m_width(width), m_height(height), m_format(format), m_filter(filter), m_depth(depth)
 {
     reset();
 }
@@ -18,7 +18,8 @@ void FrameBuffer::reset() {
     if (m_fbo) {
         glDeleteFramebuffers(1, &m_fbo);
         glDeleteTextures(1, &m_color_texture);
-        glDeleteRenderbuffers(1, &m_rbo);
+        if (m_rbo) { glDeleteRenderbuffers(1, &m_rbo); }
+        m_rbo = 0;
     }
 
     // Generate framebuffer
@@ -30,21 +31,23 @@ void FrameBuffer::reset() {
     glBindTexture(GL_TEXTURE_2D, m_color_texture);
 
     // Create texture 2D
+    bool half_float = m_format == FrameBufferFormat::RGBA16F;
     glTexImage2D(
         GL_TEXTURE_2D,
         0,
-        GL_RGBA8,
+        half_float ? GL_RGBA16F : GL_RGBA8,
         m_width,
         m_height,
         0,
         GL_RGBA,
-        GL_UNSIGNED_BYTE,
+        half_float ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE,
         nullptr
     );
 
-    // Set paramters of the texture
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    // Set paramters of the texture (only nearest and linear make sense without mipmaps)
+    GLenum gl_filter = m_filter == TextureFilter::LINEAR ? GL_LINEAR : GL_NEAREST;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -59,23 +62,25 @@ void FrameBuffer::reset() {
     );
 
     // Generate renderbuffer !!! NEED TO DISABLE DEPTH TEST !!!
-    glGenRenderbuffers(1, &m_rbo);
-    glBindRenderbuffer(GL_RENDERBUFFER, m_rbo);
-
-    glRenderbufferStorage(
-        GL_RENDERBUFFER,
-        GL_DEPTH24_STENCIL8,
-        m_width,
-        m_height
-    );
-
-    // Attach renderbuffer
-    glFramebufferRenderbuffer(
-        GL_FRAMEBUFFER,
-        GL_DEPTH_STENCIL_ATTACHMENT,
-        GL_RENDERBUFFER,
-        m_rbo
-    );
+    if (m_depth) {
+        glGenRenderbuffers(1, &m_rbo);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_rbo);
+
+        glRenderbufferStorage(
+            GL_RENDERBUFFER,
+            GL_DEPTH24_STENCIL8,
+            m_width,
+            m_height
+        );
+
+        // Attach renderbuffer
+        glFramebufferRenderbuffer(
+            GL_FRAMEBUFFER,
+            GL_DEPTH_STENCIL_ATTACHMENT,
+            GL_RENDERBUFFER,
+            m_rbo
+        );
+    }
 
     // Tell OpenGL which color buffers to draw into
     GLenum buffers[1] = { GL_COLOR_ATTACHMENT0 };
@@ -102,4 +107,23 @@ uint32_t FrameBuffer::get_color_texture() const {
     return m_color_texture;
 }
 
+void FrameBuffer::set_filter(TextureFilter filter) {
+    if (filter == m_filter) {
+        return;
+    }
+    m_filter = filter;
+
+    GLenum gl_filter = m_filter == TextureFilter::LINEAR ? GL_LINEAR : GL_NEAREST;
+    glBindTexture(GL_TEXTURE_2D, m_color_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, gl_filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, gl_filter);
+}
+
+size_t FrameBuffer::get_memory_size() const {
+    size_t pixels = size_t(m_width) * size_t(m_height);
+    size_t color = pixels * (m_format == FrameBufferFormat::RGBA16F ? 8 : 4);
+    size_t depth = m_depth ? pixels * 4 : 0; // DEPTH24_STENCIL8
+    return color + depth;
+}
+
 }
\ No newline at end of file
@@ -3,8 +3,18 @@
 namespace AMB {
 
 PostProcessor::PostProcessor(uint32_t width, uint32_t height, AssetManager& asset_manager, AssetFactory& asset_factory) 
-: m_scene_fbo(width, height), m_pingpong_fbo{FrameBuffer(width, height), FrameBuffer(width, height)}, m_vao(nullptr), m_vbo(nullptr), m_ibo(nullptr), m_width(width), m_height(height)
+: m_own_pool(std::make_unique<RenderTargetPool>(width, height)), m_pool(m_own_pool.get()), m_scene_fbo(nullptr), m_vao(nullptr), m_vbo(nullptr), m_ibo(nullptr), m_bloom(nullptr), m_asset_manager(asset_manager), m_asset_factory(asset_factory)
 {
+    init();
+}
+
+PostProcessor::PostProcessor(RenderTargetPool& pool, AssetManager& asset_manager, AssetFactory& asset_factory) 
+: m_own_pool(nullptr), m_pool(&pool), m_scene_fbo(nullptr), m_vao(nullptr), m_vbo(nullptr), m_ibo(nullptr), m_bloom(nullptr), m_asset_manager(asset_manager), m_asset_factory(asset_factory)
+{
+    init();
+}
+
+void PostProcessor::init() {
     VertexAttribLayout layout;
     layout.add_float(2); // Position
     layout.add_float(2); // UV coordinates
@@ -52,17 +62,29 @@ PostProcessor::PostProcessor(uint32_t width, uint32_t height, AssetManager& asse
     "    gl_Position = vec4(a_position, 0.0, 1.0);\n"
     "}\n";
 
-    AMB::AssetHandle handle_shader = asset_factory.create_shader_from_code(vert, frag);
-    if (!asset_manager.shaders.validity(handle_shader)) {
+    AMB::AssetHandle handle_shader = m_asset_factory.create_shader_from_code(vert, frag);
+    if (!m_asset_manager.shaders.validity(handle_shader)) {
         Logger::instance().log(Fatal, "Postprocessor can not load final shader.");
         exit(EXIT_FAILURE);
     }
-    m_final_shader = &asset_manager.shaders.get(handle_shader);
+    m_final_shader = &m_asset_manager.shaders.get(handle_shader);
+}
+
+void PostProcessor::resize(uint32_t width, uint32_t height) {
+    m_pool->set_screen_size(width, height);
+}
+
+RenderTargetPool& PostProcessor::get_pool() {
+    return *m_pool;
 }
 
 void PostProcessor::begin() {
-    m_scene_fbo.bind();
-    glViewport(0, 0, m_scene_fbo.get_width(), m_scene_fbo.get_height());
+    if (m_own_pool) {
+        m_own_pool->begin_frame();
+    }
+
+    m_scene_fbo = m_pool->acquire_screen(FrameBufferFormat::RGBA8, true);
+    m_scene_fbo->bind();
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
@@ -74,6 +96,22 @@ void PostProcessor::clear_effect() {
     m_effects.clear();
 }
 
+void PostProcessor::enable_bloom(const BloomSettings& settings) {
+    if (m_bloom) {
+        m_bloom->set_settings(settings);
+        return;
+    }
+    m_bloom = std::make_unique<Bloom>(*m_pool, m_asset_manager, m_asset_factory, m_vao, settings);
+}
+
+void PostProcessor::disable_bloom() {
+    m_bloom.reset();
+}
+
+Bloom* PostProcessor::get_bloom() {
+    return m_bloom.get();
+}
+
 void PostProcessor::end() {
     glDisable(GL_PROGRAM_POINT_SIZE);
     glDisable(GL_DEPTH_TEST);
@@ -81,12 +119,24 @@ void PostProcessor::end() {
     glDisable(GL_BLEND);
 
 
+    if (!m_scene_fbo) {
+        Logger::instance().log(Error, "PostProcessor::end called without begin.");
+        return;
+    }
+
+    // The effects do not need depth, the ping-pong targets are color only
+    FrameBuffer* pingpong_fbo[2] = {nullptr, nullptr};
+    if (!m_effects.empty()) {
+        pingpong_fbo[0] = m_pool->acquire_screen(FrameBufferFormat::RGBA8, false);
+        pingpong_fbo[1] = m_pool->acquire_screen(FrameBufferFormat::RGBA8, false);
+    }
+
     int ping_pong_id = 0;
-    uint32_t scene_texture = m_scene_fbo.get_color_texture();
+    uint32_t scene_texture = m_scene_fbo->get_color_texture();
     uint32_t effect_texture = scene_texture;
 
     for (auto& effect : m_effects) {
-        m_pingpong_fbo[ping_pong_id].bind();
+        pingpong_fbo[ping_pong_id]->bind();
         effect.shader->use_shader();
 
         if(effect.mode == AMB::PostProcessMode::single) {
@@ -126,7 +176,7 @@ void PostProcessor::end() {
 
         draw_full_screen_quad();
 
-        uint32_t output = m_pingpong_fbo[ping_pong_id].get_color_texture();
+        uint32_t output = pingpong_fbo[ping_pong_id]->get_color_texture();
 
         if (effect.scene_modifier) {
             scene_texture = output;
@@ -138,9 +188,20 @@ void PostProcessor::end() {
         ping_pong_id = 1 - ping_pong_id; // Swap 0 <-> 1
     }
 
+    FrameBuffer* bloom_fbo = nullptr;
+    if (m_bloom) {
+        bloom_fbo = m_bloom->apply(scene_texture);
+        if (bloom_fbo) {
+            scene_texture = bloom_fbo->get_color_texture();
+        }
+    }
+
+    int width = m_pool->get_screen_width();
+    int height = m_pool->get_screen_height();
+
     // --- final pass ---
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(0, 0, m_width, m_height);
+    glViewport(0, 0, width, height);
 
     m_final_shader->use_shader();
 
@@ -155,7 +216,14 @@ void PostProcessor::end() {
     glDepthMask(GL_TRUE);
     glEnable(GL_BLEND);
 
-    glViewport(0, 0, m_width, m_height);
+    glViewport(0, 0, width, height);
+
+    // Give back the transient targets
+    m_pool->release(bloom_fbo);
+    m_pool->release(pingpong_fbo[0]);
+    m_pool->release(pingpong_fbo[1]);
+    m_pool->release(m_scene_fbo);
+    m_scene_fbo = nullptr;
 }
 
 void PostProcessor::draw_full_screen_quad() {
@@ -0,0 +1,104 @@
+#include "Graphic/RenderTargetPool.hpp"
+
+#include <algorithm>
+
+namespace AMB {
+
+RenderTargetPool::RenderTargetPool(int32_t screen_width, int32_t screen_height, uint32_t max_idle_frames)
+: m_screen_width(screen_width), m_screen_height(screen_height), m_max_idle_frames(max_idle_frames), m_frame(0)
+{}
+
+void RenderTargetPool::begin_frame() {
+    ++m_frame;
+
+    std::erase_if(m_entries, [&](const Entry& entry) {
+        return !entry.in_use && m_frame - entry.last_used > m_max_idle_frames;
+    });
+}
+
+FrameBuffer* RenderTargetPool::acquire(const RenderTargetDesc& desc, TextureFilter filter) {
+    for (auto& entry : m_entries) {
+        if (!entry.in_use && entry.desc == desc) {
+            entry.in_use = true;
+            entry.last_used = m_frame;
+            entry.target->set_filter(filter);
+            return entry.target.get();
+        }
+    }
+
+    m_entries.push_back(Entry{
+        std::make_unique<FrameBuffer>(desc.width, desc.height, desc.format, filter, desc.depth),
+        desc,
+        true,
+        m_frame
+    });
+    return m_entries.back().target.get();
+}
+
+FrameBuffer* RenderTargetPool::acquire_screen(FrameBufferFormat format, bool depth, uint32_t downscale, TextureFilter filter) {
+    RenderTargetDesc desc{
+        std::max(m_screen_width >> downscale, 1),
+        std::max(m_screen_height >> downscale, 1),
+        format,
+        depth
+    };
+    return acquire(desc, filter);
+}
+
+void RenderTargetPool::release(FrameBuffer* target) {
+    if (!target) {
+        return;
+    }
+
+    for (auto& entry : m_entries) {
+        if (entry.target.get() == target) {
+            entry.in_use = false;
+            entry.last_used = m_frame;
+            return;
+        }
+    }
+    Logger::instance().log(Warning, "RenderTargetPool: release of a target not owned by the pool.");
+}
+
+void RenderTargetPool::set_screen_size(int32_t width, int32_t height) {
+    if (width == m_screen_width && height == m_screen_height) {
+        return;
+    }
+    m_screen_width = width;
+    m_screen_height = height;
+
+    // Screen sized targets are acquired again each frame with the new size
+    trim();
+}
+
+void RenderTargetPool::trim() {
+    std::erase_if(m_entries, [](const Entry& entry) {
+        return !entry.in_use;
+    });
+}
+
+size_t RenderTargetPool::memory_usage() const {
+    size_t size = 0;
+    for (const auto& entry : m_entries) {
+        size += entry.target->get_memory_size();
+    }
+    return size;
+}
+
+size_t RenderTargetPool::get_target_count() const {
+    return m_entries.size();
+}
+
+void RenderTargetPool::report() const {
+    Logger::instance().log(Info, "RenderTargetPool: " + std::to_string(m_entries.size()) + " targets, "
+        + std::to_string(memory_usage() / 1024) + " KiB");
+
+    for (const auto& entry : m_entries) {
+        Logger::instance().log(Info, "    " + std::to_string(entry.desc.width) + "x" + std::to_string(entry.desc.height)
+            + (entry.desc.format == FrameBufferFormat::RGBA16F ? " RGBA16F" : " RGBA8")
+            + (entry.desc.depth ? " +depth" : "")
+            + (entry.in_use ? " in use" : " free"));
+    }
+}
+
+}
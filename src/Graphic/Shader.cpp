@@ -1,10 +1,27 @@
 #include "Graphic/Shader.hpp"
 
+#include "Graphic/ShaderCache.hpp"
+#include "Logger/Logger.hpp"
+
 namespace AMB {
 
 Shader::Shader(int32_t index)
-: m_index(index)
+: m_index(index), m_pending(false), m_valid(true), m_vertex_shader(0), m_fragment_shader(0), m_cache(nullptr), m_cache_key(0)
 {
+    find_uniforms();
+}
+
+Shader::Shader(int32_t index, uint32_t vertex_shader, uint32_t fragment_shader, ShaderCache* cache, uint64_t cache_key)
+: m_index(index), m_pending(true), m_valid(false), m_vertex_shader(vertex_shader), m_fragment_shader(fragment_shader), m_cache(cache), m_cache_key(cache_key)
+{}
+
+Shader::~Shader() {
+    if (m_vertex_shader)    { glDeleteShader(m_vertex_shader); }
+    if (m_fragment_shader)  { glDeleteShader(m_fragment_shader); }
+    glDeleteProgram(m_index);
+}
+
+void Shader::find_uniforms() const {
     // Find all uniform variables
     int uniform_count = 0;
 
@@ -27,84 +44,153 @@ Shader::Shader(int32_t index)
     }
 }
 
-Shader::~Shader() {
-    glDeleteProgram(m_index);
+void Shader::resolve() const {
+    if (!m_pending) {
+        return;
+    }
+    m_pending = false;
+
+    // Define error variable
+    int success;
+    char info_log[512];
+
+    // Compile errors are only reported here, the link status alone does not say which stage failed
+    const std::pair<uint32_t, const char*> stages[2] = {{m_vertex_shader, "vertex"}, {m_fragment_shader, "fragment"}};
+    for (const auto& [shader, name] : stages) {
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(shader, 512, NULL, info_log);
+            Logger::instance().log(Error, "Can not compile " + std::string(name) + " shader. Error :\n" + std::string(info_log));
+        }
+    }
+
+    glGetProgramiv(m_index, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(m_index, 512, NULL, info_log);
+        Logger::instance().log(Error, "Can not bind shader to shader program. Error :\n" + std::string(info_log));
+    }
+    m_valid = success;
+
+    // The shaders are not needed once the program is linked
+    glDetachShader(m_index, m_vertex_shader);
+    glDetachShader(m_index, m_fragment_shader);
+    glDeleteShader(m_vertex_shader);
+    glDeleteShader(m_fragment_shader);
+    m_vertex_shader = 0;
+    m_fragment_shader = 0;
+
+    if (!m_valid) {
+        return;
+    }
+
+    find_uniforms();
+
+    if (m_cache) {
+        m_cache->store(m_cache_key, m_index);
+    }
 }
 
 void Shader::use_shader() const {
+    resolve();
     glUseProgram(m_index);
 }
 
+bool Shader::is_valid() const {
+    resolve();
+    return m_valid;
+}
+
+bool Shader::is_ready() const {
+    if (!m_pending) {
+        return true;
+    }
+    if (!GLAD_GL_KHR_parallel_shader_compile) {
+        return false;
+    }
+
+    GLint completed = GL_FALSE;
+    glGetProgramiv(m_index, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_TRUE;
+}
+
 const std::unordered_map<std::string, int>& Shader::get_uniform_map() const {
+    resolve();
     return m_uniform_map;
 }
 
 bool Shader::uniform_validity(const std::string& var_name) const {
+    resolve();
     return m_uniform_map.find(var_name) != m_uniform_map.end();
 }
 
+int Shader::get_location(const std::string& var_name) const {
+    resolve();
+    auto it = m_uniform_map.find(var_name);
+    return it != m_uniform_map.end() ? it->second : -1;
+}
+
 void Shader::set_1i(const std::string& var_name, int var) {
-    glUniform1i(m_uniform_map[var_name], var);
+    glUniform1i(get_location(var_name), var);
 }
 
 void Shader::set_1f(const std::string& var_name, float var) {
-    glUniform1f(m_uniform_map[var_name], var);
+    glUniform1f(get_location(var_name), var);
 }
 
 void Shader::set_1d(const std::string& var_name, double var) {
-    glUniform1d(m_uniform_map[var_name], var);
+    glUniform1d(get_location(var_name), var);
 }
 
 void Shader::set_2i(const std::string& var_name, const mat::Vec2i& var) {
-    glUniform2i(m_uniform_map[var_name], var[0], var[1]);
+    glUniform2i(get_location(var_name), var[0], var[1]);
 }
 
 void Shader::set_2f(const std::string& var_name, const mat::Vec2f& var) {
-    glUniform2f(m_uniform_map[var_name], var[0], var[1]);
+    glUniform2f(get_location(var_name), var[0], var[1]);
 }
 
 void Shader::set_2d(const std::string& var_name, const mat::Vec2d& var) {
-    glUniform2d(m_uniform_map[var_name], var[0], var[1]);
+    glUniform2d(get_location(var_name), var[0], var[1]);
 }
 
 void Shader::set_3i(const std::string& var_name, const mat::Vec3i& var) {
-    glUniform3i(m_uniform_map[var_name], var[0], var[1], var[2]);
+    glUniform3i(get_location(var_name), var[0], var[1], var[2]);
 }
 
 void Shader::set_3f(const std::string& var_name, const mat::Vec3f& var) {
-    glUniform3f(m_uniform_map[var_name], var[0], var[1], var[2]);
+    glUniform3f(get_location(var_name), var[0], var[1], var[2]);
 }
 
 void Shader::set_3d(const std::string& var_name, const mat::Vec3d& var) {
-    glUniform3d(m_uniform_map[var_name], var[0], var[1], var[2]);
+    glUniform3d(get_location(var_name), var[0], var[1], var[2]);
 }
 
 void Shader::set_4i(const std::string& var_name, const mat::Vec4i& var) {
-    glUniform4i(m_uniform_map[var_name], var[0], var[1], var[2], var[3]);
+    glUniform4i(get_location(var_name), var[0], var[1], var[2], var[3]);
 }
 
 void Shader::set_4f(const std::string& var_name, const mat::Vec4f& var) {
-    glUniform4f(m_uniform_map[var_name], var[0], var[1], var[2], var[3]);
+    glUniform4f(get_location(var_name), var[0], var[1], var[2], var[3]);
 }
 
 void Shader::set_4d(const std::string& var_name, const mat::Vec4d& var) {
-    glUniform4d(m_uniform_map[var_name], var[0], var[1], var[2], var[3]);
+    glUniform4d(get_location(var_name), var[0], var[1], var[2], var[3]);
 }
 
 void Shader::set_mat3f(const std::string& var_name, const mat::Mat3f& var) {
-    glUniformMatrix3fv(m_uniform_map[var_name], 1, false, &var(0,0));
+    glUniformMatrix3fv(get_location(var_name), 1, false, &var(0,0));
 }
 
 void Shader::set_mat3d(const std::string& var_name, const mat::Mat3d& var) {
-    glUniformMatrix3dv(m_uniform_map[var_name], 1, false, &var(0,0));
+    glUniformMatrix3dv(get_location(var_name), 1, false, &var(0,0));
 }
 
 void Shader::set_mat4f(const std::string& var_name, const mat::Mat4f& var) {
-    glUniformMatrix4fv(m_uniform_map[var_name], 1, false, &var(0,0));
+    glUniformMatrix4fv(get_location(var_name), 1, false, &var(0,0));
 }
 
 void Shader::set_mat4d(const std::string& var_name, const mat::Mat4d& var) {
-    glUniformMatrix4dv(m_uniform_map[var_name], 1, false, &var(0,0));
+    glUniformMatrix4dv(get_location(var_name), 1, false, &var(0,0));
 }
 
 }
\ No newline at end of file
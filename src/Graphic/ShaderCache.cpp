@@ -0,0 +1,188 @@
+#include "Graphic/ShaderCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+
+namespace AMB {
+
+namespace {
+
+// File header of a cache entry
+constexpr uint32_t CACHE_MAGIC = 0x53424D41; // "AMBS"
+constexpr uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+uint64_t fnv1a(uint64_t hash, const std::string& data) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    // Separator so that ("ab", "c") and ("a", "bc") do not collide
+    hash ^= 0xFF;
+    hash *= 0x100000001B3ull;
+    return hash;
+}
+
+std::string gl_string(GLenum name) {
+    const GLubyte* str = glGetString(name);
+    return str ? std::string(reinterpret_cast<const char*>(str)) : std::string();
+}
+
+}
+
+ShaderCache::ShaderCache(const std::string& directory)
+: m_directory(directory), m_initialized(false), m_supported(false), m_hit_count(0), m_miss_count(0)
+{}
+
+void ShaderCache::init() {
+    if (m_initialized) {
+        return;
+    }
+    m_initialized = true;
+
+    GLint format_count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    if (format_count <= 0) {
+        Logger::instance().log(Warning, "Shader cache disabled, the driver does not support program binaries.");
+        return;
+    }
+
+    m_driver = gl_string(GL_VENDOR) + "|" + gl_string(GL_RENDERER) + "|" + gl_string(GL_VERSION);
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) {
+        Logger::instance().log(Warning, "Shader cache disabled, can not create the directory : " + m_directory);
+        return;
+    }
+
+    m_supported = true;
+}
+
+bool ShaderCache::is_supported() {
+    init();
+    return m_supported;
+}
+
+uint64_t ShaderCache::get_key(const std::string& vertex_code, const std::string& fragment_code) {
+    init();
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hash = fnv1a(hash, vertex_code);
+    hash = fnv1a(hash, fragment_code);
+    hash = fnv1a(hash, m_driver);
+    return hash;
+}
+
+std::string ShaderCache::get_path(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(m_directory) / name).string();
+}
+
+bool ShaderCache::load(uint64_t key, uint32_t program) {
+    if (!is_supported()) {
+        return false;
+    }
+
+    std::string path = get_path(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        ++m_miss_count;
+        return false;
+    }
+
+    CacheHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key) {
+        ++m_miss_count;
+        return false;
+    }
+
+    // The binary fills the rest of the entry, a corrupt length is a miss and not an allocation
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(path, error);
+    if (error || size != sizeof(header) + uintmax_t(header.length)) {
+        ++m_miss_count;
+        return false;
+    }
+
+    std::vector<char> binary(header.length);
+    file.read(binary.data(), header.length);
+    if (!file) {
+        ++m_miss_count;
+        return false;
+    }
+    file.close();
+
+    glProgramBinary(program, header.format, binary.data(), header.length);
+
+    // The driver may refuse a binary from an other build, the entry is then rewritten after the compile
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        Logger::instance().log(Info, "Shader cache entry rejected by the driver : " + path);
+        std::filesystem::remove(path, error);
+        ++m_miss_count;
+        return false;
+    }
+
+    ++m_hit_count;
+    return true;
+}
+
+void ShaderCache::store(uint64_t key, uint32_t program) {
+    if (!is_supported()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+    CacheHeader header{CACHE_MAGIC, CACHE_VERSION, key, format, static_cast<uint32_t>(length)};
+
+    // Write in a temporary file first so that a crash never leaves a truncated entry
+    std::string path = get_path(key);
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            Logger::instance().log(Warning, "Can not write shader cache entry : " + path);
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), length);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::filesystem::remove(temp_path, error);
+    }
+}
+
+void ShaderCache::clear() {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+        if (entry.path().extension() == ".bin") {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+}
@@ -36,6 +36,8 @@ void Texture::unbind() {
 }
 
 void Texture::set_filter(TextureFilter filter_min, TextureFilter filter_mag) {
+    m_filter_min = filter_min;
+    m_filter_mag = filter_mag;
     glBindTexture(GL_TEXTURE_2D, m_texture_id);
 
     GLenum gl_min, gl_mag;
@@ -62,6 +64,8 @@ void Texture::set_filter(TextureFilter filter_min, TextureFilter filter_mag) {
 }
 
 void Texture::set_wrap(TextureWrap wrap_s, TextureWrap wrap_t) {
+    m_wrap_s = wrap_s;
+    m_wrap_t = wrap_t;
     glBindTexture(GL_TEXTURE_2D, m_texture_id);
 
     GLenum gl_wrap_s, gl_wrap_t;
@@ -86,6 +90,19 @@ void Texture::set_wrap(TextureWrap wrap_s, TextureWrap wrap_t) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, gl_wrap_t);
 }
 
+void Texture::replace(uint32_t texture_id, int32_t width, int32_t height, int32_t bpp) {
+    if (texture_id != m_texture_id) {
+        glDeleteTextures(1, &m_texture_id);
+    }
+    m_texture_id = texture_id;
+    m_width = width;
+    m_height = height;
+    m_bpp = bpp;
+
+    set_filter(m_filter_min, m_filter_mag);
+    set_wrap(m_wrap_s, m_wrap_t);
+}
+
 void Texture::set_default_filter(TextureFilter filter_min, TextureFilter filter_mag) {
     s_default_filter_min = filter_min;
     s_default_filter_mag = filter_mag;
@@ -0,0 +1,94 @@
+#include "Text/DistanceField.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace AMB {
+
+constexpr double EDT_INF = 1e20;
+
+// Squared distance transform of a sampled function along one dimension
+static void edt_1d(const double* f, int32_t n, double* d, int32_t* v, double* z) {
+    int32_t k = 0;
+    v[0] = 0;
+    z[0] = -EDT_INF;
+    z[1] = EDT_INF;
+
+    // Lower envelope of the parabolas
+    for (int32_t q = 1; q < n; ++q) {
+        double s = ((f[q] + double(q) * q) - (f[v[k]] + double(v[k]) * v[k])) / (2.0 * q - 2.0 * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + double(q) * q) - (f[v[k]] + double(v[k]) * v[k])) / (2.0 * q - 2.0 * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = EDT_INF;
+    }
+
+    k = 0;
+    for (int32_t q = 0; q < n; ++q) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        d[q] = double(q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+// Squared distance of each pixel to the nearest feature pixel, the grid is transformed in place
+static void edt_2d(std::vector<double>& grid, int32_t width, int32_t height) {
+    int32_t n = std::max(width, height);
+    std::vector<double> f(n), d(n), z(n + 1);
+    std::vector<int32_t> v(n);
+
+    for (int32_t x = 0; x < width; ++x) {
+        for (int32_t y = 0; y < height; ++y) {
+            f[y] = grid[size_t(y) * width + x];
+        }
+        edt_1d(f.data(), height, d.data(), v.data(), z.data());
+        for (int32_t y = 0; y < height; ++y) {
+            grid[size_t(y) * width + x] = d[y];
+        }
+    }
+
+    for (int32_t y = 0; y < height; ++y) {
+        double* row = &grid[size_t(y) * width];
+        std::copy(row, row + width, f.begin());
+        edt_1d(f.data(), width, row, v.data(), z.data());
+    }
+}
+
+void distance_field(const uint8_t* coverage, int32_t width, int32_t height, int32_t pitch, int32_t spread, uint8_t* field) {
+    int32_t field_width = width + 2 * spread;
+    int32_t field_height = height + 2 * spread;
+    size_t size = size_t(field_width) * field_height;
+
+    // Distance to the inside for the outside pixels, and to the outside for the inside pixels
+    std::vector<double> to_inside(size, EDT_INF);
+    std::vector<double> to_outside(size, 0.0);
+    for (int32_t y = 0; y < height; ++y) {
+        for (int32_t x = 0; x < width; ++x) {
+            if (coverage[size_t(y) * pitch + x] >= 128) {
+                size_t i = size_t(y + spread) * field_width + x + spread;
+                to_inside[i] = 0.0;
+                to_outside[i] = EDT_INF;
+            }
+        }
+    }
+
+    edt_2d(to_inside, field_width, field_height);
+    edt_2d(to_outside, field_width, field_height);
+
+    // The outline lies between the pixel centers, half a pixel from each side
+    float scale = 127.0f / spread;
+    for (size_t i = 0; i < size; ++i) {
+        float distance = to_outside[i] > 0.0
+            ? float(std::sqrt(to_outside[i])) - 0.5f
+            : 0.5f - float(std::sqrt(to_inside[i]));
+        field[i] = (uint8_t)std::clamp(128.0f + distance * scale, 0.0f, 255.0f);
+    }
+}
+
+}
@@ -0,0 +1,288 @@
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "Text/DynamicFont.hpp"
+
+namespace AMB {
+
+// Empty pixels on the right and below each glyph, avoids the bleeding of the neighbours
+constexpr uint16_t GLYPH_PADDING = 2;
+
+DynamicFont::DynamicFont(FT_Face face, std::vector<uint8_t> data, uint32_t font_size, uint32_t page_size, uint32_t max_pages)
+: m_face(face), m_data(std::move(data)), m_font_size(font_size), m_height(0),
+  m_page_size(std::min<uint32_t>(page_size, UINT16_MAX)), m_max_pages(std::max(max_pages, 1u)),
+  m_pages(), m_glyphs(), m_ascii(), m_lru(), m_empty(),
+  m_frame(0), m_evictions(0), m_upload_size(0), m_full_warned(false)
+{
+    FT_Set_Pixel_Sizes(m_face, 0, font_size);
+    m_height = m_face->size->metrics.height >> 6;
+
+    // Drawn when the atlas is full: nothing, but the text keeps its spacing
+    m_empty.character.advance = int64_t(font_size / 2) << 6;
+
+    add_page();
+}
+
+DynamicFont::~DynamicFont() {
+    FT_Done_Face(m_face);
+}
+
+const DynamicGlyph& DynamicFont::get_glyph(uint32_t codepoint) {
+    DynamicGlyph* glyph = codepoint < 128 ? m_ascii[codepoint] : nullptr;
+
+    if (!glyph) {
+        auto it = m_glyphs.find(codepoint);
+        glyph = it != m_glyphs.end() ? &it->second : rasterize(codepoint);
+    }
+
+    if (!glyph) {
+        if (!m_full_warned) {
+            Logger::instance().log(Warning, "Dynamic font atlas full, glyphs are skipped this frame");
+            m_full_warned = true;
+        }
+        return m_empty;
+    }
+
+    touch(*glyph);
+    return *glyph;
+}
+
+void DynamicFont::flush() {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_page_size);
+
+    m_upload_size = 0;
+    for (Page& page : m_pages) {
+        if (page.dirty_x0 >= page.dirty_x1) {
+            continue;
+        }
+
+        int32_t width = page.dirty_x1 - page.dirty_x0;
+        int32_t height = page.dirty_y1 - page.dirty_y0;
+        page.texture->bind();
+        glTexSubImage2D(GL_TEXTURE_2D, 0, page.dirty_x0, page.dirty_y0, width, height, GL_RED, GL_UNSIGNED_BYTE,
+            page.pixels.data() + size_t(page.dirty_y0) * m_page_size + page.dirty_x0);
+        m_upload_size += size_t(width) * height;
+
+        page.dirty_x0 = page.dirty_y0 = INT32_MAX;
+        page.dirty_x1 = page.dirty_y1 = 0;
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    m_frame++;
+    m_full_warned = false;
+}
+
+DynamicGlyph* DynamicFont::rasterize(uint32_t codepoint) {
+    // Rendered once, the bitmap is copied to the page at once
+    FT_UInt index = FT_Get_Char_Index(m_face, codepoint);
+    if (FT_Load_Glyph(m_face, index, FT_LOAD_RENDER)) {
+        Logger::instance().log(Error, "FreeType Failed to load Glyph : " + std::to_string(codepoint));
+        return nullptr;
+    }
+
+    const FT_GlyphSlot slot = m_face->glyph;
+    const FT_Bitmap& bitmap = slot->bitmap;
+
+    DynamicGlyph glyph{};
+    glyph.character = Character{
+        0.0f, 0.0f, 0.0f, 0.0f,
+        (int)bitmap.width, (int)bitmap.rows,
+        slot->bitmap_left, slot->bitmap_top,
+        slot->advance.x
+    };
+    glyph.codepoint = codepoint;
+    glyph.last_frame = m_frame;
+
+    if (bitmap.width > 0 && bitmap.rows > 0) {
+        if (!allocate(bitmap.width + GLYPH_PADDING, bitmap.rows + GLYPH_PADDING, glyph)) {
+            return nullptr;
+        }
+
+        Page& page = m_pages[glyph.page];
+        const Shelf& shelf = page.shelves[glyph.shelf];
+
+        // Clear the slot, an evicted glyph may have been bigger
+        uint32_t slot_height = std::min<uint32_t>(shelf.height, m_page_size - shelf.y);
+        uint32_t slot_width = std::min<uint32_t>(glyph.slot_width, m_page_size - glyph.slot_x);
+        for (uint32_t y = 0; y < slot_height; ++y) {
+            uint8_t* row = page.pixels.data() + size_t(shelf.y + y) * m_page_size + glyph.slot_x;
+            std::memset(row, 0, slot_width);
+            if (y < bitmap.rows) {
+                std::memcpy(row, bitmap.buffer + y * bitmap.pitch, bitmap.width);
+            }
+        }
+
+        page.dirty_x0 = std::min<int32_t>(page.dirty_x0, glyph.slot_x);
+        page.dirty_y0 = std::min<int32_t>(page.dirty_y0, shelf.y);
+        page.dirty_x1 = std::max<int32_t>(page.dirty_x1, glyph.slot_x + slot_width);
+        page.dirty_y1 = std::max<int32_t>(page.dirty_y1, shelf.y + slot_height);
+
+        glyph.character.u = glyph.slot_x / (float)m_page_size;
+        glyph.character.v = shelf.y / (float)m_page_size;
+        glyph.character.w = bitmap.width / (float)m_page_size;
+        glyph.character.h = bitmap.rows / (float)m_page_size;
+    }
+
+    DynamicGlyph& stored = m_glyphs.emplace(codepoint, glyph).first->second;
+    stored.lru_it = m_lru.insert(m_lru.end(), codepoint);
+    if (codepoint < 128) {
+        m_ascii[codepoint] = &stored;
+    }
+    return &stored;
+}
+
+bool DynamicFont::allocate(uint16_t width, uint16_t height, DynamicGlyph& glyph) {
+    if (width > m_page_size || height > m_page_size) {
+        return false;
+    }
+
+    // Shelves are created with a height rounded to 4 pixels and accept glyphs a bit smaller
+    uint16_t shelf_height = (height + 3) & ~3;
+    uint16_t max_height = shelf_height + shelf_height / 4 + 4;
+
+    while (true) {
+        // An existing shelf
+        for (uint32_t p = 0; p < m_pages.size(); ++p) {
+            std::vector<Shelf>& shelves = m_pages[p].shelves;
+            for (uint32_t s = 0; s < shelves.size(); ++s) {
+                Shelf& shelf = shelves[s];
+                if (shelf.height < height || (shelf.height > max_height && shelf.used > 0)) {
+                    continue;
+                }
+                if (allocate_in_shelf(shelf, width, glyph.slot_x)) {
+                    glyph.page = p;
+                    glyph.shelf = s;
+                    glyph.slot_width = width;
+                    shelf.used++;
+                    return true;
+                }
+            }
+        }
+
+        // A new shelf
+        for (uint32_t p = 0; p < m_pages.size(); ++p) {
+            Page& page = m_pages[p];
+            if (page.next_y + height > m_page_size) {
+                continue;
+            }
+
+            page.shelves.push_back(Shelf{page.next_y, std::min<uint16_t>(shelf_height, m_page_size - page.next_y), 0, 0, {}});
+            page.next_y += page.shelves.back().height;
+
+            Shelf& shelf = page.shelves.back();
+            allocate_in_shelf(shelf, width, glyph.slot_x);
+            glyph.page = p;
+            glyph.shelf = page.shelves.size() - 1;
+            glyph.slot_width = width;
+            shelf.used++;
+            return true;
+        }
+
+        // A new page, then the cold glyphs
+        if (m_pages.size() < m_max_pages) {
+            add_page();
+        }else if (!evict_oldest()) {
+            return false;
+        }
+    }
+}
+
+bool DynamicFont::allocate_in_shelf(Shelf& shelf, uint16_t width, uint16_t& x) {
+    for (auto it = shelf.free_slots.begin(); it != shelf.free_slots.end(); ++it) {
+        if (it->width >= width) {
+            x = it->x;
+            it->x += width;
+            it->width -= width;
+            if (it->width == 0) {
+                shelf.free_slots.erase(it);
+            }
+            return true;
+        }
+    }
+
+    if (shelf.next_x + width <= m_page_size) {
+        x = shelf.next_x;
+        shelf.next_x += width;
+        return true;
+    }
+    return false;
+}
+
+bool DynamicFont::add_page() {
+    Page page;
+    page.pixels.assign(size_t(m_page_size) * m_page_size, 0);
+    page.next_y = 0;
+    page.dirty_x0 = page.dirty_y0 = INT32_MAX;
+    page.dirty_x1 = page.dirty_y1 = 0;
+
+    uint32_t texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_page_size, m_page_size, 0, GL_RED, GL_UNSIGNED_BYTE, page.pixels.data());
+    page.texture = std::make_unique<Texture>(texture_id, m_page_size, m_page_size, 1);
+
+    m_pages.push_back(std::move(page));
+    return true;
+}
+
+bool DynamicFont::evict_oldest() {
+    // The glyphs used since the last flush may be in the mesh being built
+    if (m_lru.empty() || m_glyphs.at(m_lru.front()).last_frame >= m_frame) {
+        return false;
+    }
+
+    uint32_t codepoint = m_lru.front();
+    DynamicGlyph& glyph = m_glyphs.at(codepoint);
+
+    if (glyph.slot_width > 0) {
+        Shelf& shelf = m_pages[glyph.page].shelves[glyph.shelf];
+        shelf.used--;
+
+        if (shelf.used == 0) {
+            shelf.free_slots.clear();
+            shelf.next_x = 0;
+        }else{
+            // Give the slot back, merged with its free neighbours
+            shelf.free_slots.push_back(Slot{glyph.slot_x, glyph.slot_width});
+            std::sort(shelf.free_slots.begin(), shelf.free_slots.end(), [](const Slot& a, const Slot& b) { return a.x < b.x; });
+
+            std::vector<Slot> merged;
+            for (const Slot& slot : shelf.free_slots) {
+                if (!merged.empty() && merged.back().x + merged.back().width == slot.x) {
+                    merged.back().width += slot.width;
+                }else{
+                    merged.push_back(slot);
+                }
+            }
+            if (!merged.empty() && merged.back().x + merged.back().width == shelf.next_x) {
+                shelf.next_x = merged.back().x;
+                merged.pop_back();
+            }
+            shelf.free_slots = std::move(merged);
+        }
+    }
+
+    m_lru.pop_front();
+    if (codepoint < 128) {
+        m_ascii[codepoint] = nullptr;
+    }
+    m_glyphs.erase(codepoint);
+    m_evictions++;
+    return true;
+}
+
+void DynamicFont::touch(DynamicGlyph& glyph) {
+    if (glyph.last_frame != m_frame) {
+        glyph.last_frame = m_frame;
+        m_lru.splice(m_lru.end(), m_lru, glyph.lru_it);
+    }
+}
+
+}
@@ -2,13 +2,22 @@
 
 namespace AMB {
 
-Font::Font(const std::map<char, Character>& char_map, uint32_t height, Texture& texture)
-: m_char_map(char_map), m_height(height), m_texture(texture) {}
+Font::Font(const std::map<char, Character>& char_map, uint32_t height, Texture& texture, uint32_t sdf_base_size, uint32_t sdf_spread)
+: m_glyphs(), m_present(), m_height(height), m_texture(texture), m_sdf_base_size(sdf_base_size), m_sdf_spread(sdf_spread) {
+    // Missing characters are drawn with the fallback glyph, or nothing if it is missing too
+    auto fallback = char_map.find(FALLBACK_CHAR);
+    m_glyphs.fill(fallback != char_map.end() ? fallback->second : Character{});
+
+    for (const auto& [c, character] : char_map) {
+        m_glyphs[(uint8_t)c] = character;
+        m_present[(uint8_t)c] = true;
+    }
+}
 
 Font::~Font() {}
 
-Character Font::get_char(char c) {
-    return m_char_map[c];
+bool Font::has_char(char c) const {
+    return m_present[(uint8_t)c];
 }
 
 int32_t Font::get_height() const {
@@ -19,6 +28,10 @@ Texture& Font::get_texture() const {
     return m_texture;
 }
 
+size_t Font::get_memory_size() const {
+    return sizeof(m_glyphs) + sizeof(m_present);
+}
+
 uint32_t Font::get_char_px_space() {
     return CHAR_PX_SPACE;
 }
@@ -0,0 +1,286 @@
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+#include "Text/FontBitmap.hpp"
+#include "Text/DistanceField.hpp"
+#include "Text/Font.hpp"
+#include "Logger/Logger.hpp"
+
+namespace AMB {
+
+// Glyphs rendered by one face, the bitmaps are kept until the atlas size is known
+struct GlyphRun {
+    std::vector<std::pair<char, Character>> glyphs;
+    std::vector<size_t> offsets;
+    std::vector<uint8_t> pixels;
+};
+
+// Render the characters [first, last) of a face already set to its pixel size
+static void render_glyphs(FT_Face face, unsigned char first, unsigned char last, GlyphRun& run) {
+    for (unsigned char c(first) ; c < last ; ++c) {
+        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
+            Logger::instance().log(Error, "FreeType Failed to load Glyph : " + std::to_string(c));
+            continue;
+        }
+
+        const FT_Bitmap& glyph = face->glyph->bitmap;
+        Character character = {
+            0.0f, 0.0f, 0.0f, 0.0f,
+            (int)glyph.width, (int)glyph.rows,
+            face->glyph->bitmap_left, face->glyph->bitmap_top,
+            face->glyph->advance.x
+        };
+        run.glyphs.emplace_back((char)c, character);
+
+        run.offsets.push_back(run.pixels.size());
+        for (int y = 0; y < character.height; ++y) {
+            run.pixels.insert(run.pixels.end(), glyph.buffer + y * glyph.pitch, glyph.buffer + y * glyph.pitch + character.width);
+        }
+    }
+}
+
+// Copy the glyphs of the runs side by side, in the order of the runs
+static bool pack_glyphs(const std::vector<GlyphRun>& runs, uint32_t font_size, FontBitmap& bitmap) {
+    bitmap.char_map.clear();
+    bitmap.font_size = font_size;
+    bitmap.sdf = false;
+    bitmap.sdf_spread = 0;
+    bitmap.width = 0;
+    bitmap.height = 0;
+
+    int char_px_space = Font::get_char_px_space();
+    for (const GlyphRun& run : runs) {
+        for (const auto& [c, character] : run.glyphs) {
+            bitmap.width += character.width + char_px_space;
+            bitmap.height = std::max(bitmap.height, character.height);
+        }
+    }
+
+    if (bitmap.width == 0 || bitmap.height == 0) {
+        return false;
+    }
+
+    bitmap.pixels.assign(size_t(bitmap.width) * size_t(bitmap.height), 0);
+    int x_progression(0);
+    for (const GlyphRun& run : runs) {
+        for (size_t i = 0; i < run.glyphs.size(); ++i) {
+            Character c = run.glyphs[i].second;
+            const uint8_t* glyph = run.pixels.data() + run.offsets[i];
+            for (int y = 0; y < c.height; ++y) {
+                std::memcpy(&bitmap.pixels[size_t(y) * bitmap.width + x_progression], glyph + y * c.width, c.width);
+            }
+
+            // Set the position and dimension on the texture atlas
+            c.u = x_progression / (float)bitmap.width;
+            c.w = c.width / (float)bitmap.width;
+            c.h = c.height / (float)bitmap.height;
+            bitmap.char_map[run.glyphs[i].first] = c;
+
+            x_progression += c.width + char_px_space;
+        }
+    }
+
+    bitmap.line_height = bitmap.height;
+    return true;
+}
+
+bool rasterize_font(FT_Face face, uint32_t font_size, FontBitmap& bitmap) {
+    // Set font size
+    FT_Set_Pixel_Sizes(face, 0, font_size);
+
+    std::vector<GlyphRun> runs(1);
+    render_glyphs(face, 32, 128, runs[0]);
+    return pack_glyphs(runs, font_size, bitmap);
+}
+
+bool rasterize_font_memory(const uint8_t* data, size_t size, uint32_t font_size, FontBitmap& bitmap) {
+    // A FreeType library must not be shared between threads
+    FT_Library library;
+    if (FT_Init_FreeType(&library) != 0) {
+        return false;
+    }
+
+    FT_Face face;
+    bool success = false;
+    if (FT_New_Memory_Face(library, data, static_cast<FT_Long>(size), 0, &face) == 0) {
+        success = rasterize_font(face, font_size, bitmap);
+        FT_Done_Face(face);
+    }
+
+    FT_Done_FreeType(library);
+    return success;
+}
+
+bool rasterize_fonts(const std::vector<FontSource>& sources, ThreadPool& pool, std::vector<FontBitmap>& bitmaps) {
+    constexpr unsigned char FIRST_CHAR = 32, LAST_CHAR = 128;
+    constexpr uint32_t MIN_GLYPHS_PER_JOB = 16;
+
+    // Split the fonts in ranges of characters until the workers are busy, each range opens its own face
+    const uint32_t font_count = std::max<size_t>(sources.size(), 1);
+    const uint32_t max_jobs = (LAST_CHAR - FIRST_CHAR) / MIN_GLYPHS_PER_JOB;
+    const uint32_t jobs_per_font = std::clamp<uint32_t>((pool.get_thread_count() + font_count - 1) / font_count, 1, max_jobs);
+
+    std::vector<std::vector<GlyphRun>> runs(sources.size(), std::vector<GlyphRun>(jobs_per_font));
+    std::vector<std::future<bool>> done;
+    for (size_t f = 0; f < sources.size(); ++f) {
+        for (uint32_t j = 0; j < jobs_per_font; ++j) {
+            unsigned char first = FIRST_CHAR + (LAST_CHAR - FIRST_CHAR) * j / jobs_per_font;
+            unsigned char last = FIRST_CHAR + (LAST_CHAR - FIRST_CHAR) * (j + 1) / jobs_per_font;
+            const FontSource& source = sources[f];
+            GlyphRun& run = runs[f][j];
+
+            done.push_back(pool.submit([&source, &run, first, last]() {
+                // A FreeType library must not be shared between threads
+                FT_Library library;
+                if (FT_Init_FreeType(&library) != 0) {
+                    return false;
+                }
+
+                FT_Face face;
+                bool success = false;
+                if (FT_New_Memory_Face(library, source.data, static_cast<FT_Long>(source.size), 0, &face) == 0) {
+                    FT_Set_Pixel_Sizes(face, 0, source.font_size);
+                    render_glyphs(face, first, last, run);
+                    FT_Done_Face(face);
+                    success = true;
+                }
+
+                FT_Done_FreeType(library);
+                return success;
+            }));
+        }
+    }
+
+    std::vector<bool> read(sources.size(), true);
+    for (size_t i = 0; i < done.size(); ++i) {
+        if (!done[i].get()) {
+            read[i / jobs_per_font] = false;
+        }
+    }
+
+    // Packed on this thread, the ranges are in the character order
+    bool success = true;
+    bitmaps.clear();
+    bitmaps.resize(sources.size());
+    for (size_t f = 0; f < sources.size(); ++f) {
+        if (!read[f] || !pack_glyphs(runs[f], sources[f].font_size, bitmaps[f])) {
+            bitmaps[f] = FontBitmap();
+            success = false;
+        }
+    }
+    return success;
+}
+
+bool rasterize_font_sdf(FT_Face face, uint32_t base_size, uint32_t spread, ThreadPool* pool, FontBitmap& bitmap) {
+    FT_Set_Pixel_Sizes(face, 0, base_size);
+
+    bitmap.char_map.clear();
+    bitmap.font_size = base_size;
+    bitmap.sdf = true;
+    bitmap.sdf_spread = spread;
+    bitmap.width = 0;
+    bitmap.height = 0;
+
+    struct Glyph {
+        char c;
+        int32_t width, height;
+        std::vector<uint8_t> coverage;
+        std::vector<uint8_t> field;
+    };
+
+    // FreeType renders the coverage here, the fields are padded by the spread
+    std::vector<Glyph> glyphs;
+    int32_t line_height(0);
+    for (unsigned char c(32) ; c < 128 ; ++c) {
+        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
+            Logger::instance().log(Error, "FreeType Failed to load Glyph : " + std::to_string(c));
+            continue;
+        }
+
+        const FT_Bitmap& ft_bitmap = face->glyph->bitmap;
+        Glyph glyph{(char)c, (int32_t)ft_bitmap.width, (int32_t)ft_bitmap.rows, {}, {}};
+        for (int32_t y = 0; y < glyph.height; ++y) {
+            glyph.coverage.insert(glyph.coverage.end(), ft_bitmap.buffer + y * ft_bitmap.pitch, ft_bitmap.buffer + y * ft_bitmap.pitch + glyph.width);
+        }
+        line_height = std::max(line_height, glyph.height);
+
+        // Blank glyphs only move the pen, they get no field
+        bool blank = glyph.width == 0 || glyph.height == 0;
+        int32_t padding = blank ? 0 : spread;
+        bitmap.char_map[c] = Character{
+            0.0f, 0.0f, 0.0f, 0.0f,
+            glyph.width + 2 * padding, glyph.height + 2 * padding,
+            face->glyph->bitmap_left - padding, face->glyph->bitmap_top + padding,
+            face->glyph->advance.x
+        };
+        if (!blank) {
+            glyphs.push_back(std::move(glyph));
+        }
+    }
+
+    if (glyphs.empty()) {
+        return false;
+    }
+
+    // The distance transforms are independent
+    auto transform = [spread](Glyph& glyph) {
+        glyph.field.resize(size_t(glyph.width + 2 * spread) * (glyph.height + 2 * spread));
+        distance_field(glyph.coverage.data(), glyph.width, glyph.height, glyph.width, spread, glyph.field.data());
+    };
+    if (pool) {
+        std::vector<std::future<void>> done;
+        for (Glyph& glyph : glyphs) {
+            done.push_back(pool->submit([&transform, &glyph]() { transform(glyph); }));
+        }
+        for (auto& future : done) {
+            future.get();
+        }
+    }else{
+        for (Glyph& glyph : glyphs) {
+            transform(glyph);
+        }
+    }
+
+    // Pack the fields in rows, a single row would exceed the texture size limits
+    constexpr int32_t MAX_ROW_WIDTH = 1024;
+    int32_t char_px_space = Font::get_char_px_space();
+    std::vector<std::pair<int32_t, int32_t>> positions;
+    int32_t x(0), y(0), row_height(0);
+    for (const Glyph& glyph : glyphs) {
+        const Character& c = bitmap.char_map[glyph.c];
+        if (x > 0 && x + c.width > MAX_ROW_WIDTH) {
+            x = 0;
+            y += row_height + char_px_space;
+            row_height = 0;
+        }
+        positions.emplace_back(x, y);
+        bitmap.width = std::max(bitmap.width, x + c.width);
+        x += c.width + char_px_space;
+        row_height = std::max(row_height, c.height);
+    }
+    bitmap.height = y + row_height;
+
+    bitmap.pixels.assign(size_t(bitmap.width) * size_t(bitmap.height), 0);
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        Character& c = bitmap.char_map[glyphs[i].c];
+        auto [glyph_x, glyph_y] = positions[i];
+        for (int32_t row = 0; row < c.height; ++row) {
+            std::memcpy(&bitmap.pixels[size_t(glyph_y + row) * bitmap.width + glyph_x], &glyphs[i].field[size_t(row) * c.width], c.width);
+        }
+
+        c.u = glyph_x / (float)bitmap.width;
+        c.v = glyph_y / (float)bitmap.height;
+        c.w = c.width / (float)bitmap.width;
+        c.h = c.height / (float)bitmap.height;
+    }
+
+    // The line height of the base size, as for the bitmap fonts
+    bitmap.line_height = line_height;
+    return true;
+}
+
+}
\ No newline at end of file
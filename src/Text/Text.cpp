@@ -1,99 +1,272 @@
 #include "Text/Text.hpp"
 
+#include <algorithm>
+
 namespace AMB {
 
-TextRenderer::TextRenderer(Font& font, Shader& shader, uint32_t reserve)
-: m_font(font), m_shader(shader), m_char_count(0), m_vertex(), m_index(),
-    m_vao(nullptr), m_vbo(nullptr), m_ibo(nullptr), m_text_layout()
-{
-    // Create text layout
-    m_text_layout.add_float(3); // Add the position
-    m_text_layout.add_float(4); // Add the color
-    m_text_layout.add_float(2); // Add the texture coordinates
+static inline void write_quad(VertexText* vertex, const Character& c, float x, float y, float z, float r, float g, float b, float a, float scale) {
+    float x_(x + c.bearing_x * scale);
+    float y_(y + (c.bearing_y - c.height) * scale);
+    float w_(c.width * scale);
+    float h_(c.height * scale);
 
-    // Reserve space
-    m_vertex.resize(4 * reserve);
-    m_index.resize(6 * reserve);
+    vertex[0] = VertexText{x_,      y_,       z, r, g, b, a,   c.u,        c.v + c.h }; // Bottom left
+    vertex[1] = VertexText{x_ + w_, y_,       z, r, g, b, a,   c.u + c.w,  c.v + c.h }; // Bottom right
+    vertex[2] = VertexText{x_ + w_, y_ + h_,  z, r, g, b, a,   c.u + c.w,  c.v       }; // Top right
+    vertex[3] = VertexText{x_,      y_ + h_,  z, r, g, b, a,   c.u,        c.v       }; // Top left
+}
 
-    // Create vbo and ibo
-    m_vbo = create_vertex_buffer<VertexText>(m_vertex, false);
-    m_ibo = create_index_buffer(m_index, false);
-    m_vao = create_vertex_array();
+TextRenderer::TextRenderer(Font& font, Shader& shader, uint32_t reserve)
+: m_font(&font), m_dynamic_font(nullptr), m_shader(shader), m_char_count(0), m_index_dirty(false),
+    m_batches(), m_staging(), m_index(), m_vao(nullptr), m_vbo(nullptr), m_ibo(nullptr), m_text_layout()
+{
+    init(reserve);
+}
 
-    m_vao->bind();
-    m_vao->add_vertex_buffer(m_vbo, m_text_layout);
-    m_vao->set_index_buffer(m_ibo);
-    m_vao->unbind();
+TextRenderer::TextRenderer(DynamicFont& font, Shader& shader, uint32_t reserve)
+: m_font(nullptr), m_dynamic_font(&font), m_shader(shader), m_char_count(0), m_index_dirty(false),
+    m_batches(), m_staging(), m_index(), m_vao(nullptr), m_vbo(nullptr), m_ibo(nullptr), m_text_layout()
+{
+    init(reserve);
 }
 
 TextRenderer::~TextRenderer() {}
 
 Font& TextRenderer::get_font() {
-    return m_font;
+    return *m_font;
 }
 
-void TextRenderer::submit_text(const std::string& text, mat::Vec3f position, float r, float g, float b, float a) {
-    float current_x(0), current_y(0);
+DynamicFont* TextRenderer::get_dynamic_font() {
+    return m_dynamic_font;
+}
 
-    if ((m_char_count + text.size())*4 > m_vertex.size()) {
-        Logger::instance().log(LogLevel::Warning, "TextRenderer resize vectors");
-        m_vertex.resize((m_char_count + text.size())*4);
-        m_index.resize((m_char_count + text.size())*6);
-    }
+int32_t TextRenderer::get_line_height() const {
+    return m_dynamic_font ? m_dynamic_font->get_height() : m_font->get_height();
+}
 
-    for (uint32_t i(0) ; i < text.size() ; ++i) {
-        if (text[i] == '\n') {
-            current_x = 0;
-            current_y -= m_font.get_height();
+void TextRenderer::submit_text(std::string_view text, mat::Vec3f position, float r, float g, float b, float a, float scale) {
+    if (m_dynamic_font) {
+        submit_dynamic(text, position, r, g, b, a, scale);
+    }else{
+        submit_static(text, position, r, g, b, a, scale);
+    }
+}
 
-        }else{
-            const Character& c = m_font.get_char(text[i]);
+void TextRenderer::submit_layout(const TextLayout& layout, mat::Vec3f position, float r, float g, float b, float a) {
+    if (m_dynamic_font || layout.get_font() != m_font) {
+        Logger::instance().log(LogLevel::Warning, "TextRenderer layout made with another font");
+        return;
+    }
 
-            uint32_t vert_id = m_char_count * 4;
-            uint32_t ind_id = m_char_count * 6;
+    const std::vector<GlyphQuad>& quads = layout.get_quads();
+    Batch& batch = m_batches[0];
+    if ((batch.char_count + quads.size())*4 > batch.vertex.size()) {
+        Logger::instance().log(LogLevel::Warning, "TextRenderer resize vectors");
+        grow(batch, std::max<uint32_t>(batch.char_count + quads.size(), 2 * (batch.vertex.size() / 4)));
+    }
 
-            float x_(position[0] + current_x + c.bearing_x);
-            float y_(position[1] + current_y - c.height + c.bearing_y);
-            float z_(position[2]);
+    const float x(position[0]), y(position[1]), z(position[2]);
+    VertexText* vertex = batch.vertex.data() + batch.char_count * 4;
+    for (const GlyphQuad& q : quads) {
+        vertex[0] = VertexText{x + q.x0, y + q.y0, z, r, g, b, a, q.u0, q.v0}; // Bottom left
+        vertex[1] = VertexText{x + q.x1, y + q.y0, z, r, g, b, a, q.u1, q.v0}; // Bottom right
+        vertex[2] = VertexText{x + q.x1, y + q.y1, z, r, g, b, a, q.u1, q.v1}; // Top right
+        vertex[3] = VertexText{x + q.x0, y + q.y1, z, r, g, b, a, q.u0, q.v1}; // Top left
+        vertex += 4;
+    }
 
-            m_vertex[vert_id + 0] = VertexText{x_,           y_,             z_, r, g, b, a,   c.u,        c.v + c.h }; // Bottom left
-            m_vertex[vert_id + 1] = VertexText{x_ + c.width, y_,             z_, r, g, b, a,   c.u + c.w,  c.v + c.h }; // Bottom right
-            m_vertex[vert_id + 2] = VertexText{x_ + c.width, y_ + c.height,  z_, r, g, b, a,   c.u + c.w,  c.v       }; // Top right
-            m_vertex[vert_id + 3] = VertexText{x_,           y_ + c.height,  z_, r, g, b, a,   c.u,        c.v       }; // Top left
+    batch.char_count += quads.size();
+    m_char_count += quads.size();
+}
 
-            m_index[ind_id + 0] = vert_id + 0;
-            m_index[ind_id + 1] = vert_id + 1;
-            m_index[ind_id + 2] = vert_id + 2;
-            m_index[ind_id + 3] = vert_id + 2;
-            m_index[ind_id + 4] = vert_id + 3;
-            m_index[ind_id + 5] = vert_id + 0;
+void TextRenderer::build_mesh() {
+    grow_index(m_char_count);
 
-            current_x += c.advance >> 6;
+    // The batches are stored one after the other
+    uint32_t first_char(0), filled(0);
+    Batch* single = nullptr;
+    for (Batch& batch : m_batches) {
+        batch.first_char = first_char;
+        first_char += batch.char_count;
+        if (batch.char_count > 0) {
+            filled++;
+            single = &batch;
+        }
+    }
 
-            m_char_count++;
+    if (filled == 1) {
+        m_vbo->update(single->vertex.data(), single->char_count * 4 * sizeof(VertexText));
+    }else if (filled > 1) {
+        m_staging.resize(std::max<size_t>(m_staging.size(), m_char_count * 4));
+        for (const Batch& batch : m_batches) {
+            std::copy_n(batch.vertex.begin(), batch.char_count * 4, m_staging.begin() + batch.first_char * 4);
         }
+        m_vbo->update(m_staging.data(), m_char_count * 4 * sizeof(VertexText));
     }
-}
 
-void TextRenderer::build_mesh() {
-    m_vbo->update(m_vertex.data(), m_vertex.size() * sizeof(VertexText));
-    m_ibo->update(m_index.data(), m_index.size());
+    if (m_index_dirty) {
+        m_ibo->update(m_index.data(), m_index.size());
+        m_index_dirty = false;
+    }
 }
 
 void TextRenderer::reset() {
     m_char_count = 0;
+    for (Batch& batch : m_batches) {
+        batch.char_count = 0;
+    }
 }
 
 void TextRenderer::draw(const mat::Mat4f& mvp) {
     m_vao->bind();
-    m_font.get_texture().bind(0);
     m_shader.use_shader();
     m_shader.set_mat4f("u_mvp", mvp);
     m_ibo->bind();
 
-    glDrawElements(GL_TRIANGLES, m_char_count*6, GL_UNSIGNED_INT, 0);
+    // One draw per atlas page
+    for (uint32_t i = 0; i < m_batches.size(); ++i) {
+        const Batch& batch = m_batches[i];
+        if (batch.char_count == 0) {
+            continue;
+        }
+
+        Texture& texture = m_dynamic_font ? m_dynamic_font->get_page(i) : m_font->get_texture();
+        texture.bind(0);
+        glDrawElements(GL_TRIANGLES, batch.char_count*6, GL_UNSIGNED_INT, (const void*)(size_t(batch.first_char) * 6 * sizeof(uint32_t)));
+    }
+
+    m_vao->unbind();
+}
+
+void TextRenderer::init(uint32_t reserve) {
+    // Create text layout
+    m_text_layout.add_float(3); // Add the position
+    m_text_layout.add_float(4); // Add the color
+    m_text_layout.add_float(2); // Add the texture coordinates
+
+    // Reserve space, the quad indices never change and are written once
+    reserve = std::max(reserve, 1u);
+    m_batches.resize(1);
+    grow(m_batches[0], reserve);
+    grow_index(reserve);
+    m_index_dirty = false;
+
+    // Create vbo and ibo
+    m_vbo = create_vertex_buffer(reserve * 4 * sizeof(VertexText), false);
+    m_ibo = create_index_buffer(m_index, false);
+    m_vao = create_vertex_array();
 
+    m_vao->bind();
+    m_vao->add_vertex_buffer(m_vbo, m_text_layout);
+    m_vao->set_index_buffer(m_ibo);
     m_vao->unbind();
 }
 
-}
\ No newline at end of file
+void TextRenderer::grow(Batch& batch, uint32_t char_count) {
+    batch.vertex.resize(4 * char_count);
+}
+
+void TextRenderer::grow_index(uint32_t char_count) {
+    uint32_t previous = m_index.size() / 6;
+    if (char_count <= previous) {
+        return;
+    }
+    char_count = std::max(char_count, 2 * previous);
+    m_index.resize(6 * char_count);
+
+    for (uint32_t i = previous; i < char_count; ++i) {
+        uint32_t vert_id = i * 4;
+        uint32_t* index = &m_index[i * 6];
+        index[0] = vert_id + 0;
+        index[1] = vert_id + 1;
+        index[2] = vert_id + 2;
+        index[3] = vert_id + 2;
+        index[4] = vert_id + 3;
+        index[5] = vert_id + 0;
+    }
+    m_index_dirty = true;
+}
+
+void TextRenderer::submit_static(std::string_view text, mat::Vec3f position, float r, float g, float b, float a, float scale) {
+    Batch& batch = m_batches[0];
+    if ((batch.char_count + text.size())*4 > batch.vertex.size()) {
+        Logger::instance().log(LogLevel::Warning, "TextRenderer resize vectors");
+        grow(batch, std::max<uint32_t>(batch.char_count + text.size(), 2 * (batch.vertex.size() / 4)));
+    }
+
+    const float x0(position[0]), z(position[2]);
+    const float line_height(m_font->get_height() * scale);
+    float current_x(x0), current_y(position[1]);
+    VertexText* vertex = batch.vertex.data() + batch.char_count * 4;
+
+    const char* it = text.data();
+    const char* end = it + text.size();
+    while (it != end) {
+        // ASCII without decoding, the other characters have no glyph in a static font
+        uint32_t codepoint = (uint8_t)*it < 0x80 ? (uint8_t)*it++ : utf8_next(it, end);
+        if (codepoint == '\n') {
+            current_x = x0;
+            current_y -= line_height;
+            continue;
+        }
+
+        const Character& c = m_font->get_char(codepoint < 0x80 ? (char)codepoint : '?');
+        write_quad(vertex, c, current_x, current_y, z, r, g, b, a, scale);
+        vertex += 4;
+
+        current_x += (c.advance >> 6) * scale;
+    }
+
+    uint32_t count = (vertex - batch.vertex.data()) / 4;
+    m_char_count += count - batch.char_count;
+    batch.char_count = count;
+}
+
+void TextRenderer::submit_dynamic(std::string_view text, mat::Vec3f position, float r, float g, float b, float a, float scale) {
+    // At most one glyph per byte in any page
+    for (Batch& batch : m_batches) {
+        if ((batch.char_count + text.size())*4 > batch.vertex.size()) {
+            Logger::instance().log(LogLevel::Warning, "TextRenderer resize vectors");
+            grow(batch, std::max<uint32_t>(batch.char_count + text.size(), 2 * (batch.vertex.size() / 4)));
+        }
+    }
+
+    const float x0(position[0]), z(position[2]);
+    const float line_height(m_dynamic_font->get_height() * scale);
+    float current_x(x0), current_y(position[1]);
+
+    const char* it = text.data();
+    const char* end = it + text.size();
+    while (it != end) {
+        uint32_t codepoint = (uint8_t)*it < 0x80 ? (uint8_t)*it++ : utf8_next(it, end);
+        if (codepoint == '\n') {
+            current_x = x0;
+            current_y -= line_height;
+            continue;
+        }
+
+        const DynamicGlyph& glyph = m_dynamic_font->get_glyph(codepoint);
+        const Character& c = glyph.character;
+
+        // Blank glyphs only move the pen
+        if (c.width > 0) {
+            if (glyph.page >= m_batches.size()) {
+                // Every new page may be reached later in the text, not only this one
+                size_t old_size = m_batches.size();
+                m_batches.resize(glyph.page + 1);
+                for (size_t i = old_size; i < m_batches.size(); ++i) {
+                    grow(m_batches[i], std::max<uint32_t>(text.size(), m_batches[0].vertex.size() / 4));
+                }
+            }
+
+            Batch& batch = m_batches[glyph.page];
+            write_quad(batch.vertex.data() + batch.char_count * 4, c, current_x, current_y, z, r, g, b, a, scale);
+            batch.char_count++;
+            m_char_count++;
+        }
+
+        current_x += (c.advance >> 6) * scale;
+    }
+}
+
+}
@@ -0,0 +1,236 @@
+#include "Text/TextLayout.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace AMB {
+
+static inline bool is_continuation(char c) {
+    return ((uint8_t)c & 0xC0) == 0x80;
+}
+
+TextLayout::TextLayout()
+: m_font(nullptr), m_scale(1.0f), m_text(), m_quads(), m_pen_x(), m_pen_y(), m_first_quad(),
+  m_width(0.0f), m_line_count(0), m_written(0) {}
+
+void TextLayout::set_text(const Font& font, std::string_view text, float scale) {
+    // Whole layout
+    if (&font != m_font || scale != m_scale || m_pen_x.empty()) {
+        m_font = &font;
+        m_scale = scale;
+        m_text.assign(text);
+
+        m_quads.resize(count_quads(0, m_text.size()));
+        m_pen_x.resize(m_text.size() + 1);
+        m_pen_y.resize(m_text.size() + 1);
+        m_first_quad.resize(m_text.size() + 1);
+
+        float pen_x(0.0f), pen_y(0.0f);
+        layout_range(0, m_text.size(), pen_x, pen_y, 0);
+        m_pen_x.back() = pen_x;
+        m_pen_y.back() = pen_y;
+        m_first_quad.back() = m_quads.size();
+
+        m_written = m_quads.size();
+        measure();
+        return;
+    }
+
+    if (text == m_text) {
+        m_written = 0;
+        return;
+    }
+
+    // Common prefix and suffix, on code point boundaries
+    const size_t old_size = m_text.size();
+    const size_t new_size = text.size();
+    size_t prefix = 0;
+    while (prefix < old_size && prefix < new_size && m_text[prefix] == text[prefix]) {
+        prefix++;
+    }
+    // A lead byte only takes the continuation bytes after it, the other bytes always start a character
+    while (prefix > 0 && ((prefix < new_size && is_continuation(text[prefix])) || (prefix < old_size && is_continuation(m_text[prefix])))) {
+        prefix--;
+    }
+
+    size_t suffix = 0;
+    while (suffix < old_size - prefix && suffix < new_size - prefix && m_text[old_size - 1 - suffix] == text[new_size - 1 - suffix]) {
+        suffix++;
+    }
+    while (suffix > 0 && is_continuation(text[new_size - suffix])) {
+        suffix--;
+    }
+
+    const size_t old_end = old_size - suffix;
+    const size_t new_end = new_size - suffix;
+    const float old_pen_x = m_pen_x[old_end];
+    const float old_pen_y = m_pen_y[old_end];
+    const uint32_t old_suffix_quad = m_first_quad[old_end];
+    float pen_x(m_pen_x[prefix]), pen_y(m_pen_y[prefix]);
+
+    // Replace the changed bytes and their quads, the suffix moves with them
+    m_text.replace(prefix, old_end - prefix, text.substr(prefix, new_end - prefix));
+    uint32_t first_quad = m_first_quad[prefix];
+    uint32_t new_quads = count_quads(prefix, new_end);
+
+    m_quads.erase(m_quads.begin() + first_quad, m_quads.begin() + old_suffix_quad);
+    m_quads.insert(m_quads.begin() + first_quad, new_quads, GlyphQuad{});
+    for (auto* values : {&m_pen_x, &m_pen_y}) {
+        values->erase(values->begin() + prefix, values->begin() + old_end);
+        values->insert(values->begin() + prefix, new_end - prefix, 0.0f);
+    }
+    m_first_quad.erase(m_first_quad.begin() + prefix, m_first_quad.begin() + old_end);
+    m_first_quad.insert(m_first_quad.begin() + prefix, new_end - prefix, 0);
+
+    layout_range(prefix, new_end, pen_x, pen_y, first_quad);
+
+    // Move the suffix: the pen offset applies up to its first new line, then only the vertical one
+    const float dx = pen_x - old_pen_x;
+    const float dy = pen_y - old_pen_y;
+    const int32_t dq = int32_t(first_quad + new_quads) - int32_t(old_suffix_quad);
+    size_t line_end = m_text.find('\n', new_end);
+    if (line_end == std::string::npos) {
+        line_end = new_size;
+    }
+    for (size_t i = new_end; i <= new_size; ++i) {
+        m_pen_x[i] += i <= line_end ? dx : 0.0f;
+        m_pen_y[i] += dy;
+        m_first_quad[i] += dq;
+    }
+
+    if (dx != 0.0f || dy != 0.0f) {
+        const uint32_t line_quad = m_first_quad[line_end];
+        for (uint32_t q = first_quad + new_quads; q < m_quads.size(); ++q) {
+            float offset_x = q < line_quad ? dx : 0.0f;
+            m_quads[q].x0 += offset_x;
+            m_quads[q].x1 += offset_x;
+            m_quads[q].y0 += dy;
+            m_quads[q].y1 += dy;
+        }
+    }
+
+    m_written = new_quads;
+    measure();
+}
+
+uint32_t TextLayout::count_quads(size_t begin, size_t end) const {
+    uint32_t count = 0;
+    const char* it = m_text.data() + begin;
+    const char* last = m_text.data() + end;
+    while (it != last) {
+        uint32_t codepoint = (uint8_t)*it < 0x80 ? (uint8_t)*it++ : utf8_next(it, last);
+        count += codepoint != '\n';
+    }
+    return count;
+}
+
+void TextLayout::layout_range(size_t begin, size_t end, float& pen_x, float& pen_y, uint32_t quad) {
+    const float line_height(m_font->get_height() * m_scale);
+    const char* data = m_text.data();
+    const char* last = data + end;
+
+    size_t i = begin;
+    while (i < end) {
+        const char* it = data + i;
+        uint32_t codepoint = (uint8_t)*it < 0x80 ? (uint8_t)*it++ : utf8_next(it, last);
+
+        // All the bytes of the character share its pen position
+        size_t next = it - data;
+        for (size_t j = i; j < next; ++j) {
+            m_pen_x[j] = pen_x;
+            m_pen_y[j] = pen_y;
+            m_first_quad[j] = quad;
+        }
+        i = next;
+
+        if (codepoint == '\n') {
+            pen_x = 0.0f;
+            pen_y -= line_height;
+            continue;
+        }
+
+        // Same glyphs as TextRenderer::submit_text
+        const Character& c = m_font->get_char(codepoint < 0x80 ? (char)codepoint : '?');
+        GlyphQuad& glyph = m_quads[quad++];
+        glyph.x0 = pen_x + c.bearing_x * m_scale;
+        glyph.y0 = pen_y + (c.bearing_y - c.height) * m_scale;
+        glyph.x1 = glyph.x0 + c.width * m_scale;
+        glyph.y1 = glyph.y0 + c.height * m_scale;
+        glyph.u0 = c.u;
+        glyph.v0 = c.v + c.h;
+        glyph.u1 = c.u + c.w;
+        glyph.v1 = c.v;
+
+        pen_x += (c.advance >> 6) * m_scale;
+    }
+}
+
+void TextLayout::measure() {
+    // The pen before each new line and at the end gives the width of the lines
+    m_width = m_pen_x.back();
+    m_line_count = 1;
+    for (size_t i = 0; i < m_text.size(); ++i) {
+        if (m_text[i] == '\n') {
+            m_width = std::max(m_width, m_pen_x[i]);
+            m_line_count++;
+        }
+    }
+}
+
+TextLayoutCache::TextLayoutCache(uint32_t capacity)
+: m_capacity(std::max(capacity, 1u)), m_entries(), m_lru(), m_dynamic(), m_hits(0), m_misses(0) {}
+
+const TextLayout& TextLayoutCache::get(const Font& font, std::string_view text, float scale) {
+    uint32_t scale_bits;
+    std::memcpy(&scale_bits, &scale, sizeof(scale_bits));
+    uint64_t key = std::hash<std::string_view>()(text);
+    key ^= (std::hash<const void*>()(&font) + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2));
+    key ^= (uint64_t(scale_bits) + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2));
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        Entry& entry = it->second;
+        m_lru.splice(m_lru.end(), m_lru, entry.lru_it);
+
+        // A hash collision is laid out again in place
+        if (entry.layout.get_font() == &font && entry.layout.get_scale() == scale && entry.layout.get_text() == text) {
+            m_hits++;
+            return entry.layout;
+        }
+        m_misses++;
+        entry.layout = TextLayout();
+        entry.layout.set_text(font, text, scale);
+        return entry.layout;
+    }
+
+    m_misses++;
+    if (m_entries.size() >= m_capacity) {
+        m_entries.erase(m_lru.front());
+        m_lru.pop_front();
+    }
+
+    Entry& entry = m_entries[key];
+    entry.lru_it = m_lru.insert(m_lru.end(), key);
+    entry.layout.set_text(font, text, scale);
+    return entry.layout;
+}
+
+const TextLayout& TextLayoutCache::update(uint64_t id, const Font& font, std::string_view text, float scale) {
+    TextLayout& layout = m_dynamic[id];
+    if (layout.get_font() == &font && layout.get_scale() == scale && layout.get_text() == text) {
+        m_hits++;
+    }else{
+        m_misses++;
+        layout.set_text(font, text, scale);
+    }
+    return layout;
+}
+
+void TextLayoutCache::clear() {
+    m_entries.clear();
+    m_lru.clear();
+    m_dynamic.clear();
+}
+
+}
@@ -0,0 +1,78 @@
+#include "Thread/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace AMB {
+
+ThreadPool::ThreadPool(uint32_t thread_count)
+: m_active(0), m_stop(false)
+{
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(thread_count);
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        m_workers.emplace_back(&ThreadPool::worker_loop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_task_available.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::push(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_task_available.notify_one();
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_tasks.empty() && m_active == 0; });
+}
+
+uint32_t ThreadPool::get_thread_count() const {
+    return static_cast<uint32_t>(m_workers.size());
+}
+
+void ThreadPool::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_task_available.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+
+            // The queue is drained before stopping
+            if (m_tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_active;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_active;
+            if (m_tasks.empty() && m_active == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
+
+}
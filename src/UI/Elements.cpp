@@ -65,51 +65,26 @@ mat::Vec2f UI_Element::get_absolute_position() const {
         UI_Grid parent_grid = p_parent->get_grid();
         mat::Vec2f prent_dim = p_parent->get_dimension();
         mat::Vec2f parent_cell = {prent_dim[0]/parent_grid.column, prent_dim[1]/parent_grid.row};
-        mat::Vec2f parent_pos = p_parent->get_absolute_position() + parent_cell * p_position.position;
-        
+
         mat::Vec2f anchor{0.0f, 0.0f};
 
         switch (p_position.anchor)
         {
-        case UI_Anchor::TL:
-            anchor = {0.0f, 1.0f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::TC:
-            anchor = {0.5f, 1.0f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::TR:
-            anchor = {1.0f, 1.0f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::CL:
-            anchor = {0.0f, 0.5f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::CC:
-            anchor = {0.5f, 0.5f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::CR:
-            anchor = {1.0f, 0.5f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::BL:
-            anchor = {0.0f, 0.0f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::BC:
-            anchor = {0.5f, 0.0f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-
-        case UI_Anchor::BR:
-            anchor = {1.0f, 0.0f};
-            return parent_pos + anchor*(parent_cell - p_dimension);
-        
+        case UI_Anchor::TL: anchor = {0.0f, 1.0f}; break;
+        case UI_Anchor::TC: anchor = {0.5f, 1.0f}; break;
+        case UI_Anchor::TR: anchor = {1.0f, 1.0f}; break;
+        case UI_Anchor::CL: anchor = {0.0f, 0.5f}; break;
+        case UI_Anchor::CC: anchor = {0.5f, 0.5f}; break;
+        case UI_Anchor::CR: anchor = {1.0f, 0.5f}; break;
+        case UI_Anchor::BL: anchor = {0.0f, 0.0f}; break;
+        case UI_Anchor::BC: anchor = {0.5f, 0.0f}; break;
+        case UI_Anchor::BR: anchor = {1.0f, 0.0f}; break;
         default:
             return mat::Vec2f{0.0f, 0.0f};
         }
+
+        // The parent position is computed once per level
+        return parent_pos + parent_cell * p_position.position + anchor * (parent_cell - p_dimension);
         }
 
     default:
@@ -219,28 +194,14 @@ UI_Label::UI_Label(UI_ElementState state, UI_Position position, UI_Grid grid, ma
 {}
 
 mat::Vec2f UI_Label::compute_dimension(Font& font) {
-    float max_x(0), current_x(0), current_y(0);
-
-    for (uint32_t i(0) ; i < m_text.size() ; ++i) {
-        if (m_text[i] == '\n') {
-            if (current_x > max_x) {
-                max_x = current_x;
-            }
-            current_x = 0;
-            current_y += font.get_height();
-
-        }else{
-            const Character& c = font.get_char(m_text[i]);
-            current_x += c.advance >> 6;
-        }
-    }
+    m_layout.set_text(font, m_text);
 
-    if (current_x > max_x) {
-        max_x = current_x;
-    }
+    p_dimension = mat::Vec2f{m_layout.get_width(), float((m_layout.get_line_count() - 1) * font.get_height())};
+    return p_dimension;
+}
 
-    p_dimension = mat::Vec2f{max_x, current_y};
-    return mat::Vec2f{max_x, current_y};
+void UI_Label::set_text(const std::string& text) {
+    m_text = text;
 }
 
 void UI_Label::update(const EventManager& event_manager) {
@@ -248,34 +209,22 @@ void UI_Label::update(const EventManager& event_manager) {
 }
 
 void UI_Label::submit(UI_Renderer& ui_renderer) {
-    float current_x(0), current_y(0);
     float r=p_color[0], g=p_color[1], b=p_color[2], a=p_color[3];
-    Font& font = ui_renderer.get_font();
-    compute_dimension(font);
+    compute_dimension(ui_renderer.get_font());
     mat::Vec2f position = get_absolute_position();
 
-    for (uint32_t i(0) ; i < m_text.size() ; ++i) {
-        if (m_text[i] == '\n') {
-            current_x = 0;
-            current_y -= font.get_height();
-
-        }else{
-            const Character& c = font.get_char(m_text[i]);
-
-            float x_(position[0] + current_x + c.bearing_x);
-            float y_(position[1] + current_y - c.height + c.bearing_y);
-
-            UI_Vertex  vertex[4] = {
-                UI_Vertex{x_,           y_,            r, g, b, a,   c.u,        c.v + c.h, float(UI_DrawMode::Text)}, // Bottom left
-                UI_Vertex{x_ + c.width, y_,            r, g, b, a,   c.u + c.w,  c.v + c.h, float(UI_DrawMode::Text)}, // Bottom right
-                UI_Vertex{x_ + c.width, y_ + c.height, r, g, b, a,   c.u + c.w,  c.v      , float(UI_DrawMode::Text)}, // Top right
-                UI_Vertex{x_,           y_ + c.height, r, g, b, a,   c.u,        c.v      , float(UI_DrawMode::Text)} // Top left
-            };
-            ui_renderer.submit_quad(vertex);
-
-            current_x += c.advance >> 6;
-        }
+    for (const GlyphQuad& q : m_layout.get_quads()) {
+        float x0(position[0] + q.x0), y0(position[1] + q.y0);
+        float x1(position[0] + q.x1), y1(position[1] + q.y1);
+
+        UI_Vertex  vertex[4] = {
+            UI_Vertex{x0, y0, r, g, b, a,   q.u0, q.v0, float(UI_DrawMode::Text)}, // Bottom left
+            UI_Vertex{x1, y0, r, g, b, a,   q.u1, q.v0, float(UI_DrawMode::Text)}, // Bottom right
+            UI_Vertex{x1, y1, r, g, b, a,   q.u1, q.v1, float(UI_DrawMode::Text)}, // Top right
+            UI_Vertex{x0, y1, r, g, b, a,   q.u0, q.v1, float(UI_DrawMode::Text)} // Top left
+        };
+        ui_renderer.submit_quad(vertex);
     }
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,170 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mat/Math.hpp"
+#include "Camera/Camera2D.hpp"
+#include "Camera/Camera3D.hpp"
+
+// Compare the inverses of known structure (Affine.hpp) with an inverse in double precision: the
+// largest error relative to the largest element of the inverse, and the time per call against the
+// general inverse and the SIMD inverse of Mat4f. Then the TRS decomposition, and the picking of the
+// cameras, a point projected then unprojected. No window needed.
+
+static mat::Mat4d reference_inverse(mat::Mat4d m) {
+    mat::Mat4d result = mat::identity<double,4>();
+    for (uint32_t k(0) ; k < 4 ; ++k) {
+        uint32_t pivot = k;
+        for (uint32_t i(k + 1) ; i < 4 ; ++i) {
+            if (std::fabs(m(i,k)) > std::fabs(m(pivot,k))) {
+                pivot = i;
+            }
+        }
+        for (uint32_t j(0) ; j < 4 ; ++j) {
+            std::swap(m(k,j), m(pivot,j));
+            std::swap(result(k,j), result(pivot,j));
+        }
+        double scale = 1.0 / m(k,k);
+        for (uint32_t j(0) ; j < 4 ; ++j) {
+            m(k,j) *= scale;
+            result(k,j) *= scale;
+        }
+        for (uint32_t i(0) ; i < 4 ; ++i) {
+            if (i == k) {
+                continue;
+            }
+            double factor = m(i,k);
+            for (uint32_t j(0) ; j < 4 ; ++j) {
+                m(i,j) -= factor * m(k,j);
+                result(i,j) -= factor * result(k,j);
+            }
+        }
+    }
+    return result;
+}
+
+static double relative_error(const mat::Mat4f& m, const mat::Mat4f& inverse) {
+    mat::Mat4d md;
+    std::copy(m.begin(), m.end(), md.begin());
+    mat::Mat4d reference = reference_inverse(md);
+    double largest = 0.0, error = 0.0;
+    for (uint32_t e = 0; e < 16; ++e) {
+        largest = std::max(largest, std::fabs(reference.begin()[e]));
+        error = std::max(error, std::fabs(reference.begin()[e] - inverse.begin()[e]));
+    }
+    return error / largest;
+}
+
+template<typename F>
+static double time_ns(uint32_t count, F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < count; ++i) {
+        f(i);
+    }
+    std::chrono::duration<double, std::nano> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count() / count;
+}
+
+int main(int argc, char* argv[]) {
+    const uint32_t count = 1 << 14;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+    auto random_quaternion = [&]() {
+        mat::Vec3f axis = mat::normalize(mat::Vec3f({value(rng), value(rng), value(rng)}));
+        return mat::quat_from_angle_vec_of_rotation(value(rng) * 3.14159265f, axis);
+    };
+    auto random_translation = [&]() {
+        return mat::Vec3f({value(rng) * 100.0f, value(rng) * 100.0f, value(rng) * 100.0f});
+    };
+
+    // The matrices of each kind, as built by the cameras and the models
+    std::vector<mat::Mat4f> rigid(count), affine(count), orthographic(count), perspective(count);
+    std::vector<mat::TRS<float>> trs(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        rigid[i] = mat::dot(mat::graph::rotate3(random_quaternion()), mat::graph::translate3(random_translation()));
+        trs[i] = {random_translation(), random_quaternion(), mat::Vec3f({1.5f + value(rng), 1.5f + value(rng), 1.5f + value(rng)})};
+        affine[i] = mat::dot(mat::dot(mat::graph::translate3(trs[i].translation), mat::graph::rotate3(trs[i].rotation)),
+                             mat::graph::scale3(trs[i].scale[0], trs[i].scale[1], trs[i].scale[2]));
+        float width = 200.0f + 1000.0f * (value(rng) + 1.0f), height = 200.0f + 1000.0f * (value(rng) + 1.0f);
+        orthographic[i] = mat::graph::orthographic3(-0.5f * width, 0.5f * width, -0.5f * height, 0.5f * height, -1.0f, 1.0f + 10.0f * (value(rng) + 1.0f));
+        perspective[i] = mat::graph::perspective(1.0f + 0.5f * value(rng), 1.0f + 0.5f * value(rng), 0.1f, 100.0f + 50.0f * value(rng));
+    }
+
+    bool ok = true;
+    float sink = 0.0f;
+
+    auto check = [&](const char* name, const std::vector<mat::Mat4f>& matrices, auto&& fast, double tolerance) {
+        double fast_error = 0.0, general_error = 0.0;
+        for (uint32_t i = 0; i < count; ++i) {
+            fast_error = std::max(fast_error, relative_error(matrices[i], fast(matrices[i])));
+            general_error = std::max(general_error, relative_error(matrices[i], mat::inverse<float,4>(matrices[i])));
+        }
+        double fast_ns = time_ns(count, [&](uint32_t i) { sink += fast(matrices[i])(1, 2); });
+        double simd_ns = time_ns(count, [&](uint32_t i) { sink += mat::inverse(matrices[i])(1, 2); });
+        double general_ns = time_ns(count, [&](uint32_t i) { sink += mat::inverse<float,4>(matrices[i])(1, 2); });
+        bool passed = fast_error <= tolerance;
+        ok &= passed;
+        std::cout << name << ": error " << fast_error << " (general " << general_error << "), "
+                  << fast_ns << " ns / " << simd_ns << " ns SIMD / " << general_ns << " ns general"
+                  << (passed ? "" : "  FAILED") << std::endl;
+    };
+
+    // The rotations in float are orthonormal up to 1e-7, the transpose inherits this error times the translation
+    check("inverse_rigid", rigid, [](const mat::Mat4f& m) { return mat::inverse(m, mat::Rigid{}); }, 4e-6);
+    check("inverse_affine", affine, [](const mat::Mat4f& m) { return mat::inverse(m, mat::Affine{}); }, 1e-6);
+    check("inverse_orthographic", orthographic, [](const mat::Mat4f& m) { return mat::inverse(m, mat::Orthographic{}); }, 1e-6);
+    check("inverse_perspective", perspective, [](const mat::Mat4f& m) { return mat::inverse(m, mat::Perspective{}); }, 1e-6);
+
+    // --- TRS: decompose the products, compose without them ---
+    {
+        float matrix_error = 0.0f, scale_error = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            mat::TRS<float> decomposed = mat::decompose_trs(affine[i]);
+            mat::Mat4f composed = mat::compose_trs(decomposed);
+            for (uint32_t e = 0; e < 16; ++e) {
+                matrix_error = std::max(matrix_error, std::fabs(composed.begin()[e] - affine[i].begin()[e]));
+            }
+            for (uint32_t k = 0; k < 3; ++k) {
+                scale_error = std::max(scale_error, std::fabs(decomposed.scale[k] - trs[i].scale[k]));
+            }
+        }
+        double decompose_ns = time_ns(count, [&](uint32_t i) { sink += mat::decompose_trs(affine[i]).rotation[1]; });
+        double compose_ns = time_ns(count, [&](uint32_t i) { sink += mat::compose_trs(trs[i])(1, 2); });
+        double product_ns = time_ns(count, [&](uint32_t i) {
+            sink += mat::dot(mat::dot(mat::graph::translate3(trs[i].translation), mat::graph::rotate3(trs[i].rotation)),
+                             mat::graph::scale3(trs[i].scale[0], trs[i].scale[1], trs[i].scale[2]))(1, 2);
+        });
+        bool passed = matrix_error <= 1e-4f && scale_error <= 1e-5f;
+        ok &= passed;
+        std::cout << "TRS: recomposed error " << matrix_error << ", scale error " << scale_error << ", decompose "
+                  << decompose_ns << " ns, compose " << compose_ns << " ns / " << product_ns << " ns products"
+                  << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- picking: project a point with the cameras, unproject it ---
+    {
+        AMB::CameraPerspective camera3(mat::Vec3f({3.0f, 2.0f, 10.0f}), random_quaternion(), 4.0f / 3.0f, 1.0f, 0.1f, 100.0f);
+        AMB::CameraOrthographic camera2(mat::Vec2f({120.0f, -40.0f}), mat::Vec2f({800.0f, 600.0f}), 0.3f);
+        float error3 = 0.0f, error2 = 0.0f;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            mat::Vec3f point = mat::Vec3f(camera3.get_position()) + mat::quat_rotate_vec(camera3.get_orientation(), mat::Vec3f({value(rng), value(rng), -5.0f - 5.0f * (value(rng) + 1.0f)}));
+            mat::BaseVector<float,4> clip = mat::dot(camera3.get_vp(), mat::BaseVector<float,4>{point[0], point[1], point[2], 1.0f});
+            mat::Vec3f world = camera3.unproject(mat::Vec3f({clip[0] / clip[3], clip[1] / clip[3], clip[2] / clip[3]}));
+            error3 = std::max(error3, (world - point).norm());
+
+            mat::Vec2f point2({value(rng) * 400.0f, value(rng) * 300.0f});
+            mat::BaseVector<float,4> ndc = mat::dot(camera2.get_vp(), mat::BaseVector<float,4>{point2[0], point2[1], 0.0f, 1.0f});
+            error2 = std::max(error2, (camera2.unproject(mat::Vec2f({ndc[0], ndc[1]})) - point2).norm());
+        }
+        bool passed = error3 <= 1e-3f && error2 <= 1e-3f;
+        ok &= passed;
+        std::cout << "Unproject: perspective error " << error3 << ", orthographic error " << error2 << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    std::cout << "Checksum: " << sink << std::endl;
+    std::cout << (ok ? "The structured inverses match the reference." : "Some structured inverses differ from the reference.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
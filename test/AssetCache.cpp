@@ -0,0 +1,58 @@
+#include <iostream>
+
+#include "Window/Window.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Asset/AssetCache.hpp"
+
+#include "Check.hpp"
+
+// Load the same assets several times through the cache, then lower the budget and check
+// that only the unreferenced assets are evicted, least recently released first.
+
+int main(int argc, char* argv[]) {
+
+    bool ok = true;
+
+    AMB::Window window(800, 600, "Asset cache", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+    AMB::AssetCache cache(asset_manager, asset_factory);
+
+    {
+        AMB::AssetRef<AMB::Texture> feather = cache.texture("test/res/Feather.png");
+        AMB::AssetRef<AMB::Texture> again = cache.texture("./test/res/Feather.png");
+        ok &= check(feather && again, "textures loaded");
+        ok &= check(feather.get_handle().index == again.get_handle().index, "same path gives the same texture");
+        ok &= check(cache.get_miss_count() == 1 && cache.get_hit_count() == 1, "second request is a hit");
+        ok &= check(cache.get_gpu_bytes(AMB::AssetType::TEXTURE) == feather->get_memory_size(), "texture bytes accounted once");
+
+        AMB::AssetRef<AMB::Texture> missing = cache.texture("test/res/missing.png");
+        ok &= check(!missing, "missing file gives an invalid reference");
+        ok &= check(cache.get_entry_count() == 1, "failures are not cached");
+    }
+    ok &= check(cache.get_entry_count() == 1, "unreferenced asset stays below the budget");
+
+    // The feather is released first, the fruit second: the feather is evicted first
+    AMB::AssetRef<AMB::Texture> fruit = cache.texture("test/res/fruit.png");
+    AMB::AssetRef<AMB::Font> font = cache.font("test/res/OpenSans.ttf", 32);
+    ok &= check(font && cache.get_gpu_bytes(AMB::AssetType::FONT) > 0, "font atlas accounted");
+    size_t fruit_bytes = fruit->get_memory_size();
+    fruit.reset();
+
+    cache.set_budget(SIZE_MAX, cache.get_gpu_bytes() - 1);
+    ok &= check(cache.get_entry_count() == 2 && cache.get_eviction_count() == 1, "least recently released evicted first");
+    ok &= check(cache.get_gpu_bytes(AMB::AssetType::TEXTURE) == fruit_bytes, "evicted bytes given back");
+
+    cache.set_budget(SIZE_MAX, 0);
+    ok &= check(cache.get_entry_count() == 1 && font, "referenced asset never evicted");
+
+    font.reset();
+    ok &= check(cache.get_entry_count() == 0 && cache.get_gpu_bytes() == 0, "released asset evicted over the budget");
+
+    cache.report();
+
+    std::cout << (ok ? "All checks passed" : "Some checks failed") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,56 @@
+#include <iostream>
+#include <chrono>
+
+#include "Window/Window.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Asset/AssetGraphLoader.hpp"
+#include "Thread/ThreadPool.hpp"
+
+// Load the level manifest one asset after another through the factory, then through the
+// dependency graph, and print the timings per asset with the critical path.
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(800, 600, "Asset graph", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+
+    using Clock = std::chrono::high_resolution_clock;
+    using ms = std::chrono::duration<float, std::milli>;
+
+    // --- sequential ---
+    auto start = Clock::now();
+    asset_factory.create_texture("test/res/Feather.png");
+    asset_factory.create_texture("test/res/fruit.png");
+    asset_factory.create_texture("test/res/bloom_golden.png");
+    asset_factory.create_shader("test/res/sprite.vert", "test/res/sprite.frag");
+    asset_factory.create_shader("test/res/Text.vert", "test/res/Text.frag");
+    asset_factory.create_shader("test/res/Particle.vert", "test/res/Particle.frag");
+    asset_factory.create_font("test/res/OpenSans.ttf", 32);
+    asset_factory.create_font("test/res/OpenSans.ttf", 64);
+    asset_factory.create_sound("test/res/but.wav");
+    glFinish();
+    ms sequential_time = Clock::now() - start;
+
+    // --- graph ---
+    AMB::ThreadPool pool;
+    AMB::AssetGraphLoader loader(asset_factory, pool);
+    if (!loader.add_manifest("test/res/level.manifest")) {
+        return 1;
+    }
+
+    start = Clock::now();
+    bool success = loader.load();
+    glFinish();
+    ms graph_time = Clock::now() - start;
+
+    loader.report();
+
+    std::cout << "Sequential: " << sequential_time.count() << " ms" << std::endl;
+    std::cout << "Graph (" << pool.get_thread_count() << " workers): " << graph_time.count() << " ms" << std::endl;
+    std::cout << "Font loaded: " << asset_manager.fonts.validity(loader.get("ui_font")) << std::endl;
+
+    return success ? 0 : 1;
+}
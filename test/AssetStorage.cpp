@@ -0,0 +1,161 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <random>
+
+#include "Asset/AssetStorage.hpp"
+#include "Asset/DenseAssetStorage.hpp"
+
+#include "Check.hpp"
+
+// Headless test of DenseAssetStorage (stale handles, reuse, destruction) and comparison of the
+// lookup cost against AssetStorage.
+
+struct Asset {
+    static int alive;
+
+    float values[4];
+
+    Asset(float v) : values{v, v, v, v} { ++alive; }
+    ~Asset() { --alive; }
+
+    Asset(const Asset&) = delete;
+    Asset& operator=(const Asset&) = delete;
+};
+
+int Asset::alive = 0;
+
+// Owns an object released by its destructor and copyable by its implicit copy constructor, like Texture
+struct Resource {
+    static int released;
+
+    uint32_t id;
+
+    Resource(uint32_t id) : id(id) {}
+    ~Resource() { ++released; }
+};
+
+int Resource::released = 0;
+
+// std::vector really moves, it opts in
+template<>
+struct AMB::DenseGrowable<std::vector<int>> : std::true_type {};
+
+int main(int argc, char* argv[]) {
+
+    bool ok = true;
+
+    // --- slot map semantics ---
+    {
+        AMB::DenseAssetStorage<Asset> storage(4);
+
+        AMB::Handle<Asset> a = storage.add(1.0f);
+        AMB::Handle<Asset> b = storage.add(2.0f);
+        ok &= check(storage.validity(a) && storage.validity(b), "handles valid after add");
+        ok &= check(storage.get(b).values[0] == 2.0f, "get returns the asset");
+        ok &= check(!storage.validity(AMB::Handle<Asset>{}), "default handle is invalid");
+
+        storage.remove(a);
+        AMB::Handle<Asset> c = storage.add(3.0f);
+        ok &= check(c.index == a.index, "slot reused");
+        ok &= check(!storage.validity(a), "stale handle detected after reuse");
+        ok &= check(storage.try_get(a) == nullptr && storage.try_get(c) != nullptr, "try_get");
+        ok &= check(!storage.remove(a), "remove with a stale handle fails");
+
+        storage.add(4.0f);
+        storage.add(5.0f);
+        AMB::Handle<Asset> full = storage.add(6.0f);
+        ok &= check(!storage.validity(full) && storage.size() == 4, "fixed capacity for non movable types");
+
+        ok &= check(!storage.validity(AMB::Handle<Asset>{1000, 1}), "out of range handle");
+
+        storage.remove_all();
+        ok &= check(Asset::alive == 0 && !storage.validity(b), "remove_all destroys and invalidates");
+    }
+    ok &= check(Asset::alive == 0, "destructor destroys the assets");
+
+    // Copyable owners keep a fixed capacity, growing would destroy the originals of the copies
+    {
+        AMB::DenseAssetStorage<Resource> storage(2);
+        AMB::Handle<Resource> a = storage.add(1u);
+        storage.add(2u);
+        AMB::Handle<Resource> full = storage.add(3u);
+        ok &= check(!storage.validity(full) && storage.capacity() == 2, "fixed capacity for copyable owners");
+        ok &= check(Resource::released == 0 && storage.get(a).id == 1, "no live resource released");
+    }
+    ok &= check(Resource::released == 2, "resources released once");
+
+    // Move only types grow
+    {
+        AMB::DenseAssetStorage<std::unique_ptr<int>> storage(2);
+        std::vector<AMB::Handle<std::unique_ptr<int>>> handles;
+        for (int i = 0; i < 100; ++i) {
+            handles.push_back(storage.add(std::make_unique<int>(i)));
+        }
+        bool all = true;
+        for (int i = 0; i < 100; ++i) {
+            all &= storage.validity(handles[i]) && *storage.get(handles[i]) == i;
+        }
+        ok &= check(all && storage.capacity() >= 100, "move only types grow");
+    }
+
+    // Opted in types grow
+    {
+        AMB::DenseAssetStorage<std::vector<int>> storage(2);
+        std::vector<AMB::Handle<std::vector<int>>> handles;
+        for (int i = 0; i < 100; ++i) {
+            handles.push_back(storage.add(std::vector<int>(3, i)));
+        }
+        bool all = true;
+        for (int i = 0; i < 100; ++i) {
+            all &= storage.validity(handles[i]) && storage.get(handles[i])[2] == i;
+        }
+        ok &= check(all && storage.capacity() >= 100, "opted in types grow");
+    }
+
+    // --- lookup cost ---
+    const int count = 1000;
+    const int lookups = 10000000;
+
+    AMB::AssetStorage<Asset> sparse;
+    AMB::DenseAssetStorage<Asset> dense(count);
+    std::vector<AMB::AssetHandle> sparse_handles;
+    std::vector<AMB::Handle<Asset>> dense_handles;
+    for (int i = 0; i < count; ++i) {
+        sparse_handles.push_back(sparse.add(float(i)));
+        dense_handles.push_back(dense.add(float(i)));
+    }
+
+    std::mt19937 rng(42);
+    std::vector<int> order(lookups);
+    for (auto& o : order) {
+        o = int(rng() % count);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    using ms = std::chrono::duration<float, std::milli>;
+
+    float sum_sparse = 0.0f, sum_dense = 0.0f;
+
+    auto start = Clock::now();
+    for (int o : order) {
+        if (sparse.validity(sparse_handles[o])) {
+            sum_sparse += sparse.get(sparse_handles[o]).values[1];
+        }
+    }
+    ms sparse_time = Clock::now() - start;
+
+    start = Clock::now();
+    for (int o : order) {
+        if (dense.validity(dense_handles[o])) {
+            sum_dense += dense.get(dense_handles[o]).values[1];
+        }
+    }
+    ms dense_time = Clock::now() - start;
+
+    ok &= check(sum_sparse == sum_dense, "same results");
+    std::cout << lookups << " validity + get: AssetStorage " << sparse_time.count() << " ms, DenseAssetStorage " << dense_time.count() << " ms" << std::endl;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
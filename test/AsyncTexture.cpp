@@ -0,0 +1,71 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include "Window/Window.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Asset/AsyncTextureLoader.hpp"
+#include "Thread/ThreadPool.hpp"
+
+// Load the same level (300 textures) synchronously then asynchronously and compare the times.
+// The async loader is driven like in a game loop: a few milliseconds of upload per frame.
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(800, 600, "Async texture", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+
+    const int texture_count = 300;
+    const char* paths[2] = {"test/res/Feather.png", "test/res/fruit.png"};
+
+    using Clock = std::chrono::high_resolution_clock;
+    using ms = std::chrono::duration<float, std::milli>;
+
+    // --- synchronous ---
+    std::vector<AMB::AssetHandle> handles;
+    auto start = Clock::now();
+    for (int i = 0; i < texture_count; ++i) {
+        handles.push_back(asset_factory.create_texture(std::string(paths[i % 2])));
+    }
+    glFinish();
+    ms sync_time = Clock::now() - start;
+
+    for (auto& handle : handles) {
+        asset_manager.textures.remove(handle);
+    }
+    handles.clear();
+
+    // --- asynchronous ---
+    AMB::ThreadPool pool;
+    AMB::AsyncTextureLoader loader(asset_manager, pool);
+
+    start = Clock::now();
+    for (int i = 0; i < texture_count; ++i) {
+        handles.push_back(loader.load(paths[i % 2]));
+    }
+    ms submit_time = Clock::now() - start;
+
+    int frames = 0;
+    float max_frame = 0.0f;
+    while (loader.get_pending_count() > 0) {
+        auto frame_start = Clock::now();
+        loader.update(4.0f);
+        window.present();
+        max_frame = std::max(max_frame, ms(Clock::now() - frame_start).count());
+        ++frames;
+    }
+    glFinish();
+    ms async_time = Clock::now() - start;
+
+    AMB::Texture& texture = asset_manager.textures.get(handles[0]);
+    std::cout << "First texture: " << texture.get_width() << "x" << texture.get_height() << std::endl;
+
+    std::cout << "Synchronous load : " << sync_time.count() << " ms" << std::endl;
+    std::cout << "Asynchronous load: " << async_time.count() << " ms with " << pool.get_thread_count() << " workers"
+              << " (submit " << submit_time.count() << " ms, " << frames << " frames, longest frame " << max_frame << " ms)" << std::endl;
+
+    return 0;
+}
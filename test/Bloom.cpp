@@ -0,0 +1,158 @@
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <algorithm>
+
+#include "Graphic/BloomReference.hpp"
+
+#include "Check.hpp"
+
+#include "External/stb_image/stb_image.h"
+#include "External/stb_image/stb_image_write.h"
+
+// Headless regression test of the bloom filter: the CPU reference is compared against a golden image.
+// Run with --update-golden to regenerate test/res/bloom_golden.png after an intended change of the filter.
+
+const char* GOLDEN_PATH = "test/res/bloom_golden.png";
+
+AMB::BloomImage make_scene(int32_t width, int32_t height) {
+    AMB::BloomImage scene(width, height);
+
+    for (int32_t y = 0; y < height; ++y) {
+        for (int32_t x = 0; x < width; ++x) {
+            float* p = scene.at(x, y);
+
+            // Dark background gradient, under the threshold
+            p[0] = 0.05f + 0.15f * float(x) / float(width);
+            p[1] = 0.05f;
+            p[2] = 0.05f + 0.15f * float(y) / float(height);
+            p[3] = 1.0f;
+
+            // Bright discs
+            auto disc = [&](float cx, float cy, float r, float cr, float cg, float cb) {
+                float dx = float(x) - cx, dy = float(y) - cy;
+                if (dx * dx + dy * dy <= r * r) {
+                    p[0] = cr; p[1] = cg; p[2] = cb;
+                }
+            };
+            disc(30.0f, 30.0f, 4.0f, 1.0f, 0.9f, 0.4f);
+            disc(90.0f, 60.0f, 2.0f, 0.3f, 0.6f, 1.0f);
+            disc(64.0f, 80.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+
+            // Thin bright line
+            if (y == 15 && x > 60 && x < 120) {
+                p[0] = 1.0f; p[1] = 0.2f; p[2] = 0.2f;
+            }
+        }
+    }
+    return scene;
+}
+
+std::vector<unsigned char> to_rgba8(const AMB::BloomImage& image) {
+    std::vector<unsigned char> data(image.pixels.size());
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        data[i] = (unsigned char)(std::clamp(image.pixels[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+    return data;
+}
+
+int main(int argc, char* argv[]) {
+
+    bool update_golden = argc > 1 && std::strcmp(argv[1], "--update-golden") == 0;
+    bool ok = true;
+
+    AMB::BloomSettings settings;
+    settings.threshold = 0.8f;
+    settings.knee = 0.4f;
+    settings.intensity = 10.0f;
+    settings.radius = 1.0f;
+    settings.levels = 5;
+
+    // --- texel fetches per scene pixel ---
+    // Old bloom: bright (1) + blur (17) + combine (2), all at full resolution, for a radius of 4 texels
+    const int32_t width = 128, height = 96;
+    uint32_t levels = AMB::bloom_level_count(width, height, settings.levels);
+    double fetches = 0.0;
+    double scene_pixels = double(width) * double(height);
+    for (uint32_t i = 0; i < levels; ++i) {
+        double pixels = double(AMB::bloom_level_size(width, i)) * double(AMB::bloom_level_size(height, i));
+        fetches += 5.0 * pixels;                        // downsample
+        if (i + 1 < levels) fetches += 8.0 * pixels;    // upsample into this level
+    }
+    fetches += 9.0 * scene_pixels;                      // composite (scene + 8 taps)
+    // A separable gaussian reaching the same radius (about 2^(levels+1) texels) needs 2 * (2r + 1) fetches
+    double radius = double(1u << (levels + 1));
+    std::cout << "Texel fetches per pixel: dual-filter " << fetches / scene_pixels << " (" << levels << " levels), "
+              << "old ping-pong 20 (radius 4), gaussian of the same radius " << 2.0 * (2.0 * radius + 1.0) + 3.0 << std::endl;
+
+    // --- a scene under the threshold is left untouched ---
+    {
+        AMB::BloomImage dark(32, 32);
+        for (size_t i = 0; i < dark.pixels.size(); ++i) dark.pixels[i] = 0.2f;
+        AMB::BloomSettings hard = settings;
+        hard.threshold = 1.0f;
+        hard.knee = 0.1f;
+        AMB::BloomImage out = AMB::bloom_reference(dark, hard);
+        float diff = 0.0f;
+        for (size_t i = 0; i < out.pixels.size(); ++i) diff = std::max(diff, std::fabs(out.pixels[i] - dark.pixels[i]));
+        ok &= check(diff == 0.0f, "no bloom under the threshold");
+    }
+
+    // --- a centered point spreads symmetrically ---
+    {
+        AMB::BloomImage point(64, 64);
+        for (int c = 0; c < 3; ++c) {
+            // HDR value, the first downsample averages the point with its dark neighbours
+            point.at(31, 31)[c] = 8.0f; point.at(32, 31)[c] = 8.0f;
+            point.at(31, 32)[c] = 8.0f; point.at(32, 32)[c] = 8.0f;
+        }
+        AMB::BloomImage out = AMB::bloom_reference(point, settings);
+        float asymmetry = 0.0f;
+        for (int32_t y = 0; y < 64; ++y) {
+            for (int32_t x = 0; x < 64; ++x) {
+                asymmetry = std::max(asymmetry, std::fabs(out.at(x, y)[0] - out.at(63 - x, y)[0]));
+                asymmetry = std::max(asymmetry, std::fabs(out.at(x, y)[0] - out.at(y, x)[0]));
+            }
+        }
+        ok &= check(asymmetry < 1e-5f, "symmetric spread of a centered point");
+        ok &= check(out.at(20, 32)[0] > 0.0f, "bloom reaches beyond the point");
+    }
+
+    // --- golden image ---
+    AMB::BloomImage result = AMB::bloom_reference(make_scene(width, height), settings);
+    std::vector<unsigned char> pixels = to_rgba8(result);
+
+    stbi_flip_vertically_on_write(1);
+    stbi_set_flip_vertically_on_load(true);
+
+    if (update_golden) {
+        if (!stbi_write_png(GOLDEN_PATH, width, height, 4, pixels.data(), width * 4)) {
+            std::cerr << "Can not write " << GOLDEN_PATH << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "Golden image updated: " << GOLDEN_PATH << std::endl;
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    int golden_width, golden_height, golden_bpp;
+    unsigned char* golden = stbi_load(GOLDEN_PATH, &golden_width, &golden_height, &golden_bpp, 4);
+    if (!golden) {
+        std::cerr << "Can not load " << GOLDEN_PATH << " (run with --update-golden to create it)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    bool same_size = golden_width == width && golden_height == height;
+    ok &= check(same_size, "golden image size");
+    if (same_size) {
+        int max_diff = 0;
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            max_diff = std::max(max_diff, std::abs(int(pixels[i]) - int(golden[i])));
+        }
+        // One step of tolerance for the rounding of different compilers / float modes
+        ok &= check(max_diff <= 1, "golden image match (max diff " + std::to_string(max_diff) + ")");
+    }
+    stbi_image_free(golden);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+// The checks of the tests, one line each: ok &= check(condition, "what is checked")
+
+/// @brief Print a check as passed or failed
+/// @return The condition
+inline bool check(bool condition, const std::string& name) {
+    std::cout << (condition ? "[OK]   " : "[FAIL] ") << name << std::endl;
+    return condition;
+}
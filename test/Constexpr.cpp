@@ -0,0 +1,121 @@
+#include <iostream>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "mat/Math.hpp"
+
+// The transforms and the tables below are computed by the compiler, the static_assert fail the build
+// otherwise. At run time, the tables are compared with the same values computed by <cmath>.
+
+// --- vectors, matrices and quaternions ---
+
+constexpr mat::Vec3f a({1.0f, 2.0f, 3.0f});
+constexpr mat::Vec3f b({4.0f, 5.0f, 6.0f});
+static_assert((a + b)[2] == 9.0f && (b - a)[0] == 3.0f && (2.0f * a)[1] == 4.0f);
+static_assert(mat::dot(a, b) == 32.0f);
+static_assert(mat::cross(a, b) == mat::Vec3f({-3.0f, 6.0f, -3.0f}));
+static_assert(mat::normalize(mat::Vec3f({3.0f, 0.0f, 4.0f}))[2] == 0.8f);
+
+constexpr mat::Mat4f translation = mat::graph::translate3(mat::Vec3f({1.0f, 2.0f, 3.0f}));
+constexpr mat::Mat4f scale = mat::graph::scale3(2.0f);
+constexpr mat::Mat4f model = mat::dot(translation, scale);
+static_assert(model(0,0) == 2.0f && model(1,3) == 2.0f);
+static_assert(mat::transpose(model)(3,1) == 2.0f);
+static_assert(mat::dot(mat::inverse(model), model).data() == mat::identity<float,4>().data());
+static_assert(mat::dot(model, mat::BaseVector<float,4>({1.0f, 1.0f, 1.0f, 1.0f}))[2] == 5.0f);
+
+// The projection of the UI, 800 x 600
+constexpr mat::Mat4f ortho = mat::graph::orthographic3<float>(0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f);
+static_assert(mat::dot(ortho, mat::Vec4f({800.0f, 600.0f, 0.0f, 1.0f})) == mat::Vec4f({1.0f, 1.0f, 0.0f, 1.0f}));
+
+constexpr mat::Quatf i(0.0f, 1.0f, 0.0f, 0.0f);
+constexpr mat::Quatf j(0.0f, 0.0f, 1.0f, 0.0f);
+constexpr mat::Quatf k(0.0f, 0.0f, 0.0f, 1.0f);
+static_assert(i * j == k && j * i == -k && i * i == mat::Quatf(-1.0f));
+static_assert(mat::conjugate(i) == -i);
+
+// --- functions of <cmath> ---
+
+constexpr bool near(double x, double y, double tolerance) {
+    return mat::cx::abs(x - y) <= tolerance;
+}
+static_assert(near(mat::cx::sin(mat::PI / 6.0), 0.5, 1e-15));
+static_assert(near(mat::cx::cos(mat::PI / 3.0), 0.5, 1e-15));
+static_assert(near(mat::cx::tan(mat::PI_4), 1.0, 1e-15));
+static_assert(mat::cx::sqrt(2.0) * mat::cx::sqrt(2.0) - 2.0 < 1e-15 && mat::cx::sqrt(1e300) == 1e150);
+static_assert(near(mat::cx::exp(1.0), 2.718281828459045, 1e-15));
+
+constexpr mat::Vec3f rotated = mat::quat_rotate_vec(mat::quat_from_angle_vec_of_rotation(float(mat::PI_2), mat::Vec3f({0.0f, 0.0f, 1.0f})), mat::Vec3f({1.0f, 0.0f, 0.0f}));
+static_assert(near(rotated[0], 0.0, 1e-6) && near(rotated[1], 1.0, 1e-6));
+
+constexpr mat::Mat4f projection = mat::graph::perspective(4.0f / 3.0f, float(mat::PI_2), 0.1f, 100.0f);
+static_assert(near(projection(1,1), 1.0, 1e-6));
+
+// --- tables ---
+
+constexpr uint32_t steps = 256;
+
+// Rotations of the sprites by steps of 2 pi / 256
+constexpr std::array<mat::Mat2f, steps> rotation_table = []() {
+    std::array<mat::Mat2f, steps> table;
+    for (uint32_t s = 0; s < steps; ++s) {
+        table[s] = mat::rotate2(float(2.0 * mat::PI * s / steps));
+    }
+    return table;
+}();
+static_assert(rotation_table[0].data() == mat::identity<float,2>().data());
+static_assert(near(rotation_table[steps / 4](1,0), 1.0, 1e-7));
+
+// Easing curve of the UI animations
+constexpr std::array<float, steps> easing_table = []() {
+    std::array<float, steps> table;
+    for (uint32_t s = 0; s < steps; ++s) {
+        table[s] = mat::quintic_interpolation(0.0f, 1.0f, float(s) / (steps - 1));
+    }
+    return table;
+}();
+static_assert(easing_table[0] == 0.0f && easing_table[steps - 1] == 1.0f);
+
+static int64_t ulp(double x, double y) {
+    int64_t a, b;
+    std::memcpy(&a, &x, sizeof(a));
+    std::memcpy(&b, &y, sizeof(b));
+    a = a < 0 ? INT64_MIN - a : a;
+    b = b < 0 ? INT64_MIN - b : b;
+    return std::llabs(a - b);
+}
+
+int main(int argc, char* argv[]) {
+    bool ok = true;
+
+    // The series of the constant expressions against <cmath>
+    int64_t sin_ulp = 0, cos_ulp = 0, sqrt_ulp = 0, exp_ulp = 0;
+    for (int n = -100000; n <= 100000; ++n) {
+        double x = n * 1e-3 * mat::PI;
+        sin_ulp = std::max(sin_ulp, ulp(mat::cx::detail::sin(x), std::sin(x)));
+        cos_ulp = std::max(cos_ulp, ulp(mat::cx::detail::cos(x), std::cos(x)));
+        double e = n * 7e-3;
+        exp_ulp = std::max(exp_ulp, ulp(mat::cx::detail::exp(e), std::exp(e)));
+        double s = std::abs(n) * 1.37e3 + 1e-3;
+        sqrt_ulp = std::max(sqrt_ulp, ulp(mat::cx::detail::sqrt(s), std::sqrt(s)));
+    }
+    std::cout << "Series: sin " << sin_ulp << " ulp, cos " << cos_ulp << " ulp, sqrt " << sqrt_ulp << " ulp, exp " << exp_ulp << " ulp" << std::endl;
+    ok &= sin_ulp <= 2 && cos_ulp <= 2 && sqrt_ulp <= 2 && exp_ulp <= 2;
+
+    // The tables against the functions at run time
+    float rotation_error = 0.0f, easing_error = 0.0f;
+    for (uint32_t s = 0; s < steps; ++s) {
+        mat::Mat2f m = mat::rotate2(float(2.0 * mat::PI * s / steps));
+        for (uint32_t e = 0; e < 4; ++e) {
+            rotation_error = std::max(rotation_error, std::fabs(m.begin()[e] - rotation_table[s].begin()[e]));
+        }
+        easing_error = std::max(easing_error, std::fabs(mat::quintic_interpolation(0.0f, 1.0f, float(s) / (steps - 1)) - easing_table[s]));
+    }
+    std::cout << "Rotation table: " << rotation_error << ", easing table: " << easing_error << std::endl;
+    // The run time may contract the polynomials into FMA, the constant expressions do not
+    ok &= rotation_error <= 1e-7f && easing_error <= 1e-6f;
+
+    std::cout << (ok ? "The constant expressions match the run time." : "The constant expressions differ from the run time.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mat/Math.hpp"
+
+// Check the double-double against a quadruple precision reference (113 bits): the error-free
+// transformations are exact, the operations within a few 2^-106. Then the Mandelbrot series on a
+// zoom of width 1e-20, where double gives the same point to many pixels: the iterations in
+// double-double match the reference, and their cost against double. No window needed.
+
+#if defined(__SIZEOF_FLOAT128__)
+typedef __float128 Quad;
+#else
+typedef long double Quad;
+#endif
+
+using mat::DoubleDouble;
+
+constexpr DoubleDouble third = DoubleDouble(1.0) / 3.0;
+static_assert(third.hi() == 1.0 / 3.0 && third.lo() != 0.0);
+static_assert(sqrt(DoubleDouble(4.0)) == DoubleDouble(2.0));
+static_assert((DoubleDouble(1.0) + 1e-20) - 1.0 == DoubleDouble(1e-20));
+
+static Quad quad(const DoubleDouble& a) {
+    return Quad(a.hi()) + Quad(a.lo());
+}
+
+static double relative_error(const DoubleDouble& a, Quad reference) {
+    return double((quad(a) - reference) / reference) * (reference < 0 ? -1.0 : 1.0);
+}
+
+template<typename S>
+static uint32_t mandelbrot_serie(const mat::Complex<S>& c, uint32_t max_iter) {
+    uint32_t iter = 0;
+    mat::Complex<S> z(S(0.0), S(0.0));
+    while (z.modulus2() <= S(4.0) && iter < max_iter) {
+        z = z * z + c;
+        ++iter;
+    }
+    return iter;
+}
+
+int main(int argc, char* argv[]) {
+    std::mt19937_64 rng(13);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    const uint32_t samples = 1 << 18;
+    bool ok = true;
+
+    auto random_double = [&]() { return std::ldexp(value(rng), exponent(rng)); };
+    auto random_dd = [&]() {
+        double hi = random_double();
+        return DoubleDouble(hi) + hi * 0x1p-53 * value(rng);
+    };
+
+    // --- error-free transformations ---
+    {
+        uint32_t inexact = 0;
+        for (uint32_t i = 0; i < samples; ++i) {
+            double a = random_double(), b = random_double(), e;
+            double s = mat::dd::two_sum(a, b, e);
+            inexact += Quad(s) + Quad(e) != Quad(a) + Quad(b);
+            double p = mat::dd::two_prod(a, b, e);
+            inexact += Quad(p) + Quad(e) != Quad(a) * Quad(b);
+        }
+        ok &= inexact == 0;
+        std::cout << "two_sum, two_prod: " << inexact << " inexact of " << 2 * samples << (inexact == 0 ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- operations, in units of 2^-106 ---
+    {
+        const double unit = 0x1p-106;
+        double add_error = 0.0, mul_error = 0.0, div_error = 0.0, sqrt_error = 0.0;
+        for (uint32_t i = 0; i < samples; ++i) {
+            DoubleDouble a = random_dd(), b = random_dd();
+            Quad qa = quad(a), qb = quad(b);
+            if (qa + qb != 0) {
+                // Relative to the largest operand, the cancellations of a sum are exact
+                add_error = std::max(add_error, std::fabs(double((quad(a + b) - (qa + qb)) / std::max(qa < 0 ? -qa : qa, qb < 0 ? -qb : qb))) / unit);
+            }
+            mul_error = std::max(mul_error, std::fabs(relative_error(a * b, qa * qb)) / unit);
+            div_error = std::max(div_error, std::fabs(relative_error(a / b, qa / qb)) / unit);
+            DoubleDouble c = abs(a);
+            Quad qc = quad(c);
+            // Reference square root: one Newton step in quadruple precision from the double one
+            Quad root = Quad(std::sqrt(c.hi()));
+            root = (root + qc / root) / 2;
+            root = (root + qc / root) / 2;
+            sqrt_error = std::max(sqrt_error, std::fabs(relative_error(sqrt(c), root)) / unit);
+        }
+        bool passed = add_error <= 4.0 && mul_error <= 16.0 && div_error <= 16.0 && sqrt_error <= 16.0;
+        ok &= passed;
+        std::cout << "Errors in 2^-106: add " << add_error << ", mul " << mul_error << ", div " << div_error << ", sqrt " << sqrt_error
+                  << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- Mandelbrot at a width of 1e-20 ---
+    {
+        const uint32_t size = 48;
+        const uint32_t max_iter = 1000;
+        // Around the Misiurewicz point i, the set has filaments at all scales
+        const DoubleDouble center_re = DoubleDouble(0.0) + 3.1e-21;
+        const DoubleDouble center_im = DoubleDouble(1.0) - 1.7e-21;
+        const DoubleDouble pixel = DoubleDouble(1e-20) / double(size);
+
+        std::vector<uint32_t> reference(size * size), as_double(size * size), as_dd(size * size);
+        double double_ms = 0.0, dd_ms = 0.0;
+        uint64_t iterations = 0, double_iterations = 0;
+        for (uint32_t j = 0; j < size; ++j) {
+            for (uint32_t i = 0; i < size; ++i) {
+                DoubleDouble re = center_re + pixel * (double(i) - 0.5 * size);
+                DoubleDouble im = center_im + pixel * (double(j) - 0.5 * size);
+
+                // Reference: the series in quadruple precision
+                Quad qre = quad(re), qim = quad(im), zr = 0, zi = 0;
+                uint32_t iter = 0;
+                while (zr * zr + zi * zi <= 4 && iter < max_iter) {
+                    Quad t = zr * zr - zi * zi + qre;
+                    zi = 2 * zr * zi + qim;
+                    zr = t;
+                    ++iter;
+                }
+                reference[i + j * size] = iter;
+                iterations += iter;
+
+                auto start = std::chrono::high_resolution_clock::now();
+                as_double[i + j * size] = mandelbrot_serie(mat::Complex<double>(double(re), double(im)), max_iter);
+                double_iterations += as_double[i + j * size];
+                auto middle = std::chrono::high_resolution_clock::now();
+                as_dd[i + j * size] = mandelbrot_serie(mat::Complex<DoubleDouble>(re, im), max_iter);
+                auto end = std::chrono::high_resolution_clock::now();
+                double_ms += std::chrono::duration<double, std::milli>(middle - start).count();
+                dd_ms += std::chrono::duration<double, std::milli>(end - middle).count();
+            }
+        }
+
+        uint32_t double_match = 0, dd_match = 0, distinct_rows = 0;
+        for (uint32_t p = 0; p < size * size; ++p) {
+            double_match += as_double[p] == reference[p];
+            dd_match += as_dd[p] == reference[p];
+        }
+        for (uint32_t p = 1; p < size; ++p) {
+            distinct_rows += double(center_im + pixel * double(p)) != double(center_im + pixel * double(p - 1));
+        }
+        // The few pixels on the border of escaping may differ in the last iteration
+        bool passed = dd_match >= size * size * 99 / 100;
+        ok &= passed;
+        std::cout << "Mandelbrot at width 1e-20 (" << size << "x" << size << ", " << iterations << " iterations): "
+                  << "double matches " << double_match << " pixels (" << distinct_rows + 1 << " distinct rows of " << size
+                  << "), double-double " << dd_match << (passed ? "" : "  FAILED") << std::endl;
+        double double_ns = 1e6 * double_ms / double_iterations, dd_ns = 1e6 * dd_ms / iterations;
+        std::cout << "Time per iteration: double " << double_ns << " ns, double-double " << dd_ns << " ns (x" << dd_ns / double_ns << ")" << std::endl;
+    }
+
+    std::cout << (ok ? "The double-double matches the reference." : "The double-double differs from the reference.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
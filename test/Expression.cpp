@@ -0,0 +1,139 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "mat/Math.hpp"
+
+// Compare the operators of mat::Vector and mat::Matrix with the expressions of mat::lazy on the
+// updates of the particles, the positions of the UI grids and blends of matrices. Both give the same
+// values, the expressions without temporary objects. With optimizations (-O2) the compiler already
+// removes most of the temporaries of the operators, without them the nodes cost more calls.
+// No window needed.
+
+constexpr mat::Vec2f lazy_sum = mat::Vec2f({1.0f, 2.0f}) + mat::lazy::ref(mat::Vec2f({3.0f, 4.0f})) * 2.0f;
+static_assert(lazy_sum[0] == 7.0f && lazy_sum[1] == 10.0f);
+
+template<typename F>
+static double time_ms(uint32_t iterations, F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count() / iterations;
+}
+
+struct Particles {
+    std::vector<mat::Vec2f> position;
+    std::vector<mat::Vec2f> velocity;
+    std::vector<mat::Vec4f> color;
+};
+
+int main(int argc, char* argv[]) {
+    const uint32_t count = 1 << 18;
+    const uint32_t iterations = 20;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+    Particles initial;
+    for (uint32_t i = 0; i < count; ++i) {
+        initial.position.push_back(mat::Vec2f({value(rng) * 400.0f, value(rng) * 300.0f}));
+        initial.velocity.push_back(mat::Vec2f({value(rng), value(rng)}));
+        initial.color.push_back(mat::Vec4f({1.0f, 0.5f + 0.5f * value(rng), 0.2f, 1.0f}));
+    }
+    const mat::Vec2f pos1({-100.0f, 0.0f}), pos2({100.0f, 0.0f});
+    const mat::Vec4f fade({0.0004f, 0.0008f, 0.001f, 0.0f});
+    const float dt = 16.0f;
+
+    bool ok = true;
+
+    // --- particles: fade, attraction of two points, integration (test/Particle2Test) ---
+    {
+        Particles eager = initial, lazy = initial;
+        auto update_eager = [&]() {
+            for (uint32_t i = 0; i < count; ++i) {
+                mat::Vec2f delta1 = eager.position[i] - pos1;
+                mat::Vec2f delta2 = eager.position[i] - pos2;
+                mat::Vec2f force = (-0.01f * delta1 - 0.02f * delta2) * dt;
+                eager.color[i] -= fade * dt;
+                eager.position[i] += eager.velocity[i] * dt;
+                eager.velocity[i] += force;
+            }
+        };
+        auto update_lazy = [&]() {
+            for (uint32_t i = 0; i < count; ++i) {
+                mat::Vec2f force = (-0.01f * (mat::lazy::ref(lazy.position[i]) - pos1) - 0.02f * (mat::lazy::ref(lazy.position[i]) - pos2)) * dt;
+                lazy.color[i] -= mat::lazy::ref(fade) * dt;
+                lazy.position[i] += mat::lazy::ref(lazy.velocity[i]) * dt;
+                lazy.velocity[i] += force;
+            }
+        };
+        double eager_ms = time_ms(iterations, update_eager);
+        double lazy_ms = time_ms(iterations, update_lazy);
+
+        bool same = eager.position == lazy.position && eager.velocity == lazy.velocity && eager.color == lazy.color;
+        ok &= same;
+        std::cout << "Particles (" << count << "): " << eager_ms << " ms operators, " << lazy_ms << " ms expressions"
+                  << (same ? "" : "  DIFFERENT") << std::endl;
+    }
+
+    // --- UI: position of the elements in the cells of a grid (UI_Element::get_absolute_position) ---
+    {
+        std::vector<mat::Vec2f> eager(count), lazy(count);
+        const mat::Vec2f parent_pos({120.0f, 80.0f});
+        const mat::Vec2f parent_cell({64.0f, 32.0f});
+        const mat::Vec2f anchor({0.5f, 1.0f});
+        const std::vector<mat::Vec2f>& cells = initial.velocity;
+        const std::vector<mat::Vec2f>& dimensions = initial.position;
+
+        double eager_ms = time_ms(iterations, [&]() {
+            for (uint32_t i = 0; i < count; ++i) {
+                eager[i] = parent_pos + parent_cell * cells[i] + anchor * (parent_cell - dimensions[i]);
+            }
+        });
+        double lazy_ms = time_ms(iterations, [&]() {
+            for (uint32_t i = 0; i < count; ++i) {
+                lazy[i] = parent_pos + mat::lazy::ref(parent_cell) * cells[i] + anchor * (mat::lazy::ref(parent_cell) - dimensions[i]);
+            }
+        });
+
+        bool same = eager == lazy;
+        ok &= same;
+        std::cout << "UI grid positions (" << count << "): " << eager_ms << " ms operators, " << lazy_ms << " ms expressions"
+                  << (same ? "" : "  DIFFERENT") << std::endl;
+    }
+
+    // --- matrices: blend of two transforms, the largest temporaries ---
+    {
+        const uint32_t matrix_count = count / 8;
+        std::vector<mat::Mat4f> a(matrix_count), b(matrix_count), eager(matrix_count), lazy(matrix_count);
+        for (uint32_t i = 0; i < matrix_count; ++i) {
+            for (float& f : a[i]) { f = value(rng); }
+            for (float& f : b[i]) { f = 1.5f + value(rng); }
+        }
+        const float t = 0.3f;
+
+        double eager_ms = time_ms(iterations, [&]() {
+            for (uint32_t i = 0; i < matrix_count; ++i) {
+                eager[i] = a[i] * t + b[i] * (1.0f - t) - a[i] / b[i];
+            }
+        });
+        double lazy_ms = time_ms(iterations, [&]() {
+            for (uint32_t i = 0; i < matrix_count; ++i) {
+                lazy[i] = mat::lazy::ref(a[i]) * t + b[i] * (1.0f - t) - a[i] / mat::lazy::ref(b[i]);
+            }
+        });
+
+        bool same = true;
+        for (uint32_t i = 0; i < matrix_count; ++i) {
+            same &= eager[i].data() == lazy[i].data();
+        }
+        ok &= same;
+        std::cout << "Matrix blends (" << matrix_count << "): " << eager_ms << " ms operators, " << lazy_ms << " ms expressions"
+                  << (same ? "" : "  DIFFERENT") << std::endl;
+    }
+
+    std::cout << (ok ? "The expressions give the values of the operators." : "The expressions differ from the operators.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,226 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "mat/Math.hpp"
+
+// Measure the errors of mat::fast against the double functions of <cmath>, for the scalar and the
+// batch forms, and compare them with the bounds documented in Fast.hpp. The floats of each domain are
+// walked with a stride, all of them with the argument "exhaustive" (a few minutes). Then the time per
+// element against the float functions of <cmath>. No window needed.
+
+struct Bound {
+    double ulp;         // Maximum error in ulp of the result, for |result| >= near
+    double near;        // Below, close to the zeros of the function
+    double absolute;    // Maximum absolute error close to the zeros
+};
+
+struct Error {
+    double ulp = 0.0;       // Largest error in ulp, for |result| >= near
+    double absolute = 0.0;  // Largest absolute error, for |result| < near
+    float worst = 0.0f;     // Argument of the largest error in ulp
+    uint64_t samples = 0;
+    uint64_t failures = 0;
+};
+
+static double ulp_of(double reference) {
+    float f = std::fabs(float(reference));
+    if (f < std::numeric_limits<float>::min()) {
+        return std::numeric_limits<float>::denorm_min();
+    }
+    return std::nextafter(f, std::numeric_limits<float>::infinity()) - f;
+}
+
+static void measure(Error& error, const Bound& bound, float argument, float value, double reference) {
+    double absolute = std::fabs(double(value) - reference);
+    if (std::fabs(reference) < bound.near) {
+        error.absolute = std::max(error.absolute, absolute);
+        error.failures += absolute > bound.absolute;
+    } else {
+        double ulp = absolute / ulp_of(reference);
+        if (ulp > error.ulp) {
+            error.ulp = ulp;
+            error.worst = argument;
+        }
+        error.failures += ulp > bound.ulp;
+    }
+    ++error.samples;
+}
+
+static uint32_t bits(float x) { uint32_t b; std::memcpy(&b, &x, 4); return b; }
+static float from_bits(uint32_t b) { float x; std::memcpy(&x, &b, 4); return x; }
+
+/// @brief Call f on the floats of [lo, hi] (0 <= lo < hi) and their opposites if symmetric, by blocks
+template<typename F>
+static void walk(float lo, float hi, bool symmetric, uint32_t stride, F&& f) {
+    std::vector<float> block;
+    for (uint64_t b = bits(lo); b <= bits(hi); b += stride) {
+        block.push_back(from_bits(uint32_t(b)));
+        if (symmetric) {
+            block.push_back(-from_bits(uint32_t(b)));
+        }
+        if (block.size() >= 4096) {
+            f(block);
+            block.clear();
+        }
+    }
+    f(block);
+}
+
+static bool report(const char* name, const Bound& bound, const Error& scalar, const Error& batch) {
+    bool passed = scalar.failures == 0 && batch.failures == 0;
+    std::cout << name << " (" << scalar.samples << " samples): scalar " << scalar.ulp << " ulp (x = " << scalar.worst
+              << "), batch " << batch.ulp << " ulp, bound " << bound.ulp << " ulp";
+    if (bound.near > 0.0) {
+        std::cout << ", below " << bound.near << ": scalar " << scalar.absolute << " batch " << batch.absolute
+                  << " absolute, bound " << bound.absolute;
+    }
+    std::cout << (passed ? "" : "  FAILED") << std::endl;
+    return passed;
+}
+
+template<typename F>
+static double time_ns(const std::vector<float>& x, std::vector<float>& out, F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t r = 0; r < 20; ++r) {
+        f(x.data(), out.data(), x.size());
+    }
+    std::chrono::duration<double, std::nano> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count() / (20.0 * x.size());
+}
+
+int main(int argc, char* argv[]) {
+    const bool exhaustive = argc > 1 && std::strcmp(argv[1], "exhaustive") == 0;
+    const uint32_t stride = exhaustive ? 1 : 257;
+    const float min_normal = std::numeric_limits<float>::min();
+    const float max_normal = std::numeric_limits<float>::max();
+    bool ok = true;
+
+    // The bounds of Fast.hpp
+    const Bound sincos_bound = {2.0, 1e-4, 1e-7};
+    const Bound rsqrt_bound = {3.0, 0.0, 0.0};
+    const Bound exp_bound = {2.0, 0.0, 0.0};
+    const Bound log_bound = {2.0, 0.0, 0.0};
+    const Bound atan2_bound = {4.0, 0.0, 0.0};
+
+    // --- sin, cos ---
+    {
+        Error sin_scalar, sin_batch, cos_scalar, cos_batch;
+        walk(0.0f, 8192.0f, true, stride, [&](const std::vector<float>& x) {
+            std::vector<float> s(x.size()), c(x.size());
+            mat::fast::sincos(x.data(), s.data(), c.data(), x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                double sin_ref = std::sin(double(x[i])), cos_ref = std::cos(double(x[i]));
+                measure(sin_scalar, sincos_bound, x[i], mat::fast::sin(x[i]), sin_ref);
+                measure(cos_scalar, sincos_bound, x[i], mat::fast::cos(x[i]), cos_ref);
+                measure(sin_batch, sincos_bound, x[i], s[i], sin_ref);
+                measure(cos_batch, sincos_bound, x[i], c[i], cos_ref);
+            }
+        });
+        ok &= report("sin", sincos_bound, sin_scalar, sin_batch);
+        ok &= report("cos", sincos_bound, cos_scalar, cos_batch);
+    }
+
+    // --- rsqrt, log on the positive normals, exp on its domain ---
+    auto unary = [&](const char* name, const Bound& bound, float lo, float hi, bool symmetric, auto&& scalar, auto&& batch, auto&& reference) {
+        Error scalar_error, batch_error;
+        walk(lo, hi, symmetric, stride, [&](const std::vector<float>& x) {
+            std::vector<float> out(x.size());
+            batch(x.data(), out.data(), x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                double ref = reference(double(x[i]));
+                measure(scalar_error, bound, x[i], scalar(x[i]), ref);
+                measure(batch_error, bound, x[i], out[i], ref);
+            }
+        });
+        ok &= report(name, bound, scalar_error, batch_error);
+    };
+
+    unary("rsqrt", rsqrt_bound, min_normal, max_normal, false,
+          [](float x) { return mat::fast::rsqrt(x); },
+          [](const float* x, float* out, size_t n) { mat::fast::rsqrt(x, out, n); },
+          [](double x) { return 1.0 / std::sqrt(x); });
+    unary("exp", exp_bound, 0.0f, 86.5f, true,
+          [](float x) { return mat::fast::exp(x); },
+          [](const float* x, float* out, size_t n) { mat::fast::exp(x, out, n); },
+          [](double x) { return std::exp(x); });
+    unary("exp (x > 86.5)", exp_bound, 86.5f, 88.7f, false,
+          [](float x) { return mat::fast::exp(x); },
+          [](const float* x, float* out, size_t n) { mat::fast::exp(x, out, n); },
+          [](double x) { return std::exp(x); });
+    unary("log", log_bound, min_normal, max_normal, false,
+          [](float x) { return mat::fast::log(x); },
+          [](const float* x, float* out, size_t n) { mat::fast::log(x, out, n); },
+          [](double x) { return std::log(x); });
+
+    // --- atan2: random points of all magnitudes and the axes ---
+    {
+        Error scalar, batch;
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> mantissa(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> exponent(-40, 40);
+        const uint32_t blocks = exhaustive ? 4096 : 512;
+        std::vector<float> y(4096), x(4096), out(4096);
+        for (uint32_t b = 0; b < blocks; ++b) {
+            for (size_t i = 0; i < x.size(); ++i) {
+                y[i] = std::ldexp(mantissa(rng), exponent(rng));
+                x[i] = std::ldexp(mantissa(rng), exponent(rng));
+            }
+            if (b == 0) {
+                y[0] = 0.0f; x[0] = -1.0f;
+                y[1] = -0.0f; x[1] = -1.0f;
+                y[2] = 1.0f; x[2] = 0.0f;
+                y[3] = -1.0f; x[3] = -0.0f;
+                y[4] = 1.0f; x[4] = 1.0f;
+            }
+            mat::fast::atan2(y.data(), x.data(), out.data(), x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                double ref = std::atan2(double(y[i]), double(x[i]));
+                measure(scalar, atan2_bound, y[i], mat::fast::atan2(y[i], x[i]), ref);
+                measure(batch, atan2_bound, y[i], out[i], ref);
+            }
+        }
+        ok &= report("atan2", atan2_bound, scalar, batch);
+    }
+
+    // --- time per element ---
+    {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> value(0.001f, 6.0f);
+        std::vector<float> x(1 << 16), x2(1 << 16), out(1 << 16), out2(1 << 16);
+        for (size_t i = 0; i < x.size(); ++i) {
+            x[i] = value(rng);
+            x2[i] = value(rng) - 3.0f;
+        }
+        auto line = [&](const char* name, double std_ns, double scalar_ns, double batch_ns) {
+            std::cout << name << ": " << std_ns << " ns std, " << scalar_ns << " ns scalar, " << batch_ns << " ns batch" << std::endl;
+        };
+        line("sincos",
+             time_ns(x, out, [&](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = std::sin(a[i]); out2[i] = std::cos(a[i]); } }),
+             time_ns(x, out, [&](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { mat::fast::sincos(a[i], o[i], out2[i]); } }),
+             time_ns(x, out, [&](const float* a, float* o, size_t n) { mat::fast::sincos(a, o, out2.data(), n); }));
+        line("rsqrt",
+             time_ns(x, out, [](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = 1.0f / std::sqrt(a[i]); } }),
+             time_ns(x, out, [](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = mat::fast::rsqrt(a[i]); } }),
+             time_ns(x, out, [](const float* a, float* o, size_t n) { mat::fast::rsqrt(a, o, n); }));
+        line("exp",
+             time_ns(x, out, [](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = std::exp(a[i]); } }),
+             time_ns(x, out, [](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = mat::fast::exp(a[i]); } }),
+             time_ns(x, out, [](const float* a, float* o, size_t n) { mat::fast::exp(a, o, n); }));
+        line("log",
+             time_ns(x, out, [](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = std::log(a[i]); } }),
+             time_ns(x, out, [](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = mat::fast::log(a[i]); } }),
+             time_ns(x, out, [](const float* a, float* o, size_t n) { mat::fast::log(a, o, n); }));
+        line("atan2",
+             time_ns(x, out, [&](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = std::atan2(x2[i], a[i]); } }),
+             time_ns(x, out, [&](const float* a, float* o, size_t n) { for (size_t i = 0; i < n; ++i) { o[i] = mat::fast::atan2(x2[i], a[i]); } }),
+             time_ns(x, out, [&](const float* a, float* o, size_t n) { mat::fast::atan2(x2.data(), a, o, n); }));
+    }
+
+    std::cout << (ok ? "The approximations are within their bounds." : "Some approximations exceed their bounds.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,68 @@
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Text/FontBitmap.hpp"
+#include "Thread/ThreadPool.hpp"
+
+#include "Check.hpp"
+
+// The atlases rasterized by ranges of characters on the thread pool (rasterize_fonts) are the ones
+// rasterized by one thread (rasterize_font_memory): same size, same pixels, same glyphs. No window needed.
+
+static bool same_character(const AMB::Character& a, const AMB::Character& b) {
+    return a.u == b.u && a.v == b.v && a.w == b.w && a.h == b.h && a.width == b.width && a.height == b.height
+        && a.bearing_x == b.bearing_x && a.bearing_y == b.bearing_y && a.advance == b.advance;
+}
+
+static bool same_char_map(const std::map<char, AMB::Character>& a, const std::map<char, AMB::Character>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (auto it_a = a.begin(), it_b = b.begin(); it_a != a.end(); ++it_a, ++it_b) {
+        if (it_a->first != it_b->first || !same_character(it_a->second, it_b->second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+
+    bool ok = true;
+
+    std::ifstream file("test/res/OpenSans.ttf", std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.empty()) {
+        std::cerr << "Failed to read test/res/OpenSans.ttf." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const uint32_t sizes[] = {12, 16, 20, 24, 32, 48, 64, 96};
+    std::vector<AMB::FontSource> sources;
+    for (uint32_t size : sizes) {
+        sources.push_back(AMB::FontSource{data.data(), data.size(), size});
+    }
+
+    AMB::ThreadPool pool;
+    std::vector<AMB::FontBitmap> bitmaps;
+    ok &= check(AMB::rasterize_fonts(sources, pool, bitmaps) && bitmaps.size() == sources.size(), "fonts rasterized on the thread pool");
+
+    for (size_t i = 0; i < sources.size() && i < bitmaps.size(); ++i) {
+        AMB::FontBitmap serial;
+        AMB::rasterize_font_memory(data.data(), data.size(), sizes[i], serial);
+        const AMB::FontBitmap& parallel = bitmaps[i];
+
+        std::string name = "size " + std::to_string(sizes[i]) + ": ";
+        ok &= check(serial.valid() && parallel.valid(), name + "atlases not empty");
+        ok &= check(serial.width == parallel.width && serial.height == parallel.height, name + "same dimensions");
+        ok &= check(serial.line_height == parallel.line_height, name + "same line height");
+        ok &= check(serial.pixels == parallel.pixels, name + "same pixels");
+        ok &= check(same_char_map(serial.char_map, parallel.char_map), name + "same glyphs");
+    }
+
+    std::cout << (ok ? "All checks passed" : "Some checks failed") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
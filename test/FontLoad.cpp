@@ -0,0 +1,57 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "Window/Window.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Text/FontSystem.hpp"
+#include "Thread/ThreadPool.hpp"
+
+// Load a set of fonts at startup, serially through the FontSystem library then with the glyphs
+// rasterized by the workers of a thread pool. Both atlases are uploaded once per font.
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(800, 600, "Font load", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+    AMB::ThreadPool pool;
+
+    std::vector<std::pair<std::string, uint32_t>> fonts;
+    for (uint32_t size : {12, 16, 20, 24, 32, 48, 64, 96}) {
+        fonts.emplace_back("test/res/OpenSans.ttf", size);
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    using milliseconds = std::chrono::duration<double, std::milli>;
+
+    // --- serial ---
+    auto start = Clock::now();
+    for (const auto& [path, size] : fonts) {
+        asset_factory.create_font(path, size);
+    }
+    glFinish();
+    milliseconds serial_time = Clock::now() - start;
+
+    // --- thread pool ---
+    start = Clock::now();
+    std::vector<AMB::AssetHandle> handles = asset_factory.create_fonts(fonts, pool);
+    glFinish();
+    milliseconds parallel_time = Clock::now() - start;
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        if (!asset_manager.fonts.validity(handles[i])) {
+            std::cerr << "Failed to load the font of size " << fonts[i].second << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "Fonts: " << fonts.size() << ", workers: " << pool.get_thread_count() << std::endl;
+    std::cout << "Serial: " << serial_time.count() << " ms" << std::endl;
+    std::cout << "Thread pool: " << parallel_time.count() << " ms (x" << serial_time.count() / parallel_time.count() << ")" << std::endl;
+
+    return 0;
+}
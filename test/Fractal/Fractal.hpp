@@ -0,0 +1,491 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <stack>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.hpp"
+#include "Kernel.hpp"
+#include "Perturbation.hpp"
+#include "Scheduler.hpp"
+#include "TileCache.hpp"
+
+// The view is kept in BigFixed, the series computed in double while its precision is enough, by
+// perturbation of a reference orbit beyond
+//
+// The pixels lie on a quadtree: at the level L they are 2^-L wide, at multiples of 2^-L, and grouped
+// in tiles at multiples of TILE_SIZE pixels. A pixel is computed from the corner of its tile and its
+// place in it, so its value does not depend on the view around it. A tile done once is kept in the
+// TileCache and shown again at once on an undo, a zoom back or a revisit. A pan shifts the image and
+// computes only the tiles it exposes. The zooms are rounded to the levels.
+
+typedef mat::BigFixed T;
+typedef BigComplex complex;
+
+/// @brief Size of a tile, as a power of 2
+constexpr int32_t TILE_SIZE_LOG2 = 5;
+static_assert(1u << TILE_SIZE_LOG2 == TILE_SIZE);
+
+enum class FractalMode {
+    MANDELBROT,
+    JULIA
+};
+
+/// @brief How the pixels of a tile are computed
+enum class FillStrategy {
+    PASSES,         // Every pixel, from coarse to fine blocks
+    SUBDIVISION     // The borders of rectangles, their inside filled when uniform
+};
+
+inline std::string to_string(complex c, uint32_t digits = 20) {
+    return "(" + mat::to_string(c.real(), digits) + ", " + mat::to_string(c.imag(), digits) + "i)";
+}
+
+/// @brief If the pixels are too close for double: below about 1e-11 of the coordinates, the
+/// rounding errors of the series mix the neighbour pixels
+inline bool needs_perturbation(complex upper_left, complex lower_right, uint32_t width) {
+    double pixel = double(lower_right.real() - upper_left.real()) / width;
+    double scale = std::max({std::abs(double(upper_left.real())), std::abs(double(upper_left.imag())),
+                             std::abs(double(lower_right.real())), std::abs(double(lower_right.imag())), 1.0});
+    return pixel < 1e-11 * scale;
+}
+
+/*
+====================================
+===== Tile rendering functions =====
+====================================
+*/
+
+/// @brief The view of a render in double, copied when it starts
+struct RenderView {
+    FractalMode mode;
+    FillStrategy fill;
+    bool deep;                  // By perturbation of the reference orbit
+    double pixel;               // The size of a pixel
+    double cr, ci;              // The constant of the Julia set
+    uint32_t max_iter;
+};
+
+/// @brief A tile of the render in progress
+struct RenderTile {
+    TileKey key;
+    double left, top;           // The corner in double, or its offset to the reference when deep
+    int32_t x, y;               // The corner in the image, negative on the borders
+    TileCache::Pixels pixels;
+};
+
+/// @brief Render the pass at a step of a tile, stop when the render is cancelled
+/// @note By subdivision the tile is done in the pass at the step 1
+/// @param rebases Incremented for each pixel rebased on the start of the reference
+/// @return False if the render was cancelled before the end of the pass
+inline bool compute_tile(const RenderView& view, const ReferenceOrbit& orbit, const TileScheduler& scheduler,
+    RenderTile& tile, uint32_t step, uint64_t& rebases)
+{
+    const Tile whole = {0, 0, TILE_SIZE, TILE_SIZE};
+    if (view.fill == FillStrategy::SUBDIVISION) {
+        return render_subdivided(whole, TILE_SIZE, tile.pixels.data(), [&](uint32_t count, const uint32_t* columns, const uint32_t* rows, uint32_t* out) {
+            if (scheduler.is_cancelled()) {
+                return false;
+            }
+
+            if (view.deep) {
+                for (uint32_t k = 0; k < count; ++k) {
+                    mat::Comd delta(tile.left + columns[k] * view.pixel, tile.top - rows[k] * view.pixel);
+                    out[k] = orbit.iterate(delta, view.max_iter, rebases);
+                }
+            } else {
+                escape_pixels(view.mode == FractalMode::JULIA, tile.left, tile.top, view.pixel, view.cr, view.ci,
+                              columns, rows, count, view.max_iter, out);
+            }
+            return true;
+        });
+    }
+    return render_pass(whole, step, TILE_SIZE, tile.pixels.data(), [&](uint32_t j, uint32_t first, uint32_t stride, uint32_t count, uint32_t* out) {
+        if (scheduler.is_cancelled()) {
+            return false;
+        }
+
+        double y = tile.top - j * view.pixel;
+        if (view.deep) {
+            for (uint32_t k = 0; k < count; ++k) {
+                mat::Comd delta(tile.left + (first + k * stride) * view.pixel, y);
+                out[k] = orbit.iterate(delta, view.max_iter, rebases);
+            }
+        } else if (view.mode == FractalMode::JULIA) {
+            julia_row(tile.left, view.pixel, y, view.cr, view.ci, first, stride, count, view.max_iter, out);
+        } else {
+            mandelbrot_row(tile.left, view.pixel, y, first, stride, count, view.max_iter, out);
+        }
+        return true;
+    });
+}
+
+/// @brief Copy the pixels of a tile in the image, clipped to it
+inline void blit_tile(const RenderTile& tile, uint32_t width, uint32_t height, uint32_t* image) {
+    int32_t x0 = std::max(tile.x, 0), x1 = std::min(tile.x + int32_t(TILE_SIZE), int32_t(width));
+    int32_t y0 = std::max(tile.y, 0), y1 = std::min(tile.y + int32_t(TILE_SIZE), int32_t(height));
+    for (int32_t y = y0; y < y1; ++y) {
+        const uint32_t* row = tile.pixels.data() + (y - tile.y) * TILE_SIZE;
+        std::copy(row + (x0 - tile.x), row + (x1 - tile.x), image + y * width + x0);
+    }
+}
+
+/// @brief Number of render workers, two hardware threads are left to the window and the system
+inline uint32_t render_thread_count() {
+    uint32_t num_threads = std::thread::hardware_concurrency();
+    return num_threads <= 2 ? 1 : num_threads - 2;
+}
+
+/*
+=========================
+===== Fractal class =====
+=========================
+*/
+
+class Fractal {
+public:
+    Fractal(complex up_left, complex low_right, uint32_t width, uint32_t height, uint32_t max_iter,
+        uint32_t thread_count = render_thread_count())
+    : m_level(0), m_width(width), m_height(height), m_max_iter(max_iter), m_convergence(m_width*m_height, 0),
+        m_mode(FractalMode::MANDELBROT), m_fill(FillStrategy::PASSES), m_julia_c(0.0, 0.0), m_rebases(0), m_columns(0), m_tiles_cached(0), m_tiles_computed(0),
+        m_image(m_width*m_height, 0), m_image_ready(false), m_scheduler(thread_count)
+    {
+        AMB::Logger::instance().log(AMB::Info, "Number of CPU threads :" + std::to_string(std::thread::hardware_concurrency()));
+
+        place(up_left, low_right);
+        recompute();
+    }
+
+    /// @brief Take the image of the last pass done, if a pass was done since the last call
+    /// @param image Receive the iteration counts
+    /// @return True if the image is new
+    bool fetch_image(std::vector<uint32_t>& image) {
+        std::lock_guard<std::mutex> lock(m_image_mutex);
+        if (!m_image_ready) {
+            return false;
+        }
+        image.swap(m_image);
+        m_image_ready = false;
+        return true;
+    }
+
+    bool is_rendering() const {
+        return !m_scheduler.is_done();
+    }
+
+    /// @brief Wait until the render in progress is done or cancelled
+    void wait() {
+        m_scheduler.wait();
+    }
+
+    bool is_deep_zoom() const {
+        return needs_perturbation(m_up_left, m_low_right, m_width);
+    }
+
+    /// @brief The level of the view in the quadtree, the pixels are 2^-level wide
+    int32_t get_level() const {
+        return m_level;
+    }
+
+    double get_pixel_size() const {
+        return std::ldexp(1.0, -m_level);
+    }
+
+    /// @brief Number of significant digits to tell the pixels apart
+    uint32_t get_digits() const {
+        return std::max(20u, uint32_t(std::log10(4.0 / get_pixel_size())) + 2);
+    }
+
+    std::string get_precision() const {
+        if (!is_deep_zoom()) {
+            return "double";
+        }
+        return "perturbation, reference of " + std::to_string(32 * m_up_left.real().limbs()) + " bits, "
+             + std::to_string(m_statistics.skipped) + " of " + std::to_string(m_statistics.reference_length)
+             + " iterations skipped, " + std::to_string(m_rebases.load()) + " rebases";
+    }
+
+    std::string get_render_state() const {
+        return std::string(m_fill == FillStrategy::SUBDIVISION ? "subdivision" : "passes") + ", "
+             + (is_rendering() ? "in progress" : "done") + ", " + std::to_string(m_tiles_computed) + " tiles computed, "
+             + std::to_string(m_tiles_cached) + " from the cache of " + std::to_string(m_cache.get_entry_count()) + " tiles ("
+             + std::to_string(m_cache.get_bytes() >> 20) + " MB)";
+    }
+
+    /// @brief Number of tiles of the last render taken from the cache
+    uint32_t get_tiles_cached() const {
+        return m_tiles_cached;
+    }
+
+    /// @brief Number of tiles of the last render given to the workers
+    uint32_t get_tiles_computed() const {
+        return m_tiles_computed;
+    }
+
+    TileCache& get_cache() {
+        return m_cache;
+    }
+
+    /// @brief Start the render of the view in the background, after the cancellation of the one in progress
+    void recompute() {
+        m_scheduler.cancel();
+        render({0, 0, 0, 0});
+    }
+
+    void set_mode(FractalMode mode) {
+        if (mode != m_mode) {
+            m_mode = mode;
+            recompute();
+            clean_undo();
+        }
+    }
+
+    FractalMode get_mode() {
+        return m_mode;
+    }
+
+    void set_fill(FillStrategy fill) {
+        if (fill != m_fill) {
+            m_fill = fill;
+            recompute();
+        }
+    }
+
+    FillStrategy get_fill() const {
+        return m_fill;
+    }
+
+    complex complex_at_pixel(mat::Vec2i position) const {
+        // Pixel size in complex plane
+        double dx = double(m_low_right.real() - m_up_left.real()) / m_width;
+        double dy = double(m_up_left.imag() - m_low_right.imag()) / m_height;
+
+        // Map pixel (x, y) to complex number
+        T real_part = m_up_left.real() + position[0] * dx;
+        T imag_part = m_low_right.imag() + position[1] * dy; // <-- bottom-left origin
+
+        return complex(real_part, imag_part);
+    }
+
+    /// @brief Zoom on a rectangle, its center kept and its width rounded to a level of the quadtree
+    void set_new_position(complex up_left, complex low_right) {
+        std::pair<complex, complex> previous(m_up_left, m_low_right);
+        if (place(up_left, low_right)) {
+            m_undo_storage.push(previous);
+            recompute();
+        }
+    }
+
+    /// @brief Move the view with the image, the pixel (i, j) goes to (i + dx, j + dy)
+    /// @note Only the tiles exposed are computed, if the image was complete
+    void pan(int32_t dx, int32_t dy) {
+        if (dx == 0 && dy == 0) {
+            return;
+        }
+        bool complete = m_scheduler.is_done();
+        m_scheduler.cancel();
+
+        // The rows in the order which reads each one before it is overwritten
+        const int32_t width = m_width, height = m_height;
+        const int32_t x0 = std::max(0, dx), x1 = std::min(width, width + dx);
+        const int32_t y0 = std::max(0, dy), y1 = std::min(height, height + dy);
+        Tile kept = {0, 0, 0, 0};
+        if (x0 < x1 && y0 < y1) {
+            for (int32_t n = 0; n < y1 - y0; ++n) {
+                int32_t j = dy > 0 ? y1 - 1 - n : y0 + n;
+                std::memmove(&m_convergence[j * width + x0], &m_convergence[(j - dy) * width + x0 - dx], (x1 - x0) * sizeof(uint32_t));
+            }
+            if (complete) {
+                kept = {uint32_t(x0), uint32_t(y0), uint32_t(x1 - x0), uint32_t(y1 - y0)};
+            }
+        }
+
+        const double size = get_pixel_size();
+        m_up_left = complex(m_up_left.real() - dx * size, m_up_left.imag() + dy * size);
+        m_low_right = complex(m_low_right.real() - dx * size, m_low_right.imag() + dy * size);
+        render(kept);
+    }
+
+    void undo() {
+        if (!m_undo_storage.empty()) {
+            m_up_left = m_undo_storage.top().first;
+            m_low_right = m_undo_storage.top().second;
+            m_level = int32_t(std::lround(-std::log2(double(m_low_right.real() - m_up_left.real()) / m_width)));
+            m_undo_storage.pop();
+
+            recompute();
+        }
+    }
+
+    void clean_undo() {
+        while (!m_undo_storage.empty()) {
+            m_undo_storage.pop();
+        }
+    }
+
+    void set_max_iteration(uint32_t max_iter) {
+        m_max_iter = max_iter;
+        recompute();
+    }
+
+    uint32_t get_max_iteration() {
+        return m_max_iter;
+    }
+
+    void set_julia_c(complex julia_c) {
+        m_julia_c = julia_c;
+        if (m_mode == FractalMode::JULIA) {
+            recompute();
+        }
+    }
+
+    complex get_julia_c() const {
+        return m_julia_c;
+    }
+
+private:
+    /// @brief Set the view on the quadtree: the pixel size rounded to a power of 2, the corner to a pixel
+    /// @return False if the pixels would be too small
+    bool place(const complex& up_left, const complex& low_right) {
+        // The offsets of the pixels to the reference are doubles, with their exponent range
+        double pixel = double(low_right.real() - up_left.real()) / m_width;
+        if (!(std::fabs(pixel) >= 1e-290)) {
+            AMB::Logger::instance().log(AMB::Warning, "Zoom limit reached, pixel size " + std::to_string(pixel));
+            return false;
+        }
+
+        // Corners at the precision of the new pixels, around the same center
+        int32_t level = int32_t(std::lround(-std::log2(std::fabs(pixel))));
+        double size = std::ldexp(1.0, -level);
+        uint32_t limbs = T::limbs_for(size);
+        T center_r = up_left.real().with_limbs(limbs) + 0.5 * double(low_right.real() - up_left.real());
+        T center_i = up_left.imag().with_limbs(limbs) + 0.5 * double(low_right.imag() - up_left.imag());
+        T left = (center_r - 0.5 * m_width * size).floor_to(-level);
+        T top = -(-(center_i + 0.5 * m_height * size)).floor_to(-level);   // Rounded up
+
+        m_level = level;
+        m_up_left = complex(left, top);
+        m_low_right = complex(left + m_width * size, top - m_height * size);
+        return true;
+    }
+
+    /// @brief Start the render of the tiles not cached, the render in progress cancelled
+    /// @param kept The part of the image still valid after a pan, its tiles are not computed again
+    void render(const Tile& kept) {
+        const double size = get_pixel_size();
+        const T corner_r = m_up_left.real().floor_to(TILE_SIZE_LOG2 - m_level);
+        const T corner_i = -(-m_up_left.imag()).floor_to(TILE_SIZE_LOG2 - m_level);
+        const int32_t phase_x = int32_t(std::lround(double(m_up_left.real() - corner_r) / size));
+        const int32_t phase_y = int32_t(std::lround(double(corner_i - m_up_left.imag()) / size));
+        m_columns = (phase_x + m_width + TILE_SIZE - 1) / TILE_SIZE;
+        const uint32_t rows = (phase_y + m_height + TILE_SIZE - 1) / TILE_SIZE;
+
+        m_view = {m_mode, m_fill, is_deep_zoom(), size, double(m_julia_c.real()), double(m_julia_c.imag()), m_max_iter};
+        m_statistics = PerturbationStatistics();
+        m_rebases = 0;
+
+        // The reference at the center, at the precision of the pixels
+        complex center(m_up_left.real() + 0.5 * m_width * size, m_up_left.imag() - 0.5 * m_height * size);
+        if (m_view.deep) {
+            bool julia = m_mode == FractalMode::JULIA;
+            uint32_t limbs = m_up_left.real().limbs();
+            complex zero(T(0.0, limbs), T(0.0, limbs));
+
+            m_orbit.compute(julia ? center : zero, julia ? m_julia_c : center, julia, m_max_iter);
+            m_orbit.compute_series(0.5 * std::hypot(m_width * size, m_height * size), m_max_iter);
+            m_statistics.reference_length = m_orbit.size() - 1;
+            m_statistics.skipped = m_orbit.skip();
+        }
+
+        // The tiles of the cache at once, the others to the workers
+        const complex constant = m_mode == FractalMode::JULIA ? m_julia_c : complex(T(0.0), T(0.0));
+        std::vector<Tile> missing;
+        m_tiles.assign(m_columns * rows, RenderTile());
+        for (uint32_t b = 0; b < rows; ++b) {
+            for (uint32_t a = 0; a < m_columns; ++a) {
+                RenderTile& tile = m_tiles[b * m_columns + a];
+                tile.key = {m_level, complex(corner_r + double(a * TILE_SIZE) * size, corner_i - double(b * TILE_SIZE) * size),
+                            m_max_iter, uint32_t(m_mode), uint32_t(m_fill), constant};
+                tile.x = int32_t(a * TILE_SIZE) - phase_x;
+                tile.y = int32_t(b * TILE_SIZE) - phase_y;
+                if (m_cache.find(tile.key, tile.pixels)) {
+                    blit_tile(tile, m_width, m_height, m_convergence.data());
+                    continue;
+                }
+
+                int32_t x0 = std::max(tile.x, 0), x1 = std::min(tile.x + int32_t(TILE_SIZE), int32_t(m_width));
+                int32_t y0 = std::max(tile.y, 0), y1 = std::min(tile.y + int32_t(TILE_SIZE), int32_t(m_height));
+                if (x0 >= int32_t(kept.x) && x1 <= int32_t(kept.x + kept.width) && y0 >= int32_t(kept.y) && y1 <= int32_t(kept.y + kept.height)) {
+                    continue;
+                }
+
+                const complex& corner = tile.key.corner;
+                tile.left = m_view.deep ? double(corner.real() - center.real()) : double(corner.real());
+                tile.top = m_view.deep ? double(corner.imag() - center.imag()) : double(corner.imag());
+                tile.pixels.assign(TILE_SIZE * TILE_SIZE, 0);
+                missing.push_back({a * TILE_SIZE, b * TILE_SIZE, TILE_SIZE, TILE_SIZE});
+            }
+        }
+        m_tiles_computed = uint32_t(missing.size());
+        m_tiles_cached = uint32_t(m_tiles.size()) - m_tiles_computed;
+        publish();
+
+        m_scheduler.start(std::move(missing),
+            [this](const Tile& cell, uint32_t step) {
+                RenderTile& tile = m_tiles[(cell.y / TILE_SIZE) * m_columns + cell.x / TILE_SIZE];
+                uint64_t rebases = 0;
+                bool complete = compute_tile(m_view, m_orbit, m_scheduler, tile, step, rebases);
+                m_rebases += rebases;
+                blit_tile(tile, m_width, m_height, m_convergence.data());
+                if (complete && step == 1) {
+                    m_cache.insert(tile.key, tile.pixels);
+                }
+            },
+            [this](uint32_t) {
+                // No tile in flight between two passes
+                publish();
+            },
+            m_fill == FillStrategy::SUBDIVISION ? 1 : COARSEST_STEP);
+    }
+
+    /// @brief Give the image to the window
+    void publish() {
+        std::lock_guard<std::mutex> lock(m_image_mutex);
+        m_image = m_convergence;
+        m_image_ready = true;
+    }
+
+    complex m_up_left, m_low_right;
+    int32_t m_level;
+    uint32_t m_width, m_height;
+    uint32_t m_max_iter;
+    std::vector<uint32_t> m_convergence;
+    std::stack<std::pair<complex, complex>> m_undo_storage;
+    FractalMode m_mode;
+    FillStrategy m_fill;
+    complex m_julia_c;
+
+    // The render in progress, written by the workers
+    RenderView m_view;
+    ReferenceOrbit m_orbit;
+    PerturbationStatistics m_statistics;
+    std::atomic<uint64_t> m_rebases;
+    std::vector<RenderTile> m_tiles;    // The tiles covering the view, by rows
+    uint32_t m_columns;
+    uint32_t m_tiles_cached;
+    uint32_t m_tiles_computed;
+    TileCache m_cache;
+
+    // The image of the last pass done, for the window
+    std::vector<uint32_t> m_image;
+    std::mutex m_image_mutex;
+    bool m_image_ready;
+
+    TileScheduler m_scheduler;  // Last: the render is cancelled before the rest is destroyed
+};
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <inttypes.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Escape-time kernels of the Mandelbrot and Julia sets, in double
+//
+// A row of pixels is iterated by lanes of the widest vectors of the target: 8 pixels with AVX-512,
+// 4 with AVX2, 4 in plain arrays otherwise. A lane whose pixel escapes or ends is refilled with the
+// next pixel of the row, so no lane waits for the slowest one. Two tests skip the interior, where
+// every pixel would run to max_iter:
+//  - Mandelbrot: the main cardioid and the period-2 bulb, in closed form, before any iteration.
+//  - Both: Brent's periodicity check. The orbit is saved at iterations 8, 16, 32... and compared at
+//    every iteration with the saved point: an orbit which comes back to it is attracted by a cycle
+//    and never escapes.
+//
+// escape_row iterates pixels along a row, escape_pixels anywhere in a grid, for the subdivision.
+// escape_time is the scalar series without these tests, escape_time_checked the scalar series with
+// them. The three give the same counts: the arithmetic is written with explicit fused multiply-adds
+// so that the compiler cannot contract it differently in the scalar and the vector code.
+
+/// @brief Squared distance below which an orbit is back at its saved point
+constexpr double PERIOD_TOLERANCE = 1e-28;
+
+/// @brief First iteration where the orbit is saved, then every power of 2
+constexpr uint32_t PERIOD_FIRST_CHECK = 8;
+
+/// @brief a * b + c, rounded once when the target has FMA
+inline double fused(double a, double b, double c) {
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+    return std::fma(a, b, c);
+#else
+    return a * b + c;
+#endif
+}
+
+/// @brief Know if a point is in the main cardioid or in the period-2 bulb of the Mandelbrot set
+/// @param x The real part
+/// @param y The imaginary part
+/// @return True if the point is in one of them
+inline bool in_main_components(double x, double y) {
+    double y2 = y * y;
+    double xq = x - 0.25;
+    double q = xq * xq + y2;
+    if (q * (q + xq) <= 0.25 * y2) {
+        return true;
+    }
+    double xb = x + 1.0;
+    return xb * xb + y2 <= 0.0625;
+}
+
+/// @brief Iterate z^2 + c, without interior detection
+/// @return The number of iterations before |z| > 2, or max_iter
+inline uint32_t escape_time(double zr, double zi, double cr, double ci, uint32_t max_iter) {
+    uint32_t iter = 0;
+    while (iter < max_iter) {
+        double zi2 = zi * zi;
+        if (fused(zr, zr, zi2) > 4.0) {
+            break;
+        }
+        double next_zi = fused(zr + zr, zi, ci);
+        zr = fused(zr, zr, cr - zi2);
+        zi = next_zi;
+        ++iter;
+    }
+    return iter;
+}
+
+/// @brief Iterate z^2 + c, stop when the orbit is periodic
+/// @return The number of iterations before |z| > 2, or max_iter
+inline uint32_t escape_time_checked(double zr, double zi, double cr, double ci, uint32_t max_iter) {
+    uint32_t iter = 0;
+    uint32_t check = PERIOD_FIRST_CHECK;
+    double saved_r = zr, saved_i = zi;
+    while (iter < max_iter) {
+        double zi2 = zi * zi;
+        if (fused(zr, zr, zi2) > 4.0) {
+            break;
+        }
+        double next_zi = fused(zr + zr, zi, ci);
+        zr = fused(zr, zr, cr - zi2);
+        zi = next_zi;
+        ++iter;
+
+        double dr = zr - saved_r, di = zi - saved_i;
+        if (fused(dr, dr, di * di) < PERIOD_TOLERANCE) {
+            return max_iter;
+        }
+        if (iter == check) {
+            saved_r = zr;
+            saved_i = zi;
+            check *= 2;
+        }
+    }
+    return iter;
+}
+
+//    _
+//   | |   __ _ _ _  ___ ___
+//   | |__/ _` | ' \/ -_|_-<
+//   |____\__,_|_||_\___/__/
+//
+
+#if defined(__AVX512F__)
+
+struct Lanes {
+    static constexpr uint32_t N = 8;
+    typedef __m512d Real;
+    typedef __mmask8 Mask;
+
+    static Real load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, Real a) { _mm512_storeu_pd(p, a); }
+    static Real splat(double a) { return _mm512_set1_pd(a); }
+    static Real add(Real a, Real b) { return _mm512_add_pd(a, b); }
+    static Real sub(Real a, Real b) { return _mm512_sub_pd(a, b); }
+    static Real mul(Real a, Real b) { return _mm512_mul_pd(a, b); }
+    static Real fused(Real a, Real b, Real c) { return _mm512_fmadd_pd(a, b, c); }
+    static Mask greater(Real a, Real b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static Mask less(Real a, Real b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static Mask equal(Real a, Real b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static Mask either(Mask a, Mask b) { return Mask(a | b); }
+    /// @brief a where the mask is set, b elsewhere
+    static Real select(Mask m, Real a, Real b) { return _mm512_mask_blend_pd(m, b, a); }
+    static uint32_t bits(Mask m) { return m; }
+};
+
+#elif defined(__AVX2__)
+
+struct Lanes {
+    static constexpr uint32_t N = 4;
+    typedef __m256d Real;
+    typedef __m256d Mask;
+
+    static Real load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Real a) { _mm256_storeu_pd(p, a); }
+    static Real splat(double a) { return _mm256_set1_pd(a); }
+    static Real add(Real a, Real b) { return _mm256_add_pd(a, b); }
+    static Real sub(Real a, Real b) { return _mm256_sub_pd(a, b); }
+    static Real mul(Real a, Real b) { return _mm256_mul_pd(a, b); }
+#if defined(__FMA__)
+    static Real fused(Real a, Real b, Real c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+    static Real fused(Real a, Real b, Real c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+    static Mask greater(Real a, Real b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static Mask less(Real a, Real b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Mask equal(Real a, Real b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static Mask either(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+    /// @brief a where the mask is set, b elsewhere
+    static Real select(Mask m, Real a, Real b) { return _mm256_blendv_pd(b, a, m); }
+    static uint32_t bits(Mask m) { return uint32_t(_mm256_movemask_pd(m)); }
+};
+
+#else
+
+// Plain arrays, the compiler vectorizes the loops with the instructions it has
+struct Lanes {
+    static constexpr uint32_t N = 4;
+    typedef std::array<double, N> Real;
+    typedef uint32_t Mask;
+
+    static Real load(const double* p) { Real r; std::copy(p, p + N, r.begin()); return r; }
+    static void store(double* p, const Real& a) { std::copy(a.begin(), a.end(), p); }
+    static Real splat(double a) { Real r; r.fill(a); return r; }
+    static Real add(const Real& a, const Real& b) { Real r; for (uint32_t i = 0; i < N; ++i) { r[i] = a[i] + b[i]; } return r; }
+    static Real sub(const Real& a, const Real& b) { Real r; for (uint32_t i = 0; i < N; ++i) { r[i] = a[i] - b[i]; } return r; }
+    static Real mul(const Real& a, const Real& b) { Real r; for (uint32_t i = 0; i < N; ++i) { r[i] = a[i] * b[i]; } return r; }
+    static Real fused(const Real& a, const Real& b, const Real& c) { Real r; for (uint32_t i = 0; i < N; ++i) { r[i] = ::fused(a[i], b[i], c[i]); } return r; }
+    static Mask greater(const Real& a, const Real& b) { Mask m = 0; for (uint32_t i = 0; i < N; ++i) { m |= uint32_t(a[i] > b[i]) << i; } return m; }
+    static Mask less(const Real& a, const Real& b) { Mask m = 0; for (uint32_t i = 0; i < N; ++i) { m |= uint32_t(a[i] < b[i]) << i; } return m; }
+    static Mask equal(const Real& a, const Real& b) { Mask m = 0; for (uint32_t i = 0; i < N; ++i) { m |= uint32_t(a[i] == b[i]) << i; } return m; }
+    static Mask either(Mask a, Mask b) { return a | b; }
+    /// @brief a where the mask is set, b elsewhere
+    static Real select(Mask m, const Real& a, const Real& b) { Real r; for (uint32_t i = 0; i < N; ++i) { r[i] = (m >> i) & 1 ? a[i] : b[i]; } return r; }
+    static uint32_t bits(Mask m) { return m; }
+};
+
+#endif
+
+/// @brief Iterate pixels by lanes, with the interior detection of escape_time_checked
+/// @param julia If the pixels are the start of the orbits, else their constant
+/// @param cr, ci The constant of the Julia set
+/// @param count The number of pixels to iterate
+/// @param max_iter Maximum number of iterations
+/// @param out The iteration counts, escape_time_checked(...) for each pixel
+/// @param position position(k, x, y) gives the coordinates of the pixel k
+template<typename P>
+inline void escape_lanes(bool julia, double cr, double ci, uint32_t count, uint32_t max_iter, uint32_t* out, P&& position) {
+    constexpr uint32_t N = Lanes::N;
+    alignas(64) double zr[N], zi[N], c_r[N], c_i[N], iter[N], check[N], saved_r[N], saved_i[N];
+    uint32_t pixel[N];
+    uint32_t next = 0;
+    uint32_t active = 0;
+
+    // Give the next pixel to a lane, the ones inside the main components are done at once
+    auto refill = [&](uint32_t lane) {
+        while (next < count) {
+            uint32_t p = next++;
+            double x, y;
+            position(p, x, y);
+            if (!julia && in_main_components(x, y)) {
+                out[p] = max_iter;
+                continue;
+            }
+            pixel[lane] = p;
+            zr[lane] = julia ? x : 0.0;
+            zi[lane] = julia ? y : 0.0;
+            c_r[lane] = julia ? cr : x;
+            c_i[lane] = julia ? ci : y;
+            iter[lane] = 0.0;
+            check[lane] = PERIOD_FIRST_CHECK;
+            saved_r[lane] = zr[lane];
+            saved_i[lane] = zi[lane];
+            active |= 1u << lane;
+            return;
+        }
+        // No more pixel, the lane idles on a point which never escapes
+        active &= ~(1u << lane);
+        zr[lane] = zi[lane] = c_r[lane] = c_i[lane] = 0.0;
+        iter[lane] = check[lane] = saved_r[lane] = saved_i[lane] = 0.0;
+    };
+
+    for (uint32_t lane = 0; lane < N; ++lane) {
+        refill(lane);
+    }
+
+    const Lanes::Real four = Lanes::splat(4.0), one = Lanes::splat(1.0);
+    const Lanes::Real limit = Lanes::splat(double(max_iter)), tolerance = Lanes::splat(PERIOD_TOLERANCE);
+    while (active != 0) {
+        Lanes::Real vzr = Lanes::load(zr), vzi = Lanes::load(zi), vcr = Lanes::load(c_r), vci = Lanes::load(c_i);
+        Lanes::Real viter = Lanes::load(iter), vcheck = Lanes::load(check);
+        Lanes::Real vsr = Lanes::load(saved_r), vsi = Lanes::load(saved_i);
+
+        // Iterate all the lanes until one of them is done
+        uint32_t done = 0;
+        for (;;) {
+            Lanes::Real zi2 = Lanes::mul(vzi, vzi);
+            Lanes::Mask escaped = Lanes::greater(Lanes::fused(vzr, vzr, zi2), four);
+            Lanes::Mask running = Lanes::less(viter, limit);
+            done = (Lanes::bits(escaped) | ~Lanes::bits(running)) & active;
+            if (done != 0) {
+                break;
+            }
+            Lanes::Real next_zi = Lanes::fused(Lanes::add(vzr, vzr), vzi, vci);
+            vzr = Lanes::fused(vzr, vzr, Lanes::sub(vcr, zi2));
+            vzi = next_zi;
+            viter = Lanes::add(viter, one);
+
+            // Periodic: the count becomes max_iter, the lane is done at the next test
+            Lanes::Real dr = Lanes::sub(vzr, vsr), di = Lanes::sub(vzi, vsi);
+            Lanes::Mask periodic = Lanes::less(Lanes::fused(dr, dr, Lanes::mul(di, di)), tolerance);
+            if (Lanes::bits(periodic) != 0) {
+                viter = Lanes::select(periodic, limit, viter);
+            }
+            Lanes::Mask due = Lanes::equal(viter, vcheck);
+            if (Lanes::bits(due) != 0) {
+                vsr = Lanes::select(due, vzr, vsr);
+                vsi = Lanes::select(due, vzi, vsi);
+                vcheck = Lanes::select(due, Lanes::add(vcheck, vcheck), vcheck);
+            }
+        }
+
+        Lanes::store(zr, vzr); Lanes::store(zi, vzi);
+        Lanes::store(iter, viter); Lanes::store(check, vcheck);
+        Lanes::store(saved_r, vsr); Lanes::store(saved_i, vsi);
+        for (uint32_t lane = 0; lane < N; ++lane) {
+            if ((done >> lane) & 1) {
+                out[pixel[lane]] = std::min(uint32_t(iter[lane]), max_iter);
+                refill(lane);
+            }
+        }
+    }
+}
+
+/// @brief Iterate pixels of a row by lanes, see escape_lanes
+/// @param left The real part of the pixel 0 of the row
+/// @param dx The step between two pixels, the pixel i is at left + i * dx
+/// @param y The imaginary part of the row
+/// @param first The first pixel to iterate
+/// @param stride The step between two pixels to iterate
+/// @param out The iteration counts of the pixels first + k * stride
+inline void escape_row(bool julia, double left, double dx, double y, double cr, double ci,
+                       uint32_t first, uint32_t stride, uint32_t count, uint32_t max_iter, uint32_t* out) {
+    escape_lanes(julia, cr, ci, count, max_iter, out, [&](uint32_t k, double& x, double& row_y) {
+        x = left + (first + k * stride) * dx;
+        row_y = y;
+    });
+}
+
+/// @brief Iterate pixels scattered in a grid by lanes, see escape_lanes
+/// @param left, top The coordinates of the pixel (0, 0)
+/// @param dx The step between two pixels, the pixel (i, j) is at left + i * dx, top - j * dx
+/// @param columns, rows The pixels (columns[k], rows[k])
+inline void escape_pixels(bool julia, double left, double top, double dx, double cr, double ci,
+                          const uint32_t* columns, const uint32_t* rows, uint32_t count, uint32_t max_iter, uint32_t* out) {
+    escape_lanes(julia, cr, ci, count, max_iter, out, [&](uint32_t k, double& x, double& y) {
+        x = left + columns[k] * dx;
+        y = top - rows[k] * dx;
+    });
+}
+
+/// @brief Iterate pixels of a row of the Mandelbrot set, see escape_row
+inline void mandelbrot_row(double left, double dx, double y, uint32_t first, uint32_t stride, uint32_t count,
+                           uint32_t max_iter, uint32_t* out) {
+    escape_row(false, left, dx, y, 0.0, 0.0, first, stride, count, max_iter, out);
+}
+
+/// @brief Iterate pixels of a row of a Julia set, see escape_row
+inline void julia_row(double left, double dx, double y, double cr, double ci, uint32_t first, uint32_t stride, uint32_t count,
+                      uint32_t max_iter, uint32_t* out) {
+    escape_row(true, left, dx, y, cr, ci, first, stride, count, max_iter, out);
+}
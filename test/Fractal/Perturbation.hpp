@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "mat/Math.hpp"
+
+// Deep zooms by perturbation: a single orbit, the reference, is computed in BigFixed at the center of
+// the view, and every pixel iterates in double its difference to the reference
+//
+//     z_n = Z_n + d_n        d_(n+1) = (2 Z_n + d_n) d_n + dc
+//
+// For the Mandelbrot set, z_0 = 0 and dc is the offset of the pixel to the center. For a Julia set,
+// z_0 is the pixel, so d_0 is its offset and dc = 0. The offsets are tiny, but a double keeps them
+// with 53 bits whatever the zoom: the cost per pixel is the one of double, down to a view of 1e-300.
+//
+// Glitches: when the pixel orbit of the Mandelbrot set gets closer to the critical point 0 than to
+// the reference (|z_n| < |d_n|), d_n loses its precision against Z_n. The orbit is then rebased on
+// the start of the reference, d_n = z_n - Z_0 and n = 0: the same recurrence, and z_n is small so it
+// is exact in double. Likewise, for both sets, when the reference escapes before the pixel: the
+// pixel is then far from it, its offset is large enough for double. A Julia orbit does not start at
+// 0, it is rebased only there.
+//
+// Series approximation: for the first iterations d_n is a polynomial of the offset d,
+// d_n = A_n d + B_n d^2 + C_n d^3, with coefficients computed once along the reference. All the pixels
+// start at the last iteration where the cubic term is still negligible and no pixel can escape.
+
+typedef mat::Complex<mat::BigFixed> BigComplex;
+
+/// @brief Relative size of the cubic term of the series, against the linear term, to stop the skip
+constexpr double SERIES_TOLERANCE = 1e-12;
+
+/// @brief Counters of a perturbation render
+struct PerturbationStatistics {
+    uint32_t reference_length = 0;  // Iterations of the reference before it escapes
+    uint32_t skipped = 0;           // Iterations skipped by the series approximation
+    uint64_t rebases = 0;           // Pixels rebased on the start of the reference
+};
+
+class ReferenceOrbit {
+public:
+    /// @brief Compute the reference orbit in BigFixed, at the precision of its arguments
+    /// @param z0 The start of the orbit: 0 for the Mandelbrot set, the center for a Julia set
+    /// @param c The constant: the center for the Mandelbrot set, the one of the Julia set
+    /// @param julia If the offsets of the pixels are on z_0 rather than on c
+    /// @param max_iter Maximum number of iterations
+    /// @note Without compute_series, the pixels iterate from the start
+    void compute(const BigComplex& z0, const BigComplex& c, bool julia, uint32_t max_iter) {
+        m_julia = julia;
+        m_skip = 0;
+        m_a = mat::Comd(julia ? 1.0 : 0.0, 0.0);
+        m_b = mat::Comd(0.0, 0.0);
+        m_c = mat::Comd(0.0, 0.0);
+        m_z.clear();
+        m_z.reserve(max_iter + 1);
+
+        mat::BigFixed zr = z0.real(), zi = z0.imag();
+        m_z.emplace_back(double(zr), double(zi));
+        // Continue one step past the escape, so the pixels can always step on the last point
+        while (m_z.size() <= max_iter && (m_z.size() == 1 || m_z.back().modulus2() <= 4.0)) {
+            mat::BigFixed product = zr * zi;
+            zr = (zr + zi) * (zr - zi) + c.real();
+            zi = product + product + c.imag();
+            m_z.emplace_back(double(zr), double(zi));
+        }
+    }
+
+    /// @brief Compute the series approximation for the offsets up to a radius
+    /// @param delta_max The largest offset of a pixel to the center, e.g. half the diagonal of the view
+    /// @param max_iter Maximum number of iterations
+    void compute_series(double delta_max, uint32_t max_iter) {
+        const mat::Comd one(1.0, 0.0);
+        mat::Comd a = m_julia ? one : mat::Comd(0.0, 0.0), b(0.0, 0.0), c(0.0, 0.0);
+        m_skip = 0;
+        m_a = a; m_b = b; m_c = c;
+
+        const double d2 = delta_max * delta_max, d3 = d2 * delta_max;
+        const uint32_t last = std::min<uint32_t>(max_iter, uint32_t(m_z.size()) - 1);
+        for (uint32_t n = 0; n < last; ++n) {
+            mat::Comd twice_z = mat::Comd(2.0 * m_z[n].real(), 2.0 * m_z[n].imag());
+            mat::Comd next_c = twice_z * c + mat::Comd(2.0, 0.0) * a * b;
+            mat::Comd next_b = twice_z * b + a * a;
+            mat::Comd next_a = twice_z * a;
+            if (!m_julia) {
+                next_a += one;
+            }
+
+            // Valid at n + 1: the cubic term negligible, and no pixel escaping before the reference
+            double a_term = next_a.modulus() * delta_max;
+            double c_term = next_c.modulus() * d3;
+            double reach = m_z[n + 1].modulus() + a_term + next_b.modulus() * d2 + c_term;
+            if (!std::isfinite(reach) || c_term > SERIES_TOLERANCE * a_term || reach >= 2.0) {
+                break;
+            }
+            a = next_a; b = next_b; c = next_c;
+            m_skip = n + 1;
+            m_a = a; m_b = b; m_c = c;
+        }
+    }
+
+    /// @brief Number of points of the orbit, the last one escaped unless it reached max_iter
+    uint32_t size() const { return uint32_t(m_z.size()); }
+
+    /// @brief Number of iterations all the pixels skip
+    uint32_t skip() const { return m_skip; }
+
+    /// @brief Iterate a pixel, from the series approximation then by perturbation
+    /// @param delta The offset of the pixel to the center of the reference
+    /// @param max_iter Maximum number of iterations
+    /// @param rebases Incremented for each rebase of the pixel on the start of the reference
+    /// @return The number of iterations before the escape, as the direct series
+    uint32_t iterate(mat::Comd delta, uint32_t max_iter, uint64_t& rebases) const {
+        // d_skip = A d + B d^2 + C d^3, in Horner form
+        mat::Comd d = ((m_c * delta + m_b) * delta + m_a) * delta;
+        const double cr = m_julia ? 0.0 : delta.real();
+        const double ci = m_julia ? 0.0 : delta.imag();
+        double dr = d.real(), di = d.imag();
+
+        const mat::Comd* z = m_z.data();
+        const uint32_t last = size() - 1;
+        uint32_t iter = m_skip;
+        uint32_t m = m_skip;
+        while (iter < max_iter) {
+            double zr = z[m].real() + dr;
+            double zi = z[m].imag() + di;
+            double norm = zr * zr + zi * zi;
+            if (norm > 4.0) {
+                break;
+            }
+            // Mandelbrot: closer to the start of the reference, 0, than to the reference. Both: at its end
+            if ((!m_julia && norm < dr * dr + di * di) || m == last) {
+                dr = zr - z[0].real();
+                di = zi - z[0].imag();
+                m = 0;
+                ++rebases;
+            }
+            double tr = 2.0 * z[m].real() + dr;
+            double ti = 2.0 * z[m].imag() + di;
+            double next_dr = tr * dr - ti * di + cr;
+            di = tr * di + ti * dr + ci;
+            dr = next_dr;
+            ++m;
+            ++iter;
+        }
+        return iter;
+    }
+
+private:
+    std::vector<mat::Comd> m_z;     // The reference rounded to double, Z_0 to Z_(size - 1)
+    bool m_julia = false;
+    uint32_t m_skip = 0;
+    mat::Comd m_a, m_b, m_c;        // The coefficients of the series at m_skip
+};
@@ -0,0 +1,388 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Thread/ThreadPool.hpp"
+
+// Tiled rendering of an image on a persistent pool
+//
+// The image is cut in tiles of TILE_SIZE pixels, ordered along the Morton curve so the tiles close in
+// the order are close in the image. Each worker has a queue, a contiguous run of the order: it takes
+// its tiles from the front, and once empty steals from the back of the queue of another worker. The
+// tiles of the interior of a fractal cost hundreds of times the ones outside, the workers which
+// drew cheap tiles take the others instead of idling.
+//
+// The image is rendered in passes, from coarse to fine: the first pass computes one pixel of each
+// block of COARSEST_STEP x COARSEST_STEP pixels and fills the block, each next pass halves the step
+// and computes only the pixels no previous pass did. A callback runs between two passes, with no tile
+// in flight, so the image can be shown at each of them. A new render cancels the one in progress.
+//
+// A tile can instead be filled by subdivision (Mariani-Silver): the border of a rectangle is computed,
+// its inside filled when the whole border has one value, else it is cut in two along a line computed
+// once for both halves. The level sets of the escape time have no holes, so a uniform border encloses
+// uniform pixels except for features thinner than a pixel slipping between two of the border.
+
+/// @brief Size of a tile, in pixels
+constexpr uint32_t TILE_SIZE = 32;
+
+/// @brief Size of the blocks of the first pass, a power of 2 dividing TILE_SIZE
+constexpr uint32_t COARSEST_STEP = 8;
+
+/// @brief Size below which a rectangle of the subdivision is computed instead of cut again
+constexpr uint32_t SUBDIVISION_MIN_SIZE = 6;
+
+/// @brief A rectangle of the image, in pixels
+struct Tile {
+    uint32_t x, y;
+    uint32_t width, height;
+};
+
+/// @brief Interleave the bits of two coordinates, the position along the Morton curve
+inline uint64_t morton_code(uint32_t x, uint32_t y) {
+    auto spread = [](uint64_t v) {
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2)) & 0x3333333333333333ull;
+        v = (v | (v << 1)) & 0x5555555555555555ull;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+/// @brief Compute the pixels of a tile for the pass at a step, and fill their blocks
+/// @param tile The tile, its corner a multiple of COARSEST_STEP
+/// @param step The step of the pass: COARSEST_STEP computes the pixels at multiples of it, the next
+/// passes the multiples of step which are not multiples of 2 * step
+/// @param image_width The width of the image
+/// @param image The image, the block of step x step pixels of each computed pixel is set to its value
+/// @param row row(j, first, stride, count, out) computes the pixels first + k * stride of the row j in
+/// out, and returns false to stop the tile
+/// @return False if the tile was stopped
+template<typename F>
+bool render_pass(const Tile& tile, uint32_t step, uint32_t image_width, uint32_t* image, F&& row) {
+    std::array<uint32_t, TILE_SIZE> values;
+    for (uint32_t j = tile.y; j < tile.y + tile.height; j += step) {
+        // The rows at multiples of 2 * step were done by the previous pass at the even pixels
+        uint32_t first = tile.x, stride = step;
+        if (step != COARSEST_STEP && j % (2 * step) == 0) {
+            first += step;
+            stride = 2 * step;
+        }
+        if (first >= tile.x + tile.width) {
+            continue;
+        }
+        uint32_t count = (tile.x + tile.width - first + stride - 1) / stride;
+        if (!row(j, first, stride, count, values.data())) {
+            return false;
+        }
+
+        uint32_t block_end_j = std::min(j + step, tile.y + tile.height);
+        for (uint32_t k = 0; k < count; ++k) {
+            uint32_t i = first + k * stride;
+            uint32_t block_end_i = std::min(i + step, tile.x + tile.width);
+            for (uint32_t y = j; y < block_end_j; ++y) {
+                std::fill(image + y * image_width + i, image + y * image_width + block_end_i, values[k]);
+            }
+        }
+    }
+    return true;
+}
+
+/// @brief Compute the pixels of a tile by subdivision, the uniform rectangles filled
+/// @param tile The tile
+/// @param image_width The width of the image
+/// @param image The image, the pixels of the tile are set
+/// @param pixels pixels(count, columns, rows, out) computes the pixels (columns[k], rows[k]) in out,
+/// and returns false to stop the tile. The rectangles are cut in rounds, the pixels of a round are
+/// given at once so the kernel fills its lanes.
+/// @return False if the tile was stopped
+template<typename F>
+bool render_subdivided(const Tile& tile, uint32_t image_width, uint32_t* image, F&& pixels) {
+    std::vector<uint32_t> columns, rows, values;
+    auto at = [&](uint32_t i, uint32_t j) { return image + j * image_width + i; };
+    auto add = [&](uint32_t i, uint32_t j) {
+        columns.push_back(i);
+        rows.push_back(j);
+    };
+    auto compute = [&]() {
+        const uint32_t count = uint32_t(columns.size());
+        values.resize(count);
+        if (count != 0 && !pixels(count, columns.data(), rows.data(), values.data())) {
+            return false;
+        }
+        for (uint32_t k = 0; k < count; ++k) {
+            *at(columns[k], rows[k]) = values[k];
+        }
+        columns.clear();
+        rows.clear();
+        return true;
+    };
+
+    // The border of the tile
+    const uint32_t x1 = tile.x + tile.width - 1, y1 = tile.y + tile.height - 1;
+    for (uint32_t i = tile.x; i <= x1; ++i) {
+        add(i, tile.y);
+        if (y1 != tile.y) {
+            add(i, y1);
+        }
+    }
+    for (uint32_t j = tile.y + 1; j < y1; ++j) {
+        add(tile.x, j);
+        if (x1 != tile.x) {
+            add(x1, j);
+        }
+    }
+
+    // The rectangles of a round have their border computed at its start
+    std::vector<Tile> current = {tile}, next;
+    while (!current.empty()) {
+        if (!compute()) {
+            return false;
+        }
+        next.clear();
+        for (const Tile& r : current) {
+            if (r.width <= 2 || r.height <= 2) {
+                continue;
+            }
+            const uint32_t right = r.x + r.width - 1, bottom = r.y + r.height - 1;
+
+            const uint32_t value = *at(r.x, r.y);
+            bool uniform = true;
+            for (uint32_t i = r.x; i <= right && uniform; ++i) {
+                uniform = *at(i, r.y) == value && *at(i, bottom) == value;
+            }
+            for (uint32_t j = r.y + 1; j < bottom && uniform; ++j) {
+                uniform = *at(r.x, j) == value && *at(right, j) == value;
+            }
+
+            if (uniform) {
+                for (uint32_t j = r.y + 1; j < bottom; ++j) {
+                    std::fill(at(r.x + 1, j), at(right, j), value);
+                }
+            } else if (r.width <= SUBDIVISION_MIN_SIZE || r.height <= SUBDIVISION_MIN_SIZE) {
+                for (uint32_t j = r.y + 1; j < bottom; ++j) {
+                    for (uint32_t i = r.x + 1; i < right; ++i) {
+                        add(i, j);
+                    }
+                }
+            } else if (r.width >= r.height) {
+                // Cut along a column, the border of both halves
+                const uint32_t middle = r.x + r.width / 2;
+                for (uint32_t j = r.y + 1; j < bottom; ++j) {
+                    add(middle, j);
+                }
+                next.push_back({r.x, r.y, middle - r.x + 1, r.height});
+                next.push_back({middle, r.y, right - middle + 1, r.height});
+            } else {
+                const uint32_t middle = r.y + r.height / 2;
+                for (uint32_t i = r.x + 1; i < right; ++i) {
+                    add(i, middle);
+                }
+                next.push_back({r.x, r.y, r.width, middle - r.y + 1});
+                next.push_back({r.x, middle, r.width, bottom - middle + 1});
+            }
+        }
+        current.swap(next);
+    }
+    return compute();
+}
+
+class TileScheduler {
+public:
+    /// @brief task(tile, step) renders a tile for the pass at a step, see render_pass
+    typedef std::function<void(const Tile&, uint32_t)> TileTask;
+    /// @brief pass(step) is called when the pass at a step is done, before the next pass starts
+    typedef std::function<void(uint32_t)> PassCallback;
+
+    /// @brief Constructor
+    /// @param thread_count Number of workers, 0 to use all the hardware threads
+    TileScheduler(uint32_t thread_count = 0)
+    : m_step(0), m_remaining(0), m_cancelled(false), m_done(true), m_steals(0), m_running(0), m_pool(thread_count)
+    {
+        m_queues = std::vector<Queue>(m_pool.get_thread_count());
+    }
+
+    /// @brief Destructor, cancel the render in progress
+    ~TileScheduler() {
+        cancel();
+    }
+
+    TileScheduler(const TileScheduler&) = delete;
+    TileScheduler& operator=(const TileScheduler&) = delete;
+
+    /// @brief Render an image, after the cancellation of the render in progress
+    /// @param width The width of the image
+    /// @param height The height of the image
+    /// @param task Called for each tile and pass, from the workers
+    /// @param on_pass Called at the end of each pass, from the worker which finished it
+    /// @param first_step The step of the first pass, 1 for a single pass
+    void start(uint32_t width, uint32_t height, TileTask task, PassCallback on_pass, uint32_t first_step = COARSEST_STEP) {
+        std::vector<Tile> tiles;
+        for (uint32_t y = 0; y < height; y += TILE_SIZE) {
+            for (uint32_t x = 0; x < width; x += TILE_SIZE) {
+                tiles.push_back({x, y, std::min(TILE_SIZE, width - x), std::min(TILE_SIZE, height - y)});
+            }
+        }
+        start(std::move(tiles), std::move(task), std::move(on_pass), first_step);
+    }
+
+    /// @brief Render some tiles of an image, after the cancellation of the render in progress
+    /// @param tiles The tiles, their corners multiples of TILE_SIZE
+    /// @param task Called for each tile and pass, from the workers
+    /// @param on_pass Called at the end of each pass, from the worker which finished it
+    /// @param first_step The step of the first pass, 1 for a single pass
+    void start(std::vector<Tile> tiles, TileTask task, PassCallback on_pass, uint32_t first_step = COARSEST_STEP) {
+        cancel();
+
+        m_tiles = std::move(tiles);
+        std::sort(m_tiles.begin(), m_tiles.end(), [](const Tile& a, const Tile& b) {
+            return morton_code(a.x / TILE_SIZE, a.y / TILE_SIZE) < morton_code(b.x / TILE_SIZE, b.y / TILE_SIZE);
+        });
+
+        m_task = std::move(task);
+        m_on_pass = std::move(on_pass);
+        m_cancelled = false;
+        m_steals = 0;
+        m_done = m_tiles.empty();
+        if (!m_done) {
+            m_step = first_step;
+            start_pass();
+        }
+    }
+
+    /// @brief Stop the render in progress, return once no tile is in flight
+    /// @note The tasks should test is_cancelled to leave a long tile early
+    void cancel() {
+        m_cancelled = true;
+        wait();
+        for (Queue& queue : m_queues) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tiles.clear();
+        }
+    }
+
+    /// @brief Wait until the render is done or cancelled
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this]() { return m_running == 0; });
+    }
+
+    /// @brief Know if the render in progress is cancelled, for the tasks
+    bool is_cancelled() const {
+        return m_cancelled.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Know if the last render is complete
+    bool is_done() const {
+        return m_done;
+    }
+
+    /// @brief Get the number of tiles stolen by the workers in the last render
+    uint64_t get_steals() const {
+        return m_steals;
+    }
+
+    /// @brief Get the number of workers
+    uint32_t get_thread_count() const {
+        return m_pool.get_thread_count();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<uint32_t> tiles;   // Indices in m_tiles
+    };
+
+    // Give each queue a contiguous run of the tiles and run one drain per queue
+    void start_pass() {
+        const uint32_t tile_count = uint32_t(m_tiles.size());
+        const uint32_t queue_count = uint32_t(m_queues.size());
+        m_remaining = tile_count;
+        for (uint32_t q = 0; q < queue_count; ++q) {
+            std::lock_guard<std::mutex> lock(m_queues[q].mutex);
+            for (uint32_t t = q * tile_count / queue_count; t < (q + 1) * tile_count / queue_count; ++t) {
+                m_queues[q].tiles.push_back(t);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running += queue_count;
+        }
+        for (uint32_t q = 0; q < queue_count; ++q) {
+            m_pool.submit([this, q]() { drain(q); });
+        }
+    }
+
+    // Take a tile from the front of the own queue, else steal one from the back of another
+    bool pop(uint32_t owner, uint32_t& tile) {
+        {
+            std::lock_guard<std::mutex> lock(m_queues[owner].mutex);
+            if (!m_queues[owner].tiles.empty()) {
+                tile = m_queues[owner].tiles.front();
+                m_queues[owner].tiles.pop_front();
+                return true;
+            }
+        }
+        for (uint32_t k = 1; k < m_queues.size(); ++k) {
+            Queue& victim = m_queues[(owner + k) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tiles.empty()) {
+                tile = victim.tiles.back();
+                victim.tiles.pop_back();
+                ++m_steals;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void drain(uint32_t owner) {
+        uint32_t tile;
+        while (!is_cancelled() && pop(owner, tile)) {
+            m_task(m_tiles[tile], m_step);
+
+            // The last tile of the pass: show it, then the next pass
+            if (m_remaining.fetch_sub(1) == 1 && !is_cancelled()) {
+                m_on_pass(m_step);
+                if (m_step > 1) {
+                    m_step /= 2;
+                    start_pass();
+                } else {
+                    m_done = true;
+                }
+            }
+        }
+
+        // Notified under the lock: the scheduler may be destroyed as soon as the count is 0
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_running;
+        if (m_running == 0) {
+            m_finished.notify_all();
+        }
+    }
+
+    std::vector<Tile> m_tiles;              // In Morton order
+    std::vector<Queue> m_queues;            // One per worker
+    TileTask m_task;
+    PassCallback m_on_pass;
+    uint32_t m_step;                        // Step of the pass in progress, written between passes only
+
+    std::atomic<uint32_t> m_remaining;      // Tiles of the pass not done
+    std::atomic<bool> m_cancelled;
+    std::atomic<bool> m_done;
+    std::atomic<uint64_t> m_steals;
+
+    std::mutex m_mutex;
+    std::condition_variable m_finished;
+    uint32_t m_running;                     // Drains submitted and not returned
+
+    AMB::ThreadPool m_pool;                 // Last: joined first
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "Perturbation.hpp"
+#include "Scheduler.hpp"
+
+// Cache of the rendered tiles, in the quadtree of the views
+//
+// A tile is keyed by everything its pixels depend on: its level (the pixels are 2^-level wide), its
+// corner, the maximum number of iterations, the set and the fill. The memory of the tiles is accounted, and
+// once the budget is exceeded the least recently used ones are evicted. The workers insert the tiles
+// they complete while the window looks up the ones of a new view: the cache is locked.
+
+/// @brief Default budget of the tile cache, about 50000 tiles
+constexpr size_t TILE_CACHE_BUDGET = size_t(256) << 20;
+
+/// @brief The identity of a tile
+struct TileKey {
+    int32_t level;          // The pixels are 2^-level wide
+    BigComplex corner;      // The upper left corner, a multiple of TILE_SIZE pixels
+    uint32_t max_iter;
+    uint32_t mode;          // The set, see FractalMode
+    uint32_t fill;          // See FillStrategy, the subdivision may miss features thinner than a pixel
+    BigComplex constant;    // The constant of a Julia set, 0 for the Mandelbrot set
+
+    bool operator==(const TileKey& other) const {
+        return level == other.level && max_iter == other.max_iter && mode == other.mode && fill == other.fill
+            && corner.real() == other.corner.real() && corner.imag() == other.corner.imag()
+            && constant.real() == other.constant.real() && constant.imag() == other.constant.imag();
+    }
+};
+
+struct TileKeyHash {
+    size_t operator()(const TileKey& key) const {
+        // FNV-1a over the fields, the limbs at 0 skipped: equal values with more limbs hash the same
+        uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](uint64_t value) { hash = (hash ^ value) * 1099511628211ull; };
+        auto mix_big = [&mix](const mat::BigFixed& a) {
+            mix(a.is_negative());
+            for (uint32_t k = 0; k <= a.limbs(); ++k) {
+                if (a.limb(k) != 0) {
+                    mix((uint64_t(k) << 32) | a.limb(k));
+                }
+            }
+        };
+        mix(uint32_t(key.level));
+        mix(key.max_iter);
+        mix(key.mode);
+        mix(key.fill);
+        mix_big(key.corner.real());
+        mix_big(key.corner.imag());
+        mix_big(key.constant.real());
+        mix_big(key.constant.imag());
+        return size_t(hash);
+    }
+};
+
+class TileCache {
+public:
+    /// @brief The iteration counts of a tile, TILE_SIZE rows of TILE_SIZE pixels
+    typedef std::vector<uint32_t> Pixels;
+
+    /// @brief Constructor
+    /// @param budget The memory of the tiles above which the least recently used are evicted
+    TileCache(size_t budget = TILE_CACHE_BUDGET)
+    : m_budget(budget), m_bytes(0), m_hits(0), m_misses(0), m_evictions(0)
+    {}
+
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
+
+    /// @brief Get a copy of a tile, which becomes the most recently used
+    /// @param key The tile
+    /// @param pixels Receive the iteration counts
+    /// @return True if the tile is cached
+    bool find(const TileKey& key, Pixels& pixels) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            ++m_misses;
+            return false;
+        }
+        m_lru.splice(m_lru.end(), m_lru, it->second.lru_it);
+        pixels = it->second.pixels;
+        ++m_hits;
+        return true;
+    }
+
+    /// @brief Add a tile, or replace it, as the most recently used
+    /// @param key The tile
+    /// @param pixels The iteration counts
+    void insert(const TileKey& key, const Pixels& pixels) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_entries.try_emplace(key);
+        it->second.pixels = pixels;
+        if (inserted) {
+            it->second.lru_it = m_lru.insert(m_lru.end(), &it->first);
+            m_bytes += entry_bytes();
+        } else {
+            m_lru.splice(m_lru.end(), m_lru, it->second.lru_it);
+        }
+        evict(m_budget);
+    }
+
+    /// @brief Set the memory budget, evict at once if it is exceeded
+    /// @param budget The memory of the tiles, in bytes
+    void set_budget(size_t budget) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_budget = budget;
+        evict(m_budget);
+    }
+
+    /// @brief Remove all the tiles
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lru.clear();
+        m_entries.clear();
+        m_bytes = 0;
+    }
+
+    size_t get_bytes() const { std::lock_guard<std::mutex> lock(m_mutex); return m_bytes; }
+    size_t get_entry_count() const { std::lock_guard<std::mutex> lock(m_mutex); return m_entries.size(); }
+    uint64_t get_hit_count() const { std::lock_guard<std::mutex> lock(m_mutex); return m_hits; }
+    uint64_t get_miss_count() const { std::lock_guard<std::mutex> lock(m_mutex); return m_misses; }
+    uint64_t get_eviction_count() const { std::lock_guard<std::mutex> lock(m_mutex); return m_evictions; }
+
+private:
+    struct Entry {
+        Pixels pixels;
+        std::list<const TileKey*>::iterator lru_it;
+    };
+
+    /// @brief The memory of a tile with its key and bookkeeping
+    static size_t entry_bytes() {
+        return TILE_SIZE * TILE_SIZE * sizeof(uint32_t) + sizeof(TileKey) + sizeof(Entry) + sizeof(const TileKey*);
+    }
+
+    /// @brief Remove the least recently used tiles until the memory is within a budget
+    void evict(size_t budget) {
+        while (m_bytes > budget && !m_lru.empty()) {
+            // By iterator: the key is the one of the entry
+            m_entries.erase(m_entries.find(*m_lru.front()));
+            m_lru.pop_front();
+            m_bytes -= entry_bytes();
+            ++m_evictions;
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<TileKey, Entry, TileKeyHash> m_entries;
+    std::list<const TileKey*> m_lru;    // Least recently used first, the keys are the ones of m_entries
+
+    size_t m_budget;
+    size_t m_bytes;
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint64_t m_evictions;
+};
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "Fractal/Fractal.hpp"
+
+// Check the pans and the tile cache of Fractal/Fractal.hpp: a panned view equal to the same view
+// rendered from scratch with the exposed tiles only computed, an undo or a zoom back from the cache
+// alone, the budget of the cache respected. No window needed.
+
+static std::vector<uint32_t> finish(Fractal& fractal, uint32_t width, uint32_t height) {
+    std::vector<uint32_t> image(width * height);
+    fractal.wait();
+    fractal.fetch_image(image);
+    return image;
+}
+
+static std::vector<uint32_t> from_scratch(complex up_left, complex low_right, uint32_t width, uint32_t height, uint32_t max_iter,
+    FractalMode mode = FractalMode::MANDELBROT, complex julia_c = complex(T(0.0), T(0.0))) {
+    Fractal fractal(up_left, low_right, width, height, max_iter, 2);
+    if (mode == FractalMode::JULIA) {
+        fractal.set_mode(mode);
+        fractal.set_julia_c(julia_c);
+    }
+    return finish(fractal, width, height);
+}
+
+int main(int argc, char* argv[]) {
+    bool ok = true;
+    const uint32_t width = 400, height = 250, max_iter = 1000;
+    const uint32_t tiles = (width / TILE_SIZE + 2) * (height / TILE_SIZE + 2);
+
+    // --- pans against renders from scratch ---
+    auto check_pans = [&](const char* name, complex up_left, complex low_right, uint32_t limit, FractalMode mode, complex julia_c) {
+        Fractal fractal(up_left, low_right, width, height, limit, 2);
+        if (mode == FractalMode::JULIA) {
+            fractal.set_mode(mode);
+            fractal.set_julia_c(julia_c);
+        }
+        finish(fractal, width, height);
+
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int32_t> shift(-90, 90);
+        uint32_t differ = 0, computed = 0;
+        double pan_ms = 0.0, scratch_ms = 0.0;
+        for (uint32_t n = 0; n < 6; ++n) {
+            auto start = std::chrono::high_resolution_clock::now();
+            fractal.pan(shift(rng), shift(rng));
+            std::vector<uint32_t> panned = finish(fractal, width, height);
+            auto middle = std::chrono::high_resolution_clock::now();
+            std::vector<uint32_t> reference = from_scratch(fractal.complex_at_pixel({0, int32_t(height)}),
+                                                           fractal.complex_at_pixel({int32_t(width), 0}), width, height, limit, mode, julia_c);
+            pan_ms += std::chrono::duration<double, std::milli>(middle - start).count();
+            scratch_ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - middle).count();
+            computed += fractal.get_tiles_computed();
+            for (uint32_t p = 0; p < width * height; ++p) {
+                differ += panned[p] != reference[p];
+            }
+        }
+        bool passed = differ == 0 && computed < 6 * tiles / 2;
+        ok &= passed;
+        std::cout << name << ": 6 pans, " << differ << " pixels differ from the renders from scratch, " << computed << " tiles computed of "
+                  << 6 * tiles << ", " << pan_ms << " ms against " << scratch_ms << " ms" << (passed ? "" : "  FAILED") << std::endl;
+    };
+    check_pans("Mandelbrot, seahorse valley", complex(T(-0.80), T(0.20)), complex(T(-0.70), T(0.1375)), max_iter, FractalMode::MANDELBROT, complex());
+    check_pans("Julia, rabbit", complex(T(-1.6), T(1.0)), complex(T(1.6), T(-1.0)), max_iter, FractalMode::JULIA, complex(T(-0.123), T(0.745)));
+    check_pans("Mandelbrot at -1.25 + 0.05i, width 1e-9", complex(T(-1.25, 4) - 5e-10, T(0.05, 4) + 3e-10),
+               complex(T(-1.25, 4) + 5e-10, T(0.05, 4) - 3e-10), 3000, FractalMode::MANDELBROT, complex());
+
+    // --- undo and zoom back from the cache ---
+    {
+        Fractal fractal(complex(T(-2.5), T(1.25)), complex(T(1.5), T(-1.25)), width, height, max_iter, 2);
+        std::vector<uint32_t> whole = finish(fractal, width, height);
+        uint32_t level = fractal.get_level();
+
+        fractal.set_new_position(complex(T(-0.9), T(0.3)), complex(T(-0.5), T(0.05)));
+        std::vector<uint32_t> zoomed = finish(fractal, width, height);
+        uint32_t zoom_level = fractal.get_level();
+        complex zoom_left = fractal.complex_at_pixel({0, int32_t(height)}), zoom_right = fractal.complex_at_pixel({int32_t(width), 0});
+
+        auto start = std::chrono::high_resolution_clock::now();
+        fractal.undo();
+        std::vector<uint32_t> undone = finish(fractal, width, height);
+        double undo_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        uint32_t undo_computed = fractal.get_tiles_computed();
+
+        // The same zoom again, then back out: a revisit of both levels
+        fractal.set_new_position(zoom_left, zoom_right);
+        std::vector<uint32_t> revisited = finish(fractal, width, height);
+        uint32_t revisit_computed = fractal.get_tiles_computed();
+        fractal.undo();
+        finish(fractal, width, height);
+
+        bool passed = undone == whole && undo_computed == 0 && revisited == zoomed && revisit_computed == 0
+                   && fractal.get_tiles_computed() == 0 && zoom_level > level;
+        ok &= passed;
+        std::cout << "Zoom from level " << level << " to " << zoom_level << ", undo in " << undo_ms << " ms with " << undo_computed
+                  << " tiles computed, revisit with " << revisit_computed << ", images " << (undone == whole && revisited == zoomed ? "equal" : "different")
+                  << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- the budget of the cache ---
+    {
+        Fractal fractal(complex(T(-2.5), T(1.25)), complex(T(1.5), T(-1.25)), width, height, max_iter, 2);
+        std::vector<uint32_t> before = finish(fractal, width, height);
+        size_t full = fractal.get_cache().get_bytes();
+        fractal.get_cache().set_budget(full / 4);
+        size_t evicted = fractal.get_cache().get_eviction_count();
+
+        fractal.pan(150, 0);
+        finish(fractal, width, height);
+        fractal.pan(-150, 0);
+        std::vector<uint32_t> after = finish(fractal, width, height);
+
+        bool passed = fractal.get_cache().get_bytes() <= full / 4 && evicted > 0 && after == before;
+        ok &= passed;
+        std::cout << "Budget of " << (full / 4 >> 10) << " kB: " << (fractal.get_cache().get_bytes() >> 10) << " kB used, "
+                  << fractal.get_cache().get_eviction_count() << " tiles evicted, pan back " << (after == before ? "equal" : "different")
+                  << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    std::cout << (ok ? "The pans and the cache match the renders from scratch." : "The pans or the cache differ.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+#include "Fractal/Kernel.hpp"
+
+// Check the row kernels of Fractal/Kernel.hpp against the scalar series, pixel for pixel: without
+// interior detection, with it, and by lanes. Then the time of each on views from escape-heavy to
+// interior-heavy. No window needed.
+
+struct View {
+    const char* name;
+    double left, top, width;    // Upper left corner and width, the height follows the aspect
+    bool julia;
+    double cr, ci;
+    uint32_t max_iter;
+};
+
+template<typename F>
+static double time_ms(F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    const uint32_t width = 480, height = 270;
+    const std::vector<View> views = {
+        {"Mandelbrot, whole set", -2.5, 1.0, 3.5, false, 0.0, 0.0, 1000},
+        {"Mandelbrot, cardioid and bulb", -1.3, 0.45, 1.6, false, 0.0, 0.0, 5000},
+        {"Mandelbrot, seahorse valley", -0.76, 0.14, 0.04, false, 0.0, 0.0, 2000},
+        {"Mandelbrot, minibrot at -1.75", -1.7905, 0.012, 0.04, false, 0.0, 0.0, 5000},
+        {"Julia, rabbit", -1.6, 0.9, 3.2, true, -0.123, 0.745, 2000},
+        {"Julia, dendrite of i", -1.6, 0.9, 3.2, true, 0.0, 1.0, 1000},
+    };
+
+    std::cout << "Lanes: " << Lanes::N << " doubles" << std::endl;
+    bool ok = true;
+    for (const View& view : views) {
+        const double dx = view.width / width;
+        std::vector<uint32_t> plain(width * height), checked(width * height), lanes(width * height);
+
+        auto pixel = [&](uint32_t i, uint32_t j, auto&& serie) {
+            double x = view.left + i * dx, y = view.top - j * dx;
+            return view.julia ? serie(x, y, view.cr, view.ci, view.max_iter) : serie(0.0, 0.0, x, y, view.max_iter);
+        };
+        double plain_ms = time_ms([&]() {
+            for (uint32_t j = 0; j < height; ++j) {
+                for (uint32_t i = 0; i < width; ++i) {
+                    plain[i + j * width] = pixel(i, j, escape_time);
+                }
+            }
+        });
+        double checked_ms = time_ms([&]() {
+            for (uint32_t j = 0; j < height; ++j) {
+                for (uint32_t i = 0; i < width; ++i) {
+                    double x = view.left + i * dx, y = view.top - j * dx;
+                    checked[i + j * width] = !view.julia && in_main_components(x, y) ? view.max_iter : pixel(i, j, escape_time_checked);
+                }
+            }
+        });
+        double lanes_ms = time_ms([&]() {
+            for (uint32_t j = 0; j < height; ++j) {
+                if (view.julia) {
+                    julia_row(view.left, dx, view.top - j * dx, view.cr, view.ci, 0, 1, width, view.max_iter, &lanes[j * width]);
+                } else {
+                    mandelbrot_row(view.left, dx, view.top - j * dx, 0, 1, width, view.max_iter, &lanes[j * width]);
+                }
+            }
+        });
+
+        uint32_t checked_diff = 0, lanes_diff = 0, interior = 0;
+        for (uint32_t p = 0; p < width * height; ++p) {
+            checked_diff += checked[p] != plain[p];
+            lanes_diff += lanes[p] != plain[p];
+            interior += plain[p] == view.max_iter;
+        }
+        bool passed = checked_diff == 0 && lanes_diff == 0;
+        ok &= passed;
+        std::cout << view.name << " (" << width << "x" << height << ", " << 100 * interior / (width * height) << "% interior): "
+                  << checked_diff << " checked and " << lanes_diff << " lanes pixels differ" << (passed ? "" : "  FAILED") << std::endl;
+        std::cout << "    scalar " << plain_ms << " ms, with interior detection " << checked_ms << " ms (x" << plain_ms / checked_ms
+                  << "), by lanes " << lanes_ms << " ms (x" << plain_ms / lanes_ms << ")" << std::endl;
+    }
+
+    std::cout << (ok ? "The kernels match the scalar series." : "The kernels differ from the scalar series.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Fractal/Kernel.hpp"
+#include "Fractal/Scheduler.hpp"
+
+// Check the tiled scheduler of Fractal/Scheduler.hpp: every pixel computed once over the passes, the
+// image complete from the first pass, the progressive render equal to the one of the rows, the
+// cancellation of a render in progress and its restart. No window needed.
+
+static constexpr uint32_t UNSET = 0xFFFFFFFF;
+
+template<typename F>
+static double time_ms(F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    bool ok = true;
+    // Not a multiple of the tiles nor of the blocks, the borders are partial
+    const uint32_t width = 643, height = 365;
+    TileScheduler scheduler(4);
+    std::cout << "Workers: " << scheduler.get_thread_count() << std::endl;
+
+    // --- every pixel computed once, every pass shows a complete image ---
+    {
+        std::vector<std::atomic<uint32_t>> computed(width * height);
+        std::vector<uint32_t> image(width * height, UNSET);
+        std::vector<uint32_t> steps;
+        bool complete = true;
+        scheduler.start(width, height,
+            [&](const Tile& tile, uint32_t step) {
+                render_pass(tile, step, width, image.data(), [&](uint32_t j, uint32_t first, uint32_t stride, uint32_t count, uint32_t* out) {
+                    for (uint32_t k = 0; k < count; ++k) {
+                        ++computed[first + k * stride + j * width];
+                        out[k] = step;
+                    }
+                    return true;
+                });
+            },
+            [&](uint32_t step) {
+                steps.push_back(step);
+                complete &= std::find(image.begin(), image.end(), UNSET) == image.end();
+            });
+        scheduler.wait();
+
+        uint32_t wrong = 0;
+        for (uint32_t p = 0; p < width * height; ++p) {
+            wrong += computed[p] != 1;
+        }
+        bool passed = scheduler.is_done() && wrong == 0 && complete && steps == std::vector<uint32_t>{8, 4, 2, 1};
+        ok &= passed;
+        std::cout << "Coverage: " << wrong << " pixels not computed once, passes";
+        for (uint32_t step : steps) {
+            std::cout << " " << step;
+        }
+        std::cout << ", " << (complete ? "complete" : "incomplete") << " images, " << scheduler.get_steals() << " tiles stolen"
+                  << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- the progressive render of the Mandelbrot set against its rows ---
+    {
+        const double left = -2.5, top = 1.0, dx = 3.5 / width;
+        const uint32_t max_iter = 2000;
+        std::vector<uint32_t> rows(width * height), tiles(width * height, UNSET);
+        double rows_ms = time_ms([&]() {
+            for (uint32_t j = 0; j < height; ++j) {
+                mandelbrot_row(left, dx, top - j * dx, 0, 1, width, max_iter, &rows[j * width]);
+            }
+        });
+        double first_pass_ms = 0.0;
+        auto start = std::chrono::high_resolution_clock::now();
+        double tiles_ms = time_ms([&]() {
+            scheduler.start(width, height,
+                [&](const Tile& tile, uint32_t step) {
+                    render_pass(tile, step, width, tiles.data(), [&](uint32_t j, uint32_t first, uint32_t stride, uint32_t count, uint32_t* out) {
+                        mandelbrot_row(left, dx, top - j * dx, first, stride, count, max_iter, out);
+                        return true;
+                    });
+                },
+                [&](uint32_t step) {
+                    if (step == COARSEST_STEP) {
+                        first_pass_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+                    }
+                });
+            scheduler.wait();
+        });
+
+        bool passed = tiles == rows;
+        ok &= passed;
+        std::cout << "Mandelbrot " << width << "x" << height << ": tiles " << (passed ? "equal" : "differ from") << " rows, rows "
+                  << rows_ms << " ms on one thread, tiles " << tiles_ms << " ms, first pass shown after " << first_pass_ms << " ms, "
+                  << scheduler.get_steals() << " tiles stolen" << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- cancellation of a slow render, then a new one ---
+    {
+        std::atomic<uint32_t> tiles_done(0);
+        auto slow = [&](const Tile&, uint32_t) {
+            for (uint32_t row = 0; row < TILE_SIZE && !scheduler.is_cancelled(); ++row) {
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+            ++tiles_done;
+        };
+        scheduler.start(width, height, slow, [](uint32_t) {});
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        double cancel_ms = time_ms([&]() { scheduler.cancel(); });
+        uint32_t cancelled_after = tiles_done;
+        bool cancelled = !scheduler.is_done();
+
+        uint32_t passes = 0;
+        scheduler.start(width, height, [](const Tile&, uint32_t) {}, [&](uint32_t) { ++passes; });
+        scheduler.wait();
+
+        bool passed = cancelled && cancel_ms < 20.0 && scheduler.is_done() && passes == 4;
+        ok &= passed;
+        std::cout << "Cancellation: after " << cancelled_after << " tiles, in " << cancel_ms << " ms, then a new render of "
+                  << passes << " passes" << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    std::cout << (ok ? "The scheduler renders every pixel." : "The scheduler fails.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "Fractal/Fractal.hpp"
+
+// Check the fill by subdivision of Fractal/Scheduler.hpp: on reference views, the tiles rendered over
+// the scheduler by subdivision equal the rows computed pixel by pixel with the same kernel, for far
+// fewer pixels computed, and the Fractal by subdivision equals the one by passes. No window needed.
+//
+// Where components of the set touch, the channels of escaping points between them are thinner than a
+// pixel: the rows hit them at isolated pixels, which a uniform border of the interior around them
+// cannot see. On these views the subdivision may only differ there, interior instead of escaping.
+
+struct ReferenceView {
+    const char* name;
+    bool julia;
+    double left, top, width;    // The width of the view, the pixels are square
+    double cr, ci;
+    uint32_t max_iter;
+    bool cusps;                 // Components touching in the view
+};
+
+template<typename F>
+static double time_ms(F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/// @brief Count the pixels which differ, and the ones of them not escaping pixels filled as interior
+static uint32_t compare(const std::vector<uint32_t>& reference, const std::vector<uint32_t>& image, uint32_t max_iter, uint32_t& others) {
+    uint32_t differ = 0;
+    others = 0;
+    for (size_t p = 0; p < reference.size(); ++p) {
+        if (reference[p] != image[p]) {
+            ++differ;
+            others += !(image[p] == max_iter && reference[p] < max_iter);
+        }
+    }
+    return differ;
+}
+
+int main(int argc, char* argv[]) {
+    bool ok = true;
+    uint32_t cusp_pixels = 0;
+    // Not a multiple of the tiles, the borders are partial
+    const uint32_t width = 640, height = 400;
+    // The pixels in the channels of the cusps, at most
+    const uint32_t tolerance = width * height / 10000;
+    TileScheduler scheduler(4);
+
+    const ReferenceView views[] = {
+        {"Mandelbrot, whole set", false, -2.5, 1.25, 4.0, 0.0, 0.0, 1000, false},
+        {"Mandelbrot, minibrot at -1.7687", false, -1.76885, 0.00016, 0.0005, 0.0, 0.0, 2000, false},
+        {"Mandelbrot, spirals at -0.7436 + 0.1318i", false, -0.74368, 0.13190, 0.00004, 0.0, 0.0, 3000, false},
+        {"Julia, rabbit", true, -1.6, 1.0, 3.2, -0.123, 0.745, 1000, false},
+        {"Julia, dendrite", true, -1.6, 1.0, 3.2, 0.0, 1.0, 1000, false},
+        {"Mandelbrot, seahorse valley", false, -0.80, 0.20, 0.10, 0.0, 0.0, 1000, true},
+        {"Mandelbrot, elephant valley", false, 0.25, 0.05, 0.08, 0.0, 0.0, 1000, true},
+        {"Julia, San Marco", true, -1.8, 1.125, 3.6, -0.75, 0.0, 1000, true},
+    };
+
+    // --- tiles by subdivision against rows pixel by pixel ---
+    for (const ReferenceView& view : views) {
+        const double dx = view.width / width;
+        std::vector<uint32_t> brute(width * height), subdivided(width * height);
+        double brute_ms = time_ms([&]() {
+            for (uint32_t j = 0; j < height; ++j) {
+                escape_row(view.julia, view.left, dx, view.top - j * dx, view.cr, view.ci, 0, 1, width, view.max_iter, &brute[j * width]);
+            }
+        });
+
+        std::atomic<uint64_t> computed(0);
+        double subdivided_ms = time_ms([&]() {
+            scheduler.start(width, height,
+                [&](const Tile& tile, uint32_t) {
+                    render_subdivided(tile, width, subdivided.data(), [&](uint32_t count, const uint32_t* columns, const uint32_t* rows, uint32_t* out) {
+                        escape_pixels(view.julia, view.left, view.top, dx, view.cr, view.ci, columns, rows, count, view.max_iter, out);
+                        computed += count;
+                        return true;
+                    });
+                },
+                [](uint32_t) {}, 1);
+            scheduler.wait();
+        });
+
+        uint32_t others;
+        uint32_t differ = compare(brute, subdivided, view.max_iter, others);
+        bool passed = view.cusps ? others == 0 && differ <= tolerance : differ == 0;
+        ok &= passed;
+        cusp_pixels += view.cusps ? differ : 0;
+        std::cout << view.name << ": " << differ << " pixels differ" << (view.cusps ? " in the cusps" : "") << ", "
+                  << 100.0 * computed / (width * height) << "% computed, " << subdivided_ms << " ms against " << brute_ms << " ms"
+                  << (passed ? "" : "  FAILED") << std::endl;
+    }
+
+    // --- the Fractal by subdivision against the one by passes ---
+    auto check_fractal = [&](const char* name, complex up_left, complex low_right, uint32_t max_iter, FractalMode mode, complex julia_c, bool cusps) {
+        std::vector<uint32_t> images[2];
+        double times[2];
+        for (uint32_t n = 0; n < 2; ++n) {
+            images[n].resize(width * height);
+            times[n] = time_ms([&]() {
+                Fractal fractal(up_left, low_right, width, height, max_iter, 4);
+                fractal.set_fill(n == 0 ? FillStrategy::PASSES : FillStrategy::SUBDIVISION);
+                if (mode == FractalMode::JULIA) {
+                    fractal.set_mode(mode);
+                    fractal.set_julia_c(julia_c);
+                }
+                fractal.wait();
+                fractal.fetch_image(images[n]);
+            });
+        }
+        uint32_t others;
+        uint32_t differ = compare(images[0], images[1], max_iter, others);
+        bool passed = cusps ? others == 0 && differ <= tolerance : differ == 0;
+        ok &= passed;
+        cusp_pixels += cusps ? differ : 0;
+        std::cout << "Fractal, " << name << ": " << differ << " pixels differ" << (cusps ? " in the cusps" : "") << ", subdivision in "
+                  << times[1] << " ms against " << times[0] << " ms by passes" << (passed ? "" : "  FAILED") << std::endl;
+    };
+    check_fractal("Julia, rabbit", complex(T(-1.6), T(1.0)), complex(T(1.6), T(-1.0)), 1000, FractalMode::JULIA, complex(T(-0.123), T(0.745)), false);
+    check_fractal("Mandelbrot at -1.25 + 0.05i, width 1e-9", complex(T(-1.25, 4) - 5e-10, T(0.05, 4) + 3e-10),
+                  complex(T(-1.25, 4) + 5e-10, T(0.05, 4) - 3e-10), 3000, FractalMode::MANDELBROT, complex(), false);
+    check_fractal("Mandelbrot, seahorse valley", complex(T(-0.80), T(0.20)), complex(T(-0.70), T(0.1375)), 1000, FractalMode::MANDELBROT, complex(), true);
+
+    if (ok) {
+        std::cout << "The subdivision matches the pixels computed one by one, except " << cusp_pixels << " pixels in the cusps." << std::endl;
+    } else {
+        std::cout << "The subdivision differs." << std::endl;
+    }
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -11,38 +11,28 @@
 #include "Graphic/Renderer.hpp"
 #include "Text/Text.hpp"
 
-#include <thread>
+#include "Fractal/Fractal.hpp"
+
 #include <algorithm>
 #include <map>
 
-typedef double T;
-typedef mat::Complex<T> complex;
-
 struct Vertex {
     float x, y;  // Position
     float u, v;  // Texture coordinates
 };
 
-enum class FractalMode { 
-    MANDELBROT,
-    JULIA
-};
-
-std::string to_string(complex c) {
-    return "(" + std::to_string(c.real()) + ", " + std::to_string(c.imag()) + "i)";
-}
-
 /*
 ============================================
 ===== Mandelbrot computation functions =====
 ============================================
 */
 
-uint32_t mandelbrot_serie(complex c, uint32_t max_iter) {
+template<typename S>
+uint32_t mandelbrot_serie(mat::Complex<S> c, uint32_t max_iter) {
     uint32_t iter = 0;
-    complex z(0.0, 0.0);
+    mat::Complex<S> z(S(0.0), S(0.0));
 
-    while (z.modulus2() <= 4.0 && iter < max_iter) {
+    while (z.modulus2() <= S(4.0) && iter < max_iter) {
         z = z * z + c;
         ++iter;
     }
@@ -53,80 +43,29 @@ uint32_t mandelbrot_serie(complex c, uint32_t max_iter) {
 void mandelbrot_set(complex upper_left, complex lower_right, uint32_t width, uint32_t height, uint32_t max_iter,
     std::vector<uint32_t>& convergence) {
     
-    T dr = (lower_right.real() - upper_left.real())/width;
-    T di = (lower_right.imag() - upper_left.imag())/height;
+    double dr = double(lower_right.real() - upper_left.real())/width;
+    double di = double(lower_right.imag() - upper_left.imag())/height;
+    mat::Comd origin(double(upper_left.real()), double(upper_left.imag()));
 
     for (uint32_t j(0) ; j < height ; ++j) {
         for (uint32_t i(0) ; i < width ; ++i) {
-            convergence[i + j*width] = mandelbrot_serie(upper_left + complex(dr*i, di*j), max_iter);
-        }
-    }
-}
-
-void mandelbrot_worker(complex upper_left, complex lower_right, uint32_t width, uint32_t height,
-    uint32_t y_start, uint32_t y_end, uint32_t max_iter, std::vector<uint32_t>& convergence)
-{
-    T dr = (lower_right.real() - upper_left.real()) / width;
-    T di = (upper_left.imag() - lower_right.imag()) / height;
-
-    for (uint32_t j = y_start; j < y_end; ++j) {
-        for (uint32_t i = 0; i < width; ++i) {
-            complex c(
-                upper_left.real() + i * dr,
-                upper_left.imag() - j * di
-            );
-
-            convergence[i + j * width] = mandelbrot_serie(c, max_iter);
+            mat::Comd c = origin + mat::Comd(dr*i, di*j);
+            convergence[i + j*width] = mandelbrot_serie(c, max_iter);
         }
     }
 }
 
-void mandelbrot_multi_core(complex upper_left, complex lower_right, uint32_t width, uint32_t height, uint32_t max_iter,
-    std::vector<uint32_t>& convergence)
-{
-    uint32_t num_threads = std::thread::hardware_concurrency();
-    if (num_threads <= 2) {
-        num_threads = 1;
-    } else {
-        num_threads -= 2;
-    }
-
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads);
-
-    uint32_t rows_per_thread = height / num_threads;
-
-    for (uint32_t t = 0; t < num_threads; ++t) {
-        uint32_t y_start = t * rows_per_thread;
-        uint32_t y_end   = (t == num_threads - 1) ? height : y_start + rows_per_thread;
-
-        threads.emplace_back(
-            mandelbrot_worker,
-            upper_left,
-            lower_right,
-            width,
-            height,
-            y_start,
-            y_end,
-            max_iter,
-            std::ref(convergence)
-        );
-    }
-
-    for (auto& th : threads)
-        th.join();
-}
-
 /*
 =======================================
 ===== Julia computation functions =====
 =======================================
 */
 
-uint32_t julia_serie(complex z, complex c, uint32_t max_iter) {
+template<typename S>
+uint32_t julia_serie(mat::Complex<S> z, mat::Complex<S> c, uint32_t max_iter) {
     uint32_t iter = 0;
 
-    while (z.modulus2() <= 4.0 && iter < max_iter) {
+    while (z.modulus2() <= S(4.0) && iter < max_iter) {
         z = z * z + c;
         ++iter;
     }
@@ -137,192 +76,19 @@ uint32_t julia_serie(complex z, complex c, uint32_t max_iter) {
 void julia_set(complex c, complex upper_left, complex lower_right, uint32_t width, uint32_t height, uint32_t max_iter,
     std::vector<uint32_t>& convergence) {
     
-    T dr = (lower_right.real() - upper_left.real())/width;
-    T di = (lower_right.imag() - upper_left.imag())/height;
+    double dr = double(lower_right.real() - upper_left.real())/width;
+    double di = double(lower_right.imag() - upper_left.imag())/height;
+    mat::Comd origin(double(upper_left.real()), double(upper_left.imag()));
+    mat::Comd julia_c(double(c.real()), double(c.imag()));
 
     for (uint32_t j(0) ; j < height ; ++j) {
         for (uint32_t i(0) ; i < width ; ++i) {
-            convergence[i + j*width] = julia_serie(upper_left + complex(dr*i, di*j), c, max_iter);
-        }
-    }
-}
-
-void julia_worker(complex julia_c, complex upper_left, complex lower_right, uint32_t width, uint32_t height,
-    uint32_t y_start, uint32_t y_end, uint32_t max_iter, std::vector<uint32_t>& convergence)
-{
-    T dr = (lower_right.real() - upper_left.real()) / width;
-    T di = (upper_left.imag() - lower_right.imag()) / height;
-
-    for (uint32_t j = y_start; j < y_end; ++j) {
-        for (uint32_t i = 0; i < width; ++i) {
-            complex z(
-                upper_left.real() + i * dr,
-                upper_left.imag() - j * di
-            );
-
-            convergence[i + j * width] = julia_serie(z, julia_c, max_iter);
+            mat::Comd z = origin + mat::Comd(dr*i, di*j);
+            convergence[i + j*width] = julia_serie(z, julia_c, max_iter);
         }
     }
 }
 
-void julia_multi_core(complex julia_c, complex upper_left, complex lower_right, uint32_t width, uint32_t height, uint32_t max_iter,
-    std::vector<uint32_t>& convergence)
-{
-    uint32_t num_threads = std::thread::hardware_concurrency();
-    if (num_threads <= 2) {
-        num_threads = 1;
-    } else {
-        num_threads -= 2;
-    }
-
-    std::vector<std::thread> threads;
-    threads.reserve(num_threads);
-
-    uint32_t rows_per_thread = height / num_threads;
-
-    for (uint32_t t = 0; t < num_threads; ++t) {
-        uint32_t y_start = t * rows_per_thread;
-        uint32_t y_end   = (t == num_threads - 1) ? height : y_start + rows_per_thread;
-
-        threads.emplace_back(
-            julia_worker,
-            julia_c,
-            upper_left,
-            lower_right,
-            width,
-            height,
-            y_start,
-            y_end,
-            max_iter,
-            std::ref(convergence)
-        );
-    }
-
-    for (auto& th : threads)
-        th.join();
-}
-
-/*
-=========================
-===== Fractal class =====
-=========================
-*/
-
-class Fractal {
-public:
-    Fractal(complex up_left, complex low_right, uint32_t width, uint32_t height, uint32_t max_iter)
-    : m_up_left(up_left), m_low_right(low_right), m_width(width), m_height(height), 
-        m_max_iter(max_iter), m_convergence(m_width*m_height, 0), m_mode(FractalMode::MANDELBROT), m_julia_c(0.0, 0.0)
-    {
-        AMB::Logger::instance().log(AMB::Info, "Number of CPU threads :" + std::to_string(std::thread::hardware_concurrency()));
-
-        recompute();
-    }
-
-    std::vector<uint32_t>& get_convergence() { return m_convergence; }
-
-    void mandelbrot() {
-        mandelbrot_multi_core(m_up_left, m_low_right, m_width, m_height, m_max_iter, m_convergence);
-    }
-
-    void julia() {
-        julia_multi_core(m_julia_c, m_up_left, m_low_right, m_width, m_height, m_max_iter, m_convergence);
-    }
-
-    void recompute() {
-        switch (m_mode)
-        {
-        case FractalMode::MANDELBROT:
-            mandelbrot();
-            break;
-
-        case FractalMode::JULIA:
-            julia();
-            break;
-        
-        default:
-            break;
-        }
-    }
-
-    void set_mode(FractalMode mode) {
-        if (mode != m_mode) {
-            m_mode = mode;
-            recompute();
-            clean_undo();
-        }
-    }
-
-    FractalMode get_mode() {
-        return m_mode;
-    }
-
-    complex complex_at_pixel(mat::Vec2i position) const {
-        // Pixel size in complex plane
-        T dx = (m_low_right.real() - m_up_left.real()) / T(m_width);
-        T dy = (m_up_left.imag() - m_low_right.imag()) / T(m_height);
-
-        // Map pixel (x, y) to complex number
-        T real_part = m_up_left.real() + position[0] * dx;
-        T imag_part = m_low_right.imag() + position[1] * dy; // <-- bottom-left origin
-
-        return complex(real_part, imag_part);
-    }
-
-    void set_new_position(complex up_left, complex low_right) {
-        m_undo_storage.push({m_up_left, m_low_right});
-        m_up_left = up_left;
-        m_low_right = low_right;
-
-        recompute();
-    }
-
-    void undo() {
-        if (!m_undo_storage.empty()) {
-            m_up_left = m_undo_storage.top().first;
-            m_low_right = m_undo_storage.top().second;
-            m_undo_storage.pop();
-
-            recompute();
-        }
-    }
-
-    void clean_undo() {
-        while (!m_undo_storage.empty()) {
-            m_undo_storage.pop();
-        }
-    }
-
-    void set_max_iteration(uint32_t max_iter) {
-        m_max_iter = max_iter;
-        recompute();
-    }
-
-    uint32_t get_max_iteration() {
-        return m_max_iter;
-    }
-
-    void set_julia_c(complex julia_c) {
-        m_julia_c = julia_c;
-        if (m_mode == FractalMode::JULIA) {
-            recompute();
-        }
-    }
-
-    complex get_julia_c() const {
-        return m_julia_c;
-    }
-
-private:
-    complex m_up_left, m_low_right;
-    uint32_t m_width, m_height;
-    uint32_t m_max_iter;
-    std::vector<uint32_t> m_convergence;
-    std::stack<std::pair<complex, complex>> m_undo_storage;
-    FractalMode m_mode;
-    complex m_julia_c;
-};
-
 std::map<int, std::string> COLOR_MAP_SELECTION {
     {0, "White"},
     {1, "Vidris"},
@@ -338,7 +104,7 @@ std::map<int, std::string> COLOR_MAP_SELECTION {
 };
 
 void build_text(AMB::TextRenderer& text_renderer, uint32_t max_iter, FractalMode mode, uint32_t height, 
-                complex julia_c, complex mouse_pos, int color_selection) {
+                complex julia_c, complex mouse_pos, int color_selection, const std::string& precision, uint32_t digits, const std::string& render) {
     std::string text;
 
     switch (mode)
@@ -356,8 +122,10 @@ void build_text(AMB::TextRenderer& text_renderer, uint32_t max_iter, FractalMode
     }
 
     text += "Max iteration: " + std::to_string(max_iter) + "\n";
-    text += "Mouse position: " + to_string(mouse_pos) + "\n";
+    text += "Mouse position: " + to_string(mouse_pos, digits) + "\n";
     text += "Color selection: " + COLOR_MAP_SELECTION[color_selection] + "\n";
+    text += "Precision: " + precision + "\n";
+    text += "Render: " + render + "\n";
 
     AMB::Font& font = text_renderer.get_font();
     text_renderer.reset();
@@ -397,14 +165,14 @@ int main(int argc, char* argv[]) {
 
     uint32_t width = window.get_width();
     uint32_t height = window.get_height();
-    T win_ratio = (float)width/(float)height;
+    double win_ratio = (float)width/(float)height;
     complex upper_left(-1.0/2.0 * win_ratio*4.0,  2.0);
     complex lower_right(1.0/2.0 * win_ratio*4.0, -2.0);
     uint32_t max_iter = 1000;
     int color_selection = 0;
 
     Fractal fractal(upper_left, lower_right, width, height, max_iter);
-    std::vector<uint32_t> convergence(height*height, 0);
+    std::vector<uint32_t> image(width*height, 0);
 
     /*
     =======================
@@ -433,7 +201,7 @@ int main(int argc, char* argv[]) {
     AMB::Font& font = asset_manager.fonts.get(font_handle);
 
     AMB::AssetHandle texture_fractal_handle = asset_factory.create_texture_from_data(
-        width, height, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
+        width, height, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, image.data());
     if (!asset_manager.textures.validity(texture_fractal_handle)) {
         logger.log(AMB::Fatal, "Fail to load fractal texture");
         return EXIT_FAILURE;
@@ -473,6 +241,7 @@ int main(int argc, char* argv[]) {
 
     mat::Vec2i mouse_pos0;
     mat::Vec2i mouse_pos1;
+    mat::Vec2i mouse_pan;
     bool mouse_hold = false;
 
     AMB::TextRenderer text_renderer(font, shader_text, 2048);
@@ -483,9 +252,6 @@ int main(int argc, char* argv[]) {
     renderer.set_blend(true);
     renderer.set_depth_test(true);
 
-    texture_fractal.bind();
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
-
     while (!event_manager.is_quitting()) {
         event_manager.manage();
 
@@ -501,17 +267,11 @@ int main(int argc, char* argv[]) {
         if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_UP)) {
             int mi = fractal.get_max_iteration() + 500;
             fractal.set_max_iteration(mi);
-            fractal.recompute();
-            texture_fractal.bind();
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
         }
         if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_DOWN)) {
             int mi = fractal.get_max_iteration();
             mi - 500 < 10 ? mi = 10 : mi -= 500;
             fractal.set_max_iteration(mi);
-            fractal.recompute();
-            texture_fractal.bind();
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
         }
 
         if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_RIGHT)) {
@@ -532,34 +292,35 @@ int main(int argc, char* argv[]) {
             mouse_hold = true;
         }
 
+        // Drag the view with the right button, the mouse and the rows of the image both go up the window
+        if (event_manager.mouse().button_down(AMB::MouseButton::MOUSE_RIGHT)) {
+            mouse_pan = mouse_pos1;
+        }
+        if (event_manager.mouse().button_press(AMB::MouseButton::MOUSE_RIGHT)) {
+            fractal.pan(mouse_pos1[0] - mouse_pan[0], mouse_pos1[1] - mouse_pan[1]);
+            mouse_pan = mouse_pos1;
+        }
+
         if (event_manager.mouse().button_down(AMB::MouseButton::MOUSE_EXTRA_1) or 
             event_manager.keyboard().key_down(AMB::KEY_CODE_DELETE)) {
             fractal.undo();
-            texture_fractal.bind();
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
         }
 
         if (event_manager.mouse().button_up(AMB::MouseButton::MOUSE_LEFT)) {
             mouse_hold = false;
             complex c0 = fractal.complex_at_pixel({mouse_pos0[0], (int)height - mouse_pos0[1]});
 
-            T x_length = abs(c0[0] - mouse_c1[0]);
-            T y_length = x_length/win_ratio;
+            double x_length = double(abs(c0[0] - mouse_c1[0]));
+            double y_length = x_length/win_ratio;
 
             complex new_up_left(c0[0] - x_length, c0[1] + y_length);
             complex new_down_right(c0[0] + x_length, c0[1] - y_length);
             fractal.set_new_position(new_up_left, new_down_right);
-
-            texture_fractal.bind();
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
         }
 
         if (event_manager.keyboard().key_down(AMB::KEY_CODE_M)) {
             reset_fractal(fractal, win_ratio, FractalMode::MANDELBROT);
             fractal.set_mode(FractalMode::MANDELBROT);
-
-            texture_fractal.bind();
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
         }
 
         if (event_manager.keyboard().key_down(AMB::KEY_CODE_J)) {
@@ -571,13 +332,22 @@ int main(int argc, char* argv[]) {
             fractal.set_mode(FractalMode::JULIA);
 
             fractal.set_julia_c(c0);
+        }
+
+        // Switch the tiles between the passes and the subdivision
+        if (event_manager.keyboard().key_down(AMB::KEY_CODE_S)) {
+            fractal.set_fill(fractal.get_fill() == FillStrategy::PASSES ? FillStrategy::SUBDIVISION : FillStrategy::PASSES);
+        }
+
+        // Show the last pass of the render in progress
+        if (fractal.fetch_image(image)) {
             texture_fractal.bind();
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, fractal.get_convergence().data());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT, image.data());
         }
 
         // Create the text
         build_text(text_renderer, fractal.get_max_iteration(), fractal.get_mode(), height, fractal.get_julia_c(), 
-            mouse_c1, color_selection);
+            mouse_c1, color_selection, fractal.get_precision(), fractal.get_digits(), fractal.get_render_state());
         
         // Clear the screen
         renderer.clear();
@@ -0,0 +1,354 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "mat/Math.hpp"
+
+// Compare the SIMD overloads of the float types with the generic templates, called with explicit
+// template arguments: the largest difference in ULP and the time per call. The inverse is compared
+// to a double precision inverse with pivoting. The batch kernels are compared to a loop over the
+// per point functions, with a count that is not a multiple of the SIMD width. No window needed.
+
+static int64_t ordered(float f) {
+    int32_t i;
+    std::memcpy(&i, &f, sizeof(i));
+    return i < 0 ? int64_t(INT32_MIN) - i : i;
+}
+
+static int64_t ulp(float a, float b) {
+    return std::llabs(ordered(a) - ordered(b));
+}
+
+template<typename A, typename B>
+static void compare(const A& a, const B& b, int64_t& max_ulp, float& max_error) {
+    auto it = b.begin();
+    for (float f : a) {
+        float error = std::fabs(f - *it);
+        max_ulp = std::max(max_ulp, ulp(f, *it));
+        max_error = error > max_error || std::isnan(error) ? error : max_error;
+        ++it;
+    }
+}
+
+// Gauss-Jordan elimination with partial pivoting, the reference of the inverses
+static mat::Mat4d reference_inverse(mat::Mat4d m) {
+    mat::Mat4d result = mat::identity<double,4>();
+    for (uint32_t k(0) ; k < 4 ; ++k) {
+        uint32_t pivot = k;
+        for (uint32_t i(k + 1) ; i < 4 ; ++i) {
+            if (std::fabs(m(i,k)) > std::fabs(m(pivot,k))) {
+                pivot = i;
+            }
+        }
+        for (uint32_t j(0) ; j < 4 ; ++j) {
+            std::swap(m(k,j), m(pivot,j));
+            std::swap(result(k,j), result(pivot,j));
+        }
+
+        double scale = 1.0 / m(k,k);
+        for (uint32_t j(0) ; j < 4 ; ++j) {
+            m(k,j) *= scale;
+            result(k,j) *= scale;
+        }
+        for (uint32_t i(0) ; i < 4 ; ++i) {
+            if (i == k) {
+                continue;
+            }
+            double factor = m(i,k);
+            for (uint32_t j(0) ; j < 4 ; ++j) {
+                m(i,j) -= factor * m(k,j);
+                result(i,j) -= factor * result(k,j);
+            }
+        }
+    }
+    return result;
+}
+
+template<typename F>
+static double time_ns(uint32_t count, F&& f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < count; ++i) {
+        f(i);
+    }
+    std::chrono::duration<double, std::nano> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count() / count;
+}
+
+static bool report(const char* name, int64_t max_ulp, float max_error, float tolerance, double simd_ns, double generic_ns) {
+    bool ok = max_error <= tolerance;   // false for NaN
+    std::cout << name << ": max " << max_ulp << " ulp (" << max_error << "), "
+              << simd_ns << " ns / " << generic_ns << " ns generic"
+              << (ok ? "" : "  FAILED") << std::endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+
+#if defined(MAT_SIMD_SSE)
+    std::cout << "SIMD: SSE" << (
+#if defined(__AVX__)
+        " + AVX"
+#else
+        ""
+#endif
+    ) << std::endl;
+#elif defined(MAT_SIMD_NEON)
+    std::cout << "SIMD: NEON" << std::endl;
+#else
+    std::cout << "SIMD: disabled, the overloads are the generic templates" << std::endl;
+#endif
+
+    const uint32_t count = 1 << 14;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+    std::vector<mat::Mat4f> matrices(count);
+    std::vector<mat::Vec4f> vectors(count);
+    std::vector<mat::Quatf> quaternions(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        for (float& f : matrices[i]) {
+            f = value(rng);
+        }
+        for (float& f : vectors[i]) {
+            f = value(rng);
+        }
+        float angle = value(rng) * 3.14159265f;
+        mat::Vec3f axis = mat::normalize(mat::Vec3f({value(rng), value(rng), value(rng)}));
+        quaternions[i] = mat::quat_from_angle_vec_of_rotation(angle, axis);
+    }
+
+    // Invertible transforms: rotation, scale and translation, as built by the cameras and the sprites
+    std::vector<mat::Mat4f> transforms(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        transforms[i] = mat::dot(mat::graph::translate3(mat::Vec3f({value(rng) * 100.0f, value(rng) * 100.0f, value(rng)})),
+                        mat::dot(mat::graph::rotate3(quaternions[i]), mat::graph::scale3(1.5f + value(rng))));
+    }
+
+    bool ok = true;
+    float sink = 0.0f;
+
+    // --- matrix product ---
+    {
+        int64_t max_ulp = 0;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i + 1 < count; ++i) {
+            compare(mat::dot(matrices[i], matrices[i + 1]), mat::dot<float,4,4,4>(matrices[i], matrices[i + 1]), max_ulp, max_error);
+        }
+        double simd = time_ns(count - 1, [&](uint32_t i) { sink += mat::dot(matrices[i], matrices[i + 1])(1, 2); });
+        double generic = time_ns(count - 1, [&](uint32_t i) { sink += mat::dot<float,4,4,4>(matrices[i], matrices[i + 1])(1, 2); });
+        ok &= report("Mat4f * Mat4f", max_ulp, max_error, 1e-5f, simd, generic);
+    }
+
+    // --- matrix vector product ---
+    {
+        int64_t max_ulp = 0;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            compare(mat::dot(matrices[i], vectors[i]), mat::dot<float,4,4>(matrices[i], vectors[i]), max_ulp, max_error);
+        }
+        double simd = time_ns(count, [&](uint32_t i) { sink += mat::dot(matrices[i], vectors[i])[1]; });
+        double generic = time_ns(count, [&](uint32_t i) { sink += mat::dot<float,4,4>(matrices[i], vectors[i])[1]; });
+        ok &= report("Mat4f * Vec4f", max_ulp, max_error, 1e-5f, simd, generic);
+    }
+
+    // --- vector dot product ---
+    {
+        int64_t max_ulp = 0;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i + 1 < count; ++i) {
+            float a = mat::dot(vectors[i], vectors[i + 1]);
+            float b = mat::dot<float,4>(vectors[i], vectors[i + 1]);
+            max_ulp = std::max(max_ulp, ulp(a, b));
+            max_error = std::max(max_error, std::fabs(a - b));
+        }
+        double simd = time_ns(count - 1, [&](uint32_t i) { sink += mat::dot(vectors[i], vectors[i + 1]); });
+        double generic = time_ns(count - 1, [&](uint32_t i) { sink += mat::dot<float,4>(vectors[i], vectors[i + 1]); });
+        ok &= report("Vec4f . Vec4f", max_ulp, max_error, 1e-5f, simd, generic);
+    }
+
+    // --- transpose, exact ---
+    {
+        int64_t max_ulp = 0;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            compare(mat::transpose(matrices[i]), mat::transpose<float,4,4>(matrices[i]), max_ulp, max_error);
+        }
+        double simd = time_ns(count, [&](uint32_t i) { sink += mat::transpose(matrices[i])(1, 2); });
+        double generic = time_ns(count, [&](uint32_t i) { sink += mat::transpose<float,4,4>(matrices[i])(1, 2); });
+        ok &= report("transpose", max_ulp, max_error, 0.0f, simd, generic);
+    }
+
+    // --- inverse, both compared to a double precision inverse ---
+    {
+        int64_t max_ulp = 0, generic_ulp = 0;
+        float max_error = 0.0f, generic_error = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            mat::Mat4d m;
+            std::copy(transforms[i].begin(), transforms[i].end(), m.begin());
+            mat::Mat4d reference = reference_inverse(m);
+            mat::Mat4f reference_f;
+            std::copy(reference.begin(), reference.end(), reference_f.begin());
+
+            compare(mat::inverse(transforms[i]), reference_f, max_ulp, max_error);
+            compare(mat::inverse<float,4>(transforms[i]), reference_f, generic_ulp, generic_error);
+        }
+        double simd = time_ns(count, [&](uint32_t i) { sink += mat::inverse(transforms[i])(1, 2); });
+        double generic = time_ns(count, [&](uint32_t i) { sink += mat::inverse<float,4>(transforms[i])(1, 2); });
+        ok &= report("inverse", max_ulp, max_error, 1e-4f, simd, generic);
+        std::cout << "  generic inverse: max " << generic_ulp << " ulp (" << generic_error << ")" << std::endl;
+    }
+
+    // --- quaternion product ---
+    {
+        int64_t max_ulp = 0;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i + 1 < count; ++i) {
+            compare(quaternions[i] * quaternions[i + 1], mat::operator*<float>(quaternions[i], quaternions[i + 1]), max_ulp, max_error);
+        }
+        double simd = time_ns(count - 1, [&](uint32_t i) { sink += (quaternions[i] * quaternions[i + 1])[1]; });
+        double generic = time_ns(count - 1, [&](uint32_t i) { sink += mat::operator*<float>(quaternions[i], quaternions[i + 1])[1]; });
+        ok &= report("Quatf * Quatf", max_ulp, max_error, 1e-6f, simd, generic);
+    }
+
+    // --- quaternion rotation, the reference is the product q v q* of the generic template ---
+    {
+        auto reference = [](const mat::Quatf& q, const mat::Vec3f& v) {
+            mat::Quatf vq{0.0f, v[0], v[1], v[2]};
+            return mat::operator*<float>(mat::operator*<float>(q, vq), mat::conjugate(q)).imag();
+        };
+
+        int64_t max_ulp = 0;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            mat::Vec3f v({vectors[i][0], vectors[i][1], vectors[i][2]});
+            compare(mat::quat_rotate_vec(quaternions[i], v), reference(quaternions[i], v), max_ulp, max_error);
+        }
+        double simd = time_ns(count, [&](uint32_t i) {
+            sink += mat::quat_rotate_vec(quaternions[i], mat::Vec3f({vectors[i][0], vectors[i][1], vectors[i][2]}))[0];
+        });
+        double generic = time_ns(count, [&](uint32_t i) {
+            sink += reference(quaternions[i], mat::Vec3f({vectors[i][0], vectors[i][1], vectors[i][2]}))[0];
+        });
+        ok &= report("quat_rotate_vec", max_ulp, max_error, 1e-5f, simd, generic);
+    }
+
+    // --- batch kernels, per point time, SoA and AoS against a loop of the per point functions ---
+    {
+        const uint32_t points = count + 3;  // leaves a tail after the SIMD blocks
+        std::vector<float> x(points), y(points), z(points), out_x(points), out_y(points), out_z(points), out_w(points);
+        std::vector<mat::Vec3f> aos(points), aos_out(points);
+        std::vector<mat::Vec2f> aos2(points), aos2_out(points);
+        for (uint32_t i = 0; i < points; ++i) {
+            x[i] = value(rng) * 10.0f;
+            y[i] = value(rng) * 10.0f;
+            z[i] = value(rng) * 10.0f;
+            aos[i] = mat::Vec3f({x[i], y[i], z[i]});
+            aos2[i] = mat::Vec2f({x[i], y[i]});
+        }
+        const mat::Mat4f& m = transforms[0];
+        const mat::Mat4f projection = mat::dot(mat::graph::perspective(4.0f / 3.0f, 1.0f, 0.1f, 100.0f), m);
+        const mat::Quatf& q = quaternions[0];
+        mat::Mat3f m2 = mat::identity<float,3>();
+        m2(0,0) = 0.8f; m2(0,1) = -0.6f; m2(1,0) = 0.6f; m2(1,1) = 0.8f; m2(0,2) = 12.0f; m2(1,2) = -3.0f;
+        const uint32_t runs = 64;
+
+        auto check_soa = [&](const char* name, auto&& reference, auto&& soa, auto&& aos_kernel, float tolerance) {
+            int64_t max_ulp = 0;
+            float max_error = 0.0f;
+            soa();
+            for (uint32_t i = 0; i < points; ++i) {
+                compare(mat::Vec3f({out_x[i], out_y[i], out_z[i]}), reference(aos[i]), max_ulp, max_error);
+            }
+            aos_kernel();
+            for (uint32_t i = 0; i < points; ++i) {
+                compare(aos_out[i], reference(aos[i]), max_ulp, max_error);
+            }
+            double soa_ns = time_ns(runs, [&](uint32_t) { soa(); sink += out_x[1]; }) / points;
+            double aos_ns = time_ns(runs, [&](uint32_t) { aos_kernel(); sink += aos_out[1][0]; }) / points;
+            double loop_ns = time_ns(runs, [&](uint32_t) {
+                for (uint32_t i = 0; i < points; ++i) {
+                    aos_out[i] = reference(aos[i]);
+                }
+                sink += aos_out[1][0];
+            }) / points;
+            ok &= report(name, max_ulp, max_error, tolerance, soa_ns, loop_ns);
+            std::cout << "  AoS: " << aos_ns << " ns" << std::endl;
+        };
+
+        auto point = [&](const mat::Vec3f& p) {
+            mat::Vec4f r = mat::dot<float,4,4>(m, mat::Vec4f({p[0], p[1], p[2], 1.0f}));
+            return mat::Vec3f({r[0], r[1], r[2]});
+        };
+        check_soa("batch transform_points", point,
+            [&]() { mat::batch::transform_points(m, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), points); },
+            [&]() { mat::batch::transform_points(m, aos.data(), aos_out.data(), points); }, 1e-4f);
+
+        auto direction = [&](const mat::Vec3f& d) {
+            mat::Vec4f r = mat::dot<float,4,4>(m, mat::Vec4f({d[0], d[1], d[2], 0.0f}));
+            return mat::Vec3f({r[0], r[1], r[2]});
+        };
+        check_soa("batch transform_directions", direction,
+            [&]() { mat::batch::transform_directions(m, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), points); },
+            [&]() { mat::batch::transform_directions(m, aos.data(), aos_out.data(), points); }, 1e-4f);
+
+        check_soa("batch rotate", [&](const mat::Vec3f& v) { return mat::quat_rotate_vec(q, v); },
+            [&]() { mat::batch::rotate(q, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), points); },
+            [&]() { mat::batch::rotate(q, aos.data(), aos_out.data(), points); }, 1e-4f);
+
+        // Clip coordinates, the fourth component included
+        {
+            int64_t max_ulp = 0;
+            float max_error = 0.0f;
+            mat::batch::transform_points_clip(projection, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), out_w.data(), points);
+            for (uint32_t i = 0; i < points; ++i) {
+                mat::Vec4f r = mat::dot<float,4,4>(projection, mat::Vec4f({x[i], y[i], z[i], 1.0f}));
+                compare(mat::Vec4f({out_x[i], out_y[i], out_z[i], out_w[i]}), r, max_ulp, max_error);
+            }
+            double soa_ns = time_ns(runs, [&](uint32_t) {
+                mat::batch::transform_points_clip(projection, x.data(), y.data(), z.data(), out_x.data(), out_y.data(), out_z.data(), out_w.data(), points);
+                sink += out_w[1];
+            }) / points;
+            double loop_ns = time_ns(runs, [&](uint32_t) {
+                for (uint32_t i = 0; i < points; ++i) {
+                    mat::Vec4f r = mat::dot<float,4,4>(projection, mat::Vec4f({x[i], y[i], z[i], 1.0f}));
+                    out_x[i] = r[0]; out_y[i] = r[1]; out_z[i] = r[2]; out_w[i] = r[3];
+                }
+                sink += out_w[1];
+            }) / points;
+            ok &= report("batch transform_points_clip", max_ulp, max_error, 1e-4f, soa_ns, loop_ns);
+        }
+
+        // 2D affine, in place
+        {
+            int64_t max_ulp = 0;
+            float max_error = 0.0f;
+            std::vector<float> in_x(x), in_y(y);
+            mat::batch::transform2(m2, in_x.data(), in_y.data(), in_x.data(), in_y.data(), points);
+            mat::batch::transform2(m2, aos2.data(), aos2_out.data(), points);
+            for (uint32_t i = 0; i < points; ++i) {
+                mat::Vec3f r = mat::dot<float,3,3>(m2, mat::Vec3f({x[i], y[i], 1.0f}));
+                compare(mat::Vec2f({in_x[i], in_y[i]}), mat::Vec2f({r[0], r[1]}), max_ulp, max_error);
+                compare(aos2_out[i], mat::Vec2f({r[0], r[1]}), max_ulp, max_error);
+            }
+            double soa_ns = time_ns(runs, [&](uint32_t) {
+                mat::batch::transform2(m2, x.data(), y.data(), out_x.data(), out_y.data(), points);
+                sink += out_x[1];
+            }) / points;
+            double loop_ns = time_ns(runs, [&](uint32_t) {
+                for (uint32_t i = 0; i < points; ++i) {
+                    mat::Vec3f r = mat::dot<float,3,3>(m2, mat::Vec3f({x[i], y[i], 1.0f}));
+                    out_x[i] = r[0]; out_y[i] = r[1];
+                }
+                sink += out_x[1];
+            }) / points;
+            ok &= report("batch transform2", max_ulp, max_error, 1e-4f, soa_ns, loop_ns);
+        }
+    }
+
+    std::cout << "Checksum: " << sink << std::endl;
+    std::cout << (ok ? "All the overloads match the generic templates." : "Some overloads differ from the generic templates.") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -137,9 +137,11 @@ int main(int argc, char* argv[]) {
     AMB::Window window(800, 600, "Test Window", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
     AMB::EventManager event_manager(&window);
     AMB::Timer timer(60);
+    AMB::ShaderCache shader_cache("build/shader_cache");
     AMB::AssetManager asset_manager; 
     AMB::FontSystem font_system;
     AMB::AssetFactory asset_factory(asset_manager, font_system);
+    asset_factory.set_shader_cache(&shader_cache);
     AMB::Renderer renderer;
     AMB::Logger& logger = AMB::Logger::instance();
 
@@ -200,49 +202,14 @@ int main(int argc, char* argv[]) {
     shader_pixel.set_2f("u_resolution", mat::Vec2f{float(window.get_width()), float(window.get_height())});
     shader_pixel.set_1f("u_pixel_size", 4.0f);
 
-    // Blur shader
-    AMB::AssetHandle shader_pp1 = asset_factory.create_shader(std::string("test/res/post.vert"), std::string("test/res/blur.frag"));
-    if (!asset_manager.shaders.validity(shader_pp1)) {
-        std::cerr << "Failed to add shader asset." << std::endl;
-        return EXIT_FAILURE; 
-    }else{
-        std::cout << "Shader loaded successfully." << std::endl;
-    }
-    AMB::Shader& shader_blur = asset_manager.shaders.get(shader_pp1);
-    shader_blur.use_shader();
-    shader_blur.set_2f("u_texel_size", mat::Vec2f{1.0f/float(window.get_width()), float(1.0f/window.get_height())});
-    shader_blur.set_1i("u_horizontal", true);
-
-    // Bright shader
-    AMB::AssetHandle shader_pp2 = asset_factory.create_shader(std::string("test/res/post.vert"), std::string("test/res/bright.frag"));
-    if (!asset_manager.shaders.validity(shader_pp2)) {
-        std::cerr << "Failed to add shader asset." << std::endl;
-        return EXIT_FAILURE; 
-    }else{
-        std::cout << "Shader loaded successfully." << std::endl;
-    }
-    AMB::Shader& shader_bright = asset_manager.shaders.get(shader_pp2);
-    shader_bright.use_shader();
-    shader_bright.set_1f("u_threshold", 0.5f);
-
-    // Bloom shader
-    AMB::AssetHandle shader_pp3 = asset_factory.create_shader(std::string("test/res/post.vert"), std::string("test/res/bloom.frag"));
-    if (!asset_manager.shaders.validity(shader_pp3)) {
-        std::cerr << "Failed to add shader asset." << std::endl;
-        return EXIT_FAILURE; 
-    }else{
-        std::cout << "Shader loaded successfully." << std::endl;
-    }
-    AMB::Shader& shader_bloom = asset_manager.shaders.get(shader_pp3);
-    shader_bloom.use_shader();
-    shader_bloom.set_1f("u_bloom_intensity", 5.0f);
-
     AMB::PostProcessor pp(window.get_width(), window.get_height(), asset_manager, asset_factory);
 
     //pp.add_effect(&shader_pixel, AMB::PostProcessMode::single, true);
-    pp.add_effect(&shader_bright, AMB::PostProcessMode::single, false);
-    pp.add_effect(&shader_blur, AMB::PostProcessMode::single, false);
-    pp.add_effect(&shader_bloom, AMB::PostProcessMode::multiple, true);
+
+    AMB::BloomSettings bloom_settings;
+    bloom_settings.threshold = 0.5f;
+    bloom_settings.intensity = 5.0f;
+    pp.enable_bloom(bloom_settings);
 
     // Create Camera
     AMB::CameraOrthographic camera(mat::Vec2f{0.0f, 0.0f}, mat::Vec2f{float(window.get_width()), float(window.get_height())});
@@ -323,5 +290,7 @@ int main(int argc, char* argv[]) {
 
     }
 
+    std::cout << "Shader cache: " << shader_cache.get_hit_count() << " hits, " << shader_cache.get_miss_count() << " misses" << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+
+#include "Window/Window.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Text/FontSystem.hpp"
+#include "Text/Font.hpp"
+#include "Text/Text.hpp"
+
+// Measure the text submission throughput in glyphs per second: glyph lookups alone,
+// submit_text alone (CPU mesh building) and submit_text with the upload of the mesh.
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(800, 600, "Text bench", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+
+    AMB::AssetHandle shader_handle = asset_factory.create_shader(std::string("test/res/Text.vert"), std::string("test/res/Text.frag"));
+    AMB::AssetHandle font_handle = asset_factory.create_font(std::string("test/res/OpenSans.ttf"), 16);
+    if (!asset_manager.shaders.validity(shader_handle) || !asset_manager.fonts.validity(font_handle)) {
+        std::cerr << "Failed to load the text assets." << std::endl;
+        return EXIT_FAILURE;
+    }
+    AMB::Shader& shader = asset_manager.shaders.get(shader_handle);
+    AMB::Font& font = asset_manager.fonts.get(font_handle);
+
+    const std::string line = "The quick brown fox jumps over the lazy dog. 0123456789 !?#@\n";
+    std::string page;
+    for (int i = 0; i < 64; ++i) {
+        page += line;
+    }
+    const uint32_t glyphs_per_page = page.size() - 64;
+    const int iterations = 2000;
+
+    using Clock = std::chrono::high_resolution_clock;
+    using seconds = std::chrono::duration<double>;
+
+    // --- glyph lookups ---
+    auto start = Clock::now();
+    int64_t advance = 0;
+    for (int it = 0; it < iterations; ++it) {
+        for (char c : page) {
+            advance += font.get_char(c).advance;
+        }
+    }
+    seconds lookup_time = Clock::now() - start;
+
+    // --- submission ---
+    AMB::TextRenderer text_renderer(font, shader, glyphs_per_page);
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        text_renderer.reset();
+        text_renderer.submit_text(page, mat::Vec3f{0.0f, 580.0f, 0.0f}, 1.0f, 1.0f, 1.0f);
+    }
+    seconds submit_time = Clock::now() - start;
+
+    // --- submission and upload ---
+    start = Clock::now();
+    for (int it = 0; it < iterations / 10; ++it) {
+        text_renderer.reset();
+        text_renderer.submit_text(page, mat::Vec3f{0.0f, 580.0f, 0.0f}, 1.0f, 1.0f, 1.0f);
+        text_renderer.build_mesh();
+    }
+    glFinish();
+    seconds upload_time = Clock::now() - start;
+
+    double glyphs = double(glyphs_per_page) * iterations;
+    std::cout << "Glyphs per page: " << text_renderer.get_char_count() << " (checksum " << advance << ")" << std::endl;
+    std::cout << "Lookup: " << page.size() * double(iterations) / lookup_time.count() / 1e6 << " M glyphs/s" << std::endl;
+    std::cout << "Submit: " << glyphs / submit_time.count() / 1e6 << " M glyphs/s" << std::endl;
+    std::cout << "Submit + upload: " << glyphs / 10 / upload_time.count() / 1e6 << " M glyphs/s" << std::endl;
+
+    return 0;
+}
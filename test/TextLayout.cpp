@@ -0,0 +1,162 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Window/Window.hpp"
+#include "Time/Timer.hpp"
+#include "Event/Event.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Graphic/Renderer.hpp"
+#include "Text/FontSystem.hpp"
+#include "Text/Font.hpp"
+#include "Text/Text.hpp"
+#include "Text/TextLayout.hpp"
+
+// Compare the submission of texts laid out every frame with the submission of cached layouts,
+// count the glyphs laid out again when a score counter changes, and check the patched layouts
+// against fresh ones over random UTF-8 edits.
+
+/// @brief Compare a layout with the same text laid out from scratch
+static bool same_layout(const AMB::TextLayout& layout, const AMB::TextLayout& fresh) {
+    const std::vector<AMB::GlyphQuad>& a = layout.get_quads();
+    const std::vector<AMB::GlyphQuad>& b = fresh.get_quads();
+    if (a.size() != b.size() || layout.get_width() != fresh.get_width() || layout.get_line_count() != fresh.get_line_count()) {
+        return false;
+    }
+    for (size_t q = 0; q < a.size(); ++q) {
+        if (a[q].x0 != b[q].x0 || a[q].y0 != b[q].y0 || a[q].x1 != b[q].x1 || a[q].y1 != b[q].y1
+         || a[q].u0 != b[q].u0 || a[q].v0 != b[q].v0 || a[q].u1 != b[q].u1 || a[q].v1 != b[q].v1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(800, 600, "Text layout", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::EventManager event_manager(&window);
+    AMB::Timer timer(60);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+    AMB::Renderer renderer;
+
+    renderer.set_clear_color(0.1f, 0.1f, 0.1f, 1.0f);
+    renderer.set_blend(true);
+    renderer.set_depth_test(false);
+
+    AMB::AssetHandle shader_handle = asset_factory.create_shader(std::string("test/res/Text.vert"), std::string("test/res/Text.frag"));
+    AMB::AssetHandle font_handle = asset_factory.create_font(std::string("test/res/OpenSans.ttf"), 16);
+    if (!asset_manager.shaders.validity(shader_handle) || !asset_manager.fonts.validity(font_handle)) {
+        std::cerr << "Failed to load the text assets." << std::endl;
+        return EXIT_FAILURE;
+    }
+    AMB::Shader& shader = asset_manager.shaders.get(shader_handle);
+    AMB::Font& font = asset_manager.fonts.get(font_handle);
+
+    // A page of 64 lines, submitted every frame
+    std::string page;
+    for (int i = 0; i < 64; ++i) {
+        page += "Score " + std::to_string(i * 1250) + ", lives 3, level " + std::to_string(i) + ": press space to continue\n";
+    }
+    const uint32_t glyph_count = page.size() - 64;
+    const int iterations = 2000;
+
+    using Clock = std::chrono::high_resolution_clock;
+    using seconds = std::chrono::duration<double>;
+
+    AMB::TextRenderer text_renderer(font, shader, glyph_count + 64);
+    AMB::TextLayoutCache layout_cache;
+
+    // --- laid out every frame ---
+    auto start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        text_renderer.reset();
+        text_renderer.submit_text(page, mat::Vec3f{0.0f, 580.0f, 0.0f}, 1.0f, 1.0f, 1.0f);
+    }
+    seconds submit_time = Clock::now() - start;
+
+    // --- cached layout ---
+    start = Clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        text_renderer.reset();
+        text_renderer.submit_layout(layout_cache.get(font, page), mat::Vec3f{0.0f, 580.0f, 0.0f}, 1.0f, 1.0f, 1.0f);
+    }
+    seconds layout_time = Clock::now() - start;
+
+    // --- score counter, patched between the frames ---
+    uint64_t written = 0, total = 0;
+    for (int score = 0; score < iterations; ++score) {
+        std::string text = "Score: " + std::to_string(score * 10) + "  Lives: 3  Level: 1";
+        const AMB::TextLayout& layout = layout_cache.update(1, font, text);
+        written += layout.get_written_count();
+        total += layout.get_quads().size();
+    }
+
+    // --- patched layouts against fresh ones, random edits of 1 to 4 byte characters and new lines ---
+    const char* pieces[] = {"a", "W", " ", "1", "\n", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9D\x84\x9E"};
+    std::mt19937 rng(37);
+    std::vector<std::string> characters;
+    AMB::TextLayoutCache patched;
+    uint32_t mismatches = 0, edits = 0;
+    for (float scale : {1.0f, 1.5f}) {
+        characters.clear();
+        for (int edit = 0; edit < 5000; ++edit, ++edits) {
+            // Replace up to 3 characters at a random place with up to 3 others
+            size_t begin = std::uniform_int_distribution<size_t>(0, characters.size())(rng);
+            size_t removed = std::uniform_int_distribution<size_t>(0, std::min<size_t>(3, characters.size() - begin))(rng);
+            characters.erase(characters.begin() + begin, characters.begin() + begin + removed);
+            for (int n = std::uniform_int_distribution<int>(0, 3)(rng); n > 0; --n) {
+                characters.insert(characters.begin() + begin, pieces[std::uniform_int_distribution<int>(0, 7)(rng)]);
+            }
+
+            std::string text;
+            for (const std::string& c : characters) {
+                text += c;
+            }
+            AMB::TextLayout fresh;
+            fresh.set_text(font, text, scale);
+            mismatches += !same_layout(patched.update(1, font, text, scale), fresh);
+        }
+    }
+
+    double glyphs = double(glyph_count) * iterations;
+    std::cout << "Layout every frame: " << glyphs / submit_time.count() / 1e6 << " M glyphs/s" << std::endl;
+    std::cout << "Cached layout: " << glyphs / layout_time.count() / 1e6 << " M glyphs/s"
+              << " (" << layout_cache.get_hit_count() << " hits, " << layout_cache.get_miss_count() << " misses)" << std::endl;
+    std::cout << "Score counter: " << written << " glyphs laid out of " << total << " submitted" << std::endl;
+    std::cout << "Patched layouts: " << mismatches << " of " << edits << " edits differ from a fresh layout" << std::endl;
+    if (mismatches != 0) {
+        return EXIT_FAILURE;
+    }
+
+    // Both texts on screen, the score is patched every frame
+    mat::Mat4f ortho = mat::graph::orthographic3<float>(0.0f, window.get_width(), 0.0f, window.get_height(), -1.0f, 1.0f);
+    uint32_t frame = 0;
+
+    while (!event_manager.is_quitting()) {
+        event_manager.manage();
+
+        if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_ESCAPE)) {
+            event_manager.quit();
+        }
+
+        std::string score = "Score: " + std::to_string(frame++);
+        text_renderer.reset();
+        text_renderer.submit_layout(layout_cache.get(font, "Cached layouts"), mat::Vec3f({25.0f, 550.0f, 0.0f}), 1.0f, 1.0f, 1.0f);
+        text_renderer.submit_layout(layout_cache.update(1, font, score), mat::Vec3f({25.0f, 520.0f, 0.0f}), 1.0f, 0.8f, 0.2f);
+        text_renderer.build_mesh();
+
+        renderer.clear();
+        text_renderer.draw(ortho);
+        window.present();
+
+        timer.wait();
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+
+#include "Window/Window.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Text/FontSystem.hpp"
+#include "Text/DynamicFont.hpp"
+#include "Text/Text.hpp"
+
+#include "Check.hpp"
+
+// Submit a text to a new renderer over a dynamic font whose glyphs already fill three pages, the
+// first glyph of the text on the last page: the batches of the pages skipped must be grown too.
+
+int main(int argc, char* argv[]) {
+
+    bool ok = true;
+
+    AMB::Window window(800, 600, "Text pages", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+
+    AMB::AssetHandle shader_handle = asset_factory.create_shader(std::string("test/res/Text.vert"), std::string("test/res/Text.frag"));
+    AMB::AssetHandle font_handle = asset_factory.create_dynamic_font(std::string("test/res/OpenSans.ttf"), 24, 64, 4);
+    if (!asset_manager.shaders.validity(shader_handle) || !asset_manager.dynamic_fonts.validity(font_handle)) {
+        std::cerr << "Failed to load the text assets." << std::endl;
+        return EXIT_FAILURE;
+    }
+    AMB::Shader& shader = asset_manager.shaders.get(shader_handle);
+    AMB::DynamicFont& font = asset_manager.dynamic_fonts.get(font_handle);
+
+    // Rasterize glyphs until three pages are used, without evicting any
+    char first_on_page[3] = {0, 0, 0};
+    for (char c = 'A'; c <= 'z' && font.get_page_count() < 3; ++c) {
+        const AMB::DynamicGlyph& glyph = font.get_glyph(c);
+        if (glyph.character.width > 0 && glyph.page < 3 && first_on_page[glyph.page] == 0) {
+            first_on_page[glyph.page] = c;
+        }
+    }
+    font.flush();
+    ok &= check(font.get_page_count() == 3 && first_on_page[1] != 0 && first_on_page[2] != 0, "glyphs on three pages");
+    ok &= check(font.get_eviction_count() == 0, "no glyph evicted");
+    if (!ok) {
+        std::cout << "Some checks failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Page 2 is reached before page 1, then page 1 is written in the same submission
+    std::string text;
+    for (uint32_t i = 0; i < 8; ++i) {
+        text += first_on_page[2];
+        text += first_on_page[1];
+        text += first_on_page[0];
+    }
+
+    AMB::TextRenderer text_renderer(font, shader, 4);
+    text_renderer.submit_text(text, mat::Vec3f({10.0f, 300.0f, 0.0f}), 1.0f, 1.0f, 1.0f, 1.0f);
+    ok &= check(text_renderer.get_char_count() == text.size(), "every glyph submitted");
+
+    text_renderer.reset();
+    text_renderer.submit_text(text + text, mat::Vec3f({10.0f, 300.0f, 0.0f}), 1.0f, 1.0f, 1.0f, 1.0f);
+    ok &= check(text_renderer.get_char_count() == 2 * text.size(), "every glyph submitted after a reset");
+
+    font.flush();
+    text_renderer.build_mesh();
+
+    std::cout << (ok ? "All checks passed" : "Some checks failed") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+
+#include "Window/Window.hpp"
+#include "Time/Timer.hpp"
+#include "Event/Event.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Graphic/Renderer.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "Text/FontSystem.hpp"
+#include "Text/Font.hpp"
+#include "Text/Text.hpp"
+
+// Eight sizes of the same font: eight bitmap fonts against one signed distance field font.
+// The load times and atlas sizes are printed, the text is drawn at the eight sizes from the
+// single distance field atlas. UP / DOWN change the scale of the whole text.
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(1000, 600, "Text SDF", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::EventManager event_manager(&window);
+    AMB::Timer timer(60);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+    AMB::Renderer renderer;
+    AMB::ThreadPool pool;
+
+    renderer.set_clear_color(0.1f, 0.1f, 0.1f, 1.0f);
+    renderer.set_blend(true);
+    renderer.set_depth_test(false);
+
+    const uint32_t sizes[8] = {10, 12, 14, 16, 20, 24, 32, 48};
+
+    using Clock = std::chrono::high_resolution_clock;
+    using ms = std::chrono::duration<float, std::milli>;
+
+    // --- one bitmap font per size ---
+    auto start = Clock::now();
+    size_t bitmap_bytes = 0;
+    for (uint32_t size : sizes) {
+        AMB::AssetHandle handle = asset_factory.create_font(std::string("test/res/OpenSans.ttf"), size);
+        bitmap_bytes += asset_manager.fonts.get(handle).get_texture().get_memory_size();
+    }
+    glFinish();
+    ms bitmap_time = Clock::now() - start;
+
+    // --- one distance field font ---
+    start = Clock::now();
+    AMB::AssetHandle font_handle = asset_factory.create_sdf_font(std::string("test/res/OpenSans.ttf"), 48, 6, &pool);
+    glFinish();
+    ms sdf_time = Clock::now() - start;
+
+    AMB::AssetHandle shader_handle = asset_factory.create_shader(std::string("test/res/Text.vert"), std::string("test/res/TextSDF.frag"));
+    if (!asset_manager.shaders.validity(shader_handle) || !asset_manager.fonts.validity(font_handle)) {
+        std::cerr << "Failed to load the text assets." << std::endl;
+        return EXIT_FAILURE;
+    }
+    AMB::Shader& shader = asset_manager.shaders.get(shader_handle);
+    AMB::Font& font = asset_manager.fonts.get(font_handle);
+
+    std::cout << "Bitmap fonts: " << bitmap_time.count() << " ms, " << bitmap_bytes / 1024 << " KiB" << std::endl;
+    std::cout << "SDF font: " << sdf_time.count() << " ms, " << font.get_texture().get_memory_size() / 1024 << " KiB" << std::endl;
+
+    mat::Mat4f ortho = mat::graph::orthographic3<float>(0.0f, window.get_width(), 0.0f, window.get_height(), -1.0f, 1.0f);
+    AMB::TextRenderer text_renderer(font, shader, 512);
+
+    float zoom = 1.0f;
+    while (!event_manager.is_quitting()) {
+        event_manager.manage();
+
+        if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_ESCAPE)) {
+            event_manager.quit();
+        }
+        if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_UP)) {
+            zoom *= 1.25f;
+        }
+        if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_DOWN)) {
+            zoom /= 1.25f;
+        }
+
+        text_renderer.reset();
+        float y = 560.0f;
+        for (uint32_t size : sizes) {
+            float scale = zoom * size / font.get_sdf_base_size();
+            text_renderer.submit_text(std::to_string(size) + " px: The quick brown fox jumps over the lazy dog.",
+                mat::Vec3f({20.0f, y, 0.0f}), 1.0f, 1.0f, 1.0f, 1.0f, scale);
+            y -= font.get_height() * scale * 1.2f;
+        }
+        text_renderer.build_mesh();
+
+        renderer.clear();
+        text_renderer.draw(ortho);
+        window.present();
+
+        timer.wait();
+    }
+
+    return 0;
+}
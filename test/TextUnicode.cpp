@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+
+#include "Window/Window.hpp"
+#include "Time/Timer.hpp"
+#include "Event/Event.hpp"
+#include "Asset/AssetManager.hpp"
+#include "Asset/AssetFactory.hpp"
+#include "Graphic/Renderer.hpp"
+#include "Text/FontSystem.hpp"
+#include "Text/DynamicFont.hpp"
+#include "Text/Text.hpp"
+
+// UTF-8 text with a dynamic font: the glyphs are rasterized when first drawn into small atlas
+// pages. SPACE scrolls through a large range of code points so that the cold glyphs get evicted,
+// the atlas memory stays bounded by the page count.
+
+int main(int argc, char* argv[]) {
+
+    AMB::Window window(1000, 600, "Text unicode", SDL_INIT_EVERYTHING, SDL_WINDOW_OPENGL);
+    AMB::EventManager event_manager(&window);
+    AMB::Timer timer(60);
+    AMB::AssetManager asset_manager;
+    AMB::FontSystem font_system;
+    AMB::AssetFactory asset_factory(asset_manager, font_system);
+    AMB::Renderer renderer;
+
+    renderer.set_clear_color(0.1f, 0.1f, 0.1f, 1.0f);
+    renderer.set_blend(true);
+    renderer.set_depth_test(false);
+
+    AMB::AssetHandle shader_handle = asset_factory.create_shader(std::string("test/res/Text.vert"), std::string("test/res/Text.frag"));
+    AMB::AssetHandle font_handle = asset_factory.create_dynamic_font(std::string("test/res/OpenSans.ttf"), 24, 256, 2);
+    if (!asset_manager.shaders.validity(shader_handle) || !asset_manager.dynamic_fonts.validity(font_handle)) {
+        std::cerr << "Failed to load the text assets." << std::endl;
+        return EXIT_FAILURE;
+    }
+    AMB::Shader& shader = asset_manager.shaders.get(shader_handle);
+    AMB::DynamicFont& font = asset_manager.dynamic_fonts.get(font_handle);
+
+    mat::Mat4f ortho = mat::graph::orthographic3<float>(0.0f, window.get_width(), 0.0f, window.get_height(), -1.0f, 1.0f);
+
+    AMB::TextRenderer text_renderer(font, shader, 512);
+
+    // The font has no CJK glyphs, they are drawn with its missing glyph box
+    const std::string greeting =
+        "Hello, Grüße, Привет, Γειά σου, Olá, Ça va?\n"
+        "日本語 中文 한국어\n";
+
+    uint32_t first_codepoint = 0x100;
+
+    while (!event_manager.is_quitting()) {
+        event_manager.manage();
+
+        if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_ESCAPE)) {
+            event_manager.quit();
+        }
+
+        if (event_manager.keyboard().key_down(AMB::KeyCode::KEY_CODE_SPACE)) {
+            first_codepoint = first_codepoint >= 0x500 ? 0x100 : first_codepoint + 0x40;
+        }
+
+        // Build the text of the frame: the greeting and a block of code points
+        std::string block;
+        for (uint32_t cp = first_codepoint; cp < first_codepoint + 0x40; ++cp) {
+            char utf8[3] = {char(0xC0 | (cp >> 6)), char(0x80 | (cp & 0x3F)), 0};
+            block += utf8;
+            if ((cp & 0x0F) == 0x0F) {
+                block += '\n';
+            }
+        }
+
+        text_renderer.reset();
+        text_renderer.submit_text(greeting, mat::Vec3f({25.0f, 550.0f, 0.0f}), 1.0f, 1.0f, 0.0f, 1.0f);
+        text_renderer.submit_text(block, mat::Vec3f({25.0f, 450.0f, 0.0f}), 1.0f, 1.0f, 1.0f, 1.0f);
+
+        std::string stats = "glyphs " + std::to_string(font.get_glyph_count()) +
+            "  pages " + std::to_string(font.get_page_count()) +
+            "  evictions " + std::to_string(font.get_eviction_count()) +
+            "  upload " + std::to_string(font.get_upload_size()) + " B";
+        text_renderer.submit_text(stats, mat::Vec3f({25.0f, 30.0f, 0.0f}), 0.6f, 0.8f, 1.0f, 1.0f);
+
+        // Upload the new glyphs once for all the texts of the frame
+        font.flush();
+        text_renderer.build_mesh();
+
+        renderer.clear();
+        text_renderer.draw(ortho);
+        window.present();
+
+        timer.wait();
+    }
+
+    return 0;
+}
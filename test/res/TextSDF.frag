@@ -0,0 +1,17 @@
+// TextSDF.frag
+#version 330 core
+in vec2 texture_coord;
+
+uniform sampler2D u_texture;
+
+out vec4 frag_color;
+in vec4 vertex_color;
+
+void main()
+{
+    // Distance to the outline: 0.5 on it, the antialiasing width follows the screen size of a texel
+    float distance = texture(u_texture, texture_coord).r;
+    float width = max(fwidth(distance) * 0.75, 1e-4);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    frag_color = vec4(vertex_color.r, vertex_color.g, vertex_color.b, vertex_color.a * alpha);
+}
@@ -0,0 +1,245 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Asset/PackFormat.hpp"
+#include "Asset/AssetPack.hpp"
+
+// Offline packer of the amber pack format (see inc/Asset/PackFormat.hpp)
+//
+//  AmberPack pack <output.amb> <directory> [--no-compress] [--alignment N]
+//  AmberPack list <pack.amb>
+//  AmberPack verify <pack.amb> <directory>
+
+// Defined by stb_image_write (compiled in the engine library), not declared in its header
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+namespace fs = std::filesystem;
+
+struct SourceFile {
+    std::string name;
+    fs::path path;
+    uint64_t hash;
+};
+
+bool read_file(const fs::path& path, std::vector<uint8_t>& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Formats already compressed, zlib would only cost time at load
+bool is_compressible(const fs::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    static const char* compressed[] = {".png", ".jpg", ".jpeg", ".ogg", ".mp3", ".flac", ".amb"};
+    for (const char* ext : compressed) {
+        if (extension == ext) return false;
+    }
+    return true;
+}
+
+uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+int pack(const std::string& output, const std::string& directory, bool compress, uint32_t alignment) {
+    // Collect the files
+    // Without exceptions: a directory which can not be read stops the pack
+    std::vector<SourceFile> files;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) {
+            continue;
+        }
+        std::string name = AMB::pack_normalize_name(fs::relative(it->path(), directory).generic_string());
+        files.push_back(SourceFile{name, it->path(), AMB::pack_hash(name)});
+    }
+    if (error) {
+        std::cerr << "Can not read " << directory << " : " << error.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Sorted by hash for the binary search, by name for a deterministic output
+    std::sort(files.begin(), files.end(), [](const SourceFile& a, const SourceFile& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+    });
+
+    // Names block
+    std::string names;
+    std::vector<AMB::PackEntry> entries(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        entries[i].hash = files[i].hash;
+        entries[i].name_offset = static_cast<uint32_t>(names.size());
+        names += files[i].name;
+        names += '\0';
+    }
+
+    AMB::PackHeader header{};
+    header.magic = AMB::PACK_MAGIC;
+    header.version = AMB::PACK_VERSION;
+    header.entry_count = static_cast<uint32_t>(files.size());
+    header.alignment = alignment;
+    header.index_offset = sizeof(AMB::PackHeader);
+    header.names_offset = header.index_offset + entries.size() * sizeof(AMB::PackEntry);
+    header.names_size = names.size();
+
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Can not write " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Payloads first, the index is written at the end once the offsets are known
+    uint64_t offset = align_up(header.names_offset + header.names_size, alignment);
+    out.seekp(static_cast<std::streamoff>(offset));
+
+    uint64_t total_original = 0, total_stored = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::vector<uint8_t> content;
+        if (!read_file(files[i].path, content)) {
+            std::cerr << "Can not read " << files[i].path << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        AMB::PackEntry& entry = entries[i];
+        entry.original_size = content.size();
+        entry.flags = AMB::PACK_ENTRY_NONE;
+
+        const uint8_t* payload = content.data();
+        uint64_t payload_size = content.size();
+
+        // Keep the compressed version only if it saves at least 10%
+        unsigned char* compressed = nullptr;
+        if (compress && !content.empty() && is_compressible(files[i].path)) {
+            int compressed_size = 0;
+            compressed = stbi_zlib_compress(content.data(), static_cast<int>(content.size()), &compressed_size, 8);
+            if (compressed && uint64_t(compressed_size) * 10 <= content.size() * 9) {
+                payload = compressed;
+                payload_size = uint64_t(compressed_size);
+                entry.flags |= AMB::PACK_ENTRY_ZLIB;
+            }
+        }
+
+        entry.offset = offset;
+        entry.size = payload_size;
+        out.write(reinterpret_cast<const char*>(payload), static_cast<std::streamsize>(payload_size));
+        std::free(compressed);
+
+        total_original += entry.original_size;
+        total_stored += entry.size;
+
+        // Padding up to the next aligned payload
+        uint64_t next = align_up(offset + payload_size, alignment);
+        static const char zeros[256] = {};
+        for (uint64_t pad = next - (offset + payload_size); pad > 0; pad -= std::min<uint64_t>(pad, sizeof(zeros))) {
+            out.write(zeros, static_cast<std::streamsize>(std::min<uint64_t>(pad, sizeof(zeros))));
+        }
+        offset = next;
+
+        std::cout << ((entry.flags & AMB::PACK_ENTRY_ZLIB) ? "  z " : "    ") << files[i].name
+                  << " (" << entry.original_size << " -> " << entry.size << ")" << std::endl;
+    }
+
+    header.file_size = offset;
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AMB::PackEntry)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    // Explicit padding so the header file size matches the file
+    uint64_t names_end = header.names_offset + header.names_size;
+    if (files.empty() && offset > names_end) {
+        std::string padding(offset - names_end, '\0');
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    }
+
+    if (!out) {
+        std::cerr << "Error while writing " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << files.size() << " files, " << total_original << " bytes -> " << total_stored << " bytes stored, pack size " << header.file_size << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int list(const std::string& path) {
+    AMB::AssetPack pack;
+    if (!pack.open(path)) {
+        return EXIT_FAILURE;
+    }
+    for (const auto& name : pack.list()) {
+        std::cout << name << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
+
+int verify(const std::string& path, const std::string& directory) {
+    AMB::AssetPack pack;
+    if (!pack.open(path)) {
+        return EXIT_FAILURE;
+    }
+
+    int errors = 0;
+    for (const auto& name : pack.list()) {
+        std::vector<uint8_t> content;
+        AMB::PackData data = pack.get(name);
+        if (!read_file(fs::path(directory) / name, content) || !data.valid()
+            || content.size() != data.size || std::memcmp(content.data(), data.data, data.size) != 0) {
+            std::cerr << "Mismatch : " << name << std::endl;
+            ++errors;
+        }
+    }
+
+    std::cout << pack.get_entry_count() << " entries checked, " << errors << " errors" << std::endl;
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int usage() {
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  AmberPack pack <output.amb> <directory> [--no-compress] [--alignment N]" << std::endl;
+    std::cout << "  AmberPack list <pack.amb>" << std::endl;
+    std::cout << "  AmberPack verify <pack.amb> <directory>" << std::endl;
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    std::string command = argc > 1 ? argv[1] : "";
+
+    // The directory of pack and verify
+    std::error_code error;
+    if ((command == "pack" || command == "verify") && argc >= 4 && !fs::is_directory(argv[3], error)) {
+        std::cerr << "Not a directory : " << argv[3] << std::endl;
+        return usage();
+    }
+
+    if (command == "pack" && argc >= 4) {
+        bool compress = true;
+        uint32_t alignment = AMB::PACK_DEFAULT_ALIGNMENT;
+        for (int i = 4; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--no-compress") == 0) {
+                compress = false;
+            } else if (std::strcmp(argv[i], "--alignment") == 0 && i + 1 < argc) {
+                alignment = static_cast<uint32_t>(std::max(8, std::atoi(argv[++i])));
+            }
+        }
+        return pack(argv[2], argv[3], compress, alignment);
+    }
+    if (command == "list" && argc >= 3) {
+        return list(argv[2]);
+    }
+    if (command == "verify" && argc >= 4) {
+        return verify(argv[2], argv[3]);
+    }
+
+    return usage();
+}